@@ -0,0 +1,327 @@
+#version 450
+
+#extension GL_EXT_nonuniform_qualifier : require
+
+// Lighting subpass of the deferred path (see VyDeferredRenderSystem).
+//
+// Reads the G-buffer and the depth of its pixel as input attachments, reconstructs the world position and adds the
+// directional and clustered point / spot lights to the HDR target (additive blending on top of the ambient and
+// emission of the geometry subpass). Same lighting model as Material.frag.
+
+// ================================================================================================
+
+struct Light
+{
+    vec4  Position;    // xyz = position,  w = range   (point / spot)
+    vec4  Direction;   // xyz = direction, w = unused  (directional / spot)
+    vec4  Color;       // rgb = color,     a = intensity
+    float InnerCutoff; // cos of inner angle (spot)
+    float OuterCutoff; // cos of outer angle (spot)
+    uint  Type;
+    uint  ShadowIndex; // Into uShadows, NO_SHADOW if the light casts none.
+};
+
+// Shadow of a light, written by VyShadowSystem.
+struct Shadow
+{
+    mat4 LightSpaceMatrix; // Directional / spot.
+    vec4 UVRect;           // Directional / spot: atlas tile, xy = offset, zw = scale.
+    vec4 PositionAndRange; // Point: xyz = position, w = far plane of the cube map.
+    uint Valid;            // Unshadowed until the shadow has been rendered.
+    uint CubeIndex;        // Point: cube map of the moving casters, the static one follows the dynamic ones.
+    uint _pad0;
+    uint _pad1;
+};
+
+struct CameraData
+{
+    mat4 Projection;
+    mat4 View;
+    mat4 InverseView;
+};
+
+#define LIGHT_DIRECTIONAL 0
+#define LIGHT_POINT       1
+#define LIGHT_SPOT        2
+
+#define NO_SHADOW         0xFFFFFFFFu
+
+#define SHADOW_STATIC     0 // Atlas layers, see VyShadowSystem.
+#define SHADOW_DYNAMIC    1
+
+#define MAX_CUBE_SHADOWS  4 // VyShadowSystem::MAX_CUBE_SHADOW_MAPS
+
+// ================================================================================================
+// Uniforms
+
+layout(set = 0, binding = 0) uniform GlobalUBO 
+{
+    CameraData       Camera;
+
+    vec4             AmbientLightColor; // rgb = color, a = intensity
+
+    uvec4            ClusterGrid;       // xyz = clusters per axis, w = max lights per cluster
+    vec4             ClusterParams;     // xy  = tile size in pixels, z = slice scale, w = slice bias
+
+    uint             NumDirectionalLights;
+    uint             NumLocalLights;
+
+} uUbo;
+
+// Directional lights, followed by the point and spot lights referenced by the clusters.
+layout(std430, set = 0, binding = 1) readonly buffer LightBuffer 
+{
+    Light Lights[];
+
+} uLights;
+
+// Number of lights per cluster, written by ClusterLights.comp.
+layout(std430, set = 0, binding = 2) readonly buffer ClusterCountBuffer 
+{
+    uint Counts[];
+
+} uClusterCounts;
+
+// Light indices of each cluster, ClusterGrid.w slots per cluster.
+layout(std430, set = 0, binding = 3) readonly buffer ClusterIndexBuffer 
+{
+    uint Indices[];
+
+} uClusterIndices;
+
+// Shadows, indexed with Light.ShadowIndex.
+layout(std430, set = 0, binding = 4) readonly buffer ShadowBuffer 
+{
+    Shadow Shadows[];
+
+} uShadows;
+
+// Shadow maps of the directional and spot lights, one tile per light in a static and a dynamic layer.
+layout(set = 0, binding = 5) uniform sampler2DArrayShadow uShadowAtlas;
+
+// Normalized distances to the point lights (see CubeShadow.frag), the moving casters first, then the casters at rest.
+layout(set = 0, binding = 6) uniform samplerCube uShadowCubes[ MAX_CUBE_SHADOWS * 2 ];
+
+// G-buffer, written by GBuffer.frag in the geometry subpass.
+layout(input_attachment_index = 0, set = 1, binding = 0) uniform subpassInput uGBufferAlbedo; // rgb = albedo,            a = metallic
+layout(input_attachment_index = 1, set = 1, binding = 1) uniform subpassInput uGBufferNormal; // rg  = octahedral normal, b = roughness
+layout(input_attachment_index = 2, set = 1, binding = 2) uniform subpassInput uDepth;
+
+layout(push_constant) uniform Push
+{
+    mat4 InverseProjection;
+    vec4 ScreenSize; // xy = size in pixels, zw = 1 / size
+
+} uPush;
+
+// Output
+layout(location = 0) out vec4 outColor;
+
+// ================================================================================================
+
+// Inverse of encodeNormal in GBuffer.frag.
+vec3 decodeNormal(vec2 encoded)
+{
+    encoded = encoded * 2.0 - 1.0;
+
+    vec3  n = vec3(encoded, 1.0 - abs(encoded.x) - abs(encoded.y));
+    float t = clamp(-n.z, 0.0, 1.0);
+
+    n.xy += vec2(n.x >= 0.0 ? -t : t, n.y >= 0.0 ? -t : t);
+
+    return normalize(n);
+}
+
+// Cluster of a fragment, from its window position and view depth (the camera looks down +Z).
+uint clusterIndex(vec2 fragCoord, float viewZ)
+{
+    uvec3 grid  = uUbo.ClusterGrid.xyz;
+    float slice = log(max(viewZ, 1e-4)) * uUbo.ClusterParams.z + uUbo.ClusterParams.w;
+
+    uvec3 cluster = min(uvec3(uvec2(fragCoord / uUbo.ClusterParams.xy), uint(max(slice, 0.0))), grid - 1u);
+
+    return cluster.x + grid.x * (cluster.y + grid.y * cluster.z);
+}
+
+// Fades a light out towards its range, so it is safe to cull outside of it. ~1 well within the range.
+float rangeWindow(float distanceSq, float range)
+{
+    float ratio  = distanceSq / (range * range);
+    float window = clamp(1.0 - ratio * ratio, 0.0, 1.0);
+
+    return window * window;
+}
+
+// Visibility of a directional / spot shadow, 3x3 PCF kept inside the light's atlas tile.
+// A texel is lit when it is lit in both the static and the dynamic layer.
+float atlasShadow(Shadow shadow, vec3 fragPosWorld)
+{
+    vec4 lightSpace = shadow.LightSpaceMatrix * vec4(fragPosWorld, 1.0);
+
+    if (lightSpace.w <= 0.0)
+    {
+        return 1.0;
+    }
+
+    vec3 projected = lightSpace.xyz / lightSpace.w;
+    vec2 shadowUV  = projected.xy * 0.5 + 0.5;
+
+    // Outside of the light's frustum.
+    if (any(lessThan(shadowUV, vec2(0.0))) || any(greaterThan(shadowUV, vec2(1.0))) || projected.z > 1.0)
+    {
+        return 1.0;
+    }
+
+    // One texel of the tile in tile UVs, the taps stay half a texel inside the tile so the filter never reads a neighbour.
+    float tileTexel = 1.0 / (shadow.UVRect.z * float(textureSize(uShadowAtlas, 0).x));
+    float halfTexel = 0.5 * tileTexel;
+
+    float visibility = 0.0;
+
+    for (int x = -1; x <= 1; x++)
+    {
+        for (int y = -1; y <= 1; y++)
+        {
+            vec2 tapUV   = clamp(shadowUV + vec2(x, y) * tileTexel, halfTexel, 1.0 - halfTexel);
+            vec2 atlasUV = shadow.UVRect.xy + tapUV * shadow.UVRect.zw;
+
+            visibility += texture(uShadowAtlas, vec4(atlasUV, SHADOW_STATIC,  projected.z)) *
+                          texture(uShadowAtlas, vec4(atlasUV, SHADOW_DYNAMIC, projected.z));
+        }
+    }
+
+    return visibility / 9.0;
+}
+
+// Visibility of a point light shadow, lit when nothing in either cube map is nearer to the light than the fragment.
+float cubeShadow(Shadow shadow, vec3 fragPosWorld)
+{
+    vec3  lightToFrag  = fragPosWorld - shadow.PositionAndRange.xyz;
+    float lightDist    = length(lightToFrag);
+    float farPlane     = shadow.PositionAndRange.w;
+
+    uint  dynamicIndex = shadow.CubeIndex;
+    uint  staticIndex  = shadow.CubeIndex + MAX_CUBE_SHADOWS;
+
+    // The cube maps are written through gl_FragDepth, the pipeline's depth bias does not apply:
+    // offset by about a texel at the fragment's distance instead.
+    float texel        = 2.0 * lightDist / float(textureSize(uShadowCubes[ nonuniformEXT(dynamicIndex) ], 0).x);
+    float current      = (lightDist - 1.5 * texel - 0.02) / farPlane;
+
+    float closest      = min(texture(uShadowCubes[ nonuniformEXT(dynamicIndex) ], lightToFrag).r,
+                             texture(uShadowCubes[ nonuniformEXT(staticIndex)  ], lightToFrag).r);
+
+    return current <= closest ? 1.0 : 0.0;
+}
+
+// Visibility of a light at a fragment, 1 for lights without a rendered shadow.
+float shadowVisibility(Light light, vec3 fragPosWorld)
+{
+    if (light.ShadowIndex == NO_SHADOW)
+    {
+        return 1.0;
+    }
+
+    Shadow shadow = uShadows.Shadows[ light.ShadowIndex ];
+
+    if (shadow.Valid == 0u)
+    {
+        return 1.0;
+    }
+
+    return light.Type == LIGHT_POINT ? cubeShadow(shadow, fragPosWorld) : atlasShadow(shadow, fragPosWorld);
+}
+
+// Blinn-Phong diffuse and specular of one light.
+void shadeLight(
+    vec3       surfaceNormal, 
+    vec3       viewDirection, 
+    vec3       directionToLight, 
+    vec3       intensity, 
+    float      shininess, 
+    vec3       specularColor, 
+    inout vec3 diffuseLight, 
+    inout vec3 specularLight)
+{
+    float cosAngleIncidence = max(dot(surfaceNormal, directionToLight), 0);
+
+    diffuseLight += intensity * cosAngleIncidence;
+
+    // Specular
+    vec3  halfAngle = normalize(directionToLight + viewDirection);
+    float blinnTerm = clamp(dot(surfaceNormal, halfAngle), 0, 1);
+    blinnTerm = pow(blinnTerm, shininess);
+
+    specularLight += intensity * blinnTerm * specularColor;
+}
+
+// ================================================================================================
+
+void main() 
+{
+    vec4  albedoMetallic = subpassLoad(uGBufferAlbedo);
+    vec4  normalRough    = subpassLoad(uGBufferNormal);
+    float depth          = subpassLoad(uDepth).r;
+
+    vec3  materialColor  = albedoMetallic.rgb;
+    float metallic       = albedoMetallic.a;
+    vec3  surfaceNormal  = decodeNormal(normalRough.rg);
+    float roughness      = normalRough.b;
+
+    // [ Position ]
+    vec2 ndc     = gl_FragCoord.xy * uPush.ScreenSize.zw * 2.0 - 1.0;
+    vec4 viewPos = uPush.InverseProjection * vec4(ndc, depth, 1.0);
+    viewPos /= viewPos.w;
+
+    vec3 fragPosWorld = (uUbo.Camera.InverseView * vec4(viewPos.xyz, 1.0)).xyz;
+
+    // Diffuse + specular, the ambient term was written by the geometry subpass.
+    vec3 diffuseLight  = vec3(0.0);
+    vec3 specularLight = vec3(0.0);
+
+    vec3 cameraPosWorld = uUbo.Camera.InverseView[3].xyz;
+    vec3 viewDirection  = normalize(cameraPosWorld - fragPosWorld);
+
+    float shininess     = mix(128.0, 8.0, roughness);
+    vec3  specularColor = mix(vec3(0.04), materialColor, metallic);
+
+    // Directional lights
+    for (uint i = 0; i < uUbo.NumDirectionalLights; i++) 
+    {
+        Light light = uLights.Lights[i];
+    
+        vec3 directionToLight = normalize(-light.Direction.xyz);
+        vec3 intensity        = light.Color.xyz * light.Color.w * shadowVisibility(light, fragPosWorld);
+
+        shadeLight(surfaceNormal, viewDirection, directionToLight, intensity, shininess, specularColor, diffuseLight, specularLight);
+    }
+
+    // Point and spot lights, only the ones binned into the pixel's cluster.
+    uint cluster = clusterIndex(gl_FragCoord.xy, viewPos.z);
+    uint count   = uClusterCounts.Counts[ cluster ];
+
+    for (uint i = 0; i < count; i++) 
+    {
+        Light light = uLights.Lights[ uClusterIndices.Indices[ cluster * uUbo.ClusterGrid.w + i ] ];
+
+        vec3  directionToLight = light.Position.xyz - fragPosWorld;
+        float distanceSq       = dot(directionToLight, directionToLight);
+        float attenuation      = rangeWindow(distanceSq, light.Position.w) / max(distanceSq, 0.0001);
+
+        directionToLight = normalize(directionToLight);
+
+        if (light.Type == LIGHT_SPOT)
+        {
+            float theta   = dot(directionToLight, normalize(-light.Direction.xyz));
+            float epsilon = light.InnerCutoff - light.OuterCutoff;
+
+            attenuation *= clamp((theta - light.OuterCutoff) / epsilon, 0.0, 1.0);
+        }
+
+        vec3 intensity = light.Color.xyz * light.Color.w * attenuation * shadowVisibility(light, fragPosWorld);
+
+        shadeLight(surfaceNormal, viewDirection, directionToLight, intensity, shininess, specularColor, diffuseLight, specularLight);
+    }
+
+    outColor = vec4(diffuseLight * materialColor + specularLight, 0.0);
+}
@@ -0,0 +1,15 @@
+#version 450
+
+// Fullscreen triangle of the deferred lighting subpass, on the far plane so the depth test (GREATER) rejects the
+// background before it is shaded.
+
+void main() 
+{
+    vec2 positions[3] = vec2[](
+        vec2(-1.0, -1.0),
+        vec2( 3.0, -1.0),
+        vec2(-1.0,  3.0)
+    );
+
+    gl_Position = vec4(positions[gl_VertexIndex], 1.0, 1.0);
+}
@@ -0,0 +1,161 @@
+#version 450
+
+#extension GL_EXT_nonuniform_qualifier : require
+
+// Geometry subpass of the deferred path (see VyDeferredRenderSystem).
+//
+// Writes the ambient and emissive term straight into the HDR target and the surface into the compact G-buffer, the
+// direct lighting is added by DeferredLighting.frag. Uses the vertex stage and the sets of the forward material pass.
+
+// ================================================================================================
+
+struct CameraData
+{
+    mat4 Projection;
+    mat4 View;
+    mat4 InverseView;
+};
+
+// ================================================================================================
+// Uniforms
+
+layout(set = 0, binding = 0) uniform GlobalUBO 
+{
+    CameraData       Camera;
+
+    vec4             AmbientLightColor; // rgb = color, a = intensity
+
+    // Lights and clusters, only used by the lighting subpass.
+
+} uUbo;
+
+struct InstanceData
+{
+    mat4 ModelMatrix;
+    mat4 NormalMatrix;
+
+    vec3 Color;         // Multiplied with the material albedo.
+    uint MaterialIndex; // Index into the bindless material buffer.
+};
+
+// Per-instance data, indexed with gl_InstanceIndex (firstInstance + instance).
+layout(std430, set = 2, binding = 0) readonly buffer InstanceBuffer 
+{
+    InstanceData Instances[];
+
+} uInstances;
+
+struct MaterialData
+{
+    vec3  Albedo;
+    float Metallic;
+    float Roughness;
+    float AO;
+
+    vec2  TextureOffset;
+    vec2  TextureScale;
+
+    // Slots in uTextures, slot 0 is a white texture.
+    uint  AlbedoTexture;
+    uint  NormalTexture;
+    uint  RoughnessTexture;
+    uint  MetallicTexture;
+    uint  _pad0;
+    uint  _pad1;
+
+    vec3  EmissionColor;
+    float EmissionStrength;
+};
+
+// Bindless material textures, indexed with the texture slots of MaterialData.
+layout(set = 1, binding = 0) uniform sampler2D uTextures[];
+
+// Material parameters, indexed with InstanceData.MaterialIndex.
+layout(std430, set = 1, binding = 1) readonly buffer MaterialBuffer 
+{
+    MaterialData Materials[];
+
+} uMaterials;
+
+// ================================================================================================
+
+// Input
+layout(location = 0) in vec3 fragPosWorld;
+layout(location = 1) in vec3 fragNormalWorld;
+layout(location = 2) in vec3 fragColor;
+layout(location = 3) in vec2 fragUV;
+layout(location = 4) flat in int fragInstanceIndex;
+
+// Output
+layout(location = 0) out vec4 outColor;  // HDR:        rgb = ambient + emission
+layout(location = 1) out vec4 outAlbedo; // G-buffer 0: rgb = albedo,            a = metallic
+layout(location = 2) out vec4 outNormal; // G-buffer 1: rg  = octahedral normal, b = roughness
+
+// ================================================================================================
+
+vec2 octWrap(vec2 v)
+{
+    return (1.0 - abs(v.yx)) * vec2(v.x >= 0.0 ? 1.0 : -1.0, v.y >= 0.0 ? 1.0 : -1.0);
+}
+
+// Maps a unit vector onto the octahedron unfolded into [ 0, 1 ]^2, two channels with an even error over the sphere.
+vec2 encodeNormal(vec3 n)
+{
+    n /= abs(n.x) + abs(n.y) + abs(n.z);
+
+    vec2 encoded = n.z >= 0.0 ? n.xy : octWrap(n.xy);
+
+    return encoded * 0.5 + 0.5;
+}
+
+// Calculate tangent-bitangent-normal matrix for normal mapping
+mat3 calculateTBN(vec3 normal, vec3 pos, vec2 uv) 
+{
+    vec3 dp1  = dFdx(pos);
+    vec3 dp2  = dFdy(pos);
+    vec2 duv1 = dFdx(uv);
+    vec2 duv2 = dFdy(uv);
+    
+    vec3 dp2perp   = cross(dp2, normal);
+    vec3 dp1perp   = cross(normal, dp1);
+    vec3 tangent   = dp2perp * duv1.x + dp1perp * duv2.x;
+    vec3 bitangent = dp2perp * duv1.y + dp1perp * duv2.y;
+    
+    float invmax = inversesqrt(max(dot(tangent, tangent), dot(bitangent, bitangent)));
+    
+    return mat3(tangent * invmax, bitangent * invmax, normal);
+}
+
+// ================================================================================================
+
+void main() 
+{
+    InstanceData uInstance = uInstances.Instances[ fragInstanceIndex ];
+
+    MaterialData uMaterial = uMaterials.Materials[ uInstance.MaterialIndex ];
+
+    // The instances of a draw can use different materials, so the texture index is not dynamically uniform.
+    vec3 materialColor = uMaterial.Albedo * uInstance.Color * texture(uTextures[ nonuniformEXT(uMaterial.AlbedoTexture) ], fragUV).rgb;
+    
+    // Sample normal map.
+    vec3 normalMap     = texture(uTextures[ nonuniformEXT(uMaterial.NormalTexture) ], fragUV).rgb;
+    vec3 N             = normalize(fragNormalWorld);
+    vec3 surfaceNormal = N;
+
+    // Use normal map if not a plain white texture.
+    vec3 whiteTexel = vec3(1.0, 1.0, 1.0);
+    
+    if (length(normalMap - whiteTexel) > 0.01) 
+    {
+        normalMap     = normalize(normalMap * 2.0 - 1.0);
+        mat3 TBN      = calculateTBN(N, fragPosWorld, fragUV);
+        surfaceNormal = normalize(TBN * normalMap);
+    }
+
+    vec3 ambient  = uUbo.AmbientLightColor.xyz * uUbo.AmbientLightColor.w * materialColor;
+    vec3 emission = uMaterial.EmissionColor * uMaterial.EmissionStrength;
+
+    outColor  = vec4(ambient + emission, 1.0);
+    outAlbedo = vec4(clamp(materialColor, 0.0, 1.0), uMaterial.Metallic);
+    outNormal = vec4(encodeNormal(surfaceNormal), uMaterial.Roughness, 0.0);
+}
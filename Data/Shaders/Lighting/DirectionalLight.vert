@@ -2,12 +2,6 @@
 
 layout(location = 0) out vec3 fragColor;
 
-struct DirectionalLight
-{
-    vec4 Direction;
-    vec4 Color;
-};
-
 layout(set = 0, binding = 0) uniform UBO
 {
     mat4             Projection;
@@ -16,8 +10,6 @@ layout(set = 0, binding = 0) uniform UBO
 
     vec4             AmbientLightColor;
 
-    vec4             pointLights[16 * 2]; // Placeholder
-    DirectionalLight DirectionalLights[16];
     // ... rest of UBO
 
 } uUbo;
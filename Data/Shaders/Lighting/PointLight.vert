@@ -1,13 +1,5 @@
 #version 450
 
-// ================================================================================================
-
-struct PointLight
-{
-    vec4 Position;  // ignore w
-    vec4 Color;     // w is intensity
-};
-
 // ================================================================================================
 // Uniforms
 
@@ -18,8 +10,6 @@ layout(set = 0, binding = 0) uniform GlobalUBO
     mat4       InverseView;
     
     vec4       AmbientLightColor; // w is intensity
-    PointLight PointLights[10];
-    int        NumPointLights;
 
 } uUbo;
 
@@ -2,21 +2,6 @@
 
 layout(location = 0) out vec3 fragColor;
 
-struct SpotLight
-{
-    vec4  Position;    // xyz = position,    w = unused
-    vec4  Direction;   // xyz = direction,   w = unused
-    vec4  Color;       // rgb = color,       a = intensity
-    float InnerCutoff; // cos of inner angle
-    float OuterCutoff; // cos of outer angle
-    float _pad0;
-    float _pad1;
-    // float outerCutoff;
-    // float constantAtten;
-    // float linearAtten;
-    // float quadraticAtten;
-};
-
 // ================================================================================================
 // Uniforms
 
@@ -27,9 +12,6 @@ layout(set = 0, binding = 0) uniform GlobalUBO
     mat4       InverseView;
 
     vec4       AmbientLightColor; // w is intensity
-    vec4       PointLights[16 * 2];       // Placeholder
-    vec4       DirectionalLights[16 * 2]; // Placeholder
-    SpotLight  SpotLights[16];
 
     // ... rest of UBO
 
@@ -1,28 +1,30 @@
 #version 450
 
-// ================================================================================================
+#extension GL_EXT_nonuniform_qualifier : require
 
-struct PointLight 
-{
-    vec4 Position; // xyz = position, w = unused
-    vec4 Color;    // rgb = color,    a = intensity
-};
+// ================================================================================================
 
-struct SpotLight 
+struct Light
 {
-    vec4  Position;    // xyz = position,  w = unused
-    vec4  Direction;   // xyz = direction, w = unused
+    vec4  Position;    // xyz = position,  w = range   (point / spot)
+    vec4  Direction;   // xyz = direction, w = unused  (directional / spot)
     vec4  Color;       // rgb = color,     a = intensity
-    float InnerCutoff; // cos of inner angle
-    float OuterCutoff; // cos of outer angle
-    float _pad0;
-    float _pad1;
+    float InnerCutoff; // cos of inner angle (spot)
+    float OuterCutoff; // cos of outer angle (spot)
+    uint  Type;
+    uint  ShadowIndex; // Into uShadows, NO_SHADOW if the light casts none.
 };
 
-struct DirectionalLight 
+// Shadow of a light, written by VyShadowSystem.
+struct Shadow
 {
-    vec4 Direction; // xyz = direction, w = unused
-    vec4 Color;     // rgb = color,     a = intensity
+    mat4 LightSpaceMatrix; // Directional / spot.
+    vec4 UVRect;           // Directional / spot: atlas tile, xy = offset, zw = scale.
+    vec4 PositionAndRange; // Point: xyz = position, w = far plane of the cube map.
+    uint Valid;            // Unshadowed until the shadow has been rendered.
+    uint CubeIndex;        // Point: cube map of the moving casters, the static one follows the dynamic ones.
+    uint _pad0;
+    uint _pad1;
 };
 
 struct CameraData
@@ -32,9 +34,16 @@ struct CameraData
     mat4 InverseView;
 };
 
-const int MAX_POINT_LIGHTS  = 10;
-const int MAX_DIRECT_LIGHTS = 10;
-const int MAX_SPOT_LIGHTS   = 10;
+#define LIGHT_DIRECTIONAL 0
+#define LIGHT_POINT       1
+#define LIGHT_SPOT        2
+
+#define NO_SHADOW         0xFFFFFFFFu
+
+#define SHADOW_STATIC     0 // Atlas layers, see VyShadowSystem.
+#define SHADOW_DYNAMIC    1
+
+#define MAX_CUBE_SHADOWS  4 // VyShadowSystem::MAX_CUBE_SHADOW_MAPS
 
 // ================================================================================================
 // Uniforms
@@ -45,37 +54,95 @@ layout(set = 0, binding = 0) uniform GlobalUBO
 
     vec4             AmbientLightColor; // rgb = color, a = intensity
 
-    PointLight       PointLights      [ MAX_POINT_LIGHTS  ];
-    DirectionalLight DirectionalLights[ MAX_DIRECT_LIGHTS ];
-    SpotLight        SpotLights       [ MAX_SPOT_LIGHTS   ];
-    int              NumPointLights;
-    int              NumDirectionalLights;
-    int              NumSpotLights;
+    uvec4            ClusterGrid;       // xyz = clusters per axis, w = max lights per cluster
+    vec4             ClusterParams;     // xy  = tile size in pixels, z = slice scale, w = slice bias
+
+    uint             NumDirectionalLights;
+    uint             NumLocalLights;
 
 } uUbo;
 
-layout(push_constant) uniform Push 
+// Directional lights, followed by the point and spot lights referenced by the clusters.
+layout(std430, set = 0, binding = 1) readonly buffer LightBuffer 
+{
+    Light Lights[];
+
+} uLights;
+
+// Number of lights per cluster, written by ClusterLights.comp.
+layout(std430, set = 0, binding = 2) readonly buffer ClusterCountBuffer 
+{
+    uint Counts[];
+
+} uClusterCounts;
+
+// Light indices of each cluster, ClusterGrid.w slots per cluster.
+layout(std430, set = 0, binding = 3) readonly buffer ClusterIndexBuffer 
+{
+    uint Indices[];
+
+} uClusterIndices;
+
+// Shadows, indexed with Light.ShadowIndex.
+layout(std430, set = 0, binding = 4) readonly buffer ShadowBuffer 
+{
+    Shadow Shadows[];
+
+} uShadows;
+
+// Shadow maps of the directional and spot lights, one tile per light in a static and a dynamic layer.
+layout(set = 0, binding = 5) uniform sampler2DArrayShadow uShadowAtlas;
+
+// Normalized distances to the point lights (see CubeShadow.frag), the moving casters first, then the casters at rest.
+layout(set = 0, binding = 6) uniform samplerCube uShadowCubes[ MAX_CUBE_SHADOWS * 2 ];
+
+struct InstanceData
 {
     mat4 ModelMatrix;
     mat4 NormalMatrix;
-    // mat4 LightSpaceMatrix;
 
+    vec3 Color;         // Multiplied with the material albedo.
+    uint MaterialIndex; // Index into the bindless material buffer.
+};
+
+// Per-instance data, indexed with gl_InstanceIndex (firstInstance + instance).
+layout(std430, set = 2, binding = 0) readonly buffer InstanceBuffer 
+{
+    InstanceData Instances[];
+
+} uInstances;
+
+struct MaterialData
+{
     vec3  Albedo;
     float Metallic;
     float Roughness;
     float AO;
+
     vec2  TextureOffset;
     vec2  TextureScale;
+
+    // Slots in uTextures, slot 0 is a white texture.
+    uint  AlbedoTexture;
+    uint  NormalTexture;
+    uint  RoughnessTexture;
+    uint  MetallicTexture;
+    uint  _pad0;
+    uint  _pad1;
+
     vec3  EmissionColor;
     float EmissionStrength;
+};
 
-} uPush;
+// Bindless material textures, indexed with the texture slots of MaterialData.
+layout(set = 1, binding = 0) uniform sampler2D uTextures[];
 
-// Material textures
-layout(set = 1, binding = 0) uniform sampler2D albedoTexture;
-layout(set = 1, binding = 1) uniform sampler2D normalTexture;
-layout(set = 1, binding = 2) uniform sampler2D roughnessTexture;
-layout(set = 1, binding = 3) uniform sampler2D metallicTexture;
+// Material parameters, indexed with InstanceData.MaterialIndex.
+layout(std430, set = 1, binding = 1) readonly buffer MaterialBuffer 
+{
+    MaterialData Materials[];
+
+} uMaterials;
 
 // Shadow map texture
 // layout(set = 2, binding = 0) uniform sampler2D shadowMap;
@@ -87,7 +154,8 @@ layout(location = 0) in vec3 fragPosWorld;
 layout(location = 1) in vec3 fragNormalWorld;
 layout(location = 2) in vec3 fragColor;
 layout(location = 3) in vec2 fragUV;
-// layout(location = 4) in vec4 fragPosLightSpace;
+layout(location = 4) flat in int fragInstanceIndex;
+// layout(location = 5) in vec4 fragPosLightSpace;
 
 // Output
 layout(location = 0) out vec4 outColor;
@@ -141,6 +209,129 @@ layout(location = 0) out vec4 outColor;
 
 
 
+// Cluster of a fragment, from its window position and view depth (the camera looks down +Z).
+uint clusterIndex(vec2 fragCoord, float viewZ)
+{
+    uvec3 grid  = uUbo.ClusterGrid.xyz;
+    float slice = log(max(viewZ, 1e-4)) * uUbo.ClusterParams.z + uUbo.ClusterParams.w;
+
+    uvec3 cluster = min(uvec3(uvec2(fragCoord / uUbo.ClusterParams.xy), uint(max(slice, 0.0))), grid - 1u);
+
+    return cluster.x + grid.x * (cluster.y + grid.y * cluster.z);
+}
+
+// Fades a light out towards its range, so it is safe to cull outside of it. ~1 well within the range.
+float rangeWindow(float distanceSq, float range)
+{
+    float ratio  = distanceSq / (range * range);
+    float window = clamp(1.0 - ratio * ratio, 0.0, 1.0);
+
+    return window * window;
+}
+
+// Visibility of a directional / spot shadow, 3x3 PCF kept inside the light's atlas tile.
+// A texel is lit when it is lit in both the static and the dynamic layer.
+float atlasShadow(Shadow shadow, vec3 fragPosWorld)
+{
+    vec4 lightSpace = shadow.LightSpaceMatrix * vec4(fragPosWorld, 1.0);
+
+    if (lightSpace.w <= 0.0)
+    {
+        return 1.0;
+    }
+
+    vec3 projected = lightSpace.xyz / lightSpace.w;
+    vec2 shadowUV  = projected.xy * 0.5 + 0.5;
+
+    // Outside of the light's frustum.
+    if (any(lessThan(shadowUV, vec2(0.0))) || any(greaterThan(shadowUV, vec2(1.0))) || projected.z > 1.0)
+    {
+        return 1.0;
+    }
+
+    // One texel of the tile in tile UVs, the taps stay half a texel inside the tile so the filter never reads a neighbour.
+    float tileTexel = 1.0 / (shadow.UVRect.z * float(textureSize(uShadowAtlas, 0).x));
+    float halfTexel = 0.5 * tileTexel;
+
+    float visibility = 0.0;
+
+    for (int x = -1; x <= 1; x++)
+    {
+        for (int y = -1; y <= 1; y++)
+        {
+            vec2 tapUV   = clamp(shadowUV + vec2(x, y) * tileTexel, halfTexel, 1.0 - halfTexel);
+            vec2 atlasUV = shadow.UVRect.xy + tapUV * shadow.UVRect.zw;
+
+            visibility += texture(uShadowAtlas, vec4(atlasUV, SHADOW_STATIC,  projected.z)) *
+                          texture(uShadowAtlas, vec4(atlasUV, SHADOW_DYNAMIC, projected.z));
+        }
+    }
+
+    return visibility / 9.0;
+}
+
+// Visibility of a point light shadow, lit when nothing in either cube map is nearer to the light than the fragment.
+float cubeShadow(Shadow shadow, vec3 fragPosWorld)
+{
+    vec3  lightToFrag  = fragPosWorld - shadow.PositionAndRange.xyz;
+    float lightDist    = length(lightToFrag);
+    float farPlane     = shadow.PositionAndRange.w;
+
+    uint  dynamicIndex = shadow.CubeIndex;
+    uint  staticIndex  = shadow.CubeIndex + MAX_CUBE_SHADOWS;
+
+    // The cube maps are written through gl_FragDepth, the pipeline's depth bias does not apply:
+    // offset by about a texel at the fragment's distance instead.
+    float texel        = 2.0 * lightDist / float(textureSize(uShadowCubes[ nonuniformEXT(dynamicIndex) ], 0).x);
+    float current      = (lightDist - 1.5 * texel - 0.02) / farPlane;
+
+    float closest      = min(texture(uShadowCubes[ nonuniformEXT(dynamicIndex) ], lightToFrag).r,
+                             texture(uShadowCubes[ nonuniformEXT(staticIndex)  ], lightToFrag).r);
+
+    return current <= closest ? 1.0 : 0.0;
+}
+
+// Visibility of a light at a fragment, 1 for lights without a rendered shadow.
+float shadowVisibility(Light light, vec3 fragPosWorld)
+{
+    if (light.ShadowIndex == NO_SHADOW)
+    {
+        return 1.0;
+    }
+
+    Shadow shadow = uShadows.Shadows[ light.ShadowIndex ];
+
+    if (shadow.Valid == 0u)
+    {
+        return 1.0;
+    }
+
+    return light.Type == LIGHT_POINT ? cubeShadow(shadow, fragPosWorld) : atlasShadow(shadow, fragPosWorld);
+}
+
+// Blinn-Phong diffuse and specular of one light.
+void shadeLight(
+    vec3       surfaceNormal, 
+    vec3       viewDirection, 
+    vec3       directionToLight, 
+    vec3       intensity, 
+    float      shininess, 
+    vec3       specularColor, 
+    inout vec3 diffuseLight, 
+    inout vec3 specularLight)
+{
+    float cosAngleIncidence = max(dot(surfaceNormal, directionToLight), 0);
+
+    diffuseLight += intensity * cosAngleIncidence;
+
+    // Specular
+    vec3  halfAngle = normalize(directionToLight + viewDirection);
+    float blinnTerm = clamp(dot(surfaceNormal, halfAngle), 0, 1);
+    blinnTerm = pow(blinnTerm, shininess);
+
+    specularLight += intensity * blinnTerm * specularColor;
+}
+
 // Calculate tangent-bitangent-normal matrix for normal mapping
 mat3 calculateTBN(vec3 normal, vec3 pos, vec2 uv) 
 {
@@ -163,11 +354,16 @@ mat3 calculateTBN(vec3 normal, vec3 pos, vec2 uv)
 
 void main() 
 {
+    InstanceData uInstance = uInstances.Instances[ fragInstanceIndex ];
+
+    MaterialData uMaterial = uMaterials.Materials[ uInstance.MaterialIndex ];
+
+    // The instances of a draw can use different materials, so the texture index is not dynamically uniform.
     // Sample Albedo texture and combine with material color.
-    vec3 materialColor = uPush.Albedo * texture(albedoTexture, fragUV).rgb;
+    vec3 materialColor = uMaterial.Albedo * uInstance.Color * texture(uTextures[ nonuniformEXT(uMaterial.AlbedoTexture) ], fragUV).rgb;
     
     // Sample normal map.
-    vec3 normalMap     = texture(normalTexture, fragUV).rgb;
+    vec3 normalMap     = texture(uTextures[ nonuniformEXT(uMaterial.NormalTexture) ], fragUV).rgb;
     vec3 N             = normalize(fragNormalWorld);
     vec3 surfaceNormal = N;
 
@@ -188,92 +384,52 @@ void main()
     vec3 cameraPosWorld = uUbo.Camera.InverseView[3].xyz;
     vec3 viewDirection  = normalize(cameraPosWorld - fragPosWorld);
 
-    // Point lights
-    for (int i = 0; i < uUbo.NumPointLights; i++) 
-    {
-        PointLight light = uUbo.PointLights[i];
-
-        vec3  directionToLight = light.Position.xyz - fragPosWorld;
-        float attenuation      = 1.0 / dot(directionToLight, directionToLight);
-
-        directionToLight = normalize(directionToLight);
-
-        float cosAngleIncidence = max(dot(surfaceNormal, directionToLight), 0);
-        vec3  intensity         = light.Color.xyz * light.Color.w * attenuation;
-
-        diffuseLight += intensity * cosAngleIncidence;
+    float shininess     = mix(128.0, 8.0, uMaterial.Roughness);
+    vec3  specularColor = mix(vec3(0.04), materialColor, uMaterial.Metallic);
 
-        // Specular
-        vec3  halfAngle = normalize(directionToLight + viewDirection);
-        float blinnTerm = clamp(dot(surfaceNormal, halfAngle), 0, 1);
-        float shininess = mix(128.0, 8.0, uPush.Roughness);
-        blinnTerm = pow(blinnTerm, shininess);
-
-        vec3 specularColor = mix(vec3(0.04), materialColor, uPush.Metallic);
+    // Directional lights
+    for (uint i = 0; i < uUbo.NumDirectionalLights; i++) 
+    {
+        Light light = uLights.Lights[i];
+    
+        vec3 directionToLight = normalize(-light.Direction.xyz);
+        vec3 intensity        = light.Color.xyz * light.Color.w * shadowVisibility(light, fragPosWorld);
 
-        specularLight += intensity * blinnTerm * specularColor;
+        shadeLight(surfaceNormal, viewDirection, directionToLight, intensity, shininess, specularColor, diffuseLight, specularLight);
     }
 
-    // https://github.com/invzz/VulkanEngine/blob/main/assets/shaders/pbr_shader.frag
+    // Point and spot lights, only the ones binned into the fragment's cluster.
+    uint cluster = clusterIndex(gl_FragCoord.xy, (uUbo.Camera.View * vec4(fragPosWorld, 1.0)).z);
+    uint count   = uClusterCounts.Counts[ cluster ];
 
-    // Spot lights
-    for (int i = 0; i < uUbo.NumSpotLights; i++) 
+    for (uint i = 0; i < count; i++) 
     {
-        SpotLight light = uUbo.SpotLights[i];
+        Light light = uLights.Lights[ uClusterIndices.Indices[ cluster * uUbo.ClusterGrid.w + i ] ];
 
         vec3  directionToLight = light.Position.xyz - fragPosWorld;
-        float distance         = length(directionToLight);
-        float attenuation      = 1.0 / (distance * distance);
+        float distanceSq       = dot(directionToLight, directionToLight);
+        float attenuation      = rangeWindow(distanceSq, light.Position.w) / max(distanceSq, 0.0001);
 
         directionToLight = normalize(directionToLight);
 
-        // Calculate spotlight cone
-        float theta         = dot(directionToLight, normalize(-light.Direction.xyz));
-        float epsilon       = light.InnerCutoff - light.OuterCutoff;
-        float spotIntensity = clamp((theta - light.OuterCutoff) / epsilon, 0.0, 1.0);
-
-        float cosAngleIncidence = max(dot(surfaceNormal, directionToLight), 0);
-        vec3  intensity         = light.Color.xyz * light.Color.w * attenuation * spotIntensity;
-
-        diffuseLight += intensity * cosAngleIncidence;
-
-        // Specular
-        vec3  halfAngle = normalize(directionToLight + viewDirection);
-        float blinnTerm = clamp(dot(surfaceNormal, halfAngle), 0, 1);
-        float shininess = mix(128.0, 8.0, uPush.Roughness);
-        blinnTerm = pow(blinnTerm, shininess);
-
-        vec3 specularColor = mix(vec3(0.04), materialColor, uPush.Metallic);
-
-        specularLight += intensity * blinnTerm * specularColor;
-    }
-
-    // Directional lights
-    for (int i = 0; i < uUbo.NumDirectionalLights; i++) 
-    {
-        DirectionalLight light = uUbo.DirectionalLights[i];
-    
-        vec3 directionToLight = normalize(-light.Direction.xyz);
-
-        float cosAngleIncidence = max(dot(surfaceNormal, directionToLight), 0);
-        vec3  intensity         = light.Color.xyz * light.Color.w;
-
-        diffuseLight += intensity * cosAngleIncidence;
+        // https://github.com/invzz/VulkanEngine/blob/main/assets/shaders/pbr_shader.frag
+        if (light.Type == LIGHT_SPOT)
+        {
+            // Calculate spotlight cone
+            float theta   = dot(directionToLight, normalize(-light.Direction.xyz));
+            float epsilon = light.InnerCutoff - light.OuterCutoff;
 
-        // Specular
-        vec3  halfAngle = normalize(directionToLight + viewDirection);
-        float blinnTerm = clamp(dot(surfaceNormal, halfAngle), 0, 1);
-        float shininess = mix(128.0, 8.0, uPush.Roughness);
-        blinnTerm = pow(blinnTerm, shininess);
+            attenuation *= clamp((theta - light.OuterCutoff) / epsilon, 0.0, 1.0);
+        }
 
-        vec3 specularColor = mix(vec3(0.04), materialColor, uPush.Metallic);
+        vec3 intensity = light.Color.xyz * light.Color.w * attenuation * shadowVisibility(light, fragPosWorld);
 
-        specularLight += intensity * blinnTerm * specularColor;
+        shadeLight(surfaceNormal, viewDirection, directionToLight, intensity, shininess, specularColor, diffuseLight, specularLight);
     }
 
     // Combine lighting
     vec3 lighting   = diffuseLight * materialColor + specularLight;
-    vec3 emission   = uPush.EmissionColor * uPush.EmissionStrength;
+    vec3 emission   = uMaterial.EmissionColor * uMaterial.EmissionStrength;
     vec3 finalColor = lighting + emission;
 
     outColor = vec4(finalColor, 1.0);
@@ -285,7 +441,7 @@ void main()
 // void main() 
 // {
 //     // Sample Albedo texture and combine with material Color
-//     vec3 materialColor = uPush.Albedo * texture(albedoTexture, fragUV).rgb;
+//     vec3 materialColor = uInstance.Albedo * texture(albedoTexture, fragUV).rgb;
     
 //     // Sample normal map
 //     vec3 normalMap = texture(normalTexture, fragUV).rgb;
@@ -327,10 +483,10 @@ void main()
 //         // Specular
 //         vec3  halfAngle = normalize(directionToLight + viewDirection);
 //         float blinnTerm = clamp(dot(surfaceNormal, halfAngle), 0, 1);
-//         float shininess = mix(128.0, 8.0, uPush.Roughness);
+//         float shininess = mix(128.0, 8.0, uInstance.Roughness);
 //         blinnTerm = pow(blinnTerm, shininess);
 
-//         vec3 specularColor = mix(vec3(0.04), materialColor, uPush.Metallic);
+//         vec3 specularColor = mix(vec3(0.04), materialColor, uInstance.Metallic);
 
 //         specularLight += intensity * blinnTerm * specularColor;
 //     }
@@ -361,10 +517,10 @@ void main()
 //         // Specular
 //         vec3  halfAngle = normalize(directionToLight + viewDirection);
 //         float blinnTerm = clamp(dot(surfaceNormal, halfAngle), 0, 1);
-//         float shininess = mix(128.0, 8.0, uPush.Roughness);
+//         float shininess = mix(128.0, 8.0, uInstance.Roughness);
 //         blinnTerm = pow(blinnTerm, shininess);
 
-//         vec3 specularColor = mix(vec3(0.04), materialColor, uPush.Metallic);
+//         vec3 specularColor = mix(vec3(0.04), materialColor, uInstance.Metallic);
 
 //         specularLight += intensity * blinnTerm * specularColor;
 //     }
@@ -384,17 +540,17 @@ void main()
 //         // Specular
 //         vec3  halfAngle = normalize(directionToLight + viewDirection);
 //         float blinnTerm = clamp(dot(surfaceNormal, halfAngle), 0, 1);
-//         float shininess = mix(128.0, 8.0, uPush.Roughness);
+//         float shininess = mix(128.0, 8.0, uInstance.Roughness);
 //         blinnTerm = pow(blinnTerm, shininess);
 
-//         vec3 specularColor = mix(vec3(0.04), materialColor, uPush.Metallic);
+//         vec3 specularColor = mix(vec3(0.04), materialColor, uInstance.Metallic);
 
 //         specularLight += intensity * blinnTerm * specularColor;
 //     }
 
 //     // Combine lighting
 //     vec3 lighting   = diffuseLight * materialColor + specularLight;
-//     vec3 emission   = uPush.EmissionColor * uPush.EmissionStrength;
+//     vec3 emission   = uInstance.EmissionColor * uInstance.EmissionStrength;
 //     vec3 finalColor = lighting + emission;
 
 //     outColor = vec4(finalColor, 1.0);
@@ -2,29 +2,6 @@
 
 // ================================================================================================
 
-struct PointLight 
-{
-    vec4 Position; // xyz = position, w = unused
-    vec4 Color;    // rgb = color,    a = intensity
-};
-
-struct SpotLight 
-{
-    vec4  Position;    // xyz = position,  w = unused
-    vec4  Direction;   // xyz = direction, w = unused
-    vec4  Color;       // rgb = color,     a = intensity
-    float InnerCutoff; // cos of inner angle
-    float OuterCutoff; // cos of outer angle
-    float _pad0;
-    float _pad1;
-};
-
-struct DirectionalLight 
-{
-    vec4 Direction; // xyz = direction, w = unused
-    vec4 Color;     // rgb = color,     a = intensity
-};
-
 struct CameraData
 {
     mat4 Projection;
@@ -33,10 +10,6 @@ struct CameraData
 };
 
 
-const int MAX_POINT_LIGHTS  = 10;
-const int MAX_DIRECT_LIGHTS = 10;
-const int MAX_SPOT_LIGHTS   = 10;
-
 // ================================================================================================
 // Uniforms
 
@@ -46,33 +19,26 @@ layout(set = 0, binding = 0) uniform GlobalUBO
 
     vec4             AmbientLightColor; // rgb = color, a = intensity
 
-    PointLight       PointLights      [ MAX_POINT_LIGHTS  ];
-    DirectionalLight DirectionalLights[ MAX_DIRECT_LIGHTS ];
-    SpotLight        SpotLights       [ MAX_SPOT_LIGHTS   ];
-    int              NumPointLights;
-    int              NumDirectionalLights;
-    int              NumSpotLights;
+    // Lights and clusters, only used by the fragment shader.
 
 } uUbo;
 
 
-layout(push_constant) uniform Push 
+struct InstanceData
 {
     mat4 ModelMatrix;
     mat4 NormalMatrix;
 
-    vec3  Albedo;
-    float Metallic;
-    float Roughness;
-    float AO;
+    vec3 Color;         // Multiplied with the material albedo.
+    uint MaterialIndex; // Index into the bindless material buffer.
+};
 
-    vec2  TextureOffset;
-    vec2  TextureScale;
-    
-    vec3  EmissionColor;
-    float EmissionStrength;
+// Per-instance data, indexed with gl_InstanceIndex (firstInstance + instance).
+layout(std430, set = 2, binding = 0) readonly buffer InstanceBuffer 
+{
+    InstanceData Instances[];
 
-} uPush;
+} uInstances;
 
 // ================================================================================================
 
@@ -88,22 +54,27 @@ layout(location = 0) out vec3 fragPosWorld;
 layout(location = 1) out vec3 fragNormalWorld;
 layout(location = 2) out vec3 fragColor;
 layout(location = 3) out vec2 fragUV;
-// layout(location = 4) out vec4 fragPosLightSpace;
+layout(location = 4) flat out int fragInstanceIndex;
+// layout(location = 5) out vec4 fragPosLightSpace;
 
 // ================================================================================================
 
 void main() 
 {
-    vec4 positionWorld = uPush.ModelMatrix * vec4(inPosition, 1.0);
+    InstanceData uInstance = uInstances.Instances[ gl_InstanceIndex ];
+
+    vec4 positionWorld = uInstance.ModelMatrix * vec4(inPosition, 1.0);
 
     gl_Position = uUbo.Camera.Projection * uUbo.Camera.View * positionWorld;
 
-    fragNormalWorld = normalize(mat3(uPush.NormalMatrix) * inNormal);
+    fragNormalWorld = normalize(mat3(uInstance.NormalMatrix) * inNormal);
     fragPosWorld    = positionWorld.xyz;
     fragColor       = inColor;
 
     // Apply texture scaling and offset.
-    fragUV          = inUV; //* uPush.TextureScale + uPush.TextureOffset;
+    fragUV          = inUV; //* uInstance.TextureScale + uInstance.TextureOffset;
+
+    fragInstanceIndex = gl_InstanceIndex;
 
-    // fragPosLightSpace = uPush.LightSpaceMatrix * positionWorld;
+    // fragPosLightSpace = uInstance.LightSpaceMatrix * positionWorld;
 }
\ No newline at end of file
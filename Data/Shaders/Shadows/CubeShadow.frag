@@ -6,8 +6,9 @@
 layout(push_constant) uniform Push 
 {
     mat4 ModelMatrix;
-    mat4 LightSpaceMatrix;
     vec4 LightPosAndFarPlane; // xyz = light position, w = far plane
+    vec4 Projection;
+    uint FaceMask;
 
 } uPush;
 
@@ -1,13 +1,16 @@
 #version 450
 
+#extension GL_EXT_multiview : require
+
 // ================================================================================================
 // Uniforms
 
 layout(push_constant) uniform Push 
 {
     mat4 ModelMatrix;
-    mat4 LightSpaceMatrix;
     vec4 LightPosAndFarPlane; // xyz = light position, w = far plane
+    vec4 Projection;          // Non-zero terms of the 90 degree face projection: P[0][0], P[1][1], P[2][2], P[3][2]
+    uint FaceMask;            // Bit i set if the caster overlaps face i.
 
 } uPush;
 
@@ -26,6 +29,36 @@ layout(location = 4) in vec2 inUV;
 
 layout(location = 0) out vec3 fragPosWorld;
 
+// ================================================================================================
+// Face views, rows of VyCubeShadowMap::faceViewMatrix (+X, -X, +Y, -Y, +Z, -Z)
+
+const vec3 kFaceRight[6] = vec3[](
+    vec3( 0.0,  0.0, -1.0),
+    vec3( 0.0,  0.0,  1.0),
+    vec3( 1.0,  0.0,  0.0),
+    vec3( 1.0,  0.0,  0.0),
+    vec3( 1.0,  0.0,  0.0),
+    vec3(-1.0,  0.0,  0.0)
+);
+
+const vec3 kFaceUp[6] = vec3[](
+    vec3( 0.0, -1.0,  0.0),
+    vec3( 0.0, -1.0,  0.0),
+    vec3( 0.0,  0.0,  1.0),
+    vec3( 0.0,  0.0, -1.0),
+    vec3( 0.0, -1.0,  0.0),
+    vec3( 0.0, -1.0,  0.0)
+);
+
+const vec3 kFaceBack[6] = vec3[](
+    vec3(-1.0,  0.0,  0.0),
+    vec3( 1.0,  0.0,  0.0),
+    vec3( 0.0, -1.0,  0.0),
+    vec3( 0.0,  1.0,  0.0),
+    vec3( 0.0,  0.0, -1.0),
+    vec3( 0.0,  0.0,  1.0)
+);
+
 // ================================================================================================
 
 void main() 
@@ -34,5 +67,27 @@ void main()
 
     fragPosWorld = positionWorld.xyz;
 
-    gl_Position = uPush.LightSpaceMatrix * positionWorld;
+    // The pass is broadcast to all six faces, move the caster out of the faces it does not touch.
+    uint face = gl_ViewIndex;
+
+    if ((uPush.FaceMask & (1u << face)) == 0u)
+    {
+        gl_Position = vec4(2.0, 2.0, 2.0, 1.0); // Outside of the clip volume, the whole primitive is discarded.
+        return;
+    }
+
+    vec3 toVertex = positionWorld.xyz - uPush.LightPosAndFarPlane.xyz;
+
+    vec3 positionView = vec3(
+        dot(kFaceRight[face], toVertex),
+        dot(kFaceUp   [face], toVertex),
+        dot(kFaceBack [face], toVertex)
+    );
+
+    gl_Position = vec4(
+        uPush.Projection.x * positionView.x,
+        uPush.Projection.y * positionView.y,
+        uPush.Projection.z * positionView.z + uPush.Projection.w,
+        -positionView.z
+    );
 }
\ No newline at end of file
@@ -13,6 +13,12 @@ namespace Vy
 
 		s_Instance = this;
 
+		// Headless windows have no GLFW handle to receive input from.
+		if (!m_Window)
+		{
+			return;
+		}
+
 		if (glfwRawMouseMotionSupported())
         {
             glfwSetInputMode(m_Window, GLFW_RAW_MOUSE_MOTION, GLFW_TRUE);
@@ -42,18 +48,24 @@ namespace Vy
 
 	bool VyInput::keyPressed(Key key)
 	{
+		if (!m_Window) return false;
+
 		return glfwGetKey(m_Window, key) == GLFW_PRESS;
 	}
 
 
 	bool VyInput::mouseButtonPressed(MouseButton button)
 	{
+		if (!m_Window) return false;
+
 		return glfwGetMouseButton(m_Window, button) == GLFW_PRESS;
 	}
 
 
 	Vec2 VyInput::cursorPosition()
 	{
+		if (!m_Window) return Vec2{ 0.0f };
+
 		double xPos, yPos;
 		glfwGetCursorPos(m_Window, &xPos, &yPos);
 
@@ -63,6 +75,8 @@ namespace Vy
 
 	void VyInput::setInputMode(int mode, int value)
 	{
+		if (!m_Window) return;
+
 		glfwSetInputMode(m_Window, mode, value);
 	}
 
@@ -14,6 +14,11 @@ namespace Vy
     
     VyWindow::~VyWindow() 
     {
+        if (isHeadless())
+        {
+            return;
+        }
+
         glfwDestroyWindow(m_WindowHandle);
         glfwTerminate();
     }
@@ -21,7 +26,16 @@ namespace Vy
     
     void VyWindow::initWindow() 
     {
+        // Headless windows only carry the render extent, GLFW is never touched 
+        // so this works on machines without a display server.
+        if (isHeadless())
+        {
+            return;
+        }
+
         VY_ASSERT(glfwInit(), "Failed to initialize glfw3");
+
+        m_MainThread = std::this_thread::get_id();
         
         glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
         glfwWindowHint(GLFW_RESIZABLE,  GLFW_TRUE);
@@ -36,12 +50,37 @@ namespace Vy
 
 	void VyWindow::pollEvents()
 	{
+		if (isHeadless())
+		{
+			return;
+		}
+
 		glfwPollEvents();
 	}
 
+
+	void VyWindow::waitEvents()
+	{
+		if (isHeadless())
+		{
+			return;
+		}
+
+		if (std::this_thread::get_id() == m_MainThread)
+		{
+			glfwWaitEvents();
+		}
+		else
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		}
+	}
+
         
     void VyWindow::createWindowSurface(VkInstance instance, VkSurfaceKHR* surface) 
     {
+        VY_ASSERT(!isHeadless(), "Cannot create a window surface for a headless window");
+
         if (glfwCreateWindowSurface(instance, m_WindowHandle, nullptr, surface) != VK_SUCCESS) 
         {
             throw std::runtime_error("failed to create window surface");
@@ -137,9 +176,9 @@ namespace Vy
         {
             VyWindowData& data = *(VyWindowData*) glfwGetWindowUserPointer(window);
             {
-                data.Width              = static_cast<U32>(width);
-                data.Height             = static_cast<U32>(height);
-                data.FramebufferResized = true;
+                std::atomic_ref<U32> (data.Width             ).store(static_cast<U32>(width),  std::memory_order_relaxed);
+                std::atomic_ref<U32> (data.Height            ).store(static_cast<U32>(height), std::memory_order_relaxed);
+                std::atomic_ref<bool>(data.FramebufferResized).store(true,                     std::memory_order_relaxed);
             }
 
             WindowResizeEvent event(width, height);
@@ -6,6 +6,9 @@
 
 #include <VyLib/VyLib.h>
 
+#include <atomic>
+#include <thread>
+
 namespace Vy
 {
     class VyEvent;
@@ -26,6 +29,7 @@ namespace Vy
 		bool   IsFullscreen               = false;
 		bool   HasFocus                   = true;
         bool   VSync                      = false;
+        bool   Headless                   = false; // No GLFW window / surface is created (offscreen rendering only).
 
         bool   FramebufferResized;
 
@@ -93,7 +97,11 @@ namespace Vy
          */
         VkExtent2D windowExtent() const 
         { 
-            return { m_Data.Width, m_Data.Height }; 
+            // Written by the GLFW callbacks on the main thread, read by the render thread.
+            return { 
+                std::atomic_ref<U32>(const_cast<U32&>(m_Data.Width )).load(std::memory_order_relaxed), 
+                std::atomic_ref<U32>(const_cast<U32&>(m_Data.Height)).load(std::memory_order_relaxed) 
+            }; 
         }
 
 
@@ -117,7 +125,16 @@ namespace Vy
          */
         bool shouldClose() 
         { 
-            return glfwWindowShouldClose(m_WindowHandle); 
+            return m_WindowHandle ? glfwWindowShouldClose(m_WindowHandle) : false; 
+        }
+
+        /**
+         * @brief Checks if the window was created without a GLFW window or Vulkan surface.
+         * @return True if running headless, false otherwise.
+         */
+        bool isHeadless() const 
+        { 
+            return m_Data.Headless; 
         }
         
         /**
@@ -126,13 +143,12 @@ namespace Vy
          */
         bool wasWindowResized() 
         { 
-            return m_Data.FramebufferResized; 
+            return std::atomic_ref<bool>(m_Data.FramebufferResized).load(std::memory_order_relaxed); 
         }
         
         void resetWindowResizedFlag() 
         { 
-            m_Data.FramebufferResized = false; 
-        
+            std::atomic_ref<bool>(m_Data.FramebufferResized).store(false, std::memory_order_relaxed); 
         }
 
 		inline bool shouldInvalidateSwapchain() const { return m_Data.ShouldInvalidateSwapchain; }
@@ -146,6 +162,14 @@ namespace Vy
 
         void pollEvents();
 
+        /**
+         * @brief Blocks until window events arrived.
+         * 
+         * GLFW only processes events on the thread that created the window, other threads 
+         * (e.g. the render thread) sleep briefly instead while the main thread keeps polling.
+         */
+        void waitEvents();
+
         /**
          * @brief Creates a Vulkan surface for the window.
          * @param instance The Vulkan instance.
@@ -164,7 +188,8 @@ namespace Vy
 
         void initWindow();
 
-        GLFWwindow*  m_WindowHandle;
-        VyWindowData m_Data;
+        GLFWwindow*     m_WindowHandle{ nullptr };
+        VyWindowData    m_Data;
+        std::thread::id m_MainThread;
     };
 }
\ No newline at end of file
@@ -1,14 +1,74 @@
 #include <Vy/Engine.h>
 
 #include <Vy/GFX/Context.h>
+#include <Vy/GFX/RenderThread.h>
 
 #include <Vy/Core/FrameRateController.h>
 #include <Vy/Core/DataBuffer.h>
 
 #include <Vy/Systems/Buffer/MaterialSystem.h>
 
+#include <json/json.h>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+
 namespace Vy
 {
+    static VyWindowData headlessWindowData(const VyHeadlessSettings& headless)
+    {
+        VyWindowData data{};
+
+        if (headless.Enabled)
+        {
+            data.Width    = headless.Width;
+            data.Height   = headless.Height;
+            data.Headless = true;
+        }
+
+        return data;
+    }
+
+
+    /**
+     * @brief Builds avg / min / max / percentile statistics of a set of timings (ignores negative values).
+     */
+    static Json::Value timingSummary(TVector<double> values)
+    {
+        values.erase(std::remove_if(values.begin(), values.end(), [](double v) { return v < 0.0; }), values.end());
+
+        Json::Value summary{ Json::objectValue };
+
+        if (values.empty())
+        {
+            return summary;
+        }
+
+        std::sort(values.begin(), values.end());
+
+        double sum = 0.0;
+        for (double v : values)
+        {
+            sum += v;
+        }
+
+        auto percentile = [&values](double p) 
+        {
+            return values[ static_cast<size_t>(p * static_cast<double>(values.size() - 1)) ];
+        };
+
+        summary["Avg"] = sum / static_cast<double>(values.size());
+        summary["Min"] = values.front();
+        summary["Max"] = values.back();
+        summary["P50"] = percentile(0.50);
+        summary["P95"] = percentile(0.95);
+        summary["P99"] = percentile(0.99);
+
+        return summary;
+    }
+
+
 	VyEngine* VyEngine::s_Instance      = nullptr;
 	bool      VyEngine::s_bInstanceFlag = false;
 
@@ -21,7 +81,9 @@ namespace Vy
 	}
 
 
-    VyEngine::VyEngine()
+    VyEngine::VyEngine(const VyHeadlessSettings& headless) :
+        m_Headless{ headless                     },
+        m_Window  { headlessWindowData(headless) }
     {
 		s_Instance      = this;
 		s_bInstanceFlag = true;
@@ -59,16 +121,11 @@ namespace Vy
     }
 
 
-    void VyEngine::updateCamera(VyCamera& camera)
+    void VyEngine::updateCamera(const VyFramePacket& packet, VyCamera& camera)
 	{
-        if (VyEntity mainCameraEntity = m_Scene->mainCamera()) 
+        if (packet.bHasCamera) 
         {
-            const auto& cameraComponent = mainCameraEntity.get<CameraComponent>();
-            const auto& transform       = mainCameraEntity.get<TransformComponent>();
-
-            camera = cameraComponent.Camera;
-
-            camera.setView(transform.Translation, transform.Rotation);
+            camera = packet.Camera;
 
             if (camera.isPerspective()) 
             {
@@ -77,6 +134,9 @@ namespace Vy
             else {
 				camera.setOrthographic();
             }
+
+            // Frustum used by the render systems for culling.
+            camera.updateFrustum();
         }
         else
         {
@@ -91,13 +151,20 @@ namespace Vy
 
     void VyEngine::run()
     {
-        // Active Camera Object.
-        VyCamera camera{};
+        if (m_Headless.Enabled)
+        {
+            runHeadless();
+
+            return;
+        }
 
         // [ Initialize FrameRate Controller (60 FPS) ]
         FrameRateController frameRateController{ 60u };
 
-        VkExtent2D previousExtent = m_Renderer.swapchainExtent();
+        m_PreviousExtent = m_Renderer.swapchainExtent();
+
+        // Frame N is recorded on the render thread while the main thread simulates frame N+1.
+        VyRenderThread renderThread{ [this](const VyFramePacket& packet) { renderFrame(packet); } };
 
         // [ Main Loop ]
         while (isRunning()) 
@@ -111,57 +178,286 @@ namespace Vy
             {
                 // Update Scripts and Scene Systems.
                 m_Scene->update(deltaTime);
-                
-                updateCamera(camera);
             }
 
-            // [ Frame ]
-            if (auto cmdBuffer = m_Renderer.beginFrame()) 
+            // [ Extract ]
             {
-                // Check if window was resized and recreate post-processing resources.
+                VyFramePacket& packet = renderThread.acquire();
+
+                packet.extract(*m_Scene, deltaTime);
+
+                renderThread.submit();
+            }
+        } // [ Main Loop End ]
+
+        renderThread.stop();
+
+        VyContext::waitIdle();
+    }
+
+
+    void VyEngine::renderFrame(const VyFramePacket& packet)
+    {
+        updateCamera(packet, m_RenderCamera);
+
+        // [ Frame ]
+        if (auto cmdBuffer = m_Renderer.beginFrame()) 
+        {
+            // Check if window was resized and recreate post-processing resources.
+            {
+                VkExtent2D currentExtent = m_Renderer.swapchainExtent();
+                
+                if (currentExtent.width  != m_PreviousExtent.width || 
+                    currentExtent.height != m_PreviousExtent.height) 
                 {
-                    VkExtent2D currentExtent = m_Renderer.swapchainExtent();
+                    m_RenderSystem->recreate(currentExtent);
                     
-                    if (currentExtent.width  != previousExtent.width || 
-                        currentExtent.height != previousExtent.height) 
-                    {
-                        m_RenderSystem->recreate(currentExtent);
-                        
-                        previousExtent = currentExtent;
-                    }
+                    m_PreviousExtent = currentExtent;
                 }
+            }
 
-                // Update Frame Info.
-                int frameIndex = m_Renderer.frameIndex();
+            // Update Frame Info.
+            int frameIndex = m_Renderer.frameIndex();
+
+            VyFrameInfo frameInfo{
+                .FrameIndex            = frameIndex,                              // Index of the current frame.
+                .FrameTime             = packet.DeltaTime,                        // Time between frames.
+                .CommandBuffer         = cmdBuffer,                               // Main command buffer.
+                .GlobalDescriptorSet   = m_RenderSystem->globalSet(frameIndex),   // Global descriptor set for the current frame.
+                .MaterialDescriptorSet = m_RenderSystem->materialSet(frameIndex), // Bindless material set for the current frame.
+                .Packet                = packet,                                  // Scene data of the frame.
+                .Camera                = m_RenderCamera                           // Active camera to update the UBOs.
+            };
 
-                VyFrameInfo frameInfo{
-                    .FrameIndex          = frameIndex,                            // Index of the current frame.
-                    .FrameTime           = deltaTime,                             // Time between frames.
-                    .CommandBuffer       = cmdBuffer,                             // Main command buffer.
-                    .GlobalDescriptorSet = m_RenderSystem->globalSet(frameIndex), // Global descriptor set for the current frame.
-                    .Scene               = m_Scene,                               // Active scene.
-                    .Camera              = camera                                 // Active camera to update the UBOs.
-                };
+            // [ Update ]
+            {
+                GlobalUBO ubo{};
 
-                // [ Update ]
-                {
-                    GlobalUBO ubo{};
+                // Update UBOs and Render Systems.
+                m_RenderSystem->updateUniformBuffers(frameInfo, ubo);
+            }
 
-                    // Update UBOs and Render Systems.
-                    m_RenderSystem->updateUniformBuffers(frameInfo, ubo);
-                }
+            // [ Render ]
+            {
+                m_RenderSystem->render(frameInfo);
+            }
+
+            m_Renderer.endFrame();
+
+        } // [ Frame End ]
+    }
 
-                // [ Render ]
+
+    void VyEngine::runHeadless()
+    {
+        using Clock = std::chrono::high_resolution_clock;
+
+        struct FrameTiming
+        {
+            double CpuMs  = -1.0; // Scene update, recording and submission (excluding the frame fence wait).
+            double WaitMs = -1.0; // Time blocked in `beginFrame` waiting for the GPU to release the frame.
+            double GpuMs  = -1.0; // GPU time between the first and last command of the frame.
+
+            VyCullStats MainPass{}; // Visible / culled entities of the main pass.
+
+            VyCommandStats Queue{}; // Binds recorded and elided by the render queue (CPU path).
+
+            int ShadowLights{ 0 }; // Directional / spot and point lights with a shadow.
+            U32 ShadowViews { 0 }; // Atlas tile layers and cube faces re-rendered, the others came from the cache.
+        };
+
+        auto toMs = [](Clock::duration duration) 
+        {
+            return std::chrono::duration<double, std::milli>(duration).count();
+        };
+
+        const U32   frameCount = m_Headless.FrameCount;
+        const float deltaTime  = m_Headless.DeltaTime;
+
+        VY_INFO_TAG("VyEngine", "Headless run: {} frames, dt = {}s, {}x{}", 
+            frameCount, deltaTime, m_Headless.Width, m_Headless.Height);
+
+        // Headless runs stay on one thread so the CPU timings cover both the simulation and the recording.
+        VyFramePacket packet{};
+        VyCamera      camera{};
+
+        TVector<FrameTiming> timings( frameCount );
+
+        // Which frame was last recorded into each frame-in-flight slot, its GPU time 
+        // can be read once the slot comes around again.
+        TArray<I64, MAX_FRAMES_IN_FLIGHT> slotFrames;
+        slotFrames.fill(-1);
+
+        const auto runStart = Clock::now();
+
+        for (U32 frame = 0; frame < frameCount; frame++)
+        {
+            const auto frameStart = Clock::now();
+
+            // [ Pre-Frame Update ]
+            {
+                m_Scene->update(deltaTime);
+
+                packet.extract(*m_Scene, deltaTime);
+                
+                updateCamera(packet, camera);
+            }
+
+            const auto waitStart = Clock::now();
+
+            // Headless frames never need a swapchain recreation, so this always returns a command buffer.
+            VkCommandBuffer cmdBuffer = m_Renderer.beginFrame();
+
+            const auto waitEnd = Clock::now();
+
+            int frameIndex = m_Renderer.frameIndex();
+
+            if (slotFrames[ frameIndex ] >= 0)
+            {
+                timings[ slotFrames[ frameIndex ] ].GpuMs = m_Renderer.gpuFrameTime(frameIndex);
+            }
+
+            slotFrames[ frameIndex ] = frame;
+
+            VyFrameInfo frameInfo{
+                .FrameIndex            = frameIndex,
+                .FrameTime             = deltaTime,
+                .CommandBuffer         = cmdBuffer,
+                .GlobalDescriptorSet   = m_RenderSystem->globalSet(frameIndex),
+                .MaterialDescriptorSet = m_RenderSystem->materialSet(frameIndex),
+                .Packet                = packet,
+                .Camera                = camera
+            };
+
+            // [ Update ]
+            {
+                GlobalUBO ubo{};
+
+                m_RenderSystem->updateUniformBuffers(frameInfo, ubo);
+            }
+
+            // [ Render ]
+            {
+                m_RenderSystem->render(frameInfo);
+            }
+
+            m_Renderer.endFrame();
+
+            const auto frameEnd = Clock::now();
+
+            timings[ frame ].MainPass = m_RenderSystem->mainPassCullStats();
+            timings[ frame ].Queue    = m_RenderSystem->renderQueueStats();
+
+            const VyShadowSystem& shadows = m_RenderSystem->shadowSystem();
+
+            timings[ frame ].ShadowLights = shadows.shadowLightCount() + shadows.cubeShadowLightCount();
+            timings[ frame ].ShadowViews  = shadows.updatedViewCount();
+
+            timings[ frame ].WaitMs = toMs(waitEnd  - waitStart);
+            timings[ frame ].CpuMs  = toMs(frameEnd - frameStart) - timings[ frame ].WaitMs;
+        }
+
+        VyContext::waitIdle();
+
+        const double totalMs = toMs(Clock::now() - runStart);
+
+        // Resolve the frames still in flight when the loop ended.
+        for (int i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
+        {
+            if (slotFrames[i] >= 0)
+            {
+                timings[ slotFrames[i] ].GpuMs = m_Renderer.gpuFrameTime(i);
+            }
+        }
+
+        // [ Write Timings ]
+        Json::Value root;
+        {
+            root["Device"]     = VyContext::device().properties().deviceName;
+            root["Width"]      = m_Headless.Width;
+            root["Height"]     = m_Headless.Height;
+            root["FrameCount"] = frameCount;
+            root["DeltaTime"]  = deltaTime;
+            root["TotalMs"]    = totalMs;
+            root["RenderPath"] = m_RenderSystem->renderPath() == ERenderPath::GPUDriven ? "GPUDriven" : "CPU";
+            root["Occlusion"]  = m_RenderSystem->occlusionCulling();
+            root["Shading"]    = m_RenderSystem->shadingPath() == EShadingPath::Deferred ? "Deferred" : "Forward";
+
+            // Shadow views re-rendered per frame at most, see `ShadowViews` of the frames.
+            root["ShadowBudget"] = m_RenderSystem->shadowSystem().updateBudget();
+
+            const VyGeometryStats geometry = VyContext::geometry().stats();
+            {
+                root["Geometry"]["Allocations"]    = geometry.Allocations;
+                root["Geometry"]["VerticesUsed"]   = geometry.VerticesUsed;
+                root["Geometry"]["VertexCapacity"] = geometry.VertexCapacity;
+                root["Geometry"]["IndicesUsed"]    = geometry.IndicesUsed;
+                root["Geometry"]["IndexCapacity"]  = geometry.IndexCapacity;
+                root["Geometry"]["Grows"]          = geometry.Grows;
+            }
+
+            TVector<double> cpuTimes;
+            TVector<double> gpuTimes;
+            
+            cpuTimes.reserve(frameCount);
+            gpuTimes.reserve(frameCount);
+
+            Json::Value& frames = root["Frames"];
+            frames = Json::Value{ Json::arrayValue };
+
+            for (U32 frame = 0; frame < frameCount; frame++)
+            {
+                Json::Value entry;
                 {
-                    m_RenderSystem->render(frameInfo);
+                    entry["Frame"]  = frame;
+                    entry["CpuMs"]  = timings[ frame ].CpuMs;
+                    entry["WaitMs"] = timings[ frame ].WaitMs;
+                    entry["GpuMs"]  = timings[ frame ].GpuMs;
+
+                    entry["Visible"] = timings[ frame ].MainPass.Visible;
+                    entry["Culled"]  = timings[ frame ].MainPass.Culled;
+
+                    const VyCommandStats& queue = timings[ frame ].Queue;
+
+                    entry["PipelineBinds"]            = queue.PipelineBinds;
+                    entry["PipelineBindsElided"]      = queue.PipelineBindsElided;
+                    entry["DescriptorSetBinds"]       = queue.DescriptorSetBinds;
+                    entry["DescriptorSetBindsElided"] = queue.DescriptorSetBindsElided;
+                    entry["VertexBufferBinds"]        = queue.VertexBufferBinds;
+                    entry["VertexBufferBindsElided"]  = queue.VertexBufferBindsElided;
+                    entry["IndexBufferBinds"]         = queue.IndexBufferBinds;
+                    entry["IndexBufferBindsElided"]   = queue.IndexBufferBindsElided;
+                    entry["PushConstants"]            = queue.PushConstants;
+                    entry["PushConstantsElided"]      = queue.PushConstantsElided;
+
+                    entry["ShadowLights"] = timings[ frame ].ShadowLights;
+                    entry["ShadowViews"]  = timings[ frame ].ShadowViews;
                 }
 
-                m_Renderer.endFrame();
+                frames.append(entry);
 
-            } // [ Frame End ]
-        } // [ Main Loop End ]
+                cpuTimes.push_back(timings[ frame ].CpuMs);
+                gpuTimes.push_back(timings[ frame ].GpuMs);
+            }
 
-        VyContext::waitIdle();
+            root["Summary"]["CpuMs"] = timingSummary(std::move(cpuTimes));
+            root["Summary"]["GpuMs"] = timingSummary(std::move(gpuTimes));
+        }
+
+        std::ofstream file(m_Headless.OutputPath);
+
+        if (!file.is_open())
+        {
+            VY_ERROR_TAG("VyEngine", "Failed to open '{}' for writing frame timings", m_Headless.OutputPath.string());
+
+            return;
+        }
+
+        file << root;
+        file.close();
+
+        VY_INFO_TAG("VyEngine", "Headless run finished in {:.2f}ms, timings written to '{}'", 
+            totalMs, m_Headless.OutputPath.string());
     }
 
 
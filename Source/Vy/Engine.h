@@ -5,6 +5,7 @@
 #include <Vy/Core/Event/Event.h>
 
 #include <Vy/GFX/Renderer.h>
+#include <Vy/GFX/FramePacket.h>
 
 #include <Vy/GFX/Backend/Descriptors.h>
 #include <Vy/GFX/Backend/Device.h>
@@ -14,8 +15,27 @@
 
 #include <Vy/Systems/Rendering/MasterRenderSystem.h>
 
+#include <VyLib/STL/Path.h>
+
 namespace Vy
 {
+    /**
+     * @brief Settings for running the engine without a window or swapchain.
+     * 
+     * In headless mode the engine renders a fixed number of frames into offscreen targets with a 
+     * fixed time step and no frame cap, and writes per-frame CPU / GPU timings to a JSON file.
+     * Meant for benchmarking on machines without a display (e.g. software Vulkan on CI).
+     */
+    struct VyHeadlessSettings
+    {
+        bool  Enabled    = false;
+        U32   FrameCount = 1000;                // Number of frames to render before exiting.
+        float DeltaTime  = 1.0f / 60.0f;        // Fixed time step passed to the scene. (In Seconds)
+        U32   Width      = 1280;                // Offscreen render target width.
+        U32   Height     = 720;                 // Offscreen render target height.
+        Path  OutputPath = "FrameTimings.json"; // Where the frame timings are written.
+    };
+
     /**
      * Phases:
      * 
@@ -46,7 +66,7 @@ namespace Vy
     class VyEngine
     {
     public:
-        VyEngine();
+        VyEngine(const VyHeadlessSettings& headless = {});
 
         ~VyEngine();
 
@@ -61,18 +81,35 @@ namespace Vy
 
         void onEvent(VyEvent& event);
 
-        VY_NODISCARD VyRenderer& renderer()         { return m_Renderer; }
-        VY_NODISCARD VyEntity    mainCamera() const { return m_Scene->mainCamera(); }
+        VY_NODISCARD VyRenderer&           renderer()         { return m_Renderer; }
+        VY_NODISCARD VyMasterRenderSystem& renderSystem()     { return *m_RenderSystem; }
+        VY_NODISCARD VyScene&              scene()            { return *m_Scene; }
+        VY_NODISCARD VyEntity              mainCamera() const { return m_Scene->mainCamera(); }
 
     private:
         void loadEntities();
 
         bool isRunning();
 
-        void updateCamera(VyCamera& camera);
+        /**
+         * @brief Sets up the camera of a frame: the packet's view with the projection of the current swapchain.
+         */
+        void updateCamera(const VyFramePacket& packet, VyCamera& camera);
+
+        /**
+         * @brief Records and submits one frame from an extracted packet, runs on the render thread.
+         */
+        void renderFrame(const VyFramePacket& packet);
+
+        /**
+         * @brief Main loop for headless mode: fixed frame count, fixed time step, no frame cap.
+         */
+        void runHeadless();
 
     private:
-        VyWindow   m_Window  { VyWindowData{} };
+        VyHeadlessSettings m_Headless;
+
+        VyWindow   m_Window;
         VyInput    m_Input   { m_Window };
         VyRenderer m_Renderer{ m_Window };
 
@@ -81,6 +118,9 @@ namespace Vy
 
         Shared<VyScene> m_Scene;
 
+        VyCamera   m_RenderCamera{};   // Camera of the frame being recorded, only touched by the render thread.
+        VkExtent2D m_PreviousExtent{}; // Swapchain extent the render system resources were created for.
+
         // Singleton
 		static VyEngine* s_Instance;
 		static bool      s_bInstanceFlag;
@@ -67,6 +67,35 @@ namespace Vy
 	}
 
 
+	VyBufferDesc VyBuffer::indirectBuffer(VkDeviceSize instanceSize, U32 instanceCount, VkBufferUsageFlags otherUsage)
+	{
+		VY_ASSERT(instanceSize  > 0, "Cannot create indirect buffer of size 0");
+		VY_ASSERT(instanceCount > 0, "Cannot create indirect buffer with 0 instances");
+
+		return VyBufferDesc{
+			.InstanceSize       = instanceSize, 
+			.InstanceCount      = instanceCount, 
+			.UsageFlags         = otherUsage | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | 
+			                                   VK_BUFFER_USAGE_TRANSFER_SRC_BIT    | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+			.AllocFlags         = 0
+		};
+	}
+
+
+	VyBufferDesc VyBuffer::readbackBuffer(VkDeviceSize instanceSize, U32 instanceCount)
+	{
+		VY_ASSERT(instanceSize  > 0, "Cannot create readback buffer of size 0");
+		VY_ASSERT(instanceCount > 0, "Cannot create readback buffer with 0 instances");
+
+		return VyBufferDesc{
+			.InstanceSize       = instanceSize, 
+			.InstanceCount      = instanceCount, 
+			.UsageFlags         = VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+			.AllocFlags         = VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT
+		};
+	}
+
+
 	VyBufferDesc 
     VyBuffer::stagingBuffer(VkDeviceSize instanceSize)
 	{
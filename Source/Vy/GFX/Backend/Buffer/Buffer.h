@@ -87,6 +87,29 @@ namespace Vy
          */
 		static VyBufferDesc storageBuffer(VkDeviceSize instanceSize, U32 instanceCount = 1, VkBufferUsageFlags otherUsage = 0);
 
+        /**
+         * @brief Factory Method for creating a descriptor for a device local Indirect Buffer object.
+         * 
+         * The buffer can be written by compute shaders (storage) and consumed by indirect draws.
+         * It is not host visible, create it with `bPersistentMapped = false`.
+         * 
+         * @param instanceSize  The size of each instance within the buffer. (In Bytes)
+         * @param instanceCount The number of instances in the buffer.
+         * 
+         * @return The created Indirect Buffer Description.
+         */
+		static VyBufferDesc indirectBuffer(VkDeviceSize instanceSize, U32 instanceCount = 1, VkBufferUsageFlags otherUsage = 0);
+
+        /**
+         * @brief Factory Method for creating a descriptor for a host readable Readback Buffer object.
+         * 
+         * @param instanceSize  The size of each instance within the buffer. (In Bytes)
+         * @param instanceCount The number of instances in the buffer.
+         * 
+         * @return The created Readback Buffer Description.
+         */
+		static VyBufferDesc readbackBuffer(VkDeviceSize instanceSize, U32 instanceCount = 1);
+
         /**
          * @brief Factory Method for creating a Staging Buffer object.
          * 
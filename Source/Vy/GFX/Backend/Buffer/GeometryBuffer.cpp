@@ -0,0 +1,358 @@
+#include <Vy/GFX/Backend/Buffer/GeometryBuffer.h>
+
+#include <Vy/GFX/Backend/CommandContext.h>
+#include <Vy/GFX/Context.h>
+
+#include <algorithm>
+
+namespace Vy
+{
+    VyGeometryBuffer::VyGeometryBuffer(U32 vertexStride, U32 vertexCapacity, U32 indexCapacity) :
+        m_VertexStride{ vertexStride   },
+        m_VertexRanges{ vertexCapacity },
+        m_IndexRanges { indexCapacity  }
+    {
+        VY_ASSERT(vertexStride > 0,                       "Vertex stride must be greater than 0");
+        VY_ASSERT(vertexCapacity > 0 && indexCapacity > 0, "Geometry arenas cannot be empty");
+
+        m_VertexArena = createVertexArena(vertexCapacity);
+        m_IndexArena  = createIndexArena (indexCapacity);
+    }
+
+
+    VyGeometryHandle VyGeometryBuffer::allocate(const void* pVertices, U32 vertexCount, const U32* pIndices, U32 indexCount)
+    {
+        VY_ASSERT(pVertices && vertexCount > 0, "Geometry needs vertices");
+        VY_ASSERT(indexCount == 0 || pIndices,  "Index count without indices");
+
+        LockGuard<Mutex> lock{ m_Mutex };
+
+        reserveLocked(vertexCount, indexCount);
+
+        VyGeometryRange range{};
+        {
+            range.VertexCount = vertexCount;
+            range.FirstVertex = m_VertexRanges.allocate(vertexCount);
+
+            range.IndexCount  = indexCount;
+            range.FirstIndex  = indexCount > 0 ? m_IndexRanges.allocate(indexCount) : 0;
+        }
+
+        // The upload is recorded under the lock, a relocation can not copy the arena before it.
+        VyContext::uploader().uploadBuffer(m_VertexArena->handle(),
+            pVertices, VkDeviceSize(vertexCount) * m_VertexStride, VkDeviceSize(range.FirstVertex) * m_VertexStride);
+
+        if (indexCount > 0)
+        {
+            VyContext::uploader().uploadBuffer(m_IndexArena->handle(),
+                pIndices, VkDeviceSize(indexCount) * sizeof(U32), VkDeviceSize(range.FirstIndex) * sizeof(U32));
+        }
+
+        VyGeometryHandle handle;
+
+        if (!m_FreeHandles.empty())
+        {
+            handle = m_FreeHandles.back();
+            m_FreeHandles.pop_back();
+        }
+        else
+        {
+            handle = static_cast<VyGeometryHandle>(m_Allocations.size());
+            m_Allocations.emplace_back();
+        }
+
+        m_Allocations[ handle ] = Allocation{ .Range = range, .bLive = true };
+
+        return handle;
+    }
+
+
+    void VyGeometryBuffer::free(VyGeometryHandle handle)
+    {
+        // Draws of the frames in flight may still read the data, a new allocation must not overwrite it before
+        // they completed.
+        VyContext::deletionQueue().schedule([this, handle]()
+        {
+            release(handle);
+        });
+    }
+
+
+    void VyGeometryBuffer::release(VyGeometryHandle handle)
+    {
+        LockGuard<Mutex> lock{ m_Mutex };
+
+        VY_ASSERT(handle < m_Allocations.size() && m_Allocations[ handle ].bLive, "Invalid geometry handle");
+
+        Allocation& allocation = m_Allocations[ handle ];
+
+        m_VertexRanges.free(allocation.Range.FirstVertex, allocation.Range.VertexCount);
+
+        if (allocation.Range.IndexCount > 0)
+        {
+            m_IndexRanges.free(allocation.Range.FirstIndex, allocation.Range.IndexCount);
+        }
+
+        allocation = Allocation{};
+
+        m_FreeHandles.push_back(handle);
+    }
+
+
+    VyGeometryRange VyGeometryBuffer::range(VyGeometryHandle handle) const
+    {
+        LockGuard<Mutex> lock{ m_Mutex };
+
+        VY_ASSERT(handle < m_Allocations.size() && m_Allocations[ handle ].bLive, "Invalid geometry handle");
+
+        return m_Allocations[ handle ].Range;
+    }
+
+
+    void VyGeometryBuffer::bind(VkCommandBuffer cmdBuffer) const
+    {
+        LockGuard<Mutex> lock{ m_Mutex };
+
+        VkBuffer     buffers[] = { m_VertexArena->handle() };
+        VkDeviceSize offsets[] = { 0 };
+
+        vkCmdBindVertexBuffers(cmdBuffer, 0, 1, buffers, offsets);
+        vkCmdBindIndexBuffer  (cmdBuffer, m_IndexArena->handle(), 0, VK_INDEX_TYPE_UINT32);
+    }
+
+
+    void VyGeometryBuffer::bind(VyCommandContext& context) const
+    {
+        LockGuard<Mutex> lock{ m_Mutex };
+
+        context.bindVertexBuffer(0, m_VertexArena->handle());
+        context.bindIndexBuffer (m_IndexArena->handle(), 0, VK_INDEX_TYPE_UINT32);
+    }
+
+
+    void VyGeometryBuffer::defragment()
+    {
+        LockGuard<Mutex> lock{ m_Mutex };
+
+        if (m_VertexRanges.fragmentation() == 0.0f && m_IndexRanges.fragmentation() == 0.0f)
+        {
+            return;
+        }
+
+        relocateLocked(m_VertexRanges.capacity(), m_IndexRanges.capacity(), true);
+
+        m_Defragments++;
+    }
+
+
+    U32 VyGeometryBuffer::generation() const
+    {
+        LockGuard<Mutex> lock{ m_Mutex };
+
+        return m_Generation;
+    }
+
+
+    VyGeometryStats VyGeometryBuffer::stats() const
+    {
+        LockGuard<Mutex> lock{ m_Mutex };
+
+        return VyGeometryStats{
+            .Allocations         = static_cast<U32>(m_Allocations.size() - m_FreeHandles.size()),
+            .VertexCapacity      = m_VertexRanges.capacity(),
+            .VerticesUsed        = m_VertexRanges.used(),
+            .IndexCapacity       = m_IndexRanges.capacity(),
+            .IndicesUsed         = m_IndexRanges.used(),
+            .VertexFragmentation = m_VertexRanges.fragmentation(),
+            .IndexFragmentation  = m_IndexRanges.fragmentation(),
+            .Grows               = m_Grows,
+            .Defragments         = m_Defragments
+        };
+    }
+
+
+    Unique<VyBuffer> VyGeometryBuffer::createVertexArena(U32 capacity) const
+    {
+        VyBufferDesc desc = VyBuffer::vertexBuffer(m_VertexStride, capacity, VK_BUFFER_USAGE_TRANSFER_SRC_BIT);
+        {
+            // Only written by uploads and relocation copies.
+            desc.AllocFlags = 0;
+        }
+
+        return MakeUnique<VyBuffer>(desc, false);
+    }
+
+
+    Unique<VyBuffer> VyGeometryBuffer::createIndexArena(U32 capacity) const
+    {
+        VyBufferDesc desc = VyBuffer::indexBuffer(sizeof(U32), capacity, VK_BUFFER_USAGE_TRANSFER_SRC_BIT);
+        {
+            desc.AllocFlags = 0;
+        }
+
+        return MakeUnique<VyBuffer>(desc, false);
+    }
+
+
+    void VyGeometryBuffer::reserveLocked(U32 vertexCount, U32 indexCount)
+    {
+        const bool bVerticesFit = m_VertexRanges.largestFreeRange() >= vertexCount;
+        const bool bIndicesFit  = indexCount == 0 || m_IndexRanges.largestFreeRange() >= indexCount;
+
+        if (bVerticesFit && bIndicesFit)
+        {
+            return;
+        }
+
+        // Doubling keeps the number of copies logarithmic in the final size. Offsets are kept, draws recorded
+        // against the old buffer stay valid until it is deleted.
+        const auto grownCapacity = [](const VyRangeAllocator& ranges, U32 count)
+        {
+            return std::max(ranges.capacity() * 2, ranges.capacity() + count);
+        };
+
+        const U32 vertexCapacity = bVerticesFit ? m_VertexRanges.capacity() : grownCapacity(m_VertexRanges, vertexCount);
+        const U32 indexCapacity  = bIndicesFit  ? m_IndexRanges .capacity() : grownCapacity(m_IndexRanges,  indexCount);
+
+        VY_DEBUG_TAG("VyGeometryBuffer", "Growing arenas to {} vertices and {} indices", vertexCapacity, indexCapacity);
+
+        relocateLocked(vertexCapacity, indexCapacity, false);
+
+        m_Grows++;
+    }
+
+
+    void VyGeometryBuffer::relocateLocked(U32 vertexCapacity, U32 indexCapacity, bool bCompact)
+    {
+        // Growing only replaces the arena that grows, compacting replaces both.
+        const bool bMoveVertices = bCompact || vertexCapacity != m_VertexRanges.capacity();
+        const bool bMoveIndices  = bCompact || indexCapacity  != m_IndexRanges .capacity();
+
+        Unique<VyBuffer> vertexArena = bMoveVertices ? createVertexArena(vertexCapacity) : nullptr;
+        Unique<VyBuffer> indexArena  = bMoveIndices  ? createIndexArena (indexCapacity)  : nullptr;
+
+        TVector<VkBufferCopy> vertexCopies;
+        TVector<VkBufferCopy> indexCopies;
+
+        if (bCompact)
+        {
+            // Allocating the live ranges in offset order from empty allocators packs them without reordering.
+            TVector<Allocation*> live;
+
+            for (Allocation& allocation : m_Allocations)
+            {
+                if (allocation.bLive)
+                {
+                    live.push_back(&allocation);
+                }
+            }
+
+            m_VertexRanges.reset(vertexCapacity);
+            m_IndexRanges .reset(indexCapacity);
+
+            std::sort(live.begin(), live.end(), [](const Allocation* a, const Allocation* b)
+            {
+                return a->Range.FirstVertex < b->Range.FirstVertex;
+            });
+
+            for (Allocation* allocation : live)
+            {
+                VyGeometryRange& range = allocation->Range;
+
+                const U32 firstVertex = m_VertexRanges.allocate(range.VertexCount);
+
+                vertexCopies.push_back(VkBufferCopy{
+                    .srcOffset = VkDeviceSize(range.FirstVertex) * m_VertexStride,
+                    .dstOffset = VkDeviceSize(firstVertex)       * m_VertexStride,
+                    .size      = VkDeviceSize(range.VertexCount) * m_VertexStride
+                });
+
+                range.FirstVertex = firstVertex;
+            }
+
+            std::sort(live.begin(), live.end(), [](const Allocation* a, const Allocation* b)
+            {
+                return a->Range.FirstIndex < b->Range.FirstIndex;
+            });
+
+            for (Allocation* allocation : live)
+            {
+                VyGeometryRange& range = allocation->Range;
+
+                if (range.IndexCount == 0)
+                {
+                    continue;
+                }
+
+                const U32 firstIndex = m_IndexRanges.allocate(range.IndexCount);
+
+                indexCopies.push_back(VkBufferCopy{
+                    .srcOffset = VkDeviceSize(range.FirstIndex) * sizeof(U32),
+                    .dstOffset = VkDeviceSize(firstIndex)       * sizeof(U32),
+                    .size      = VkDeviceSize(range.IndexCount) * sizeof(U32)
+                });
+
+                range.FirstIndex = firstIndex;
+            }
+
+            m_Generation++;
+        }
+        else
+        {
+            // Copying the whole arena is one region, the free space in it costs less than splitting the copy.
+            if (bMoveVertices)
+            {
+                vertexCopies.push_back(VkBufferCopy{ 0, 0, VkDeviceSize(m_VertexRanges.capacity()) * m_VertexStride });
+
+                m_VertexRanges.grow(vertexCapacity);
+            }
+
+            if (bMoveIndices)
+            {
+                indexCopies.push_back(VkBufferCopy{ 0, 0, VkDeviceSize(m_IndexRanges.capacity()) * sizeof(U32) });
+
+                m_IndexRanges.grow(indexCapacity);
+            }
+        }
+
+        VyDevice& device = VyContext::device();
+
+        VkCommandBuffer cmdBuffer = device.beginSingleTimeCommands();
+        {
+            if (!vertexCopies.empty())
+            {
+                vkCmdCopyBuffer(cmdBuffer, m_VertexArena->handle(), vertexArena->handle(),
+                    static_cast<U32>(vertexCopies.size()), vertexCopies.data());
+            }
+
+            if (!indexCopies.empty())
+            {
+                vkCmdCopyBuffer(cmdBuffer, m_IndexArena->handle(), indexArena->handle(),
+                    static_cast<U32>(indexCopies.size()), indexCopies.data());
+            }
+
+            VkMemoryBarrier barrier{ VK_STRUCTURE_TYPE_MEMORY_BARRIER };
+            {
+                barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+                barrier.dstAccessMask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+            }
+
+            vkCmdPipelineBarrier(cmdBuffer,
+                VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT, 0,
+                1, &barrier, 0, nullptr, 0, nullptr
+            );
+        }
+        device.endSingleTimeCommands(cmdBuffer);
+
+        // The old arenas are destroyed through the deletion queue, frames in flight can still read them.
+        if (vertexArena)
+        {
+            m_VertexArena = std::move(vertexArena);
+        }
+
+        if (indexArena)
+        {
+            m_IndexArena = std::move(indexArena);
+        }
+    }
+}
@@ -0,0 +1,160 @@
+#pragma once
+
+#include <Vy/GFX/Backend/Buffer/Buffer.h>
+
+#include <VyLib/STL/Mutex.h>
+#include <VyLib/Util/RangeAllocator.h>
+
+namespace Vy
+{
+    class VyCommandContext;
+
+    /**
+     * @brief Handle of a geometry allocation, it stays valid when `VyGeometryBuffer::defragment` moves the data.
+     */
+    using VyGeometryHandle = U32;
+
+    constexpr VyGeometryHandle kInvalidGeometry = ~0u;
+
+    /**
+     * @brief Where an allocation lives in the arenas, in vertices and indices.
+     *
+     * Draws pass `FirstVertex` as the vertex offset (indexed) or first vertex, and `FirstIndex` as the first index.
+     */
+    struct VyGeometryRange
+    {
+        U32 FirstVertex{ 0 };
+        U32 VertexCount{ 0 };
+        U32 FirstIndex { 0 };
+        U32 IndexCount { 0 };
+    };
+
+    struct VyGeometryStats
+    {
+        U32   Allocations        { 0 };
+        U32   VertexCapacity     { 0 };
+        U32   VerticesUsed       { 0 };
+        U32   IndexCapacity      { 0 };
+        U32   IndicesUsed        { 0 };
+        float VertexFragmentation{ 0.0f };
+        float IndexFragmentation { 0.0f };
+        U32   Grows              { 0 };
+        U32   Defragments        { 0 };
+    };
+
+    /**
+     * @brief Vertex and index data of all meshes, sub-allocated from one device local vertex and one index arena.
+     *
+     * Every mesh draws from the same two buffers, so switching meshes needs no buffer binds and indirect draws can
+     * reach any mesh through the offsets in their commands.
+     *
+     * Both arenas are managed by a best fit free list (VyRangeAllocator). An allocation that does not fit grows the
+     * arena: a larger buffer is created, the old contents are copied over at the same offsets and the old buffer goes
+     * through the deletion queue. `defragment` packs the live allocations to the front of new buffers and changes
+     * their offsets, which is why allocations are referenced through handles.
+     *
+     * @note Thread safe. Growing and defragmenting wait for the graphics queue like single time commands do.
+     *       Defragmenting moves data that recorded draws may still point at, only call it while no frame is recorded.
+     * @note Owned by VyContext.
+     */
+    class VyGeometryBuffer
+    {
+    public:
+        static constexpr U32 kInitialVertexCapacity = 256 * 1024;
+        static constexpr U32 kInitialIndexCapacity  = 1024 * 1024;
+
+        explicit VyGeometryBuffer(
+            U32 vertexStride,
+            U32 vertexCapacity = kInitialVertexCapacity,
+            U32 indexCapacity  = kInitialIndexCapacity
+        );
+
+        VyGeometryBuffer(const VyGeometryBuffer&)            = delete;
+        VyGeometryBuffer& operator=(const VyGeometryBuffer&) = delete;
+
+        /**
+         * @brief Allocates and uploads the vertices and (optional) 32-bit indices of a mesh.
+         *
+         * The data is copied into staging memory before returning.
+         */
+        VY_NODISCARD VyGeometryHandle allocate(const void* pVertices, U32 vertexCount, const U32* pIndices, U32 indexCount);
+
+        /**
+         * @brief Frees an allocation. Its ranges are reused once the frames in flight completed.
+         */
+        void free(VyGeometryHandle handle);
+
+        /**
+         * @brief Current location of an allocation. Only changes when the arenas are defragmented.
+         */
+        VY_NODISCARD VyGeometryRange range(VyGeometryHandle handle) const;
+
+        /**
+         * @brief Binds the vertex arena to binding 0 and the index arena.
+         */
+        void bind(VkCommandBuffer cmdBuffer) const;
+
+        /**
+         * @brief Binds the arenas through a command context, skipped if they are already bound.
+         */
+        void bind(VyCommandContext& context) const;
+
+        /**
+         * @brief Packs the live allocations to the front of the arenas.
+         *
+         * Bumps `generation`, anything that cached ranges (e.g. GPU draw groups) must fetch them again.
+         */
+        void defragment();
+
+        /**
+         * @brief Incremented whenever allocations move.
+         */
+        VY_NODISCARD U32 generation() const;
+
+        VY_NODISCARD VyGeometryStats stats() const;
+
+    private:
+        struct Allocation
+        {
+            VyGeometryRange Range{};
+            bool            bLive{ false };
+        };
+
+        /**
+         * @brief Returns the ranges of a freed allocation to the arenas, run by the deletion queue.
+         */
+        void release(VyGeometryHandle handle);
+
+        VY_NODISCARD Unique<VyBuffer> createVertexArena(U32 capacity) const;
+        VY_NODISCARD Unique<VyBuffer> createIndexArena (U32 capacity) const;
+
+        /**
+         * @brief Makes room for `vertexCount` vertices and `indexCount` indices, growing the arenas if needed.
+         */
+        void reserveLocked(U32 vertexCount, U32 indexCount);
+
+        /**
+         * @brief Moves the arenas into new buffers of the given capacities.
+         *
+         * @param bCompact Pack the live allocations to the front instead of keeping their offsets.
+         */
+        void relocateLocked(U32 vertexCapacity, U32 indexCapacity, bool bCompact);
+
+        U32                  m_VertexStride;
+
+        Unique<VyBuffer>     m_VertexArena;
+        Unique<VyBuffer>     m_IndexArena;
+
+        VyRangeAllocator     m_VertexRanges;
+        VyRangeAllocator     m_IndexRanges;
+
+        TVector<Allocation>       m_Allocations;
+        TVector<VyGeometryHandle> m_FreeHandles;
+
+        U32                  m_Generation { 0 };
+        U32                  m_Grows      { 0 };
+        U32                  m_Defragments{ 0 };
+
+        mutable Mutex        m_Mutex;
+    };
+}
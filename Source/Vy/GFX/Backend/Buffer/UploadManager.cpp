@@ -0,0 +1,560 @@
+#include <Vy/GFX/Backend/Buffer/UploadManager.h>
+
+#include <Vy/GFX/Context.h>
+
+#include <cstring>
+
+namespace Vy
+{
+    VyUploadManager::VyUploadManager(VyDevice& device) :
+        m_Device   { device                             },
+        m_Dedicated{ device.hasDedicatedTransferQueue() }
+    {
+        createCommandPools();
+        createTimelines();
+
+        m_Ring = MakeUnique<VyBuffer>( VyBuffer::stagingBuffer(kStagingSize), true );
+    }
+
+
+    VyUploadManager::~VyUploadManager()
+    {
+        {
+            LockGuard<Mutex> lock{ m_Mutex };
+
+            submitLocked();
+            waitLocked(m_LastSubmitted);
+            retireCompleted();
+        }
+
+        m_Ring.reset();
+
+        vkDestroySemaphore(m_Device, m_Timeline,         nullptr);
+        vkDestroySemaphore(m_Device, m_TransferTimeline, nullptr);
+
+        vkDestroyCommandPool(m_Device, m_TransferPool, nullptr);
+        vkDestroyCommandPool(m_Device, m_GraphicsPool, nullptr);
+    }
+
+
+    void VyUploadManager::createCommandPools()
+    {
+        VkCommandPoolCreateInfo poolInfo{ VKInit::commandPoolCreateInfo() };
+        {
+            poolInfo.queueFamilyIndex = m_Device.transferFamily();
+            poolInfo.flags            = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+        }
+
+        VK_CHECK(vkCreateCommandPool(m_Device, &poolInfo, nullptr, &m_TransferPool));
+
+        if (m_Dedicated)
+        {
+            poolInfo.queueFamilyIndex = m_Device.graphicsFamily();
+
+            VK_CHECK(vkCreateCommandPool(m_Device, &poolInfo, nullptr, &m_GraphicsPool));
+        }
+    }
+
+
+    void VyUploadManager::createTimelines()
+    {
+        VkSemaphoreTypeCreateInfo typeInfo{ VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO };
+        {
+            typeInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+            typeInfo.initialValue  = 0;
+        }
+
+        VkSemaphoreCreateInfo semaphoreInfo{ VKInit::semaphoreCreateInfo() };
+        {
+            semaphoreInfo.pNext = &typeInfo;
+        }
+
+        VK_CHECK(vkCreateSemaphore(m_Device, &semaphoreInfo, nullptr, &m_Timeline));
+
+        if (m_Dedicated)
+        {
+            VK_CHECK(vkCreateSemaphore(m_Device, &semaphoreInfo, nullptr, &m_TransferTimeline));
+        }
+    }
+
+    // ============================================================================================
+
+    VyUploadToken VyUploadManager::uploadBuffer(
+        VkBuffer     dstBuffer,
+        const void*  pData,
+        VkDeviceSize size,
+        VkDeviceSize dstOffset)
+    {
+        VY_ASSERT(size > 0, "Cannot upload 0 bytes");
+
+        LockGuard<Mutex> lock{ m_Mutex };
+
+        auto [ srcBuffer, srcOffset ] = stage(pData, size);
+
+        beginBatch();
+
+        VkBufferCopy region{};
+        {
+            region.srcOffset = srcOffset;
+            region.dstOffset = dstOffset;
+            region.size      = size;
+        }
+
+        vkCmdCopyBuffer(m_Open.TransferCmd, srcBuffer, dstBuffer, 1, &region);
+
+        VkBufferMemoryBarrier barrier{ VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER };
+        {
+            barrier.buffer              = dstBuffer;
+            barrier.offset              = dstOffset;
+            barrier.size                = size;
+            barrier.srcAccessMask       = VK_ACCESS_TRANSFER_WRITE_BIT;
+            barrier.dstAccessMask       = VK_ACCESS_MEMORY_READ_BIT;
+            barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        }
+
+        if (m_Dedicated)
+        {
+            barrier.srcQueueFamilyIndex = m_Device.transferFamily();
+            barrier.dstQueueFamilyIndex = m_Device.graphicsFamily();
+
+            // Release on the transfer queue ( dstAccessMask is ignored ).
+            vkCmdPipelineBarrier(m_Open.TransferCmd,
+                VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0,
+                0, nullptr, 1, &barrier, 0, nullptr
+            );
+
+            // Acquire on the graphics queue ( srcAccessMask is ignored ).
+            barrier.srcAccessMask = 0;
+
+            vkCmdPipelineBarrier(m_Open.GraphicsCmd,
+                VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0,
+                0, nullptr, 1, &barrier, 0, nullptr
+            );
+        }
+        else
+        {
+            vkCmdPipelineBarrier(m_Open.TransferCmd,
+                VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0,
+                0, nullptr, 1, &barrier, 0, nullptr
+            );
+        }
+
+        return m_Open.Token;
+    }
+
+
+    VyUploadToken VyUploadManager::uploadImage(
+        VyImage&      image,
+        const void*   pData,
+        VkDeviceSize  size,
+        VkImageLayout finalLayout,
+        bool          bGenerateMipmaps)
+    {
+        VY_ASSERT(size > 0, "Cannot upload 0 bytes");
+
+        LockGuard<Mutex> lock{ m_Mutex };
+
+        auto [ srcBuffer, srcOffset ] = stage(pData, size);
+
+        beginBatch();
+
+        // Every mip and layer, the image is owned by the transfer queue until it is released below.
+        VkImageMemoryBarrier barrier{ VKInit::imageMemoryBarrier() };
+        {
+            barrier.image               = image.handle();
+            barrier.oldLayout           = VK_IMAGE_LAYOUT_UNDEFINED;
+            barrier.newLayout           = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+            barrier.srcAccessMask       = 0;
+            barrier.dstAccessMask       = VK_ACCESS_TRANSFER_WRITE_BIT;
+            barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.subresourceRange    = VkImageSubresourceRange{ VK_IMAGE_ASPECT_COLOR_BIT, 0, image.mipLevels(), 0, image.layerCount() };
+        }
+
+        vkCmdPipelineBarrier(m_Open.TransferCmd,
+            VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0,
+            0, nullptr, 0, nullptr, 1, &barrier
+        );
+
+        VkBufferImageCopy region{};
+        {
+            region.bufferOffset                    = srcOffset;
+            region.bufferRowLength                 = 0;
+            region.bufferImageHeight               = 0;
+
+            region.imageSubresource.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+            region.imageSubresource.mipLevel       = 0;
+            region.imageSubresource.baseArrayLayer = 0;
+            region.imageSubresource.layerCount     = image.layerCount();
+
+            region.imageOffset                     = { 0, 0, 0 };
+            region.imageExtent                     = image.extent();
+        }
+
+        vkCmdCopyBufferToImage(m_Open.TransferCmd, srcBuffer, image.handle(), VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+
+        image.setLayout(VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+
+        VkCommandBuffer finalizeCmd = m_Open.TransferCmd;
+
+        if (m_Dedicated)
+        {
+            barrier.oldLayout           = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+            barrier.newLayout           = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+            barrier.srcAccessMask       = VK_ACCESS_TRANSFER_WRITE_BIT;
+            barrier.dstAccessMask       = 0;
+            barrier.srcQueueFamilyIndex = m_Device.transferFamily();
+            barrier.dstQueueFamilyIndex = m_Device.graphicsFamily();
+
+            vkCmdPipelineBarrier(m_Open.TransferCmd,
+                VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0,
+                0, nullptr, 0, nullptr, 1, &barrier
+            );
+
+            barrier.srcAccessMask       = 0;
+            barrier.dstAccessMask       = VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+
+            vkCmdPipelineBarrier(m_Open.GraphicsCmd,
+                VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0,
+                0, nullptr, 0, nullptr, 1, &barrier
+            );
+
+            // Blits need a graphics queue.
+            finalizeCmd = m_Open.GraphicsCmd;
+        }
+
+        if (bGenerateMipmaps && image.mipLevels() > 1)
+        {
+            image.generateMipmaps(finalizeCmd, finalLayout);
+        }
+        else
+        {
+            image.transitionLayout(finalizeCmd, finalLayout);
+        }
+
+        return m_Open.Token;
+    }
+
+    // ============================================================================================
+
+    VyUploadToken VyUploadManager::submit()
+    {
+        LockGuard<Mutex> lock{ m_Mutex };
+
+        return submitLocked();
+    }
+
+
+    void VyUploadManager::wait(VyUploadToken token)
+    {
+        LockGuard<Mutex> lock{ m_Mutex };
+
+        waitLocked(token);
+        retireCompleted();
+    }
+
+
+    bool VyUploadManager::isComplete(VyUploadToken token) const
+    {
+        return completedValue() >= token;
+    }
+
+
+    VyUploadManager::GraphicsWait VyUploadManager::graphicsWait()
+    {
+        LockGuard<Mutex> lock{ m_Mutex };
+
+        submitLocked();
+        retireCompleted();
+
+        return GraphicsWait{ m_Timeline, m_LastSubmitted };
+    }
+
+    // ============================================================================================
+
+    void VyUploadManager::beginBatch()
+    {
+        if (m_Open.TransferCmd != VK_NULL_HANDLE)
+        {
+            return;
+        }
+
+        m_Open.Token = m_NextToken;
+
+        VkCommandBufferBeginInfo beginInfo{ VKInit::commandBufferBeginInfo() };
+        {
+            beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+        }
+
+        VkCommandBufferAllocateInfo allocInfo{ VKInit::commandBufferAllocateInfo() };
+        {
+            allocInfo.level              = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+            allocInfo.commandPool        = m_TransferPool;
+            allocInfo.commandBufferCount = 1;
+        }
+
+        VK_CHECK(vkAllocateCommandBuffers(m_Device, &allocInfo, &m_Open.TransferCmd));
+        VK_CHECK(vkBeginCommandBuffer(m_Open.TransferCmd, &beginInfo));
+
+        if (m_Dedicated)
+        {
+            allocInfo.commandPool = m_GraphicsPool;
+
+            VK_CHECK(vkAllocateCommandBuffers(m_Device, &allocInfo, &m_Open.GraphicsCmd));
+            VK_CHECK(vkBeginCommandBuffer(m_Open.GraphicsCmd, &beginInfo));
+        }
+    }
+
+
+    std::pair<VkBuffer, VkDeviceSize> VyUploadManager::stage(const void* pData, VkDeviceSize size)
+    {
+        // Large uploads would stall on the ring, give them their own staging buffer.
+        if (size > kStagingSize / 4)
+        {
+            auto& staging = m_Open.OversizedStaging.emplace_back(
+                MakeUnique<VyBuffer>( VyBuffer::stagingBuffer(size), false )
+            );
+
+            staging->singleWrite(pData, size, 0);
+
+            return { staging->handle(), 0 };
+        }
+
+        VkDeviceSize offset = 0;
+
+        while (!tryAllocate(size, offset))
+        {
+            retireCompleted();
+
+            if (tryAllocate(size, offset))
+            {
+                break;
+            }
+
+            if (m_InFlight.empty())
+            {
+                // Only the open batch holds ring space, submit it so it can be waited on.
+                submitLocked();
+            }
+
+            VY_ASSERT(!m_InFlight.empty(), "Upload staging ring is full without batches in flight");
+
+            waitLocked(m_InFlight.front().Token);
+        }
+
+        std::memcpy(static_cast<U8*>(m_Ring->mappedData()) + offset, pData, size);
+
+        m_Ring->flush(size, offset);
+
+        return { m_Ring->handle(), offset };
+    }
+
+
+    bool VyUploadManager::tryAllocate(VkDeviceSize size, VkDeviceSize& offset)
+    {
+        if (m_Used == 0)
+        {
+            m_Head = 0;
+            m_Tail = 0;
+        }
+        else if (m_Head == m_Tail)
+        {
+            return false; // Full.
+        }
+
+        VkDeviceSize start = (m_Head + kStagingAlignment - 1) & ~(kStagingAlignment - 1);
+        VkDeviceSize used  = 0;
+
+        if (m_Head >= m_Tail)
+        {
+            // Free: [ head, end ) and [ 0, tail ).
+            if (start + size <= kStagingSize)
+            {
+                used = start + size - m_Head;
+            }
+            else if (size <= m_Tail)
+            {
+                // Wrap, the end of the ring is padding held by this batch.
+                used  = (kStagingSize - m_Head) + size;
+                start = 0;
+            }
+            else
+            {
+                return false;
+            }
+        }
+        else
+        {
+            // Free: [ head, tail ).
+            if (start + size > m_Tail)
+            {
+                return false;
+            }
+
+            used = start + size - m_Head;
+        }
+
+        offset  = start;
+        m_Head  = start + size;
+        m_Used += used;
+
+        m_Open.RingBytes += used;
+        m_Open.RingEnd    = m_Head;
+
+        return true;
+    }
+
+
+    VyUploadToken VyUploadManager::submitLocked()
+    {
+        if (m_Open.TransferCmd == VK_NULL_HANDLE)
+        {
+            // Nothing recorded, but oversized staging buffers may have been written.
+            VY_ASSERT(m_Open.OversizedStaging.empty() && m_Open.RingBytes == 0, "Staged data without recorded uploads");
+
+            return m_LastSubmitted;
+        }
+
+        const VyUploadToken token = m_Open.Token;
+
+        VK_CHECK(vkEndCommandBuffer(m_Open.TransferCmd));
+
+        // Uploads are started from any thread, the render thread submits to the same queues.
+        LockGuard<Mutex> queueLock{ m_Device.queueMutex() };
+
+        if (m_Dedicated)
+        {
+            VK_CHECK(vkEndCommandBuffer(m_Open.GraphicsCmd));
+
+            // [ Transfer ] Copies and releases, signals the transfer timeline.
+            VkTimelineSemaphoreSubmitInfo transferTimeline{ VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO };
+            {
+                transferTimeline.signalSemaphoreValueCount = 1;
+                transferTimeline.pSignalSemaphoreValues    = &token;
+            }
+
+            VkSubmitInfo transferSubmit{ VKInit::submitInfo() };
+            {
+                transferSubmit.pNext                = &transferTimeline;
+                transferSubmit.commandBufferCount   = 1;
+                transferSubmit.pCommandBuffers      = &m_Open.TransferCmd;
+                transferSubmit.signalSemaphoreCount = 1;
+                transferSubmit.pSignalSemaphores    = &m_TransferTimeline;
+            }
+
+            VK_CHECK(vkQueueSubmit(m_Device.transferQueue(), 1, &transferSubmit, VK_NULL_HANDLE));
+
+            // [ Graphics ] Acquires, mipmaps and final layouts, signals the upload timeline.
+            VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+
+            VkTimelineSemaphoreSubmitInfo graphicsTimeline{ VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO };
+            {
+                graphicsTimeline.waitSemaphoreValueCount   = 1;
+                graphicsTimeline.pWaitSemaphoreValues      = &token;
+                graphicsTimeline.signalSemaphoreValueCount = 1;
+                graphicsTimeline.pSignalSemaphoreValues    = &token;
+            }
+
+            VkSubmitInfo graphicsSubmit{ VKInit::submitInfo() };
+            {
+                graphicsSubmit.pNext                = &graphicsTimeline;
+                graphicsSubmit.waitSemaphoreCount   = 1;
+                graphicsSubmit.pWaitSemaphores      = &m_TransferTimeline;
+                graphicsSubmit.pWaitDstStageMask    = &waitStage;
+                graphicsSubmit.commandBufferCount   = 1;
+                graphicsSubmit.pCommandBuffers      = &m_Open.GraphicsCmd;
+                graphicsSubmit.signalSemaphoreCount = 1;
+                graphicsSubmit.pSignalSemaphores    = &m_Timeline;
+            }
+
+            VK_CHECK(vkQueueSubmit(m_Device.graphicsQueue(), 1, &graphicsSubmit, VK_NULL_HANDLE));
+        }
+        else
+        {
+            VkTimelineSemaphoreSubmitInfo timelineInfo{ VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO };
+            {
+                timelineInfo.signalSemaphoreValueCount = 1;
+                timelineInfo.pSignalSemaphoreValues    = &token;
+            }
+
+            VkSubmitInfo submitInfo{ VKInit::submitInfo() };
+            {
+                submitInfo.pNext                = &timelineInfo;
+                submitInfo.commandBufferCount   = 1;
+                submitInfo.pCommandBuffers      = &m_Open.TransferCmd;
+                submitInfo.signalSemaphoreCount = 1;
+                submitInfo.pSignalSemaphores    = &m_Timeline;
+            }
+
+            VK_CHECK(vkQueueSubmit(m_Device.graphicsQueue(), 1, &submitInfo, VK_NULL_HANDLE));
+        }
+
+        m_InFlight.emplace_back(std::move(m_Open));
+        m_Open = Batch{};
+
+        m_LastSubmitted = token;
+        m_NextToken     = token + 1;
+
+        return token;
+    }
+
+
+    void VyUploadManager::waitLocked(VyUploadToken token)
+    {
+        if (token == m_Open.Token && m_Open.TransferCmd != VK_NULL_HANDLE)
+        {
+            submitLocked();
+        }
+
+        if (token == 0 || token > m_LastSubmitted)
+        {
+            return;
+        }
+
+        VkSemaphoreWaitInfo waitInfo{ VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO };
+        {
+            waitInfo.semaphoreCount = 1;
+            waitInfo.pSemaphores    = &m_Timeline;
+            waitInfo.pValues        = &token;
+        }
+
+        VK_CHECK(vkWaitSemaphores(m_Device, &waitInfo, UINT64_MAX));
+    }
+
+
+    void VyUploadManager::retireCompleted()
+    {
+        const U64 completed = completedValue();
+
+        while (!m_InFlight.empty() && m_InFlight.front().Token <= completed)
+        {
+            Batch& batch = m_InFlight.front();
+
+            vkFreeCommandBuffers(m_Device, m_TransferPool, 1, &batch.TransferCmd);
+
+            if (batch.GraphicsCmd != VK_NULL_HANDLE)
+            {
+                vkFreeCommandBuffers(m_Device, m_GraphicsPool, 1, &batch.GraphicsCmd);
+            }
+
+            if (batch.RingBytes > 0)
+            {
+                m_Used -= batch.RingBytes;
+                m_Tail  = batch.RingEnd;
+            }
+
+            m_InFlight.pop_front();
+        }
+    }
+
+
+    U64 VyUploadManager::completedValue() const
+    {
+        U64 value = 0;
+
+        VK_CHECK(vkGetSemaphoreCounterValue(m_Device, m_Timeline, &value));
+
+        return value;
+    }
+}
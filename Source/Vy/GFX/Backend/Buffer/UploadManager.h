@@ -0,0 +1,151 @@
+#pragma once
+
+#include <Vy/GFX/Backend/Buffer/Buffer.h>
+#include <Vy/GFX/Backend/Image/Image.h>
+
+#include <VyLib/STL/Mutex.h>
+
+namespace Vy
+{
+    /**
+     * @brief Completion token of an upload: the timeline value signaled once its batch is done.
+     */
+    using VyUploadToken = U64;
+
+    /**
+     * @brief Batches buffer and image uploads through a persistently mapped staging ring.
+     *
+     * An upload copies its data into the ring right away (the caller can free it on return) and records the copy
+     * into the open batch. The batch is submitted by `submit()`, at the latest before the next frame or single time
+     * command submission, or when the ring runs out of space. Every batch signals a timeline semaphore, an upload's
+     * token is the value its batch signals.
+     *
+     * With a dedicated transfer queue family the copies run on the transfer queue, the resources are released to the
+     * graphics family and acquired by a small graphics queue submission that also generates the mipmaps and
+     * transitions the images to their final layout. Without one everything is recorded for the graphics queue.
+     *
+     * Graphics queue submissions wait for the uploads on the GPU (`graphicsWait`), the host only has to `wait` on a
+     * token when it needs the upload to be finished itself.
+     *
+     * @note Thread safe. Owned by VyContext.
+     */
+    class VyUploadManager
+    {
+    public:
+        static constexpr VkDeviceSize kStagingSize      = 64ull * 1024 * 1024;
+        static constexpr VkDeviceSize kStagingAlignment = 16;
+
+        /**
+         * @brief Semaphore wait that orders a graphics queue submission after every submitted upload.
+         */
+        struct GraphicsWait
+        {
+            VkSemaphore Semaphore;
+            U64         Value;
+        };
+
+        explicit VyUploadManager(VyDevice& device);
+
+        VyUploadManager(const VyUploadManager&)            = delete;
+        VyUploadManager& operator=(const VyUploadManager&) = delete;
+
+        ~VyUploadManager();
+
+        /**
+         * @brief Uploads `size` bytes into `dstBuffer` at `dstOffset`.
+         */
+        VyUploadToken uploadBuffer(VkBuffer dstBuffer, const void* pData, VkDeviceSize size, VkDeviceSize dstOffset = 0);
+
+        /**
+         * @brief Uploads the first mip level of every layer of `image` (tightly packed, layer after layer).
+         *
+         * The previous contents of the image are discarded. The image must be created with `TRANSFER_DST` usage
+         * (and `TRANSFER_SRC` to generate mipmaps) and stay alive until the upload completed.
+         */
+        VyUploadToken uploadImage(
+            VyImage&      image,
+            const void*   pData,
+            VkDeviceSize  size,
+            VkImageLayout finalLayout      = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+            bool          bGenerateMipmaps = false
+        );
+
+        /**
+         * @brief Submits the open batch, if it recorded anything.
+         *
+         * @return The token of the last submitted batch.
+         */
+        VyUploadToken submit();
+
+        /**
+         * @brief Blocks until the upload with the given token is done. Submits its batch if it is still open.
+         */
+        void wait(VyUploadToken token);
+
+        VY_NODISCARD bool isComplete(VyUploadToken token) const;
+
+        /**
+         * @brief Submits the open batch and returns the wait a graphics submission needs to see every upload.
+         */
+        VY_NODISCARD GraphicsWait graphicsWait();
+
+    private:
+        struct Batch
+        {
+            VyUploadToken             Token      { 0 };
+            VkCommandBuffer           TransferCmd{ VK_NULL_HANDLE };
+            VkCommandBuffer           GraphicsCmd{ VK_NULL_HANDLE }; // Dedicated transfer queue only: acquires and image finalization.
+            VkDeviceSize              RingEnd    { 0 };              // Ring head after the batch's last allocation.
+            VkDeviceSize              RingBytes  { 0 };              // Ring bytes held by the batch, including wrap padding.
+            TVector<Unique<VyBuffer>> OversizedStaging;              // Uploads too large for the ring.
+        };
+
+        void createCommandPools();
+        void createTimelines();
+
+        /**
+         * @brief Begins the open batch's command buffers if it has none yet.
+         */
+        void beginBatch();
+
+        /**
+         * @brief Copies the data into staging memory held by the open batch.
+         *
+         * @return The staging buffer and the offset of the data in it.
+         */
+        std::pair<VkBuffer, VkDeviceSize> stage(const void* pData, VkDeviceSize size);
+
+        bool tryAllocate(VkDeviceSize size, VkDeviceSize& offset);
+
+        VyUploadToken submitLocked();
+        void          waitLocked(VyUploadToken token);
+
+        /**
+         * @brief Frees the batches that completed and their ring space.
+         */
+        void retireCompleted();
+
+        VY_NODISCARD U64 completedValue() const;
+
+        VyDevice&           m_Device;
+        bool                m_Dedicated{ false };
+
+        VkCommandPool       m_TransferPool{ VK_NULL_HANDLE };
+        VkCommandPool       m_GraphicsPool{ VK_NULL_HANDLE };
+
+        VkSemaphore         m_Timeline        { VK_NULL_HANDLE }; // Signaled by the last submission of each batch.
+        VkSemaphore         m_TransferTimeline{ VK_NULL_HANDLE }; // Signaled by the transfer queue, dedicated only.
+
+        Unique<VyBuffer>    m_Ring;
+        VkDeviceSize        m_Head{ 0 };
+        VkDeviceSize        m_Tail{ 0 };
+        VkDeviceSize        m_Used{ 0 };
+
+        Batch               m_Open;
+        TDeque<Batch>       m_InFlight;
+        VyUploadToken       m_NextToken{ 1 };
+        VyUploadToken       m_LastSubmitted{ 0 };
+
+        mutable Mutex       m_Mutex;
+    };
+}
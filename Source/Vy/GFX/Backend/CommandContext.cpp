@@ -0,0 +1,178 @@
+#include <Vy/GFX/Backend/CommandContext.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace Vy
+{
+    void VyCommandContext::bindPipeline(const VyPipeline& pipeline)
+    {
+        VY_ASSERT(pipeline.bindPoint() == VK_PIPELINE_BIND_POINT_GRAPHICS, "VyCommandContext only tracks the graphics bind point");
+
+        if (pipeline.handle() == m_Pipeline)
+        {
+            m_Stats.PipelineBindsElided++;
+
+            return;
+        }
+
+        // Binding a pipeline does not disturb the bound sets or push constants, they stay tracked.
+        pipeline.bind(m_CommandBuffer);
+
+        m_Pipeline = pipeline.handle();
+
+        m_Stats.PipelineBinds++;
+    }
+
+
+    void VyCommandContext::bindDescriptorSet(
+        const VyPipeline& pipeline,
+        U32               setIndex,
+        VkDescriptorSet   descriptorSet,
+        U32               dynamicOffsetCount,
+        const U32*        pDynamicOffsets)
+    {
+        VY_ASSERT(setIndex < kMaxDescriptorSets, "Descriptor set index out of range");
+
+        useSetLayout(pipeline.layout());
+
+        if (dynamicOffsetCount == 0 && m_Sets[ setIndex ] == descriptorSet)
+        {
+            m_Stats.DescriptorSetBindsElided++;
+
+            return;
+        }
+
+        pipeline.bindDescriptorSet(m_CommandBuffer, setIndex, descriptorSet, dynamicOffsetCount, pDynamicOffsets);
+
+        // The offsets are not tracked, a set bound with them is never considered bound.
+        m_Sets[ setIndex ] = dynamicOffsetCount == 0 ? descriptorSet : VK_NULL_HANDLE;
+
+        m_Stats.DescriptorSetBinds++;
+    }
+
+
+    void VyCommandContext::bindDescriptorSets(
+        const VyPipeline&            pipeline,
+        U32                          firstSet,
+        TSpan<const VkDescriptorSet> descriptorSets)
+    {
+        VY_ASSERT(firstSet + descriptorSets.size() <= kMaxDescriptorSets, "Descriptor set index out of range");
+
+        useSetLayout(pipeline.layout());
+
+        if (std::equal(descriptorSets.begin(), descriptorSets.end(), m_Sets.begin() + firstSet))
+        {
+            m_Stats.DescriptorSetBindsElided++;
+
+            return;
+        }
+
+        pipeline.bindDescriptorSets(m_CommandBuffer, firstSet, descriptorSets);
+
+        std::copy(descriptorSets.begin(), descriptorSets.end(), m_Sets.begin() + firstSet);
+
+        m_Stats.DescriptorSetBinds++;
+    }
+
+
+    void VyCommandContext::bindVertexBuffer(U32 binding, VkBuffer buffer, VkDeviceSize offset)
+    {
+        VY_ASSERT(binding < kMaxVertexBindings, "Vertex buffer binding out of range");
+
+        if (m_VertexBuffers[ binding ] == buffer && m_VertexOffsets[ binding ] == offset)
+        {
+            m_Stats.VertexBufferBindsElided++;
+
+            return;
+        }
+
+        vkCmdBindVertexBuffers(m_CommandBuffer, binding, 1, &buffer, &offset);
+
+        m_VertexBuffers[ binding ] = buffer;
+        m_VertexOffsets[ binding ] = offset;
+
+        m_Stats.VertexBufferBinds++;
+    }
+
+
+    void VyCommandContext::bindIndexBuffer(VkBuffer buffer, VkDeviceSize offset, VkIndexType indexType)
+    {
+        if (m_IndexBuffer == buffer && m_IndexOffset == offset && m_IndexType == indexType)
+        {
+            m_Stats.IndexBufferBindsElided++;
+
+            return;
+        }
+
+        vkCmdBindIndexBuffer(m_CommandBuffer, buffer, offset, indexType);
+
+        m_IndexBuffer = buffer;
+        m_IndexOffset = offset;
+        m_IndexType   = indexType;
+
+        m_Stats.IndexBufferBinds++;
+    }
+
+
+    void VyCommandContext::pushConstants(
+        const VyPipeline&  pipeline,
+        VkShaderStageFlags stageFlags,
+        const void*        pData,
+        U32                size,
+        U32                offset)
+    {
+        VY_ASSERT(offset + size <= kMaxPushConstantBytes, "Push constant range out of range");
+
+        const bool bSame =
+            m_PushLayout == pipeline.layout() &&
+            m_PushStages == stageFlags        &&
+            m_PushOffset == offset            &&
+            m_PushSize   == size              &&
+            std::memcmp(m_PushData.data() + offset, pData, size) == 0;
+
+        if (bSame)
+        {
+            m_Stats.PushConstantsElided++;
+
+            return;
+        }
+
+        pipeline.pushConstants(m_CommandBuffer, stageFlags, pData, size, offset);
+
+        m_PushLayout = pipeline.layout();
+        m_PushStages = stageFlags;
+        m_PushOffset = offset;
+        m_PushSize   = size;
+
+        std::memcpy(m_PushData.data() + offset, pData, size);
+
+        m_Stats.PushConstants++;
+    }
+
+
+    void VyCommandContext::invalidate()
+    {
+        m_Pipeline  = VK_NULL_HANDLE;
+        m_SetLayout = VK_NULL_HANDLE;
+        m_Sets.fill(VK_NULL_HANDLE);
+
+        m_VertexBuffers.fill(VK_NULL_HANDLE);
+        m_VertexOffsets.fill(0);
+
+        m_IndexBuffer = VK_NULL_HANDLE;
+
+        m_PushLayout = VK_NULL_HANDLE;
+        m_PushSize   = 0;
+    }
+
+
+    void VyCommandContext::useSetLayout(VkPipelineLayout layout)
+    {
+        if (m_SetLayout != layout)
+        {
+            m_SetLayout = layout;
+            m_Sets.fill(VK_NULL_HANDLE);
+        }
+    }
+}
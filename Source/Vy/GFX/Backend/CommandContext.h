@@ -0,0 +1,155 @@
+#pragma once
+
+#include <Vy/GFX/Backend/Pipeline.h>
+
+namespace Vy
+{
+    /**
+     * @brief Binds and push constants recorded through a VyCommandContext, and the redundant ones it skipped.
+     */
+    struct VyCommandStats
+    {
+        U32 PipelineBinds           { 0 };
+        U32 PipelineBindsElided     { 0 };
+        U32 DescriptorSetBinds      { 0 };
+        U32 DescriptorSetBindsElided{ 0 };
+        U32 VertexBufferBinds       { 0 };
+        U32 VertexBufferBindsElided { 0 };
+        U32 IndexBufferBinds        { 0 };
+        U32 IndexBufferBindsElided  { 0 };
+        U32 PushConstants           { 0 };
+        U32 PushConstantsElided     { 0 };
+
+        void reset() { *this = VyCommandStats{}; }
+
+        /**
+         * @brief Total number of Vulkan calls that were skipped.
+         */
+        VY_NODISCARD U32 elided() const
+        {
+            return PipelineBindsElided + DescriptorSetBindsElided + VertexBufferBindsElided + IndexBufferBindsElided + PushConstantsElided;
+        }
+
+        VyCommandStats& operator+=(const VyCommandStats& other)
+        {
+            PipelineBinds            += other.PipelineBinds;
+            PipelineBindsElided      += other.PipelineBindsElided;
+            DescriptorSetBinds       += other.DescriptorSetBinds;
+            DescriptorSetBindsElided += other.DescriptorSetBindsElided;
+            VertexBufferBinds        += other.VertexBufferBinds;
+            VertexBufferBindsElided  += other.VertexBufferBindsElided;
+            IndexBufferBinds         += other.IndexBufferBinds;
+            IndexBufferBindsElided   += other.IndexBufferBindsElided;
+            PushConstants            += other.PushConstants;
+            PushConstantsElided      += other.PushConstantsElided;
+
+            return *this;
+        }
+    };
+
+
+    /**
+     * @brief Records graphics state into a command buffer and skips the calls that would not change it.
+     *
+     * Tracks the bound pipeline, descriptor sets, vertex and index buffers and the last push constant contents, so
+     * callers can bind everything they need for every draw and only the changes reach the command buffer.
+     *
+     * Descriptor sets and push constants are only compared while they were bound with the same pipeline layout, a
+     * different layout forgets them (a compatible layout would keep them valid, they are just bound again).
+     *
+     * @note Commands recorded into the buffer without the context are not seen by it, call `invalidate` afterwards.
+     */
+    class VyCommandContext
+    {
+    public:
+        explicit VyCommandContext(VkCommandBuffer commandBuffer) :
+            m_CommandBuffer{ commandBuffer }
+        {
+        }
+
+        VyCommandContext(const VyCommandContext&)            = delete;
+        VyCommandContext& operator=(const VyCommandContext&) = delete;
+
+        VY_NODISCARD VkCommandBuffer commandBuffer() const { return m_CommandBuffer; }
+
+        void bindPipeline(const VyPipeline& pipeline);
+
+        /**
+         * @brief Binds a descriptor set. Sets with dynamic offsets are always bound.
+         */
+        void bindDescriptorSet(
+            const VyPipeline& pipeline,
+            U32               setIndex,
+            VkDescriptorSet   descriptorSet,
+            U32               dynamicOffsetCount = 0,
+            const U32*        pDynamicOffsets    = nullptr
+        );
+
+        /**
+         * @brief Binds consecutive descriptor sets starting at `firstSet`, skipping the call if all of them are bound.
+         */
+        void bindDescriptorSets(
+            const VyPipeline&            pipeline,
+            U32                          firstSet,
+            TSpan<const VkDescriptorSet> descriptorSets
+        );
+
+        void bindVertexBuffer(U32 binding, VkBuffer buffer, VkDeviceSize offset = 0);
+
+        void bindIndexBuffer(VkBuffer buffer, VkDeviceSize offset, VkIndexType indexType);
+
+        void pushConstants(
+            const VyPipeline&  pipeline,
+            VkShaderStageFlags stageFlags,
+            const void*        pData,
+            U32                size,
+            U32                offset = 0
+        );
+
+        template <typename T>
+        void pushConstants(const VyPipeline& pipeline, VkShaderStageFlags stageFlags, const T& data)
+        {
+            pushConstants(pipeline, stageFlags, &data, sizeof(T));
+        }
+
+        /**
+         * @brief Forgets all tracked state, the next bind of everything is recorded.
+         */
+        void invalidate();
+
+        VY_NODISCARD const VyCommandStats& stats() const { return m_Stats; }
+
+    private:
+        static constexpr U32 kMaxDescriptorSets    = 8;
+        static constexpr U32 kMaxVertexBindings    = 4;
+        static constexpr U32 kMaxPushConstantBytes = 256;
+
+        /**
+         * @brief Forgets the sets bound with another layout before sets of `layout` are bound.
+         */
+        void useSetLayout(VkPipelineLayout layout);
+
+        VkCommandBuffer m_CommandBuffer;
+
+        VkPipeline       m_Pipeline { VK_NULL_HANDLE };
+
+        VkPipelineLayout                            m_SetLayout{ VK_NULL_HANDLE }; // Layout the tracked sets were bound with.
+        TArray<VkDescriptorSet, kMaxDescriptorSets> m_Sets     {};
+
+        TArray<VkBuffer,     kMaxVertexBindings>    m_VertexBuffers{};
+        TArray<VkDeviceSize, kMaxVertexBindings>    m_VertexOffsets{};
+
+        VkBuffer     m_IndexBuffer{ VK_NULL_HANDLE };
+        VkDeviceSize m_IndexOffset{ 0 };
+        VkIndexType  m_IndexType  { VK_INDEX_TYPE_UINT32 };
+
+        // Last push: the bytes [offset, offset + size) for the stages, valid for the layout only.
+        VkPipelineLayout                  m_PushLayout{ VK_NULL_HANDLE };
+        VkShaderStageFlags                m_PushStages{ 0 };
+        U32                               m_PushOffset{ 0 };
+        U32                               m_PushSize  { 0 };
+        TArray<U8, kMaxPushConstantBytes> m_PushData  {};
+
+        VyCommandStats m_Stats{};
+    };
+}
@@ -63,14 +63,14 @@ namespace Vy
 	Unique<VyDescriptorSetLayout> 
 	VyDescriptorSetLayout::Builder::buildUnique() const
 	{
-		return std::make_unique<VyDescriptorSetLayout>(m_Bindings);
+		return std::make_unique<VyDescriptorSetLayout>(m_Bindings, m_BindingFlags, m_LayoutFlags);
 	}
 
 
 	VyDescriptorSetLayout 
 	VyDescriptorSetLayout::Builder::build() const
 	{
-		return VyDescriptorSetLayout{ m_Bindings };
+		return VyDescriptorSetLayout{ m_Bindings, m_BindingFlags, m_LayoutFlags };
 	}
 
 #pragma endregion [ Set Layout Builder ]
@@ -85,6 +85,25 @@ namespace Vy
             return write(binding, pImagesInfo, count);
         }
 
+        /**
+         * @brief Writes a single image descriptor into one element of an array binding.
+         * 
+         * Used for bindless arrays, where only the changed elements are written.
+         * 
+         * @param binding      The binding index.
+         * @param arrayElement The element of the binding's array to write.
+         * @param pImageInfo   Pointer to the image descriptor info.
+         * 
+         * @return Reference to the VyDescriptorWriter instance.
+         */
+        VyDescriptorWriter& writeImageElement(
+            BindingIndex           binding, 
+            U32                    arrayElement,
+            VkDescriptorImageInfo* pImageInfo) 
+        {
+            return write(binding, pImageInfo, 1, arrayElement, true);
+        }
+
 		/**
 		 * @brief Writes a single acceleration structure descriptor to the specified binding.
 		 *
@@ -127,7 +146,7 @@ namespace Vy
          * @return Reference to the VyDescriptorWriter instance.
          */
         template <typename T>
-        VyDescriptorWriter& write(U32 binding, T* pInfo, U32 count) 
+        VyDescriptorWriter& write(U32 binding, T* pInfo, U32 count, U32 arrayElement = 0, bool bPartial = false) 
         {
 			size_t bindingCount = m_SetLayout.m_Bindings.count(binding);
 
@@ -135,12 +154,14 @@ namespace Vy
             
             auto& bindingDescription = m_SetLayout.m_Bindings[binding];
             
-            VY_ASSERT(bindingDescription.descriptorCount == count, "Binding descriptor info count mismatch");
+            VY_ASSERT(bPartial ? arrayElement + count <= bindingDescription.descriptorCount : bindingDescription.descriptorCount == count, 
+                "Binding descriptor info count mismatch");
             
             VkWriteDescriptorSet write{ VKInit::writeDescriptorSet() };
             {
                 write.descriptorType  = bindingDescription.descriptorType;
                 write.dstBinding      = binding;
+                write.dstArrayElement = arrayElement;
                 write.descriptorCount = count;
                 
                 if constexpr (std::is_same_v<T, VkDescriptorBufferInfo>) 
@@ -137,9 +137,16 @@ namespace Vy
 
     void VyDevice::initialize(VyWindow& window)
     {
+        m_Headless = window.isHeadless();
+
         createInstance();
         setupDebugMessenger();
-        createSurface(window);
+
+        if (!m_Headless)
+        {
+            createSurface(window);
+        }
+
         pickPhysicalDevice();
         createLogicalDevice();
         createAllocator();
@@ -160,7 +167,10 @@ namespace Vy
             DestroyDebugUtilsMessengerEXT(m_Instance, m_DebugMessenger, nullptr);
         }
 
-        vkDestroySurfaceKHR(m_Instance, m_Surface, nullptr);
+        if (m_Surface != VK_NULL_HANDLE)
+        {
+            vkDestroySurfaceKHR(m_Instance, m_Surface, nullptr);
+        }
 		
         vkDestroyInstance(m_Instance, nullptr);
     }
@@ -196,7 +206,10 @@ namespace Vy
 		auto instanceIxtensions{ queryRequiredInstanceExtensions() };
 
 #ifdef VY_DEBUG_MODE
-		displayGflwRequiredInstanceExtensions();
+		if (!m_Headless)
+		{
+			displayGflwRequiredInstanceExtensions();
+		}
 #endif
 
 		VkInstanceCreateInfo createInfo{ VKInit::instanceCreateInfo() };
@@ -265,6 +278,13 @@ namespace Vy
 				continue;
 			}
 
+			// Nothing is presented in headless mode, any device that can render is suitable.
+			if (m_Headless)
+			{
+				m_PhysicalDevice = device;
+				break;
+			}
+
 			SwapchainSupportDetails swapchainSupport = querySwapchainSupport(device);
 
 			if (swapchainSupport.Formats.empty()      || 
@@ -310,6 +330,11 @@ namespace Vy
             indices.PresentFamily .value()
         };
 
+		if (indices.TransferFamily.has_value())
+		{
+			uniqueQueueFamilies.insert(indices.TransferFamily.value());
+		}
+
 		float queuePriority = 1.0f;
 
 		for (U32 queueFamily : uniqueQueueFamilies)
@@ -324,7 +349,7 @@ namespace Vy
 			queueCreateInfos.push_back(queueCreateInfo);
 		}
 
-        TVector<CString> enabledExtensions( kDeviceExtensions.begin(), kDeviceExtensions.end() );
+        TVector<CString> enabledExtensions = queryRequiredDeviceExtensions();
 
 		enabledExtensions.push_back( VK_EXT_MESH_SHADER_EXTENSION_NAME );
 
@@ -340,6 +365,36 @@ namespace Vy
 
 		// Features
 
+		// Indirect drawing ( GPU-Driven Rendering ), optional.
+		{
+			VkPhysicalDeviceVulkan12Features vk12Supported{};
+			{
+				vk12Supported.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+			}
+
+			VkPhysicalDeviceFeatures2 supported{};
+			{
+				supported.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+				supported.pNext = &vk12Supported;
+			}
+
+			vkGetPhysicalDeviceFeatures2(m_PhysicalDevice, &supported);
+
+			m_DrawIndirectCountSupported = 
+				vk12Supported.drawIndirectCount              == VK_TRUE &&
+				supported.features.multiDrawIndirect         == VK_TRUE &&
+				supported.features.drawIndirectFirstInstance == VK_TRUE;
+		}
+
+		// Vulkan 1.1 Features ( Multiview, required since 1.1 )
+		VkPhysicalDeviceVulkan11Features vk11Features{};
+		{
+			vk11Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_1_FEATURES;
+
+			// Renders the six faces of a cube shadow map in one pass.
+			vk11Features.multiview = VK_TRUE;
+		}
+
 		// Vulkan 1.2 Features ( Bindless Rendering / Descriptor Indexing Features )
 		VkPhysicalDeviceVulkan12Features vk12Features{};
 		{
@@ -356,11 +411,18 @@ namespace Vy
 			// This is useful for situations where you don't need to bind all resources in a descriptor set.
 			vk12Features.descriptorBindingPartiallyBound            = VK_TRUE;
 			vk12Features.descriptorBindingVariableDescriptorCount   = VK_TRUE;
+			// Bindless material textures: new texture slots are written while the set is bound by frames in flight.
+			vk12Features.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+			vk12Features.descriptorBindingUpdateUnusedWhilePending    = VK_TRUE;
 			// This enables runtime-sized descriptor arrays, 
 			// which means that the size of descriptor arrays can be determined dynamically at runtime.
 			vk12Features.runtimeDescriptorArray                     = VK_TRUE;
 			vk12Features.scalarBlockLayout                          = VK_TRUE;
 			vk12Features.bufferDeviceAddress                        = VK_TRUE;
+			// vkCmdDrawIndexedIndirectCount
+			vk12Features.drawIndirectCount                          = m_DrawIndirectCountSupported ? VK_TRUE : VK_FALSE;
+			// Upload completion tokens ( VyUploadManager ).
+			vk12Features.timelineSemaphore                          = VK_TRUE;
 		}
 
 		// Vulkan 1.3 Features ( Dynamic Rendering )
@@ -409,7 +471,8 @@ namespace Vy
 		
 		m_PresentIdSupported = false;
 
-		if (presentIdExtensionAvailable)
+		// Present IDs are only used with a swapchain.
+		if (presentIdExtensionAvailable && !m_Headless)
 		{
 			VkPhysicalDeviceFeatures2 features2{}; 
 			{
@@ -440,9 +503,10 @@ namespace Vy
 			presentIdFeaturesEnable.presentId = VK_TRUE;
 		}
 
-		// Set up pNext chain: presentId (if supported) -> meshShaderFeatures -> vk12Features
+		// Set up pNext chain: presentId (if supported) -> meshShaderFeatures -> vk12Features -> vk11Features
 
-		vk12Features.pNext         = nullptr;               // Chain end
+		vk11Features.pNext         = nullptr;               // Chain end
+		vk12Features.pNext         = &vk11Features;         // Chain to vk11Features
 		vk13Features.pNext         = &vk12Features;         // Chain to vk12Features
 		maintenance4Features.pNext = &vk12Features;         // Chain to vk12Features
 		bdaFeatures.pNext          = &maintenance4Features; // Chain to maintenance4Features
@@ -465,6 +529,10 @@ namespace Vy
 			// Enable fill mode non solid for wireframe support
 			deviceFeatures.fillModeNonSolid   = VK_TRUE;
 			deviceFeatures.robustBufferAccess = VK_TRUE;
+
+			// Indirect draws with more than one command and a non-zero first instance.
+			deviceFeatures.multiDrawIndirect         = m_DrawIndirectCountSupported ? VK_TRUE : VK_FALSE;
+			deviceFeatures.drawIndirectFirstInstance = m_DrawIndirectCountSupported ? VK_TRUE : VK_FALSE;
 		}
 
 
@@ -514,6 +582,13 @@ namespace Vy
 		vkGetDeviceQueue(m_Device, indices.GraphicsFamily.value(), 0, &m_GraphicsQueue);
 		vkGetDeviceQueue(m_Device, indices.PresentFamily .value(), 0, &m_PresentQueue );
 		vkGetDeviceQueue(m_Device, indices.ComputeFamily .value(), 0, &m_ComputeQueue );
+
+		m_GraphicsFamily = indices.GraphicsFamily.value();
+		m_TransferFamily = indices.TransferFamily.value_or(m_GraphicsFamily);
+
+		vkGetDeviceQueue(m_Device, m_TransferFamily, 0, &m_TransferQueue);
+
+		VY_INFO_TAG("VyDevice", "Transfer queue: {}", hasDedicatedTransferQueue() ? "dedicated" : "graphics");
 	}
 
 	// --------------------------------------------------------------------------------------------
@@ -633,8 +708,33 @@ namespace Vy
     }
 
     
+	TVector<CString> VyDevice::queryRequiredDeviceExtensions() const
+	{
+		TVector<CString> extensions( kDeviceExtensions.begin(), kDeviceExtensions.end() );
+
+		if (!m_Headless)
+		{
+			extensions.push_back(VK_KHR_SWAPCHAIN_EXTENSION_NAME);
+		}
+
+		return extensions;
+	}
+
+
 	TVector<CString> VyDevice::queryRequiredInstanceExtensions() const
 	{
+		if (m_Headless)
+		{
+			TVector<CString> extensions;
+
+			if constexpr (kEnableValidationLayers)
+			{
+				extensions.emplace_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
+			}
+
+			return extensions;
+		}
+
 		U32 glfwExtensionCount{};
 		CString* glfwExtensions{ glfwGetRequiredInstanceExtensions(&glfwExtensionCount) };
 
@@ -701,7 +801,9 @@ namespace Vy
     {
 		auto availableExtensions = queryDeviceExtensionProperties(device);
 
-		TSet<String> requiredExtensions( kDeviceExtensions.begin(), kDeviceExtensions.end() );
+		const TVector<CString> required = queryRequiredDeviceExtensions();
+
+		TSet<String> requiredExtensions( required.begin(), required.end() );
 
 		for (const auto& extension : availableExtensions)
 		{
@@ -717,9 +819,15 @@ namespace Vy
 		VkPhysicalDeviceFeatures supportedFeatures;
 		vkGetPhysicalDeviceFeatures(device, &supportedFeatures);
 
+		VkPhysicalDeviceVulkan11Features vk11Features{};
+		{
+			vk11Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_1_FEATURES;
+		}
+
 		VkPhysicalDeviceVulkan12Features vk12Features{};
 		{
 			vk12Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+			vk12Features.pNext = &vk11Features;
 		}
 
 		VkPhysicalDeviceFeatures2 features2{};
@@ -753,6 +861,12 @@ namespace Vy
 			return false;
 		}
 
+		// Multiview Support (single pass cube shadow maps)
+		if (!vk11Features.multiview)
+		{
+			return false;
+		}
+
 		// TODO: check for more features (dynamic rendering, mesh shaders, etc.)
 
 		return true;
@@ -785,12 +899,24 @@ namespace Vy
 			}
 
 			// Present
-			VkBool32 presentSupport = false;
-			vkGetPhysicalDeviceSurfaceSupportKHR(device, i, m_Surface, &presentSupport);
-			
-			if (queueFamily.queueCount > 0 && presentSupport)
+			if (m_Headless)
 			{
-				indices.PresentFamily = i;
+				// There is no surface to present to, alias the graphics family so the 
+				// present queue handle stays valid for code that submits to it.
+				if (indices.GraphicsFamily.has_value())
+				{
+					indices.PresentFamily = indices.GraphicsFamily;
+				}
+			}
+			else
+			{
+				VkBool32 presentSupport = false;
+				vkGetPhysicalDeviceSurfaceSupportKHR(device, i, m_Surface, &presentSupport);
+				
+				if (queueFamily.queueCount > 0 && presentSupport)
+				{
+					indices.PresentFamily = i;
+				}
 			}
 
 			if (indices.isComplete())
@@ -801,6 +927,20 @@ namespace Vy
 			i++;
 		}
 
+		// Transfer, optional: a family that only supports transfers is usually backed by a dedicated DMA engine.
+		for (U32 family = 0; family < queueFamilyCount; family++)
+		{
+			const VkQueueFlags flags = queueFamilies[ family ].queueFlags;
+
+			if (queueFamilies[ family ].queueCount > 0 && 
+				(flags & VK_QUEUE_TRANSFER_BIT) && 
+			   !(flags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT)))
+			{
+				indices.TransferFamily = family;
+				break;
+			}
+		}
+
 		return indices;
 	}
 
@@ -986,15 +1126,34 @@ namespace Vy
 	{
 		vkEndCommandBuffer(cmdBuffer);
 
+		// The commands may use resources the upload manager is still writing.
+		const auto uploadWait = VyContext::uploader().graphicsWait();
+
+		VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+
+		VkTimelineSemaphoreSubmitInfo timelineInfo{ VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO };
+		{
+			timelineInfo.waitSemaphoreValueCount = 1;
+			timelineInfo.pWaitSemaphoreValues    = &uploadWait.Value;
+		}
+
 		VkSubmitInfo submitInfo{ VKInit::submitInfo() };
 		{
+			submitInfo.pNext              = &timelineInfo;
+			submitInfo.waitSemaphoreCount = 1;
+			submitInfo.pWaitSemaphores    = &uploadWait.Semaphore;
+			submitInfo.pWaitDstStageMask  = &waitStage;
 			submitInfo.commandBufferCount = 1;
 			submitInfo.pCommandBuffers    = &cmdBuffer;
 		}
 
-		vkQueueSubmit(m_GraphicsQueue, 1, &submitInfo, VK_NULL_HANDLE);
+		{
+			LockGuard<Mutex> lock{ m_QueueMutex };
 
-		vkQueueWaitIdle(m_GraphicsQueue);
+			vkQueueSubmit(m_GraphicsQueue, 1, &submitInfo, VK_NULL_HANDLE);
+
+			vkQueueWaitIdle(m_GraphicsQueue);
+		}
 
 		vkFreeCommandBuffers(m_Device, m_CommandPool, 1, &cmdBuffer);
 	}
@@ -5,6 +5,8 @@
 
 #include <Vy/Core/Window.h>
 
+#include <VyLib/STL/Mutex.h>
+
 namespace Vy
 {
 
@@ -27,7 +29,7 @@ namespace Vy
 	public:
 		static constexpr U32  kAPIVersion       = VK_API_VERSION_1_3;
 		static constexpr auto kValidationLayers = std::array{ "VK_LAYER_KHRONOS_validation"   };
-		static constexpr auto kDeviceExtensions = std::array{ VK_KHR_SWAPCHAIN_EXTENSION_NAME, VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME };
+		static constexpr auto kDeviceExtensions = std::array{ VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME }; // + VK_KHR_swapchain unless headless.
 
  		VyDevice(const VyDevice&) = delete;
 		 VyDevice(VyDevice&&)     = delete;
@@ -47,10 +49,25 @@ namespace Vy
         VY_NODISCARD       VkQueue                     graphicsQueue()        const { return m_GraphicsQueue; }
         VY_NODISCARD       VkQueue                     presentQueue()         const { return m_PresentQueue; }
 		VY_NODISCARD       VkQueue                     computeQueue()         const { return m_ComputeQueue; }
+		VY_NODISCARD       VkQueue                     transferQueue()        const { return m_TransferQueue; }
+		VY_NODISCARD       U32                         graphicsFamily()       const { return m_GraphicsFamily; }
+		VY_NODISCARD       U32                         transferFamily()       const { return m_TransferFamily; }
+		VY_NODISCARD       bool                        hasDedicatedTransferQueue() const { return m_TransferFamily != m_GraphicsFamily; }
 		VY_NODISCARD const VkPhysicalDeviceProperties& properties()           const { return m_Properties; }
 		VY_NODISCARD const VKFeatures&                 features()             const { return m_Features; }
 		VY_NODISCARD       VkSampleCountFlagBits       supportedSampleCount()       { return m_MsaaSamples; }
 		VY_NODISCARD       bool                        supportsPresentId()    const { return m_PresentIdSupported; }
+		VY_NODISCARD       bool                        supportsDrawIndirectCount() const { return m_DrawIndirectCountSupported; }
+		VY_NODISCARD       bool                        isHeadless()           const { return m_Headless; }
+
+		/**
+		 * @brief Lock that externally synchronizes the queues of the device.
+		 *
+		 * The render thread and uploads started on other threads submit to the same queues (the transfer and present
+		 * queues may be the graphics queue), so every vkQueueSubmit, vkQueuePresentKHR, vkQueueWaitIdle and
+		 * vkDeviceWaitIdle holds it.
+		 */
+		VY_NODISCARD       Mutex&                      queueMutex()           const { return m_QueueMutex; }
 
 		/** 
 		 * @brief Initializes the Vulkan device and related resources.
@@ -58,6 +75,7 @@ namespace Vy
 		 * @note Called from 'VyContext::initialize(VyWindow& window)'.
 		 * 
 		 * @param window The VyWindow instance used to create the Vulkan surface.
+		 *               If the window is headless no surface is created and no present support is required.
 		 */
 		void initialize(VyWindow& window);
 
@@ -499,6 +517,14 @@ namespace Vy
          */
 		TVector<CString> queryRequiredInstanceExtensions() const;
 
+        /**
+         * @brief Gets the device extensions a physical device must support.
+         *
+         * `kDeviceExtensions`, and the swapchain extension unless headless, so offscreen and compute only devices
+         * are accepted in headless mode.
+         */
+		TVector<CString> queryRequiredDeviceExtensions() const;
+
         /**
          * @brief Checks if the required GLFW extensions are supported.
          *
@@ -618,10 +644,18 @@ namespace Vy
 		VkQueue		m_GraphicsQueue	{ VK_NULL_HANDLE };
 		VkQueue		m_PresentQueue	{ VK_NULL_HANDLE };
 		VkQueue		m_ComputeQueue	{ VK_NULL_HANDLE };
+		VkQueue		m_TransferQueue	{ VK_NULL_HANDLE }; // The graphics queue if there is no dedicated transfer family.
+
+		U32			m_GraphicsFamily{ 0 };
+		U32			m_TransferFamily{ 0 };
 
 		VkSampleCountFlagBits m_MsaaSamples = VK_SAMPLE_COUNT_1_BIT;
 
-		bool m_PresentIdSupported = false;
+		bool m_PresentIdSupported         = false;
+		bool m_DrawIndirectCountSupported = false;
+		bool m_Headless                   = false;
+
+		mutable Mutex m_QueueMutex;
     };
 }
 
@@ -225,6 +225,11 @@ namespace Vy
 		void generateMipmaps(VkCommandBuffer cmdBuffer, VkImageLayout finalLayout);
 		void generateMipmaps(VkImageLayout finalLayout);
 
+		/**
+		 * @brief Updates the tracked layout after a transition recorded outside of VyImage (e.g. a queue ownership transfer).
+		 */
+		void setLayout(VkImageLayout layout) { m_Layout = layout; }
+
 		void setName(const String& name) const;
 
 	private:
@@ -0,0 +1,122 @@
+#include <Vy/GFX/Backend/ParallelRecorder.h>
+
+#include <Vy/GFX/Context.h>
+
+namespace Vy
+{
+    VyParallelRecorder::~VyParallelRecorder()
+    {
+        for (auto& [ id, threadPools ] : m_Threads)
+        {
+            // Destroying a pool frees its command buffers.
+            for (VkCommandPool pool : threadPools->Pools)
+            {
+                vkDestroyCommandPool(VyContext::device(), pool, nullptr);
+            }
+        }
+    }
+
+
+    void VyParallelRecorder::beginFrame(int frameIndex)
+    {
+        LockGuard<Mutex> lock(m_Mutex);
+
+        for (auto& [ id, threadPools ] : m_Threads)
+        {
+            if (threadPools->Used[ frameIndex ] == 0)
+            {
+                continue;
+            }
+
+            VK_CHECK(vkResetCommandPool(VyContext::device(), threadPools->Pools[ frameIndex ], 0));
+
+            threadPools->Used[ frameIndex ] = 0;
+        }
+    }
+
+
+    VkCommandBuffer VyParallelRecorder::begin(int frameIndex, const VyRecordingPass& pass)
+    {
+        ThreadPools& pools = threadPools();
+
+        TVector<VkCommandBuffer>& buffers = pools.Buffers[ frameIndex ];
+        U32&                      used    = pools.Used   [ frameIndex ];
+
+        if (used == buffers.size())
+        {
+            VkCommandBufferAllocateInfo allocInfo{ VKInit::commandBufferAllocateInfo() };
+            {
+                allocInfo.level              = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+                allocInfo.commandPool        = pools.Pools[ frameIndex ];
+                allocInfo.commandBufferCount = 1;
+            }
+
+            VK_CHECK(vkAllocateCommandBuffers(VyContext::device(), &allocInfo, &buffers.emplace_back()));
+        }
+
+        VkCommandBuffer commandBuffer = buffers[ used++ ];
+
+        VkCommandBufferInheritanceInfo inheritanceInfo{ VKInit::commandBufferInheritanceInfo() };
+        {
+            inheritanceInfo.renderPass  = pass.RenderPass;
+            inheritanceInfo.subpass     = pass.Subpass;
+            inheritanceInfo.framebuffer = pass.Framebuffer;
+        }
+
+        VkCommandBufferBeginInfo beginInfo{ VKInit::commandBufferBeginInfo() };
+        {
+            beginInfo.flags            = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+            beginInfo.pInheritanceInfo = &inheritanceInfo;
+        }
+
+        VK_CHECK(vkBeginCommandBuffer(commandBuffer, &beginInfo));
+
+        const VkRect2D area{ pass.Offset, pass.Extent };
+
+        VKCmd::viewport(commandBuffer, area);
+        VKCmd::scissor (commandBuffer, area);
+
+        return commandBuffer;
+    }
+
+
+    void VyParallelRecorder::end(VkCommandBuffer commandBuffer)
+    {
+        VK_CHECK(vkEndCommandBuffer(commandBuffer));
+    }
+
+
+    U32 VyParallelRecorder::chunkCount(U32 itemCount, U32 minItemsPerChunk) const
+    {
+        // A few chunks per thread so uneven chunks still balance, but never chunks smaller than the minimum.
+        const U32 maxChunks = (VyJobSystem::shared().workerCount() + 1) * 2;
+
+        return std::clamp(itemCount / std::max(minItemsPerChunk, 1u), 1u, maxChunks);
+    }
+
+
+    VyParallelRecorder::ThreadPools& VyParallelRecorder::threadPools()
+    {
+        LockGuard<Mutex> lock(m_Mutex);
+
+        Unique<ThreadPools>& threadPools = m_Threads[ std::this_thread::get_id() ];
+
+        if (!threadPools)
+        {
+            threadPools = MakeUnique<ThreadPools>();
+
+            VkCommandPoolCreateInfo poolInfo{ VKInit::commandPoolCreateInfo() };
+            {
+                poolInfo.queueFamilyIndex = VyContext::device().graphicsFamily();
+                poolInfo.flags            = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+            }
+
+            for (VkCommandPool& pool : threadPools->Pools)
+            {
+                VK_CHECK(vkCreateCommandPool(VyContext::device(), &poolInfo, nullptr, &pool));
+            }
+        }
+
+        return *threadPools;
+    }
+}
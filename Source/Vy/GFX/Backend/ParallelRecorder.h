@@ -0,0 +1,141 @@
+#pragma once
+
+#include <Vy/GFX/Backend/Device.h>
+
+#include <VyLib/Util/JobSystem.h>
+
+#include <thread>
+
+namespace Vy
+{
+    /**
+     * @brief Render pass subpass that secondary command buffers are recorded for.
+     */
+    struct VyRecordingPass
+    {
+        VkRenderPass  RenderPass { VK_NULL_HANDLE };
+        U32           Subpass    { 0 };
+        VkFramebuffer Framebuffer{ VK_NULL_HANDLE }; // Optional, lets the driver optimize for the framebuffer.
+        VkExtent2D    Extent     { 0, 0 };           // Viewport and scissor, secondaries do not inherit dynamic state.
+        VkOffset2D    Offset     { 0, 0 };           // Of the viewport and scissor, for passes into a region (atlas tiles).
+    };
+
+    /**
+     * @brief Records draw lists in parallel into secondary command buffers.
+     *
+     * Every thread that records gets its own command pool per frame in flight, created on first use, so recording
+     * never synchronizes on a pool. The pools of a frame are reset as a whole by `beginFrame` and their command
+     * buffers are reused, nothing is freed per frame.
+     *
+     * The caller begins the render pass with `VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS` and executes the
+     * recorded buffers in order with `vkCmdExecuteCommands`.
+     *
+     * @code
+     * recorder.record(frameIndex, pass, drawCount, 64, commandBuffers, [&](VkCommandBuffer cmd, U32 chunk, U32 begin, U32 end)
+     * {
+     *     ... // Bind the pipeline and record draws [begin, end).
+     * });
+     *
+     * vkCmdExecuteCommands(primary, commandBuffers.size(), commandBuffers.data());
+     * @endcode
+     */
+    class VyParallelRecorder
+    {
+    public:
+        VyParallelRecorder() = default;
+
+        ~VyParallelRecorder();
+
+        VyParallelRecorder(const VyParallelRecorder&)            = delete;
+        VyParallelRecorder& operator=(const VyParallelRecorder&) = delete;
+
+        /**
+         * @brief Resets the command pools of a frame. Its previous submission must have completed.
+         */
+        void beginFrame(int frameIndex);
+
+        /**
+         * @brief Begins a secondary command buffer of the calling thread for the pass, with viewport and scissor set.
+         */
+        VY_NODISCARD VkCommandBuffer begin(int frameIndex, const VyRecordingPass& pass);
+
+        void end(VkCommandBuffer commandBuffer);
+
+        /**
+         * @brief Number of chunks `record` splits `itemCount` items into.
+         */
+        VY_NODISCARD U32 chunkCount(U32 itemCount, U32 minItemsPerChunk) const;
+
+        /**
+         * @brief Splits [0, itemCount) into chunks and records them on the job system.
+         *
+         * Calls `function(commandBuffer, chunk, begin, end)` once per chunk with a begun secondary command buffer and
+         * appends the buffers to `commandBuffers` in chunk order.
+         */
+        template <typename F>
+        void record(
+            int                       frameIndex,
+            const VyRecordingPass&    pass,
+            U32                       itemCount,
+            U32                       minItemsPerChunk,
+            TVector<VkCommandBuffer>& commandBuffers,
+            F&&                       function
+        );
+
+    private:
+        struct ThreadPools
+        {
+            TArray<VkCommandPool,            MAX_FRAMES_IN_FLIGHT> Pools{};
+            TArray<TVector<VkCommandBuffer>, MAX_FRAMES_IN_FLIGHT> Buffers;
+            TArray<U32,                      MAX_FRAMES_IN_FLIGHT> Used{}; // Buffers handed out since the last reset.
+        };
+
+        /**
+         * @brief Pools of the calling thread, created on first use.
+         */
+        ThreadPools& threadPools();
+
+        Mutex                                          m_Mutex; // Guards m_Threads, not the pools themselves.
+        THashMap<std::thread::id, Unique<ThreadPools>> m_Threads;
+    };
+
+    // ============================================================================================
+
+    template <typename F>
+    void VyParallelRecorder::record(
+        int                       frameIndex,
+        const VyRecordingPass&    pass,
+        U32                       itemCount,
+        U32                       minItemsPerChunk,
+        TVector<VkCommandBuffer>& commandBuffers,
+        F&&                       function)
+    {
+        if (itemCount == 0)
+        {
+            return;
+        }
+
+        const U32    chunks    = chunkCount(itemCount, minItemsPerChunk);
+        const U32    chunkSize = (itemCount + chunks - 1) / chunks;
+        const size_t first     = commandBuffers.size();
+
+        commandBuffers.resize(first + chunks, VK_NULL_HANDLE);
+
+        VyJobSystem::shared().parallelFor(chunks, 1, [&](U32 chunkBegin, U32 chunkEnd)
+        {
+            for (U32 chunk = chunkBegin; chunk < chunkEnd; chunk++)
+            {
+                const U32 begin = chunk * chunkSize;
+                const U32 end   = std::min(begin + chunkSize, itemCount);
+
+                VkCommandBuffer commandBuffer = this->begin(frameIndex, pass);
+
+                function(commandBuffer, chunk, begin, end);
+
+                this->end(commandBuffer);
+
+                commandBuffers[ first + chunk ] = commandBuffer;
+            }
+        });
+    }
+}
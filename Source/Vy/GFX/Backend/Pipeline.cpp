@@ -1,4 +1,5 @@
 #include <Vy/GFX/Backend/Pipeline.h>
+#include <Vy/GFX/Backend/Pipeline/PipelineCompiler.h>
 
 #include <Vy/GFX/Resources/StaticMesh.h>
 
@@ -143,6 +144,19 @@ namespace Vy
 	}
 
 
+	VyPipeline::GraphicsBuilder& 
+	VyPipeline::GraphicsBuilder::setColorBlendAttachment(
+		U32                                        attachment, 
+		const VkPipelineColorBlendAttachmentState& blendState)
+	{
+		VY_ASSERT(attachment < m_GraphicsConfig.ColorBlendAttachments.size(), "Color attachment must be added before its blend state");
+
+		m_GraphicsConfig.ColorBlendAttachments[attachment] = blendState;
+
+		return *this;
+	}
+
+
 	VyPipeline::GraphicsBuilder& 
 	VyPipeline::GraphicsBuilder::setDepthAttachment(VkFormat depthFormat)
 	{
@@ -293,6 +307,15 @@ namespace Vy
     }
 
 
+    VyPipeline::GraphicsBuilder& 
+    VyPipeline::GraphicsBuilder::setSubpass(U32 subpass)
+    {
+        m_GraphicsConfig.Subpass = subpass;
+
+        return *this;
+    }
+
+
     VyPipeline::GraphicsBuilder& 
     VyPipeline::GraphicsBuilder::addFlag(EFlags flag)
     {
@@ -305,6 +328,20 @@ namespace Vy
 	Unique<VyPipeline> 
 	VyPipeline::GraphicsBuilder::buildUnique()
 	{
+		if (VyPipelineCompiler* compiler = VyPipelineCompiler::current())
+		{
+			auto pipeline = MakeUnique<VyPipeline>();
+			{
+				pipeline->m_BindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+				pipeline->m_Flags     = m_GraphicsConfig.Flags;
+				pipeline->createPipelineLayout(m_LayoutConfig);
+			}
+
+			deferPipeline(*compiler, *pipeline);
+
+			return pipeline;
+		}
+
 		return MakeUnique<VyPipeline>(m_LayoutConfig, m_GraphicsConfig);
 	}
 
@@ -312,6 +349,19 @@ namespace Vy
 	Unique<VyPipeline> 
 	VyPipeline::GraphicsBuilder::buildUnique(VkPipelineLayout layout)
 	{
+		if (VyPipelineCompiler* compiler = VyPipelineCompiler::current())
+		{
+			auto pipeline = MakeUnique<VyPipeline>();
+			{
+				pipeline->m_BindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+				pipeline->m_Layout    = layout;
+			}
+
+			deferPipeline(*compiler, *pipeline);
+
+			return pipeline;
+		}
+
 		return MakeUnique<VyPipeline>(layout, m_GraphicsConfig);
 	}
 
@@ -341,6 +391,25 @@ namespace Vy
 		m_GraphicsConfig.ShaderStages.emplace_back(info);
 	}
 
+
+	void VyPipeline::GraphicsBuilder::deferPipeline(VyPipelineCompiler& compiler, VyPipeline& pipeline)
+	{
+		// The builder is gone by the time the pipeline is compiled, the job owns the config and destroys the modules.
+		auto config = MakeShared<GraphicsConfig>(std::move(m_GraphicsConfig));
+
+		m_GraphicsConfig.ShaderStages.clear();
+
+		compiler.enqueue([&pipeline, config](VkPipelineCache cache)
+		{
+			pipeline.createGraphicsPipeline(*config, cache);
+
+			for (auto& shaderStage : config->ShaderStages)
+			{
+				vkDestroyShaderModule(VyContext::device(), shaderStage.module, nullptr);
+			}
+		});
+	}
+
 #pragma endregion [ GraphicsBuilder ]
 
 // ================================================================================================
@@ -349,6 +418,11 @@ namespace Vy
 
 	VyPipeline::ComputeBuilder::~ComputeBuilder()
 	{
+		if (m_bDeferred)
+		{
+			return;
+		}
+
 		if (m_ComputeConfig.ShaderStage.module)
 		{
 			vkDestroyShaderModule(VyContext::device(), m_ComputeConfig.ShaderStage.module, nullptr);
@@ -407,6 +481,27 @@ namespace Vy
 	Unique<VyPipeline> 
 	VyPipeline::ComputeBuilder::buildUnique()
 	{
+		if (VyPipelineCompiler* compiler = VyPipelineCompiler::current())
+		{
+			auto pipeline = MakeUnique<VyPipeline>();
+			{
+				pipeline->m_BindPoint = VK_PIPELINE_BIND_POINT_COMPUTE;
+				pipeline->createPipelineLayout(m_LayoutConfig);
+			}
+
+			// The job owns the shader module from here on.
+			m_bDeferred = true;
+
+			compiler->enqueue([pipelinePtr = pipeline.get(), config = m_ComputeConfig](VkPipelineCache cache)
+			{
+				pipelinePtr->createComputePipeline(config, cache);
+
+				vkDestroyShaderModule(VyContext::device(), config.ShaderStage.module, nullptr);
+			});
+
+			return pipeline;
+		}
+
 		return MakeUnique<VyPipeline>(m_LayoutConfig, m_ComputeConfig);
 	}
 
@@ -431,7 +526,7 @@ namespace Vy
 		m_Flags    { graphicsConfig.Flags            }
     {
         createPipelineLayout(layoutConfig);
-        createGraphicsPipeline(graphicsConfig);
+        createGraphicsPipeline(graphicsConfig, VyContext::pipelineCache());
     }
 
 
@@ -442,7 +537,7 @@ namespace Vy
         m_BindPoint{ VK_PIPELINE_BIND_POINT_GRAPHICS },
 		m_Layout   { layout }
 	{
-		createGraphicsPipeline(graphicsConfig);
+		createGraphicsPipeline(graphicsConfig, VyContext::pipelineCache());
 	}
 
 
@@ -453,7 +548,7 @@ namespace Vy
         m_BindPoint{ VK_PIPELINE_BIND_POINT_COMPUTE }
     {
         createPipelineLayout(layoutConfig);
-        createComputePipeline(computeConfig);
+        createComputePipeline(computeConfig, VyContext::pipelineCache());
     }
 
 
@@ -495,6 +590,8 @@ namespace Vy
 
     void VyPipeline::bind(VkCommandBuffer cmdBuffer) const
     {
+		VY_ASSERT(m_Pipeline != VK_NULL_HANDLE, "Pipeline is not compiled yet (queued on a VyPipelineCompiler?)");
+
         vkCmdBindPipeline(cmdBuffer, m_BindPoint, m_Pipeline);
     }
 
@@ -520,11 +617,11 @@ namespace Vy
 
 
 	void VyPipeline::bindDescriptorSets(
-		VkCommandBuffer          cmdBuffer, 
-		SetIndex                 setIndex, 
-		TVector<VkDescriptorSet> descriptorSets,
-		U32                      dynamicOffsetCount,
-		const U32*               pDynamicOffsets
+		VkCommandBuffer              cmdBuffer, 
+		SetIndex                     setIndex, 
+		TSpan<const VkDescriptorSet> descriptorSets,
+		U32                          dynamicOffsetCount,
+		const U32*                   pDynamicOffsets
 	) const
 	{
 		vkCmdBindDescriptorSets(cmdBuffer, 
@@ -565,7 +662,7 @@ namespace Vy
 	}
 
 
-	void VyPipeline::createGraphicsPipeline(const VyPipeline::GraphicsConfig& config)
+	void VyPipeline::createGraphicsPipeline(const VyPipeline::GraphicsConfig& config, VkPipelineCache cache)
 	{
         VY_ASSERT(config.RenderPass != VK_NULL_HANDLE,
             "Cannot create graphics pipeline: no RenderPass provided in config"
@@ -610,11 +707,11 @@ namespace Vy
 			pipelineInfo.basePipelineIndex   = -1;
 		}
 
-		VK_CHECK(vkCreateGraphicsPipelines(VyContext::device(), VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &m_Pipeline));
+		VK_CHECK(vkCreateGraphicsPipelines(VyContext::device(), cache, 1, &pipelineInfo, nullptr, &m_Pipeline));
 	}
 
 
-	void VyPipeline::createComputePipeline(const VyPipeline::ComputeConfig& config)
+	void VyPipeline::createComputePipeline(const VyPipeline::ComputeConfig& config, VkPipelineCache cache)
 	{
 		VY_ASSERT(config.ShaderStage.module != VK_NULL_HANDLE, 
 			"Cannot create pipeline: no shader provided");
@@ -629,7 +726,7 @@ namespace Vy
 			pipelineInfo.basePipelineIndex  = -1;
 		}
 
-		VK_CHECK(vkCreateComputePipelines(VyContext::device(), VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &m_Pipeline));
+		VK_CHECK(vkCreateComputePipelines(VyContext::device(), cache, 1, &pipelineInfo, nullptr, &m_Pipeline));
 	}
 
 
@@ -4,6 +4,8 @@
 
 namespace Vy 
 {
+    class VyPipelineCompiler;
+
     class VyPipeline 
     {
     public:
@@ -41,6 +43,9 @@ namespace Vy
 			GraphicsConfig(const GraphicsConfig&)            = delete;
 			GraphicsConfig& operator=(const GraphicsConfig&) = delete;
 
+			// The state infos only point into the vectors' storage, which moves with them.
+			GraphicsConfig(GraphicsConfig&&)                 = default;
+
 			TVector<VkVertexInputBindingDescription>     BindingDescriptions   {};
 			TVector<VkVertexInputAttributeDescription>   AttributeDescriptions {};
 
@@ -108,6 +113,7 @@ namespace Vy
 
             // Color Blending
 			GraphicsBuilder& addColorAttachment(VkFormat colorFormat, bool alphaBlending = false);
+            GraphicsBuilder& setColorBlendAttachment(U32 attachment, const VkPipelineColorBlendAttachmentState& blendState);
 
             // Depth Stencil
             GraphicsBuilder& setDepthAttachment(VkFormat depthFormat);
@@ -120,9 +126,11 @@ namespace Vy
 
             // Other
             GraphicsBuilder& setRenderPass(VkRenderPass renderPass);
+            GraphicsBuilder& setSubpass(U32 subpass);
             GraphicsBuilder& addFlag(VyPipeline::EFlags flag);
 
             // Build
+            // With a VyPipelineCompiler active on the thread, buildUnique only creates the layout and queues the pipeline.
 			Unique<VyPipeline> buildUnique();
             Unique<VyPipeline> buildUnique(VkPipelineLayout layout);
 			VyPipeline         build();
@@ -130,6 +138,11 @@ namespace Vy
 		private:
 			void addShaderStage(VkShaderStageFlagBits stage, VkShaderModule shaderModule, const char* entryPoint);
 
+			/**
+			 * @brief Hands the config and its shader modules over to the compiler, which creates the pipeline later.
+			 */
+			void deferPipeline(VyPipelineCompiler& compiler, VyPipeline& pipeline);
+
 			LayoutConfig            m_LayoutConfig;
 			GraphicsConfig          m_GraphicsConfig;
 			TVector<VkShaderModule> m_ShaderModules;
@@ -168,12 +181,14 @@ namespace Vy
 
 			ComputeBuilder& setShaderStage(const Path& shaderPath, const char* entryPoint = "main");
 
+			// With a VyPipelineCompiler active on the thread, buildUnique only creates the layout and queues the pipeline.
 			Unique<VyPipeline> buildUnique();
 			VyPipeline         build();
 
 		private:
 			LayoutConfig  m_LayoutConfig;
 			ComputeConfig m_ComputeConfig;
+			bool          m_bDeferred{ false }; // The shader module was handed over to a VyPipelineCompiler.
 		};
 
         // ----------------------------------------------------------------------------------------
@@ -252,11 +267,11 @@ namespace Vy
          * @param pDynamicOffsets    (Optional) A pointer to an array of U32 values specifying dynamic offsets.
          */
 	    void bindDescriptorSets(
-            VkCommandBuffer          cmdBuffer, 
-            SetIndex                 setIndex, 
-            TVector<VkDescriptorSet> descriptorSets,
-            U32                      dynamicOffsetCount = 0,
-            const U32*               pDynamicOffsets    = nullptr
+            VkCommandBuffer              cmdBuffer, 
+            SetIndex                     setIndex, 
+            TSpan<const VkDescriptorSet> descriptorSets,
+            U32                          dynamicOffsetCount = 0,
+            const U32*                   pDynamicOffsets    = nullptr
         ) const;
 
         /** 
@@ -301,8 +316,8 @@ namespace Vy
 
 		void createPipelineLayout(const VyPipeline::LayoutConfig& config);
 
-        void createGraphicsPipeline(const VyPipeline::GraphicsConfig& config);
-        void createComputePipeline (const VyPipeline::ComputeConfig&  config);
+        void createGraphicsPipeline(const VyPipeline::GraphicsConfig& config, VkPipelineCache cache);
+        void createComputePipeline (const VyPipeline::ComputeConfig&  config, VkPipelineCache cache);
 
         void destroy();
 
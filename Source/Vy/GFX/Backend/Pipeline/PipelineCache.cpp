@@ -0,0 +1,144 @@
+#include <Vy/GFX/Backend/Pipeline/PipelineCache.h>
+
+#include <Vy/Core/File/FileSystem.hpp>
+
+#include <cstring>
+#include <fstream>
+
+namespace Vy
+{
+    VyPipelineCache::VyPipelineCache(VyDevice& device, const Path& directory) :
+        m_Device{ device }
+    {
+        const auto& properties = m_Device.properties();
+
+        m_FilePath = directory / fmt::format("PipelineCache_{:04x}_{:04x}.bin", properties.vendorID, properties.deviceID);
+
+        TVector<char> data = FileSystem::readBinary(m_FilePath);
+
+        if (!data.empty() && !isCompatible(data))
+        {
+            VY_WARN_TAG("VyPipelineCache", "Discarding incompatible pipeline cache: {}", m_FilePath.string());
+
+            data.clear();
+        }
+
+        VkPipelineCacheCreateInfo cacheInfo{ VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO };
+        {
+            cacheInfo.initialDataSize = data.size();
+            cacheInfo.pInitialData    = data.empty() ? nullptr : data.data();
+        }
+
+        VK_CHECK(vkCreatePipelineCache(m_Device, &cacheInfo, nullptr, &m_Cache));
+
+        VY_INFO_TAG("VyPipelineCache", "Loaded pipeline cache: {} bytes", data.size());
+    }
+
+
+    VyPipelineCache::~VyPipelineCache()
+    {
+        if (m_Cache != VK_NULL_HANDLE)
+        {
+            save();
+
+            vkDestroyPipelineCache(m_Device, m_Cache, nullptr);
+        }
+    }
+
+
+    VkPipelineCache VyPipelineCache::createChild() const
+    {
+        size_t dataSize = 0;
+        VK_CHECK(vkGetPipelineCacheData(m_Device, m_Cache, &dataSize, nullptr));
+
+        TVector<char> data(dataSize);
+        VK_CHECK(vkGetPipelineCacheData(m_Device, m_Cache, &dataSize, data.data()));
+
+        VkPipelineCacheCreateInfo cacheInfo{ VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO };
+        {
+            cacheInfo.initialDataSize = dataSize;
+            cacheInfo.pInitialData    = data.data();
+        }
+
+        VkPipelineCache cache;
+        VK_CHECK(vkCreatePipelineCache(m_Device, &cacheInfo, nullptr, &cache));
+
+        return cache;
+    }
+
+
+    void VyPipelineCache::merge(const TVector<VkPipelineCache>& caches)
+    {
+        if (caches.empty())
+        {
+            return;
+        }
+
+        VK_CHECK(vkMergePipelineCaches(m_Device, m_Cache, static_cast<U32>(caches.size()), caches.data()));
+    }
+
+
+    void VyPipelineCache::save() const
+    {
+        size_t dataSize = 0;
+        if (vkGetPipelineCacheData(m_Device, m_Cache, &dataSize, nullptr) != VK_SUCCESS || dataSize == 0)
+        {
+            return;
+        }
+
+        TVector<char> data(dataSize);
+        if (vkGetPipelineCacheData(m_Device, m_Cache, &dataSize, data.data()) != VK_SUCCESS)
+        {
+            return;
+        }
+
+        std::error_code error;
+        std::filesystem::create_directories(m_FilePath.parent_path(), error);
+
+        // Write to a temporary file first, a crash mid-write must not leave a truncated cache behind.
+        Path tempPath = m_FilePath;
+        tempPath += ".tmp";
+
+        {
+            std::ofstream file{ tempPath, std::ios::binary | std::ios::trunc };
+
+            if (!file.is_open())
+            {
+                VY_WARN_TAG("VyPipelineCache", "Failed to write pipeline cache: {}", tempPath.string());
+                return;
+            }
+
+            file.write(data.data(), static_cast<std::streamsize>(dataSize));
+        }
+
+        std::filesystem::rename(tempPath, m_FilePath, error);
+
+        if (error)
+        {
+            VY_WARN_TAG("VyPipelineCache", "Failed to write pipeline cache: {}", error.message());
+            return;
+        }
+
+        VY_INFO_TAG("VyPipelineCache", "Saved pipeline cache: {} bytes", dataSize);
+    }
+
+
+    bool VyPipelineCache::isCompatible(const TVector<char>& data) const
+    {
+        if (data.size() < sizeof(VkPipelineCacheHeaderVersionOne))
+        {
+            return false;
+        }
+
+        VkPipelineCacheHeaderVersionOne header;
+        std::memcpy(&header, data.data(), sizeof(header));
+
+        const auto& properties = m_Device.properties();
+
+        return header.headerSize    >= sizeof(VkPipelineCacheHeaderVersionOne)     &&
+               header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE        &&
+               header.vendorID      == properties.vendorID                         &&
+               header.deviceID      == properties.deviceID                         &&
+               std::memcmp(header.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+    }
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <Vy/GFX/Backend/Device.h>
+
+namespace Vy
+{
+    /**
+     * @brief A VkPipelineCache persisted on disk.
+     *
+     * The cache is loaded from `<directory>/PipelineCache_<vendor>_<device>.bin` on creation and written back by
+     * `save()` (and on destruction). The data is only reused if its header matches the device's vendor, device and
+     * `pipelineCacheUUID`, a driver update invalidates it.
+     *
+     * @note Owned by VyContext and passed to every pipeline creation.
+     */
+    class VyPipelineCache
+    {
+    public:
+        VyPipelineCache(VyDevice& device, const Path& directory);
+
+        VyPipelineCache(const VyPipelineCache&)            = delete;
+        VyPipelineCache& operator=(const VyPipelineCache&) = delete;
+
+        ~VyPipelineCache();
+
+        operator     VkPipelineCache() const { return m_Cache; }
+        VY_NODISCARD VkPipelineCache handle() const { return m_Cache; }
+
+        /**
+         * @brief Creates a new cache seeded with this cache's data, e.g. for a compile thread.
+         *
+         * @note The caller owns the cache, merge it back with `merge` and destroy it.
+         */
+        VY_NODISCARD VkPipelineCache createChild() const;
+
+        /**
+         * @brief Merges the given caches into this cache.
+         */
+        void merge(const TVector<VkPipelineCache>& caches);
+
+        /**
+         * @brief Writes the cache data to disk.
+         */
+        void save() const;
+
+    private:
+        /**
+         * @brief Whether `data` was written by a driver compatible with the device.
+         */
+        VY_NODISCARD bool isCompatible(const TVector<char>& data) const;
+
+        VyDevice&       m_Device;
+        Path            m_FilePath;
+        VkPipelineCache m_Cache{ VK_NULL_HANDLE };
+    };
+}
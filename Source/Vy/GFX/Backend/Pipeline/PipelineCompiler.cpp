@@ -0,0 +1,130 @@
+#include <Vy/GFX/Backend/Pipeline/PipelineCompiler.h>
+
+#include <Vy/GFX/Context.h>
+
+#include <VyLib/Util/Executor.h>
+
+#include <exception>
+
+namespace Vy
+{
+    static thread_local VyPipelineCompiler* s_CurrentCompiler = nullptr;
+
+
+    VyPipelineCompiler::VyPipelineCompiler() :
+        m_Previous{ s_CurrentCompiler }
+    {
+        s_CurrentCompiler = this;
+    }
+
+
+    VyPipelineCompiler::~VyPipelineCompiler()
+    {
+        s_CurrentCompiler = m_Previous;
+
+        // Unwinding, the pipelines the jobs write into may already be gone.
+        if (std::uncaught_exceptions() > 0)
+        {
+            m_Jobs.clear();
+            return;
+        }
+
+        try
+        {
+            compile();
+        }
+        catch (const std::exception& e)
+        {
+            VY_ERROR_TAG("VyPipelineCompiler", "Pipeline compilation failed: {}", e.what());
+        }
+    }
+
+
+    VyPipelineCompiler* VyPipelineCompiler::current()
+    {
+        return s_CurrentCompiler;
+    }
+
+
+    void VyPipelineCompiler::enqueue(Job&& job)
+    {
+        m_Jobs.emplace_back(std::move(job));
+    }
+
+
+    void VyPipelineCompiler::compile()
+    {
+        if (m_Jobs.empty())
+        {
+            return;
+        }
+
+        TVector<Job> jobs = std::move(m_Jobs);
+        m_Jobs.clear();
+
+        VyPipelineCache& pipelineCache = VyContext::pipelineCache();
+
+        const U32 threadCount = std::min<U32>(std::max(std::thread::hardware_concurrency(), 1u), static_cast<U32>(jobs.size()));
+
+        if (threadCount == 1)
+        {
+            for (auto& job : jobs)
+            {
+                job(pipelineCache);
+            }
+
+            return;
+        }
+
+        TVector<VkPipelineCache> caches(threadCount);
+        AtomicU32                nextJob{ 0 };
+
+        for (U32 i = 0; i < threadCount; i++)
+        {
+            caches[i] = pipelineCache.createChild();
+        }
+
+        // One task per worker, each pulls jobs until none are left and compiles them into its own cache.
+        ExecutorService            executor{ threadCount };
+        TVector<std::future<void>> results;
+
+        for (U32 i = 0; i < threadCount; i++)
+        {
+            results.emplace_back(executor.submit([&jobs, &nextJob, cache = caches[i]]()
+            {
+                for (U32 index = nextJob++; index < jobs.size(); index = nextJob++)
+                {
+                    jobs[index](cache);
+                }
+            }));
+        }
+
+        std::exception_ptr error;
+
+        for (auto& result : results)
+        {
+            try
+            {
+                result.get();
+            }
+            catch (...)
+            {
+                error = error ? error : std::current_exception();
+            }
+        }
+
+        pipelineCache.merge(caches);
+
+        for (VkPipelineCache cache : caches)
+        {
+            vkDestroyPipelineCache(VyContext::device(), cache, nullptr);
+        }
+
+        VY_INFO_TAG("VyPipelineCompiler", "Compiled {} pipelines on {} threads", jobs.size(), threadCount);
+
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+    }
+}
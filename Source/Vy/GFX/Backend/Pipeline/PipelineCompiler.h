@@ -0,0 +1,61 @@
+#pragma once
+
+#include <Vy/GFX/Backend/Device.h>
+
+namespace Vy
+{
+    class VyPipelineCache;
+
+    /**
+     * @brief Compiles the pipelines built in its scope on worker threads.
+     *
+     * While a compiler is alive on a thread, `GraphicsBuilder::buildUnique` and `ComputeBuilder::buildUnique` called on
+     * that thread return a pipeline that only has its layout; the pipeline itself is queued on the compiler.
+     * `compile()` (or the destructor) then creates the queued pipelines on up to `hardware_concurrency` threads.
+     * Every thread compiles into its own cache seeded from VyContext's pipeline cache, the caches are merged back
+     * into it once all threads are done.
+     *
+     * @code
+     * {
+     *     VyPipelineCompiler compiler;
+     *
+     *     m_SystemA = MakeUnique<SystemA>(...); // Builds its pipelines with buildUnique().
+     *     m_SystemB = MakeUnique<SystemB>(...);
+     * } // All pipelines are valid from here on.
+     * @endcode
+     *
+     * @note The queued pipelines must not be used (and must outlive the compiler) until `compile()` returned.
+     *       `build()` is not deferred, it returns the pipeline by value.
+     */
+    class VyPipelineCompiler
+    {
+    public:
+        using Job = Function<void(VkPipelineCache)>;
+
+        VyPipelineCompiler();
+
+        VyPipelineCompiler(const VyPipelineCompiler&)            = delete;
+        VyPipelineCompiler& operator=(const VyPipelineCompiler&) = delete;
+
+        ~VyPipelineCompiler();
+
+        /**
+         * @brief The compiler active on the calling thread, nullptr if there is none.
+         */
+        VY_NODISCARD static VyPipelineCompiler* current();
+
+        /**
+         * @brief Queues a pipeline creation, run with the cache of the thread it is compiled on.
+         */
+        void enqueue(Job&& job);
+
+        /**
+         * @brief Compiles the queued pipelines and waits for them.
+         */
+        void compile();
+
+    private:
+        VyPipelineCompiler* m_Previous{ nullptr }; // Compiler active on the thread before this one.
+        TVector<Job>        m_Jobs;
+    };
+}
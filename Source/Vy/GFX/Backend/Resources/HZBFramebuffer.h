@@ -1,5 +1,3 @@
-
-
 #pragma once
 
 #include <Vy/GFX/Backend/Image/Image.h>
@@ -10,74 +8,68 @@
 
 namespace Vy
 {
+    /**
+     * @brief Hierarchical-Z depth pyramid used for occlusion culling.
+     *
+     * One R32_SFLOAT image with a full mip chain per frame in flight. Mip 0 is half the size of the
+     * depth buffer it is built from (rounded down), every texel holds the farthest (max) depth of the
+     * texels it covers. Odd sized levels fold the extra row / column into the last texel, so a texel
+     * always conservatively covers its footprint.
+     *
+     * The pyramid is kept in `VK_IMAGE_LAYOUT_GENERAL`, each mip is written as a storage image and the
+     * whole chain is read through `imageView` with `texelFetch`.
+     */
     class VyHZBFramebuffer
     {
     public:
-        struct Attachment
-        {
-            VkFormat          Format;
-            VkImageUsageFlags Usage;
-            VkImageLayout     FinalLayout;
-        };
+        static constexpr VkFormat kFormat = VK_FORMAT_R32_SFLOAT;
 
-        VyHZBFramebuffer(VkExtent2D extent, U32 frameCount, bool useMipmaps = false);
+        VyHZBFramebuffer(VkExtent2D depthExtent, U32 frameCount);
 
-        ~VyHZBFramebuffer();
+        ~VyHZBFramebuffer() = default;
 
         VyHZBFramebuffer(const VyHZBFramebuffer&)            = delete;
         VyHZBFramebuffer& operator=(const VyHZBFramebuffer&) = delete;
 
-        void resize(VkExtent2D newExtent);
+        /**
+         * @brief Recreates the pyramids for a new depth buffer size.
+         */
+        void resize(VkExtent2D depthExtent);
 
-        VkRenderPass          renderPass() const { return m_RenderPass; }
-        VkDescriptorImageInfo descriptorImageInfo(int index) const;
+        /**
+         * @brief Size of mip 0.
+         */
+        VY_NODISCARD VkExtent2D extent()    const { return m_Extent;    }
+        VY_NODISCARD U32        mipLevels() const { return m_MipLevels; }
 
-        void beginRenderPass(VkCommandBuffer cmdBuffer, int frameIndex);
-        void endRenderPass(VkCommandBuffer cmdBuffer) const;
+        VY_NODISCARD VkImage     image       (int frameIndex)               const { return m_Images[frameIndex].handle(); }
+        VY_NODISCARD VkImageView imageView   (int frameIndex)               const { return m_ImageViews[frameIndex].handle(); }
+        VY_NODISCARD VkImageView mipImageView(int frameIndex, int mipLevel) const { return m_MipImageViews[frameIndex][mipLevel].handle(); }
+        VY_NODISCARD VkSampler   sampler()                                  const { return m_Sampler.handle(); }
 
-        void generateMipmaps(VkCommandBuffer cmdBuffer, int frameIndex);
+        /**
+         * @brief Whole pyramid, read in `VK_IMAGE_LAYOUT_GENERAL`.
+         */
+        VY_NODISCARD VkDescriptorImageInfo descriptorImageInfo(int frameIndex) const;
 
-        float aspectRatio() const 
-        { 
-            return static_cast<float>(m_Extent.width) / static_cast<float>(m_Extent.height); 
-        }
-
-        // Accessors for HZB
-        VkImage     depthImage       (int frameIndex)               const { return m_DepthImages[frameIndex].handle(); }
-        VkImageView depthImageView   (int frameIndex)               const { return m_DepthImageViews[frameIndex].handle(); }
-        VkImageView depthMipImageView(int frameIndex, int mipLevel) const { return m_DepthMipImageViews[frameIndex][mipLevel].handle(); }
-        VkSampler   depthSampler()                                  const { return m_DepthSampler.handle(); }
+        /**
+         * @brief Single mip level, as storage image (write) or as reduction source (read).
+         */
+        VY_NODISCARD VkDescriptorImageInfo mipDescriptorImageInfo(int frameIndex, int mipLevel) const;
 
     private:
-        void createRenderPass();
         void createImages();
-        void createFramebuffers();
-
-        void cleanup();
-
-        void destroy();
 
+        VkExtent2D m_DepthExtent;
         VkExtent2D m_Extent;
         U32        m_FrameCount;
-        bool       m_UseMipmaps;
-        U32        m_MipLevels{1};
-
-        VkRenderPass m_RenderPass{VK_NULL_HANDLE};
-
-        // Color attachment
-        TVector<VyImage>        m_ColorImages;
-        TVector<VyImageView>    m_ColorImageViews;
-        TVector<VyImageView>    m_ColorAttachmentImageViews;
+        U32        m_MipLevels{ 1 };
 
-        // Depth attachment
-        TVector<VyImage>        m_DepthImages;
-        TVector<VyImageView>    m_DepthImageViews;
-        // Per-mip views for depth (for HZB generation)
+        TVector<VyImage>              m_Images;
+        TVector<VyImageView>          m_ImageViews;
         // Outer vector: frame index, Inner vector: mip level
-        TVector<TVector<VyImageView>> m_DepthMipImageViews;
+        TVector<TVector<VyImageView>> m_MipImageViews;
 
-        TVector<VkFramebuffer> m_Framebuffers;
-        VySampler              m_Sampler;
-        VySampler              m_DepthSampler;
+        VySampler m_Sampler;
     };
-}
\ No newline at end of file
+}
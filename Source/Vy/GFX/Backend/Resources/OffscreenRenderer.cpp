@@ -10,9 +10,10 @@ namespace Vy
         VkFormat  depthFormat, 
         VkFormat  colorFormat
     ) :
-        m_Window     { window      },
-        m_DepthFormat{ depthFormat },
-        m_ColorFormat{ colorFormat }
+        m_Window     { window                },
+        m_ColorFormat{ colorFormat           },
+        m_DepthFormat{ depthFormat           },
+        m_Extent     { window.windowExtent() }
     {
         init(imageCount);
     }
@@ -20,6 +21,7 @@ namespace Vy
 
     VyOffscreenRenderer::~VyOffscreenRenderer()
     {
+        m_Framebuffers   .clear();
         m_Images         .clear();
         m_ImageViews     .clear();
         m_DepthImages    .clear();
@@ -33,6 +35,16 @@ namespace Vy
         createImages(imageCount);
         createImageViews();
         createDepthResources(imageCount);
+        createRenderPass();
+        createFramebuffers();
+    }
+
+
+    void VyOffscreenRenderer::setImageIndex(U32 index)
+    {
+        VY_ASSERT(index < m_Images.size(), "Offscreen image index out of range");
+
+        m_ImageIndex = index;
     }
 
 
@@ -63,6 +75,10 @@ namespace Vy
             
             auto extent = m_Window.windowExtent();
 
+            m_Extent = extent;
+
+            m_Framebuffers.clear();
+
             for (size_t i = 0; i < m_Images.size(); ++i)
             {
                 m_Images[i] = VyImage::Builder{}
@@ -75,7 +91,7 @@ namespace Vy
                     .imageLayout(VK_IMAGE_LAYOUT_UNDEFINED)
                     .sampleCount(VK_SAMPLE_COUNT_1_BIT)
                     .sharingMode(VK_SHARING_MODE_EXCLUSIVE)
-                    .usage      (VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT)
+                    .usage      (VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT)
                     .memoryUsage(VMA_MEMORY_USAGE_GPU_ONLY)
                 .build();
 
@@ -88,6 +104,8 @@ namespace Vy
                 .build(m_Images[i]);
             }
 
+            createFramebuffers();
+
             m_ImageIndex = 0;
             return;
         }
@@ -111,7 +129,7 @@ namespace Vy
 
     void VyOffscreenRenderer::createImages(size_t imageCount)
     {
-        auto extent = m_Window.windowExtent();
+        auto extent = m_Extent;
 
         m_Images.resize( imageCount );
 
@@ -127,7 +145,7 @@ namespace Vy
                 .imageLayout(VK_IMAGE_LAYOUT_UNDEFINED)
                 .sampleCount(VK_SAMPLE_COUNT_1_BIT)
                 .sharingMode(VK_SHARING_MODE_EXCLUSIVE)
-                .usage      (VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT)
+                .usage      (VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT)
                 .memoryUsage(VMA_MEMORY_USAGE_GPU_ONLY)
             .build();
         }
@@ -159,7 +177,7 @@ namespace Vy
             m_DepthImages[i] = VyImage::Builder{}
                 .imageType  (VK_IMAGE_TYPE_2D)
                 .format     (m_DepthFormat)
-                .extent     (VkExtent2D{ 2048, 2048 })
+                .extent     (m_Extent)
                 .mipLevels  (1)
                 .arrayLayers(1)
                 .tiling     (VK_IMAGE_TILING_OPTIMAL)
@@ -180,6 +198,101 @@ namespace Vy
         }
     }
 
+    void VyOffscreenRenderer::createRenderPass()
+    {
+        // Same attachment layout as the swapchain render pass (color = 0, depth = 1) so pipelines
+        // built against either one are compatible. The color target stays in attachment layout 
+        // after the pass since nothing presents it.
+        VkAttachmentDescription colorAttachment{};
+        {
+            colorAttachment.format         = m_ColorFormat;
+            colorAttachment.samples        = VK_SAMPLE_COUNT_1_BIT;
+            colorAttachment.loadOp         = VK_ATTACHMENT_LOAD_OP_CLEAR;
+            colorAttachment.storeOp        = VK_ATTACHMENT_STORE_OP_STORE;
+            colorAttachment.stencilLoadOp  = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+            colorAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+            colorAttachment.initialLayout  = VK_IMAGE_LAYOUT_UNDEFINED;
+            colorAttachment.finalLayout    = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+        }
+
+        VkAttachmentDescription depthAttachment{};
+        {
+            depthAttachment.format         = m_DepthFormat;
+            depthAttachment.samples        = VK_SAMPLE_COUNT_1_BIT;
+            depthAttachment.loadOp         = VK_ATTACHMENT_LOAD_OP_CLEAR;
+            depthAttachment.storeOp        = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+            depthAttachment.stencilLoadOp  = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+            depthAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+            depthAttachment.initialLayout  = VK_IMAGE_LAYOUT_UNDEFINED;
+            depthAttachment.finalLayout    = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+        }
+
+        VkAttachmentReference colorAttachmentRef{};
+        {
+            colorAttachmentRef.attachment = 0;
+            colorAttachmentRef.layout     = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+        }
+
+        VkAttachmentReference depthAttachmentRef{};
+        {
+            depthAttachmentRef.attachment = 1;
+            depthAttachmentRef.layout     = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+        }
+
+        VkSubpassDescription subpass{};
+        {
+            subpass.pipelineBindPoint       = VK_PIPELINE_BIND_POINT_GRAPHICS;
+            subpass.colorAttachmentCount    = 1;
+            subpass.pColorAttachments       = &colorAttachmentRef;
+            subpass.pDepthStencilAttachment = &depthAttachmentRef;
+        }
+
+        VkSubpassDependency dependency{};
+        {
+            dependency.srcSubpass    = VK_SUBPASS_EXTERNAL;
+            dependency.srcAccessMask = 0;
+            dependency.srcStageMask  = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
+            dependency.dstSubpass    = 0;
+            dependency.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+            dependency.dstStageMask  = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
+        }
+
+        TArray<VkAttachmentDescription, 2> attachments = { colorAttachment, depthAttachment };
+
+        VkRenderPassCreateInfo renderPassInfo{ VKInit::renderPassCreateInfo() };
+        {
+            renderPassInfo.attachmentCount = static_cast<U32>(attachments.size());
+            renderPassInfo.pAttachments    = attachments.data();
+            renderPassInfo.subpassCount    = 1;
+            renderPassInfo.pSubpasses      = &subpass;
+            renderPassInfo.dependencyCount = 1;
+            renderPassInfo.pDependencies   = &dependency;
+        }
+
+        m_RenderPass = MakeUnique<VyRenderPass>(renderPassInfo);
+    }
+
+
+    void VyOffscreenRenderer::createFramebuffers()
+    {
+        m_Framebuffers.reserve( m_Images.size() );
+
+        for (size_t i = 0; i < m_Images.size(); i++)
+        {
+            VyFramebufferDesc framebufferDesc{};
+            {
+                framebufferDesc.Width       = m_Extent.width;
+                framebufferDesc.Height      = m_Extent.height;
+                framebufferDesc.Attachments = { m_ImageViews[i].handle(), m_DepthImageViews[i].handle() };
+                framebufferDesc.Layers      = 1;
+                framebufferDesc.Flags       = 0;
+            }
+
+            m_Framebuffers.emplace_back( *m_RenderPass, framebufferDesc );
+        }
+    }
+
+
     void transitionImageLayout(VkCommandBuffer cmdBuffer, VkImage image)
     {
         VkImageMemoryBarrier barrier{ VKInit::imageMemoryBarrier() };
@@ -212,7 +325,7 @@ namespace Vy
 
     void VyOffscreenRenderer::startOffscreenRenderPass(VkCommandBuffer cmdBuffer)
     {
-        auto extent = m_Window.windowExtent();
+        auto extent = m_Extent;
 
         VkRenderingAttachmentInfoKHR colorAttachment{ VKInit::renderingAttachmentInfoKHR() };
         {
@@ -3,18 +3,27 @@
 #include <Vy/GFX/Backend/Image/Image.h>
 #include <Vy/GFX/Backend/Image/ImageView.h>
 #include <Vy/GFX/Backend/Image/Sampler.h>
+#include <Vy/GFX/Backend/Resources/RenderPass.h>
+#include <Vy/GFX/Backend/Resources/Framebuffer.h>
 
 #include <Vy/Core/Window.h>
 
 namespace Vy
 {
+    /**
+     * @brief Owns a ring of color/depth targets that can be rendered to without a swapchain.
+     *
+     * The targets can be used either with dynamic rendering (`startOffscreenRenderPass`) or
+     * with the legacy render pass/framebuffer pair (`renderPass()` / `framebuffer()`), which
+     * mirrors the swapchain render pass so the same pipelines can target both.
+     */
     class VyOffscreenRenderer
     {
     public:
         VyOffscreenRenderer(
-            VyWindow& window, 
-            size_t    imageCount, 
-            VkFormat  depthFormat, 
+            VyWindow& window,
+            size_t    imageCount,
+            VkFormat  depthFormat,
             VkFormat  colorFormat
         );
 
@@ -24,6 +33,33 @@ namespace Vy
         VkImageView currentImageView() const { return m_ImageViews[m_ImageIndex].handle(); }
         VkSampler   imageSampler()           { return m_ImageSampler.handle(); }
 
+        VkExtent2D  extent()           const { return m_Extent; }
+        VkFormat    colorFormat()      const { return m_ColorFormat; }
+        VkFormat    depthFormat()      const { return m_DepthFormat; }
+        size_t      imageCount()       const { return m_Images.size(); }
+        U32         imageIndex()       const { return m_ImageIndex; }
+
+        /**
+         * @brief Gets the render pass compatible with the offscreen color and depth targets.
+         */
+        VyRenderPass& renderPass() const
+        {
+            return *m_RenderPass;
+        }
+
+        /**
+         * @brief Gets the framebuffer for the target at the given index.
+         */
+        const VyFramebuffer& framebuffer(U32 index) const
+        {
+            return m_Framebuffers[ index ];
+        }
+
+        /**
+         * @brief Selects the target that `currentImage()` / `startOffscreenRenderPass()` refer to.
+         */
+        void setImageIndex(U32 index);
+
         void startOffscreenRenderPass(VkCommandBuffer cmdBuffer);
         void endOffscreenRenderPass(VkCommandBuffer cmdBuffer);
 
@@ -38,7 +74,9 @@ namespace Vy
         void createImages(size_t imageCount);
         void createImageViews();
         void createDepthResources(size_t imageCount);
- 
+        void createRenderPass();
+        void createFramebuffers();
+
         VyWindow& m_Window;
 
         TVector<VyImage>     m_Images;
@@ -47,11 +85,16 @@ namespace Vy
         TVector<VyImage>     m_DepthImages;
         TVector<VyImageView> m_DepthImageViews;
 
+        Unique<VyRenderPass>   m_RenderPass;
+        TVector<VyFramebuffer> m_Framebuffers;
+
         VkFormat m_ColorFormat = VK_FORMAT_UNDEFINED;
         VkFormat m_DepthFormat = VK_FORMAT_UNDEFINED;
-        
+
+        VkExtent2D m_Extent{ 0, 0 };
+
         VySampler m_ImageSampler;
 
         U32 m_ImageIndex{ 0 };
     };
-}
\ No newline at end of file
+}
@@ -120,15 +120,27 @@ namespace Vy
         // The RenderFinishedSemaphores for the current frame to be submitted as the command buffer complete signal semaphore.
         VkSemaphore signalSemaphores[] = { m_RenderFinishedSemaphores[ m_CurrentFrame ] };
 
+        // The frame may use resources the upload manager is still writing, wait for its timeline as well.
+        const auto uploadWait = VyContext::uploader().graphicsWait();
+
         // Specify the semaphore to wait on before execution begins and in which stage of the pipeline to wait.
-        VkSemaphore          waitSemaphores[] = { m_ImageAvailableSemaphores[ m_CurrentFrame ] };
-        VkPipelineStageFlags waitStages[]     = { VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT };
+        VkSemaphore          waitSemaphores[] = { m_ImageAvailableSemaphores[ m_CurrentFrame ], uploadWait.Semaphore };
+        VkPipelineStageFlags waitStages[]     = { VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT };
+        U64                  waitValues[]     = { 0, uploadWait.Value }; // The binary semaphore's value is ignored.
+
+        VkTimelineSemaphoreSubmitInfo timelineInfo{ VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO };
+        {
+            timelineInfo.waitSemaphoreValueCount = 2;
+            timelineInfo.pWaitSemaphoreValues    = waitValues;
+        }
         
         // [ Submit ]
         VkSubmitInfo submitInfo{ VKInit::submitInfo() };
         {
+            submitInfo.pNext                = &timelineInfo;
+
             // Semaphore(s) to wait before the command buffers for this batch begin execution.
-            submitInfo.waitSemaphoreCount   = 1;
+            submitInfo.waitSemaphoreCount   = 2;
             submitInfo.pWaitSemaphores      = waitSemaphores;
 
             // Pipeline stages at which each corresponding semaphore wait will occur.
@@ -148,7 +160,11 @@ namespace Vy
         
         // Submit command buffer to the graphics queue.
         // Pass in a fence to signal when the command buffer being submitted has finished executing.
-		VK_CHECK(vkQueueSubmit(VyContext::device().graphicsQueue(), 1, &submitInfo, m_InFlightFences[ m_CurrentFrame ]));
+        {
+            LockGuard<Mutex> lock{ VyContext::device().queueMutex() };
+
+            VK_CHECK(vkQueueSubmit(VyContext::device().graphicsQueue(), 1, &submitInfo, m_InFlightFences[ m_CurrentFrame ]));
+        }
 
         // Set this swapchain as the swapchain to use for presentation.
         VkSwapchainKHR swapchains[] = { m_Swapchain };
@@ -202,7 +218,12 @@ namespace Vy
         }
 
         // Send image to be presented to the display.
-        auto result = vkQueuePresentKHR(VyContext::device().presentQueue(), &presentInfo);
+        VkResult result;
+        {
+            LockGuard<Mutex> lock{ VyContext::device().queueMutex() };
+
+            result = vkQueuePresentKHR(VyContext::device().presentQueue(), &presentInfo);
+        }
 
         // Advance to the next frame.
         m_CurrentFrame = (m_CurrentFrame + 1) % MAX_FRAMES_IN_FLIGHT;
@@ -831,6 +831,29 @@ namespace Vy
     }
 
 
+    void VKCmd::memoryBarrier(
+		VkCommandBuffer      cmdBuffer, 
+		VkPipelineStageFlags srcStage, 
+		VkAccessFlags        srcAccess, 
+		VkPipelineStageFlags dstStage, 
+		VkAccessFlags        dstAccess)
+    {
+		VkMemoryBarrier barrier{ VKInit::memoryBarrier() };
+		{
+			barrier.srcAccessMask = srcAccess;
+			barrier.dstAccessMask = dstAccess;
+		}
+
+		vkCmdPipelineBarrier(cmdBuffer,
+			srcStage, dstStage,
+			0,
+			1, &barrier,
+			0, nullptr,
+			0, nullptr
+		);
+    }
+
+
     void VKCmd::scissor(VkCommandBuffer cmdBuffer, VkExtent2D extent)
     {
 		VkRect2D scissor{};
@@ -841,6 +864,12 @@ namespace Vy
 
         vkCmdSetScissor(cmdBuffer, 0, 1, &scissor);
     }
+
+
+    void VKCmd::scissor(VkCommandBuffer cmdBuffer, const VkRect2D& rect)
+    {
+        vkCmdSetScissor(cmdBuffer, 0, 1, &rect);
+    }
 	
 
     void VKCmd::transitionImageLayout(
@@ -1033,6 +1062,22 @@ namespace Vy
     }
 
 
+    void VKCmd::viewport(VkCommandBuffer cmdBuffer, const VkRect2D& rect)
+    {
+		VkViewport viewport{};
+        {
+            viewport.x        = static_cast<float>(rect.offset.x);
+            viewport.y        = static_cast<float>(rect.offset.y);
+            viewport.width    = static_cast<float>(rect.extent.width);
+            viewport.height   = static_cast<float>(rect.extent.height);
+            viewport.minDepth = 0.0f;
+            viewport.maxDepth = 1.0f;
+        }
+
+		vkCmdSetViewport(cmdBuffer, 0, 1, &viewport);
+    }
+
+
     void VKCmd::beginDebugUtilsLabel(VkCommandBuffer cmdBuffer, const char* label, const Vec4& color)
     {
 		// if constexpr (VY_ENABLE_VALIDATION)
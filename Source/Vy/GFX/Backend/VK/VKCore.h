@@ -162,7 +162,12 @@ namespace Vy
         Optional<U32> ComputeFamily;
 
 
-        // Optional<U32> TransferFamily;
+        /**
+         * @brief Index of a dedicated transfer queue family (transfer only, no graphics or compute), if any.
+         *
+         * Used by VyUploadManager so uploads run on the device's DMA engines, next to rendering.
+         */
+        Optional<U32> TransferFamily;
 
         /**
          * @brief Checks if the required queue families have been found.
@@ -424,7 +429,19 @@ namespace Vy
             const TVector<VkImageMemoryBarrier>& barriers
         );
 
+        /**
+         * @brief Global memory barrier, used to order buffer writes (e.g. compute -> indirect draw).
+         */
+        void memoryBarrier(
+            VkCommandBuffer      cmdBuffer, 
+            VkPipelineStageFlags srcStage, 
+            VkAccessFlags        srcAccess, 
+            VkPipelineStageFlags dstStage, 
+            VkAccessFlags        dstAccess
+        );
+
         void scissor(VkCommandBuffer cmdBuffer, VkExtent2D extent);
+        void scissor(VkCommandBuffer cmdBuffer, const VkRect2D& rect);
 
         void transitionImageLayout(
             VkCommandBuffer cmd, 
@@ -449,6 +466,7 @@ namespace Vy
         );
 
         void viewport(VkCommandBuffer cmdBuffer, VkExtent2D extent);
+        void viewport(VkCommandBuffer cmdBuffer, const VkRect2D& rect);
 
 
         // Extensions
@@ -674,6 +692,18 @@ namespace Vy
             return ret;
         }
 
+        /**
+         * Returns a default initialized VkQueryPoolCreateInfo structure
+         * @returns default initialized VkQueryPoolCreateInfo
+         * */
+        inline VkQueryPoolCreateInfo queryPoolCreateInfo() 
+        {
+            VkQueryPoolCreateInfo ret{};
+            ret.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+
+            return ret;
+        }
+
         /**
          * Returns a default initialized VkMemoryAllocateInfo structure
          * @returns default initialized VkMemoryAllocateInfo
@@ -734,6 +764,18 @@ namespace Vy
             return ret;
         }
 
+        /**
+         * Returns a default initialized VkCommandBufferInheritanceInfo structure
+         * @returns default initialized VkCommandBufferInheritanceInfo
+         * */
+        inline VkCommandBufferInheritanceInfo commandBufferInheritanceInfo() 
+        {
+            VkCommandBufferInheritanceInfo ret{};
+            ret.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+
+            return ret;
+        }
+
 
         inline VkCommandBufferSubmitInfo commandBufferSubmitInfo() 
         {
@@ -883,6 +925,18 @@ namespace Vy
             return ret;
         }
 
+        /**
+         * Returns a default initialized VkMemoryBarrier structure
+         * @returns default initialized VkMemoryBarrier
+         * */
+        inline VkMemoryBarrier memoryBarrier() 
+        {
+            VkMemoryBarrier ret{};
+            ret.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+
+            return ret;
+        }
+
         /**
          * Returns a default initialized VkImageMemoryBarrier structure
          * @returns default initialized VkImageMemoryBarrier
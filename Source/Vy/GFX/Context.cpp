@@ -1,5 +1,8 @@
 #include <Vy/GFX/Context.h>
 
+#include <Vy/GFX/Resources/StaticMesh.h>
+#include <Vy/Globals.h>
+
 
 namespace Vy
 {
@@ -14,17 +17,24 @@ namespace Vy
 
 	void DeletionQueue::schedule(Function<void()>&& function)
 	{
+		LockGuard<Mutex> lock{ m_Mutex };
+
 		m_PendingDeletions[ m_CurrentFrameIndex ].Deletors.emplace_back( std::move(function) );
 	}
 
 
 	void DeletionQueue::flush(U32 frameIndex)
 	{
-		m_CurrentFrameIndex = frameIndex;
+		{
+			LockGuard<Mutex> lock{ m_Mutex };
 
-		auto& deletors = m_PendingDeletions[ frameIndex ].Deletors;
+			m_CurrentFrameIndex = frameIndex;
+
+			// Deletors may schedule again, they run unlocked.
+			m_Flushing.swap(m_PendingDeletions[ frameIndex ].Deletors);
+		}
         
-		for (auto& DeleteFunc : deletors)
+		for (auto& DeleteFunc : m_Flushing)
 		{
 			if (DeleteFunc)
             {
@@ -32,7 +42,7 @@ namespace Vy
             }
 		}
 
-		deletors.clear();
+		m_Flushing.clear();
 	}
 
 
@@ -47,12 +57,23 @@ namespace Vy
     // ============================================================================================
     // Context
 
+	VyContext::~VyContext()
+	{
+		// Pending deletions may reference members (freed geometry ranges), run them while everything is alive.
+		m_DeletionQueue.flushAll();
+	}
+
+
 	VyContext& VyContext::initialize(VyWindow& window)
 	{
 		auto& context = get();
 
 		context.m_Device.initialize(window);
 
+		context.m_PipelineCache = MakeUnique<VyPipelineCache>(context.m_Device, CACHE_DIR);
+		context.m_Uploader      = MakeUnique<VyUploadManager>(context.m_Device);
+		context.m_Geometry      = MakeUnique<VyGeometryBuffer>(static_cast<U32>(sizeof(VyVertex)));
+
 		// TODO: Let the pool grow dynamically (see: https://vkguide.dev/docs/extra-chapter/abstracting_descriptors/)
 		// https://github.com/TNtube/Cardia/blob/6fbde85b58bac3921ed7d12624e896750686b2db/Cardia/include/Cardia/Renderer/Descriptors.hpp
 
@@ -196,6 +217,8 @@ namespace Vy
 
 	void VyContext::waitIdle()
 	{
+		LockGuard<Mutex> lock{ get().m_Device.queueMutex() };
+
 		vkDeviceWaitIdle(get().m_Device);
 	}
 }
\ No newline at end of file
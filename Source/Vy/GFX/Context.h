@@ -2,6 +2,9 @@
 
 #include <Vy/GFX/Backend/Device.h>
 #include <Vy/GFX/Backend/Descriptors.h>
+#include <Vy/GFX/Backend/Pipeline/PipelineCache.h>
+#include <Vy/GFX/Backend/Buffer/UploadManager.h>
+#include <Vy/GFX/Backend/Buffer/GeometryBuffer.h>
 
 #include <Vy/Core/Window.h>
 
@@ -11,6 +14,8 @@ namespace Vy
      * @brief Manages the deletion of vulkan objects to ensure they are not deleted while in use.
      * 
      * @note Deletion is deferred for MAX_FRAMES_IN_FLIGHT frames.
+     * @note Thread safe: the main thread schedules deletions (e.g. when the frame packet drops the last reference to
+     *       a mesh) while the render thread schedules and flushes them. Deletors run outside the lock.
      */
 	class DeletionQueue
 	{
@@ -39,6 +44,8 @@ namespace Vy
 
 		TArray<DeletorQueue, MAX_FRAMES_IN_FLIGHT> m_PendingDeletions;
 		U32                                        m_CurrentFrameIndex{ 0 };
+		TVector<Function<void()>>                  m_Flushing;  // Deletors being run by flush, swapped out under the lock.
+		Mutex                                      m_Mutex;
 	};
 
     constexpr U32 MAX_DESCRIPTOR_SETS  = 1000;
@@ -54,7 +61,7 @@ namespace Vy
 	class VyContext
 	{
 	public:
-		~VyContext() = default;
+		~VyContext();
 
 		VyContext(const VyContext&) = delete;
 		VyContext(VyContext&&)      = delete;
@@ -68,14 +75,19 @@ namespace Vy
         VY_NODISCARD static VkPhysicalDevice  physicalDevice() { return get().device().physicalDevice(); }
         VY_NODISCARD static VmaAllocator      allocator()      { return get().device().allocator();      }
 		VY_NODISCARD static DeletionQueue&    deletionQueue()  { return get().m_DeletionQueue;           }
+		VY_NODISCARD static VyPipelineCache&  pipelineCache()  { return *get().m_PipelineCache;          }
+		VY_NODISCARD static VyUploadManager&  uploader()       { return *get().m_Uploader;               }
+		VY_NODISCARD static VyGeometryBuffer& geometry()       { return *get().m_Geometry;               }
 		// VY_NODISCARD static VyDescriptorPool& descriptorPool() { return get().m_DescriptorPool;          }
 
 		VY_NODISCARD static Shared<VyDescriptorPool> globalPool() { return get().m_GlobalPool; }
 
         /**
-         * @brief Initialize VyContext, VyDevice, and the global descriptor pool.
+         * @brief Initialize VyContext, VyDevice, the pipeline cache, the upload manager, the geometry arenas and the
+         *        global descriptor pool.
          * 
          * @note Called on VyRenderer creation. `VyRenderer::VyRenderer(VyWindow& window)`
+         * @note If the window is headless the device is created without a surface.
          */
 		static VyContext& initialize(VyWindow& window);
 
@@ -109,10 +121,13 @@ namespace Vy
 
 		VyContext() = default;
 
-		VyDevice         m_Device{};
-		VyDescriptorPool m_DescriptorPool{};
+		VyDevice                m_Device{};
+		Unique<VyPipelineCache> m_PipelineCache;      // Declared after m_Device, saved and destroyed before it.
+		VyDescriptorPool        m_DescriptorPool{};
 		
-		DeletionQueue    m_DeletionQueue{};
+		DeletionQueue           m_DeletionQueue{};
+		Unique<VyUploadManager> m_Uploader;           // Declared after m_DeletionQueue, its staging ring is queued for deletion.
+		Unique<VyGeometryBuffer> m_Geometry;          // Declared after m_DeletionQueue, its arenas are queued for deletion.
 
 		Shared<VyDescriptorPool> m_GlobalPool;
 	};
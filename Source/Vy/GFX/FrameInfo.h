@@ -3,39 +3,66 @@
 #include <Vy/Scene/Scene.h>
 #include <Vy/Scene/ECS/Components/LightComponent.h>
 #include <Vy/Scene/Camera.h>
+#include <Vy/GFX/FramePacket.h>
 
 #include <Vy/GFX/Backend/VK/VKCore.h>
 
 namespace Vy 
 {
 
+// Shadowed lights of SimpleRenderSystem, the lit lights are only bounded by VyClusteredLightSystem::kMaxLights.
 #define MAX_POINT_LIGHTS  10
-#define MAX_DIRECT_LIGHTS 10
 #define MAX_SPOT_LIGHTS   10
 
-    struct PointLightUBO
+    /**
+     * @brief Matches the `LIGHT_*` defines of the lighting shaders.
+     */
+    enum ELightType : U32
     {
-        Vec4 Position{}; // xyz = position, w = unused
-        Vec4 Color   {}; // rgb = color,    a = intensity
+        LightType_Directional = 0,
+        LightType_Point       = 1,
+        LightType_Spot        = 2,
     };
 
-    struct DirectionalLightUBO
+    /**
+     * @brief `LightData::ShadowIndex` of a light without a shadow.
+     */
+    constexpr U32 kNoShadow = ~0u;
+
+    /**
+     * @brief One light of the light storage buffer (std430).
+     * 
+     * Directional lights come first, followed by the point and spot lights that are binned into the clusters.
+     */
+    struct LightData
     {
-        Vec4 Direction{}; // xyz = direction, w = *unused* ambientStrength 
-        Vec4 Color    {}; // rgb = color,     a = intensity
+        Vec4  Position   {};     // xyz = position,  w = range   (point / spot)
+        Vec4  Direction  {};     // xyz = direction, w = unused  (directional / spot)
+        Vec4  Color      {};     // rgb = color,     a = intensity
+        float InnerCutoff{ 0 };  // cos of inner angle (spot)
+        float OuterCutoff{ 0 };  // cos of outer angle (spot)
+        U32   Type       { 0 };  // ELightType
+        U32   ShadowIndex{ kNoShadow }; // Into the shadow buffer, see VyShadowSystem.
     };
-    
-    struct SpotLightUBO
+
+    static_assert(sizeof(LightData) == 64, "LightData must match the std430 Light struct of the shaders");
+
+    /**
+     * @brief Shadow of one light in the shadow storage buffer (std430), see VyShadowSystem.
+     */
+    struct ShadowData
     {
-        Vec4  Position   {}; // xyz = position,    w = unused
-        Vec4  Direction  {}; // xyz = direction,   w = unused
-        Vec4  Color      {}; // rgb = color,       a = intensity
-        float InnerCutoff{}; // cos of inner angle
-        float OuterCutoff{}; // cos of outer angle
-        float _pad0{ 0.0f };
-        float _pad1{ 0.0f };
+        Mat4 LightSpaceMatrix{ 1.0f }; // Directional / spot.
+        Vec4 UVRect          {};       // Directional / spot: atlas tile, xy = offset, zw = scale.
+        Vec4 PositionAndRange{};       // Point: xyz = position, w = far plane of the cube map.
+        U32  Valid           { 0 };    // The shadow has been rendered, unshadowed otherwise.
+        U32  CubeIndex       { 0 };    // Point: cube map of the moving casters, the static one follows the dynamic ones.
+        U32  _pad0           { 0 };
+        U32  _pad1           { 0 };
     };
 
+    static_assert(sizeof(ShadowData) == 112, "ShadowData must match the std430 Shadow struct of the shaders");
+
     struct CameraDataUBO
     {
         Mat4 Projection  { 1.0f };
@@ -50,15 +77,15 @@ namespace Vy
 
         Vec4                AmbientLightColor   { 1.0f, 1.0f, 1.0f, 0.02f }; // rgb = color, a = intensity
 
-        PointLightUBO       PointLights         [ MAX_POINT_LIGHTS  ];
-        DirectionalLightUBO DirectionalLights   [ MAX_DIRECT_LIGHTS ];
-        SpotLightUBO        SpotLights          [ MAX_SPOT_LIGHTS   ];
-        int                 NumPointLights      { 0 };
-        int                 NumDirectionalLights{ 0 };
-        int                 NumSpotLights       { 0 };
+        // Light clusters, see VyClusteredLightSystem.
+        UVec4               ClusterGrid         {}; // xyz = clusters per axis, w = max lights per cluster
+        Vec4                ClusterParams       {}; // xy  = tile size in pixels, z = slice scale, w = slice bias
+
+        U32                 NumDirectionalLights{ 0 }; // Lights [ 0, NumDirectionalLights ) of the light buffer.
+        U32                 NumLocalLights      { 0 }; // Point and spot lights, after the directional lights.
     };
 
-    
+
     struct GenericPushConstantData
     {
         Mat4 ModelMatrix { 1.0f };
@@ -103,6 +130,25 @@ namespace Vy
         float            EmissionStrength{ 0.0f };
     };
 
+    /**
+     * @brief Per-instance data of the batched material pass, stored in a storage buffer
+     *        and indexed with `gl_InstanceIndex`.
+     * 
+     * The material parameters and textures are looked up in the bindless material set (set 1) with `MaterialIndex`.
+     * 
+     * @note Matches `InstanceData` in Material.vert / Material.frag (std430).
+     */
+    struct MaterialInstanceData
+    {
+        alignas(16) Mat4 ModelMatrix  { 1.0f };
+        alignas(16) Mat4 NormalMatrix { 1.0f }; // 4x4 because of alignment
+
+        alignas(16) Vec3 Color        { 1.0f, 1.0f, 1.0f }; // Multiplied with the material albedo (ColorComponent fallback).
+        U32              MaterialIndex{ 0 };                // Index into the material buffer, 0 is the default material.
+    };
+
+    static_assert(sizeof(MaterialInstanceData) == 144, "MaterialInstanceData must match the std430 layout of InstanceData");
+
 	struct VyRenderInfo 
     {
 		VkFramebuffer         Framebuffer;
@@ -115,16 +161,17 @@ namespace Vy
 
     struct VyFrameInfo 
     {
-        int              FrameIndex;
-        float            FrameTime;
-        VkCommandBuffer  CommandBuffer;
-        // U32              DynamicOffset;
-        VkDescriptorSet  GlobalDescriptorSet;
-        // VkDescriptorSet  ShadowDescriptorSet;
-        // VkDescriptorSet  GlobalTextureSet; // Bindless
-        // VkDescriptorSet  LightDescriptorSet;
-        Shared<VyScene>& Scene;
-        VyCamera&        Camera;
+        int                  FrameIndex;
+        float                FrameTime;
+        VkCommandBuffer      CommandBuffer;
+        // U32                  DynamicOffset;
+        VkDescriptorSet      GlobalDescriptorSet;
+        VkDescriptorSet      MaterialDescriptorSet; // Bindless textures and material parameters.
+        // VkDescriptorSet      ShadowDescriptorSet;
+        // VkDescriptorSet      LightDescriptorSet;
+        const VyFramePacket& Packet;                // Scene data extracted for this frame, render systems never read the registry.
+        VyCamera&            Camera;
+        const U32*           MaterialIndices{ nullptr }; // Material buffer index of each packet material, set by VyMaterialSystem::updateMaterials.
     };
 
 
@@ -0,0 +1,119 @@
+#include <Vy/GFX/FramePacket.h>
+
+#include <Vy/Scene/Scene.h>
+#include <Vy/Scene/ECS/Components.h>
+
+namespace Vy
+{
+    U32 VyFramePacket::extractMaterial(const Shared<VyMaterial>& material)
+    {
+        auto [ it, bInserted ] = m_MaterialLookup.try_emplace(material.get(), static_cast<U32>(Materials.size()));
+
+        if (!bInserted)
+        {
+            return it->second;
+        }
+
+        VyMaterialProxy& proxy = Materials.emplace_back();
+        {
+            proxy.Material = material;
+            proxy.Data     = material->getData();
+            proxy.Version  = material->version();
+        }
+
+        for (U32 i = 0; i < static_cast<U32>(EMaterialTexture::Count); i++)
+        {
+            const auto type = static_cast<EMaterialTexture>(i);
+
+            if (material->hasTexture(type))
+            {
+                proxy.Textures[i] = material->descriptorImageInfo(type);
+            }
+        }
+
+        return it->second;
+    }
+
+
+    void VyFramePacket::extract(VyScene& scene, float deltaTime)
+    {
+        auto& registry = scene.registry();
+
+        FrameNumber++;
+        DeltaTime = deltaTime;
+
+        // [ Camera ]
+        bHasCamera = false;
+
+        if (VyEntity mainCamera = scene.mainCamera())
+        {
+            const auto& cameraComponent = mainCamera.get<CameraComponent>();
+            const auto& transform       = mainCamera.get<TransformComponent>();
+
+            Camera = cameraComponent.Camera;
+            Camera.setView(transform.Translation, transform.Rotation);
+
+            bHasCamera = true;
+        }
+
+        // [ Objects ]
+        Objects  .clear();
+        Materials.clear();
+
+        m_MaterialLookup.clear();
+
+        auto view = registry.view<ModelComponent, LocalToWorldComponent>();
+
+        for (auto&& [ entity, model, world ] : view.each())
+        {
+            if (!model.Model)
+            {
+                continue;
+            }
+
+            VyRenderProxy& proxy = Objects.emplace_back();
+            {
+                proxy.Mesh         = model.Model;
+                proxy.Matrix       = world.Matrix;
+                proxy.NormalMatrix = world.NormalMatrix;
+                proxy.Entity       = static_cast<U32>(entity);
+                proxy.Version      = world.Version;
+            }
+
+            if (auto* material = registry.try_get<MaterialComponent>(entity))
+            {
+                if (material->Material)
+                {
+                    proxy.Material = extractMaterial(material->Material);
+                }
+            }
+            else if (auto* color = registry.try_get<ColorComponent>(entity))
+            {
+                proxy.Color = color->Color;
+            }
+        }
+
+        // [ Lights ]
+        PointLights      .clear();
+        DirectionalLights.clear();
+        SpotLights       .clear();
+
+        for (auto&& [ entity, light, transform ] : registry.view<PointLightComponent, TransformComponent>().each())
+        {
+            PointLights.push_back(VyPointLightProxy{ light, transform });
+        }
+
+        for (auto&& [ entity, light, transform ] : registry.view<DirectionalLightComponent, TransformComponent>().each())
+        {
+            DirectionalLights.push_back(VyDirectionalLightProxy{ light, transform });
+        }
+
+        for (auto&& [ entity, light, transform ] : registry.view<SpotLightComponent, TransformComponent>().each())
+        {
+            SpotLights.push_back(VySpotLightProxy{ light, transform });
+        }
+
+        // [ Post-Processing ]
+        PostProcessing = scene.getPostProcessingComponent();
+    }
+}
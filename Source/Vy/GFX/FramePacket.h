@@ -0,0 +1,108 @@
+#pragma once
+
+#include <Vy/Scene/Camera.h>
+
+#include <Vy/GFX/Resources/Material.h>
+
+#include <Vy/Scene/ECS/Components/TransformComponent.h>
+#include <Vy/Scene/ECS/Components/LightComponent.h>
+#include <Vy/Scene/ECS/Components/PostProcessingComponent.h>
+
+#include <VyLib/VyLib.h>
+
+namespace Vy
+{
+    class VyScene;
+    class VyStaticMesh;
+
+    /**
+     * @brief A material as seen by the renderer, its parameters and textures copied when the packet is extracted.
+     *
+     * The main thread may change the material while the frame is recorded, the render thread only reads the copy.
+     */
+    struct VyMaterialProxy
+    {
+        Shared<VyMaterial> Material;    // Keeps the textures alive and identifies the material, never read by the render thread.
+        VyMaterialData     Data;
+        U32                Version{ 0 };
+
+        TArray<VkDescriptorImageInfo, static_cast<U32>(EMaterialTexture::Count)> Textures{}; // Null image view if not loaded.
+    };
+
+    /**
+     * @brief A drawable entity as seen by the renderer.
+     *
+     * Holds its mesh so it outlives the entity while the frame is recorded.
+     */
+    struct VyRenderProxy
+    {
+        static constexpr U32 kNoMaterial = ~0u;
+
+        Shared<VyStaticMesh> Mesh;
+        U32                  Material    { kNoMaterial };      // Index into VyFramePacket::Materials, kNoMaterial: default material.
+        Mat4                 Matrix      { 1.0f };
+        Mat4                 NormalMatrix{ 1.0f };
+        Vec3                 Color       { 1.0f, 1.0f, 1.0f }; // ColorComponent fallback of entities without a material.
+        U32                  Entity      { 0 };                // Registry id, identifies the object across frames.
+        U32                  Version     { 0 };                // LocalToWorldComponent::Version, changes when it moves.
+    };
+
+    struct VyPointLightProxy
+    {
+        PointLightComponent       Light;
+        TransformComponent        Transform;
+    };
+
+    struct VyDirectionalLightProxy
+    {
+        DirectionalLightComponent Light;
+        TransformComponent        Transform;
+    };
+
+    struct VySpotLightProxy
+    {
+        SpotLightComponent        Light;
+        TransformComponent        Transform;
+    };
+
+    /**
+     * @brief Everything the renderer needs from the scene for one frame, copied out of the registry.
+     *
+     * The main thread extracts the packet once the simulation of a frame finished, the render thread records the
+     * frame from it while the main thread already simulates the next one. Render systems never touch the registry.
+     *
+     * The camera only has its view set, the projection depends on the swapchain and is set when the frame is
+     * recorded.
+     */
+    struct VyFramePacket
+    {
+        U64                              FrameNumber{ 0 };
+        float                            DeltaTime  { 0.0f };
+
+        VyCamera                         Camera;
+        bool                             bHasCamera { false };
+
+        TVector<VyRenderProxy>           Objects;
+        TVector<VyMaterialProxy>         Materials; // Every material used by the objects, once.
+        TVector<VyPointLightProxy>       PointLights;
+        TVector<VyDirectionalLightProxy> DirectionalLights;
+        TVector<VySpotLightProxy>        SpotLights;
+
+        PostProcessingComponent          PostProcessing;
+
+        /**
+         * @brief Refills the packet from the scene, reusing its allocations.
+         */
+        void extract(VyScene& scene, float deltaTime);
+
+    private:
+        /**
+         * @brief Copies a material into Materials the first time it is seen this frame.
+         *
+         * @return Its index in Materials.
+         */
+        U32 extractMaterial(const Shared<VyMaterial>& material);
+
+        THashMap<const VyMaterial*, U32> m_MaterialLookup; // Material to its index in Materials, while extracting.
+    };
+}
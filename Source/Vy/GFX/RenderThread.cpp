@@ -0,0 +1,163 @@
+#include <Vy/GFX/RenderThread.h>
+
+#include <algorithm>
+
+namespace Vy
+{
+    VyRenderThread::VyRenderThread(RenderFn render) :
+        m_Render{ std::move(render) }
+    {
+        VY_ASSERT(m_Render != nullptr, "Render callback is null");
+
+        // The calling (main) thread must own the shared job system, the render thread only registers with it.
+        VyJobSystem::shared();
+
+        m_Thread = std::thread([this]() { threadLoop(); });
+    }
+
+
+    VyRenderThread::~VyRenderThread()
+    {
+        stop();
+    }
+
+
+    VyFramePacket& VyRenderThread::acquire()
+    {
+        UniqueLock<Mutex> lock(m_Mutex);
+
+        m_PacketFreed.wait(lock, [this]()
+        {
+            return m_States[ m_WriteIndex ] == EPacketState::Free || m_Error;
+        });
+
+        rethrowError();
+
+        return m_Packets[ m_WriteIndex ];
+    }
+
+
+    void VyRenderThread::submit()
+    {
+        {
+            LockGuard<Mutex> lock(m_Mutex);
+
+            rethrowError();
+
+            VY_ASSERT(m_States[ m_WriteIndex ] == EPacketState::Free, "Submitted a packet that was not acquired");
+
+            m_States[ m_WriteIndex ] = EPacketState::Submitted;
+            m_WriteIndex             = (m_WriteIndex + 1) % m_Packets.size();
+        }
+
+        m_PacketSubmitted.notify_one();
+    }
+
+
+    void VyRenderThread::flush()
+    {
+        UniqueLock<Mutex> lock(m_Mutex);
+
+        m_PacketFreed.wait(lock, [this]()
+        {
+            return m_Error || std::all_of(m_States.begin(), m_States.end(), [](EPacketState state)
+            {
+                return state == EPacketState::Free;
+            });
+        });
+
+        rethrowError();
+    }
+
+
+    void VyRenderThread::stop()
+    {
+        if (!m_Thread.joinable())
+        {
+            return;
+        }
+
+        {
+            LockGuard<Mutex> lock(m_Mutex);
+
+            m_bStopping = true;
+        }
+
+        m_PacketSubmitted.notify_one();
+
+        m_Thread.join();
+    }
+
+
+    void VyRenderThread::threadLoop()
+    {
+        // The recording jobs of the frame are submitted from here, give them a deque of their own.
+        VyJobSystem& jobs = VyJobSystem::shared();
+
+        jobs.registerThread();
+
+        recordPackets();
+
+        jobs.unregisterThread();
+    }
+
+
+    void VyRenderThread::recordPackets()
+    {
+        while (true)
+        {
+            {
+                UniqueLock<Mutex> lock(m_Mutex);
+
+                // Packets submitted before stopping are still recorded.
+                m_PacketSubmitted.wait(lock, [this]()
+                {
+                    return m_States[ m_ReadIndex ] == EPacketState::Submitted || m_bStopping;
+                });
+
+                if (m_States[ m_ReadIndex ] != EPacketState::Submitted)
+                {
+                    return;
+                }
+
+                m_States[ m_ReadIndex ] = EPacketState::Recording;
+            }
+
+            try
+            {
+                m_Render(m_Packets[ m_ReadIndex ]);
+            }
+            catch (...)
+            {
+                {
+                    LockGuard<Mutex> lock(m_Mutex);
+
+                    m_Error = std::current_exception();
+                }
+
+                m_PacketFreed.notify_all();
+
+                return;
+            }
+
+            {
+                LockGuard<Mutex> lock(m_Mutex);
+
+                m_States[ m_ReadIndex ] = EPacketState::Free;
+                m_ReadIndex             = (m_ReadIndex + 1) % m_Packets.size();
+            }
+
+            m_PacketFreed.notify_all();
+        }
+    }
+
+
+    void VyRenderThread::rethrowError()
+    {
+        if (m_Error)
+        {
+            // The render thread is gone, the error stays so every later call fails as well.
+            std::rethrow_exception(m_Error);
+        }
+    }
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <Vy/GFX/FramePacket.h>
+
+#include <VyLib/VyLib.h>
+#include <VyLib/Util/JobSystem.h>
+
+#include <exception>
+#include <thread>
+
+namespace Vy
+{
+    /**
+     * @brief Records frames on a dedicated thread from double-buffered frame packets.
+     *
+     * The main thread acquires a packet, extracts the scene into it and submits it. The render thread records the
+     * submitted packets in order while the main thread fills the other packet, so simulating frame N+1 overlaps with
+     * recording frame N. Acquiring blocks while both packets are in use.
+     *
+     * @note An exception thrown by the render callback stops the thread and is rethrown by the next call of
+     *       `acquire`, `submit` or `flush` on the main thread.
+     */
+    class VyRenderThread
+    {
+    public:
+        using RenderFn = Function<void(const VyFramePacket& packet)>;
+
+        explicit VyRenderThread(RenderFn render);
+
+        ~VyRenderThread();
+
+        VyRenderThread(const VyRenderThread&)            = delete;
+        VyRenderThread& operator=(const VyRenderThread&) = delete;
+
+        /**
+         * @brief Waits until the next packet is no longer read by the render thread and returns it for writing.
+         */
+        VY_NODISCARD VyFramePacket& acquire();
+
+        /**
+         * @brief Hands the acquired packet to the render thread.
+         */
+        void submit();
+
+        /**
+         * @brief Waits until every submitted packet was recorded.
+         */
+        void flush();
+
+        /**
+         * @brief Records the remaining packets and joins the thread.
+         */
+        void stop();
+
+    private:
+        enum class EPacketState : U8
+        {
+            Free,      // Owned by the main thread.
+            Submitted, // Waiting to be recorded.
+            Recording  // Read by the render thread.
+        };
+
+        void threadLoop();
+        void recordPackets();
+
+        void rethrowError();
+
+        RenderFn                    m_Render;
+
+        TArray<VyFramePacket, 2>    m_Packets;
+        TArray<EPacketState, 2>     m_States{ EPacketState::Free, EPacketState::Free };
+        U32                         m_WriteIndex{ 0 }; // Next packet the main thread fills.
+        U32                         m_ReadIndex { 0 }; // Next packet the render thread records.
+
+        Mutex                       m_Mutex;
+        ConditionVariable           m_PacketSubmitted;
+        ConditionVariable           m_PacketFreed;
+        bool                        m_bStopping{ false };
+        std::exception_ptr          m_Error;
+
+        std::thread                 m_Thread;
+    };
+}
@@ -10,13 +10,34 @@ namespace Vy
         m_Window   { window                          },
         m_VyContext{ VyContext::initialize(m_Window) }
     {
-        recreateSwapchain();
+        if (m_Window.isHeadless())
+        {
+            createOffscreenTargets();
+        }
+        else
+        {
+            recreateSwapchain();
+        }
+
         createCommandBuffers();
+        createTimestampQueries();
     }
 
 
     VyRenderer::~VyRenderer() 
     { 
+        VyContext::waitIdle();
+
+        if (m_TimestampPool != VK_NULL_HANDLE)
+        {
+            vkDestroyQueryPool(VyContext::device(), m_TimestampPool, nullptr);
+        }
+
+        for (auto fence : m_InFlightFences)
+        {
+            vkDestroyFence(VyContext::device(), fence, nullptr);
+        }
+
         freeCommandBuffers(); 
     }
 
@@ -33,7 +54,7 @@ namespace Vy
             
             // While one of the windows dimensions is 0 (e.g. during minimization), wait until otherwise.
             // https://www.glfw.org/docs/3.3/group__window.html#ga554e37d781f0a997656c26b2c56c835e
-            glfwWaitEvents();
+            m_Window.waitEvents();
         }
 
         // Wait until the current swapchain is no longer being used before (re)creating it.
@@ -61,6 +82,108 @@ namespace Vy
     }
 
 
+    // =====================================================================================================================
+
+    void VyRenderer::createOffscreenTargets()
+    {
+        // Same color format the swapchain prefers, so shaders output identical values in both modes.
+        m_Offscreen = MakeUnique<VyOffscreenRenderer>(
+            m_Window, 
+            MAX_FRAMES_IN_FLIGHT, 
+            VyContext::device().findDepthFormat(), 
+            VK_FORMAT_B8G8R8A8_SRGB
+        );
+
+        m_InFlightFences.assign( MAX_FRAMES_IN_FLIGHT, VK_NULL_HANDLE );
+
+        // Specify a signaled fence so the first wait on each frame returns immediately.
+        VkFenceCreateInfo fenceInfo{ VKInit::fenceCreateInfo() };
+        {
+            fenceInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
+        }
+
+        for (auto& fence : m_InFlightFences)
+        {
+            VK_CHECK(vkCreateFence(VyContext::device(), &fenceInfo, nullptr, &fence));
+        }
+
+        VY_INFO_TAG("VyRenderer", "Headless: rendering to {}x{} offscreen targets", 
+            m_Offscreen->extent().width, m_Offscreen->extent().height);
+    }
+
+    // =====================================================================================================================
+
+    void VyRenderer::createTimestampQueries()
+    {
+        const auto& limits = VyContext::device().properties().limits;
+
+        if (!limits.timestampComputeAndGraphics)
+        {
+            VY_WARN_TAG("VyRenderer", "Timestamp queries not supported, GPU frame times are unavailable");
+            
+            return;
+        }
+
+        // The frame is timed on the graphics queue, only the low `timestampValidBits` of its timestamps are meaningful.
+        U32 queueFamilyCount = 0;
+        vkGetPhysicalDeviceQueueFamilyProperties(VyContext::device().physicalDevice(), &queueFamilyCount, nullptr);
+
+        TVector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+        vkGetPhysicalDeviceQueueFamilyProperties(VyContext::device().physicalDevice(), &queueFamilyCount, queueFamilies.data());
+
+        const U32 validBits = queueFamilies[ VyContext::device().graphicsFamily() ].timestampValidBits;
+
+        if (validBits == 0)
+        {
+            VY_WARN_TAG("VyRenderer", "Graphics queue has no valid timestamp bits, GPU frame times are unavailable");
+            
+            return;
+        }
+
+        m_TimestampMask   = validBits >= 64 ? ~U64{ 0 } : (U64{ 1 } << validBits) - 1;
+        m_TimestampPeriod = static_cast<double>(limits.timestampPeriod);
+
+        // Two timestamps (begin, end) per frame in flight.
+        VkQueryPoolCreateInfo queryPoolInfo{ VKInit::queryPoolCreateInfo() };
+        {
+            queryPoolInfo.queryType  = VK_QUERY_TYPE_TIMESTAMP;
+            queryPoolInfo.queryCount = 2 * MAX_FRAMES_IN_FLIGHT;
+        }
+
+        VK_CHECK(vkCreateQueryPool(VyContext::device(), &queryPoolInfo, nullptr, &m_TimestampPool));
+    }
+
+    // =====================================================================================================================
+
+    double VyRenderer::gpuFrameTime(int frameIndex) const
+    {
+        if (m_TimestampPool == VK_NULL_HANDLE || !m_TimestampsWritten[ frameIndex ])
+        {
+            return -1.0;
+        }
+
+        TArray<U64, 2> timestamps{};
+
+        VkResult result = vkGetQueryPoolResults(
+            VyContext::device(), 
+            m_TimestampPool, 
+            2 * frameIndex, 2, 
+            sizeof(timestamps), timestamps.data(), sizeof(U64), 
+            VK_QUERY_RESULT_64_BIT
+        );
+
+        if (result != VK_SUCCESS)
+        {
+            return -1.0;
+        }
+
+        // The counter wraps at `timestampValidBits`, the masked difference stays correct across one wrap.
+        const U64 ticks = ((timestamps[1] & m_TimestampMask) - (timestamps[0] & m_TimestampMask)) & m_TimestampMask;
+
+        return static_cast<double>(ticks) * m_TimestampPeriod * 1e-6;
+    }
+
+
 // =========================================================================================================================
 #pragma region [ Cmd Buffers ]
 // =========================================================================================================================
@@ -112,23 +235,36 @@ namespace Vy
         VY_ASSERT(!m_IsFrameStarted, 
             "Can't call `beginFrame` while frame is already in progress.");
 
-        // Get the index of the frame buffer to render to next.
-        auto result = m_Swapchain->acquireNextImage( &m_CurrentImageIndex );
-        
-        // Recreate swapchain if window was resized.
-        // VK_ERROR_OUT_OF_DATE_KHR occurs when the surface is no longer compatible with the swapchain (e.g. after window is resized).
-        if (result == VK_ERROR_OUT_OF_DATE_KHR) 
+        if (m_Offscreen)
         {
-            VY_DEBUG_TAG("VyRenderer", "beginFrame: Swapchain resized");
-
-            recreateSwapchain();
+            // Wait until the previous submission using this frame's resources has completed.
+            vkWaitForFences(VyContext::device(), 1, &m_InFlightFences[ m_CurrentFrameIndex ], VK_TRUE, UINT64_MAX);
 
-            return VK_NULL_HANDLE;
+            // One offscreen target per frame in flight.
+            m_CurrentImageIndex = static_cast<U32>(m_CurrentFrameIndex);
+            
+            m_Offscreen->setImageIndex(m_CurrentImageIndex);
         }
+        else
+        {
+            // Get the index of the frame buffer to render to next.
+            auto result = m_Swapchain->acquireNextImage( &m_CurrentImageIndex );
+        
+            // Recreate swapchain if window was resized.
+            // VK_ERROR_OUT_OF_DATE_KHR occurs when the surface is no longer compatible with the swapchain (e.g. after window is resized).
+            if (result == VK_ERROR_OUT_OF_DATE_KHR) 
+            {
+                VY_DEBUG_TAG("VyRenderer", "beginFrame: Swapchain resized");
 
-        // VK_SUBOPTIMAL_KHR may be returned if the swapchain no longer matches the surface properties exactly (e.g. if the window was resized).
-        VY_ASSERT(result == VK_SUCCESS || result == VK_SUBOPTIMAL_KHR, 
-            "Failed to aquire swapchain image!");
+                recreateSwapchain();
+
+                return VK_NULL_HANDLE;
+            }
+
+            // VK_SUBOPTIMAL_KHR may be returned if the swapchain no longer matches the surface properties exactly (e.g. if the window was resized).
+            VY_ASSERT(result == VK_SUCCESS || result == VK_SUBOPTIMAL_KHR, 
+                "Failed to aquire swapchain image!");
+        }
 
         m_IsFrameStarted = true;
         
@@ -142,6 +278,12 @@ namespace Vy
         
 		VK_CHECK(vkResetCommandBuffer(cmdBuffer, 0));
 		VK_CHECK(vkBeginCommandBuffer(cmdBuffer, &beginInfo));
+
+        if (m_TimestampPool != VK_NULL_HANDLE)
+        {
+            vkCmdResetQueryPool(cmdBuffer, m_TimestampPool, 2 * m_CurrentFrameIndex, 2);
+            vkCmdWriteTimestamp(cmdBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, m_TimestampPool, 2 * m_CurrentFrameIndex);
+        }
         
         return cmdBuffer;
     }
@@ -155,6 +297,13 @@ namespace Vy
             "Can't call `endFrame` while frame is not in progress.");
         
         auto cmdBuffer = currentCommandBuffer();
+
+        if (m_TimestampPool != VK_NULL_HANDLE)
+        {
+            vkCmdWriteTimestamp(cmdBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, m_TimestampPool, 2 * m_CurrentFrameIndex + 1);
+
+            m_TimestampsWritten[ m_CurrentFrameIndex ] = true;
+        }
         
         // Stop command buffer recording.
         if (vkEndCommandBuffer(cmdBuffer) != VK_SUCCESS) 
@@ -162,6 +311,46 @@ namespace Vy
             VY_THROW_RUNTIME_ERROR("Failed to record command buffer!");
         }
 
+        // Headless: submit straight to the graphics queue, there is nothing to present.
+        if (m_Offscreen)
+        {
+            const auto uploadWait = VyContext::uploader().graphicsWait();
+
+            VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+
+            VkTimelineSemaphoreSubmitInfo timelineInfo{ VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO };
+            {
+                timelineInfo.waitSemaphoreValueCount = 1;
+                timelineInfo.pWaitSemaphoreValues    = &uploadWait.Value;
+            }
+
+            VkSubmitInfo submitInfo{ VKInit::submitInfo() };
+            {
+                submitInfo.pNext              = &timelineInfo;
+                submitInfo.waitSemaphoreCount = 1;
+                submitInfo.pWaitSemaphores    = &uploadWait.Semaphore;
+                submitInfo.pWaitDstStageMask  = &waitStage;
+                submitInfo.commandBufferCount = 1;
+                submitInfo.pCommandBuffers    = &cmdBuffer;
+            }
+
+            vkResetFences(VyContext::device(), 1, &m_InFlightFences[ m_CurrentFrameIndex ]);
+
+            {
+                LockGuard<Mutex> lock{ VyContext::device().queueMutex() };
+
+                VK_CHECK(vkQueueSubmit(VyContext::device().graphicsQueue(), 1, &submitInfo, m_InFlightFences[ m_CurrentFrameIndex ]));
+            }
+
+            m_IsFrameStarted = false;
+
+            m_CurrentFrameIndex = (m_CurrentFrameIndex + 1) % MAX_FRAMES_IN_FLIGHT;
+
+            VyContext::flushDeletionQueue( m_CurrentFrameIndex );
+
+            return;
+        }
+
         // Submit command buffer.
 		// Vulkan will execute the commands in this command buffer
 		// to output that information to the selected frame buffer.
@@ -211,13 +400,17 @@ namespace Vy
             clearValues[1].depthStencil = { 1.0f, 0 };
         }
 
+        const VkExtent2D extent = swapchainExtent();
+
         // Begin render pass.
         VkRenderPassBeginInfo renderPassInfo{ VKInit::renderPassBeginInfo() };
         {
-            renderPassInfo.renderPass        = m_Swapchain->renderPass().handle();
+            renderPassInfo.renderPass        = swapchainRenderPass().handle();
 
             // The frame buffer this render pass will write to.
-            renderPassInfo.framebuffer       = m_Swapchain->frameBuffer(m_CurrentImageIndex).handle();
+            renderPassInfo.framebuffer       = m_Offscreen 
+                ? m_Offscreen->framebuffer(m_CurrentImageIndex).handle() 
+                : m_Swapchain->frameBuffer(m_CurrentImageIndex).handle();
             
             // Defines the area in which the shader loads and stores will take place.
             renderPassInfo.renderArea.offset = { 0, 0 };
@@ -225,7 +418,7 @@ namespace Vy
             // Specify the swap chain extent and not the window extent because for
             // high density displays (e.g. Apple's Retina displays), the size of the
             // window will not be 1:1 with the size of the swap chain.
-            renderPassInfo.renderArea.extent = m_Swapchain->swapchainExtent();
+            renderPassInfo.renderArea.extent = extent;
             
             // Inital values for the frame buffer attatchments to be cleared to.
             // This corresponds to how we've structured our render pass: Index 0 = color attatchment, Index 1 = Depth Attatchment.
@@ -243,8 +436,8 @@ namespace Vy
         vkCmdBeginRenderPass(cmdBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
 
         // Set viewport and scissor rect.
-        VKCmd::viewport(cmdBuffer, m_Swapchain->swapchainExtent());
-        VKCmd::scissor (cmdBuffer, m_Swapchain->swapchainExtent());
+        VKCmd::viewport(cmdBuffer, extent);
+        VKCmd::scissor (cmdBuffer, extent);
     }
 
     // =====================================================================================================================
@@ -2,6 +2,7 @@
 
 #include <Vy/GFX/Context.h>
 #include <Vy/GFX/Backend/Swapchain.h>
+#include <Vy/GFX/Backend/Resources/OffscreenRenderer.h>
 
 #include <Vy/Core/Window.h>
 #include <Vy/GFX/Backend/Resources/Framebuffer.h>
@@ -172,6 +173,7 @@ namespace Vy
          * @brief Constructs a VyRenderer object.
          * 
          * Initializes the renderer by recreating the swapchain and creating command buffers.
+         * If the window is headless, offscreen targets are created instead of a swapchain.
          * 
          * @param window The window to render to.
          */
@@ -196,7 +198,7 @@ namespace Vy
          */
         VyRenderPass& swapchainRenderPass() const 
         { 
-            return m_Swapchain->renderPass(); 
+            return m_Offscreen ? m_Offscreen->renderPass() : m_Swapchain->renderPass(); 
         }
 
         
@@ -207,13 +209,30 @@ namespace Vy
          */
         float aspectRatio() const 
         { 
+            if (m_Offscreen)
+            {
+                return static_cast<float>(m_Offscreen->extent().width ) / 
+                       static_cast<float>(m_Offscreen->extent().height);
+            }
+
             return m_Swapchain->extentAspectRatio();
         }
 
 
         VkExtent2D swapchainExtent() const 
         { 
-            return m_Swapchain->swapchainExtent(); 
+            return m_Offscreen ? m_Offscreen->extent() : m_Swapchain->swapchainExtent(); 
+        }
+
+
+        /**
+         * @brief Checks if the renderer draws into offscreen targets instead of a swapchain.
+         * 
+         * @return True if the renderer was created for a headless window.
+         */
+        bool isHeadless() const 
+        { 
+            return m_Offscreen != nullptr; 
         }
 
 
@@ -259,6 +278,20 @@ namespace Vy
         }
 
 
+        /**
+         * @brief Gets the GPU time of the last submission recorded for a frame index.
+         * 
+         * The time is measured with timestamp queries written at the start and end of the frame's
+         * command buffer. Only valid once that submission has completed, i.e. right after `beginFrame()`
+         * returned the same frame index again, or after waiting for the device to be idle.
+         * 
+         * @param frameIndex The frame index (0 .. MAX_FRAMES_IN_FLIGHT - 1) to read.
+         * 
+         * @return The GPU time in milliseconds, or a negative value if no timing is available.
+         */
+        double gpuFrameTime(int frameIndex) const;
+
+
         /**
          * @brief Begins a new frame for rendering.
          * 
@@ -322,16 +355,33 @@ namespace Vy
          */
         void recreateSwapchain();
 
+        /**
+         * @brief Creates the offscreen color/depth targets and frame fences used instead of a swapchain.
+         */
+        void createOffscreenTargets();
+
+        /**
+         * @brief Creates the timestamp query pool used to measure GPU frame times (if supported).
+         */
+        void createTimestampQueries();
+
     private:
 
-        VyWindow&                  m_Window;
-        VyContext&                 m_VyContext;
+        VyWindow&                          m_Window;
+        VyContext&                         m_VyContext;
+
+        Unique<VySwapchain>                m_Swapchain;
+        Unique<VyOffscreenRenderer>        m_Offscreen;      // Only created in headless mode.
+        TVector<VkFence>                   m_InFlightFences; // Headless frame fences (the swapchain owns its own).
+        TVector<VkCommandBuffer>           m_CommandBuffers;
 
-        Unique<VySwapchain>        m_Swapchain;
-        TVector<VkCommandBuffer>   m_CommandBuffers;
+        VkQueryPool                        m_TimestampPool{ VK_NULL_HANDLE };
+        TArray<bool, MAX_FRAMES_IN_FLIGHT> m_TimestampsWritten{};
+        double                             m_TimestampPeriod{ 0.0 }; // Nanoseconds per timestamp tick.
+        U64                                m_TimestampMask  { 0 };   // Valid bits of the graphics queue timestamps.
 
-        U32                        m_CurrentImageIndex{ 0 }; // Index of the current swap chain image.
-        int                        m_CurrentFrameIndex{ 0 }; // Index of the current frame.
-        bool                       m_IsFrameStarted{ false };
+        U32                                m_CurrentImageIndex{ 0 }; // Index of the current swap chain image.
+        int                                m_CurrentFrameIndex{ 0 }; // Index of the current frame.
+        bool                               m_IsFrameStarted{ false };
     };
 }
\ No newline at end of file
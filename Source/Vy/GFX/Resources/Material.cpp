@@ -12,7 +12,6 @@ namespace Vy
 {
     VyMaterial::VyMaterial()
     {
-        createDefaultTexture();
     }
 
 
@@ -21,48 +20,6 @@ namespace Vy
     }
 
 
-    void VyMaterial::createDefaultTexture() 
-    {
-        // Create a simple 1x1 white texture as default
-        const U32 texWidth    = 1;
-        const U32 texHeight   = 1;
-        const U32 texChannels = 4;
-
-        unsigned char pixels[4] = { 255, 255, 255, 255 }; // White pixel
-
-        VkDeviceSize imageSize = texWidth * texHeight * texChannels;
-
-        // Create staging buffer
-        VyBuffer stagingBuffer{ VyBuffer::stagingBuffer(imageSize) };
-
-        stagingBuffer.singleWrite(pixels);
-
-        // Create image
-        m_DefaultTextureImage = VyImage::Builder{}
-            .imageType  (VK_IMAGE_TYPE_2D)
-            .format     (VK_FORMAT_R8G8B8A8_SRGB)
-            .extent     (VkExtent2D{ texWidth, texHeight })
-            .mipLevels  (1)
-			.arrayLayers(1)
-            .tiling     (VK_IMAGE_TILING_OPTIMAL)
-            .imageLayout(VK_IMAGE_LAYOUT_UNDEFINED)
-            .usage      (VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT)
-            .sampleCount(VK_SAMPLE_COUNT_1_BIT)
-            .sharingMode(VK_SHARING_MODE_EXCLUSIVE)
-            .memoryUsage(VMA_MEMORY_USAGE_AUTO)
-        .build();
-
-        // Transition image layout and copy buffer to image.
-        m_DefaultTextureImage.copyFrom(stagingBuffer);
-
-        // Create image view
-        createTextureImageView(m_DefaultTextureImage, m_DefaultTextureImageView);
-        
-        // Create sampler
-        createTextureSampler(m_DefaultTextureSampler);
-    }
-
-
     void VyMaterial::loadAlbedoTexture(const String& filepath) 
     {
         try 
@@ -83,6 +40,8 @@ namespace Vy
             m_FailedAlbedo = true;
             m_Data.Albedo  = Vec3(1.0f, 0.0f, 1.0f); // pink
         }
+
+        m_Version++;
     }
 
 
@@ -102,6 +61,8 @@ namespace Vy
 
             m_HasNormalTexture = false;
         }
+
+        m_Version++;
     }
 
     
@@ -121,6 +82,8 @@ namespace Vy
 
             m_HasRoughnessTexture = false;
         }
+
+        m_Version++;
     }
 
     
@@ -140,6 +103,8 @@ namespace Vy
 
             m_HasMetallicTexture = false;
         }
+
+        m_Version++;
     }
 
 
@@ -164,13 +129,6 @@ namespace Vy
 			VY_THROW_RUNTIME_ERROR("Failed to load texture image: " + fullPath + " - " + stbi_failure_reason());
 		}
 
-        // Create staging buffer
-        VyBuffer stagingBuffer{ VyBuffer::stagingBuffer(imageSize) };
-
-        stagingBuffer.singleWrite(pixels);
-
-        stbi_image_free(pixels);
-
         // Create image
         image = VyImage::Builder{}
             .imageType  (VK_IMAGE_TYPE_2D)
@@ -186,8 +144,9 @@ namespace Vy
             .memoryUsage(VMA_MEMORY_USAGE_AUTO)
         .build();
 
-        // Transition image layout and copy buffer to image.
-        image.copyFrom(stagingBuffer);
+        VyContext::uploader().uploadImage(image, pixels, imageSize);
+
+        stbi_image_free(pixels);
     }
 
 
@@ -217,50 +176,39 @@ namespace Vy
     }
 
 
-    void VyMaterial::updateDescriptorSet(VyDescriptorSetLayout& setLayout, VyDescriptorPool& pool) 
+    bool VyMaterial::hasTexture(EMaterialTexture texture) const
     {
-        // Create descriptor set if not already created.
-        if (m_DescriptorSet == VK_NULL_HANDLE) 
+        switch (texture)
         {
-            if (!pool.allocateDescriptorSet(setLayout.handle(), m_DescriptorSet)) 
-            {
-                VY_THROW_RUNTIME_ERROR("Failed to allocate material descriptor set!");
-            }
+            case EMaterialTexture::Albedo:    return m_HasAlbedoTexture;
+            case EMaterialTexture::Normal:    return m_HasNormalTexture;
+            case EMaterialTexture::Roughness: return m_HasRoughnessTexture;
+            case EMaterialTexture::Metallic:  return m_HasMetallicTexture;
+            default:                          return false;
         }
+    }
 
-        VkDescriptorImageInfo albedoImageInfo{};
-        {
-            albedoImageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-            albedoImageInfo.imageView   = m_HasAlbedoTexture ? m_AlbedoTextureImageView.handle() : m_DefaultTextureImageView.handle();
-            albedoImageInfo.sampler     = m_HasAlbedoTexture ? m_AlbedoTextureSampler  .handle() : m_DefaultTextureSampler  .handle();
-        }
 
-        VkDescriptorImageInfo normalImageInfo{};
-        {
-            normalImageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-            normalImageInfo.imageView   = m_HasNormalTexture ? m_NormalTextureImageView.handle() : m_DefaultTextureImageView.handle();
-            normalImageInfo.sampler     = m_HasNormalTexture ? m_NormalTextureSampler  .handle() : m_DefaultTextureSampler  .handle();
-        }
+    VkDescriptorImageInfo VyMaterial::descriptorImageInfo(EMaterialTexture texture) const
+    {
+        VY_ASSERT(hasTexture(texture), "Material texture is not loaded");
 
-        VkDescriptorImageInfo roughnessImageInfo{};
-        {
-            roughnessImageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-            roughnessImageInfo.imageView   = m_HasRoughnessTexture ? m_RoughnessTextureImageView.handle() : m_DefaultTextureImageView.handle();
-            roughnessImageInfo.sampler     = m_HasRoughnessTexture ? m_RoughnessTextureSampler  .handle() : m_DefaultTextureSampler  .handle();
-        }
+        const VyImageView* imageView = nullptr;
+        const VySampler*   sampler   = nullptr;
 
-        VkDescriptorImageInfo metallicImageInfo{};
+        switch (texture)
         {
-            metallicImageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-            metallicImageInfo.imageView   = m_HasMetallicTexture ? m_MetallicTextureImageView.handle() : m_DefaultTextureImageView.handle();
-            metallicImageInfo.sampler     = m_HasMetallicTexture ? m_MetallicTextureSampler  .handle() : m_DefaultTextureSampler  .handle();
+            case EMaterialTexture::Albedo:    imageView = &m_AlbedoTextureImageView;    sampler = &m_AlbedoTextureSampler;    break;
+            case EMaterialTexture::Normal:    imageView = &m_NormalTextureImageView;    sampler = &m_NormalTextureSampler;    break;
+            case EMaterialTexture::Roughness: imageView = &m_RoughnessTextureImageView; sampler = &m_RoughnessTextureSampler; break;
+            case EMaterialTexture::Metallic:  imageView = &m_MetallicTextureImageView;  sampler = &m_MetallicTextureSampler;  break;
+            default:                          break;
         }
 
-        VyDescriptorWriter{ setLayout, pool }
-            .writeImage(0, &albedoImageInfo)
-            .writeImage(1, &normalImageInfo)
-            .writeImage(2, &roughnessImageInfo)
-            .writeImage(3, &metallicImageInfo)
-        .update(m_DescriptorSet);
+        return VkDescriptorImageInfo{
+            .sampler     = sampler  ->handle(),
+            .imageView   = imageView->handle(),
+            .imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+        };
     }
 }
\ No newline at end of file
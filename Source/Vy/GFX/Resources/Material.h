@@ -21,6 +21,19 @@ namespace Vy
         float EmissionStrength{ 0.0f };
     };
 
+    /**
+     * @brief Texture slots of a material, in the order of the texture indices in `MaterialData` (Material.frag).
+     */
+    enum class EMaterialTexture : U32
+    {
+        Albedo,
+        Normal,
+        Roughness,
+        Metallic,
+
+        Count
+    };
+
     class VyMaterial 
     {
     public:
@@ -30,29 +43,40 @@ namespace Vy
         VyMaterial(const VyMaterial&)            = delete;
         VyMaterial& operator=(const VyMaterial&) = delete;
 
-        void setAlbedo       (const Vec3& value) { m_Data.Albedo        = value; }
-        void setMetallic     (float       value) { m_Data.Metallic      = value; }
-        void setRoughness    (float       value) { m_Data.Roughness     = value; }
-        void setAO           (float       value) { m_Data.AO            = value; }
-        void setTextureOffset(const Vec2& value) { m_Data.TextureOffset = value; }
-        void setTextureScale (const Vec2& value) { m_Data.TextureScale  = value; }
+        void setAlbedo       (const Vec3& value) { m_Data.Albedo        = value; m_Version++; }
+        void setMetallic     (float       value) { m_Data.Metallic      = value; m_Version++; }
+        void setRoughness    (float       value) { m_Data.Roughness     = value; m_Version++; }
+        void setAO           (float       value) { m_Data.AO            = value; m_Version++; }
+        void setTextureOffset(const Vec2& value) { m_Data.TextureOffset = value; m_Version++; }
+        void setTextureScale (const Vec2& value) { m_Data.TextureScale  = value; m_Version++; }
 
         void loadAlbedoTexture(const String& filepath);
         void loadNormalTexture(const String& filepath);
         void loadRoughnessMap (const String& filepath);
         void loadMetallicMap  (const String& filepath);
 
-        void setEmissionColor   (const Vec3& c)          { m_Data.EmissionColor    = c; }
-        void setEmissionStrength(float s)                { m_Data.EmissionStrength = s; }
-        void setEmission        (const Vec3& c, float s) { m_Data.EmissionColor    = c; m_Data.EmissionStrength = s; }
+        void setEmissionColor   (const Vec3& c)          { m_Data.EmissionColor    = c; m_Version++; }
+        void setEmissionStrength(float s)                { m_Data.EmissionStrength = s; m_Version++; }
+        void setEmission        (const Vec3& c, float s) { m_Data.EmissionColor    = c; m_Data.EmissionStrength = s; m_Version++; }
 
         // Getters
         const VyMaterialData& getData() const { return m_Data; }
         
-        VkDescriptorSet descriptorSet() const 
+        /**
+         * @brief Incremented whenever a parameter is set or a texture is (re)loaded, so the 
+         *        VyMaterialSystem only rewrites the materials that changed. Starts at 1.
+         */
+        U32 version() const 
         { 
-            return m_DescriptorSet; 
+            return m_Version; 
         }
+
+        bool hasTexture(EMaterialTexture texture) const;
+
+        /**
+         * @brief Descriptor of a loaded texture. Must only be called if `hasTexture` is true.
+         */
+        VkDescriptorImageInfo descriptorImageInfo(EMaterialTexture texture) const;
         
         bool hasTextures() const 
         { 
@@ -63,13 +87,9 @@ namespace Vy
                 m_HasMetallicTexture; 
         }
 
-        // Update descriptor set
-        void updateDescriptorSet(VyDescriptorSetLayout& setLayout, VyDescriptorPool& pool);
-
         bool albedoLoadFailed() const { return m_FailedAlbedo; }
 
     private:
-        void createDefaultTexture();
         void createTextureImage(const String& filepath, VyImage& image);
         void createTextureImageView(VyImage& image, VyImageView& imageView);
         void createTextureSampler(VySampler& sampler);
@@ -93,12 +113,7 @@ namespace Vy
         VyImageView    m_MetallicTextureImageView    ;
         VySampler      m_MetallicTextureSampler      ;
 
-        // Default white texture for when no texture is loaded
-        VyImage        m_DefaultTextureImage             ;
-        VyImageView    m_DefaultTextureImageView         ;
-        VySampler      m_DefaultTextureSampler           ;
-
-        VkDescriptorSet m_DescriptorSet = VK_NULL_HANDLE;
+        U32 m_Version = 1;
 
         bool m_HasAlbedoTexture    = false;
         bool m_HasNormalTexture    = false;
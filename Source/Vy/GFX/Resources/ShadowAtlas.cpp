@@ -0,0 +1,380 @@
+#include <Vy/GFX/Resources/ShadowAtlas.h>
+
+#include <Vy/GFX/Context.h>
+
+#include <bit>
+
+namespace Vy
+{
+    VyShadowAtlas::VyShadowAtlas(U32 size, U32 minTileSize, U32 layerCount) :
+        m_Size       { size        },
+        m_MinTileSize{ minTileSize },
+        m_LayerCount { layerCount  }
+    {
+        VY_ASSERT(std::has_single_bit(size) && std::has_single_bit(minTileSize) && minTileSize <= size,
+            "VyShadowAtlas: Size and minimum tile size must be powers of two"
+        );
+
+        m_FreeTiles.resize(levelOf(m_MinTileSize) + 1);
+
+        reset();
+
+        createDepthResources();
+        createRenderPass();
+        createFramebuffers();
+        createSampler();
+    }
+
+
+    VyShadowAtlas::~VyShadowAtlas()
+    {
+        for (VkFramebuffer framebuffer : m_Framebuffers)
+        {
+            vkDestroyFramebuffer(VyContext::device(), framebuffer, nullptr);
+        }
+
+        m_Framebuffers.clear();
+
+        if (m_RenderPass != VK_NULL_HANDLE)
+        {
+            vkDestroyRenderPass(VyContext::device(), m_RenderPass, nullptr);
+
+            m_RenderPass = VK_NULL_HANDLE;
+        }
+    }
+
+    // =====================================================================================================================
+
+    U32 VyShadowAtlas::levelOf(U32 tileSize) const
+    {
+        // Both are powers of two, every level halves the tile size.
+        return static_cast<U32>(std::countr_zero(m_Size / tileSize));
+    }
+
+
+    VyShadowAtlasTile VyShadowAtlas::allocate(U32 tileSize)
+    {
+        const U32 size  = std::clamp(std::bit_ceil(std::max(tileSize, 1u)), m_MinTileSize, m_Size);
+        const U32 level = levelOf(size);
+
+        // Smallest free tile that fits, searching up towards the root.
+        I32 from = static_cast<I32>(level);
+
+        while (from >= 0 && m_FreeTiles[ from ].empty())
+        {
+            from--;
+        }
+
+        if (from < 0)
+        {
+            return VyShadowAtlasTile{};
+        }
+
+        VyShadowAtlasTile tile = m_FreeTiles[ from ].back();
+
+        m_FreeTiles[ from ].pop_back();
+
+        // Split down to the requested size, keeping the top left child. The siblings are pushed so the next
+        // allocation of this level takes them in row order.
+        for (U32 split = static_cast<U32>(from); split < level; split++)
+        {
+            const U32 half = tile.Size / 2;
+
+            TVector<VyShadowAtlasTile>& children = m_FreeTiles[ split + 1 ];
+
+            children.push_back({ tile.X + half, tile.Y + half, half });
+            children.push_back({ tile.X,        tile.Y + half, half });
+            children.push_back({ tile.X + half, tile.Y,        half });
+
+            tile.Size = half;
+        }
+
+        m_UsedTexels += static_cast<U64>(size) * size;
+
+        return tile;
+    }
+
+
+    void VyShadowAtlas::free(const VyShadowAtlasTile& tile)
+    {
+        VY_ASSERT(tile.valid(), "VyShadowAtlas: Freeing an invalid tile");
+
+        m_UsedTexels -= static_cast<U64>(tile.Size) * tile.Size;
+
+        VyShadowAtlasTile current = tile;
+        U32               level   = levelOf(tile.Size);
+
+        // Merge with the siblings while all four children of the parent are free.
+        while (level > 0)
+        {
+            const U32 parentMask = ~(current.Size * 2 - 1);
+
+            const VyShadowAtlasTile parent{ current.X & parentMask, current.Y & parentMask, current.Size * 2 };
+
+            auto isSibling = [&](const VyShadowAtlasTile& other)
+            {
+                return (other.X & parentMask) == parent.X && (other.Y & parentMask) == parent.Y;
+            };
+
+            TVector<VyShadowAtlasTile>& freeTiles = m_FreeTiles[ level ];
+
+            if (std::count_if(freeTiles.begin(), freeTiles.end(), isSibling) < 3)
+            {
+                break;
+            }
+
+            std::erase_if(freeTiles, isSibling);
+
+            current = parent;
+            level--;
+        }
+
+        m_FreeTiles[ level ].push_back(current);
+    }
+
+
+    void VyShadowAtlas::reset()
+    {
+        for (TVector<VyShadowAtlasTile>& freeTiles : m_FreeTiles)
+        {
+            freeTiles.clear();
+        }
+
+        m_FreeTiles[0].push_back({ 0, 0, m_Size });
+
+        m_UsedTexels = 0;
+    }
+
+    // =====================================================================================================================
+
+    void VyShadowAtlas::createDepthResources()
+    {
+        m_DepthImage = VyImage::Builder{}
+            .imageType  (VK_IMAGE_TYPE_2D)
+            .format     (kDepthFormat)
+            .usage      (VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT)
+            .extent     (VkExtent2D{ m_Size, m_Size })
+            .arrayLayers(m_LayerCount)
+            .mipLevels  (1)
+            .sampleCount(VK_SAMPLE_COUNT_1_BIT)
+            .tiling     (VK_IMAGE_TILING_OPTIMAL)
+            .sharingMode(VK_SHARING_MODE_EXCLUSIVE)
+            .memoryUsage(VMA_MEMORY_USAGE_GPU_ONLY)
+        .build();
+
+        m_DepthImageView = VyImageView::Builder{}
+            .viewType   (VK_IMAGE_VIEW_TYPE_2D_ARRAY)
+            .format     (kDepthFormat)
+            .aspectMask (VK_IMAGE_ASPECT_DEPTH_BIT)
+            .arrayLayers(0, m_LayerCount)
+            .mipLevels  (0, 1)
+        .build(m_DepthImage);
+
+        for (U32 layer = 0; layer < m_LayerCount; layer++)
+        {
+            m_LayerImageViews.push_back(VyImageView::Builder{}
+                .viewType   (VK_IMAGE_VIEW_TYPE_2D)
+                .format     (kDepthFormat)
+                .aspectMask (VK_IMAGE_ASPECT_DEPTH_BIT)
+                .arrayLayers(layer, 1)
+                .mipLevels  (0, 1)
+            .build(m_DepthImage));
+        }
+
+        // The render pass loads the atlas in its read only layout, clear it once so tiles never rendered read as lit.
+        VkCommandBuffer cmdBuffer = VyContext::device().beginSingleTimeCommands();
+        {
+            VkImageSubresourceRange range{};
+            {
+                range.aspectMask     = VK_IMAGE_ASPECT_DEPTH_BIT;
+                range.baseMipLevel   = 0;
+                range.levelCount     = 1;
+                range.baseArrayLayer = 0;
+                range.layerCount     = m_LayerCount;
+            }
+
+            VkImageMemoryBarrier barrier{ VKInit::imageMemoryBarrier() };
+            {
+                barrier.oldLayout           = VK_IMAGE_LAYOUT_UNDEFINED;
+                barrier.newLayout           = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+                barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+                barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+                barrier.image               = m_DepthImage;
+                barrier.subresourceRange    = range;
+                barrier.srcAccessMask       = 0;
+                barrier.dstAccessMask       = VK_ACCESS_TRANSFER_WRITE_BIT;
+            }
+
+            vkCmdPipelineBarrier(cmdBuffer,
+                VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                VK_PIPELINE_STAGE_TRANSFER_BIT, 0,
+                0, nullptr,
+                0, nullptr,
+                1, &barrier
+            );
+
+            const VkClearDepthStencilValue clearValue{ 1.0f, 0 };
+
+            vkCmdClearDepthStencilImage(cmdBuffer, m_DepthImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, &clearValue, 1, &range);
+
+            barrier.oldLayout     = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+            barrier.newLayout     = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
+            barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+            vkCmdPipelineBarrier(cmdBuffer,
+                VK_PIPELINE_STAGE_TRANSFER_BIT,
+                VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0,
+                0, nullptr,
+                0, nullptr,
+                1, &barrier
+            );
+        }
+        VyContext::device().endSingleTimeCommands(cmdBuffer);
+    }
+
+
+    void VyShadowAtlas::createSampler()
+    {
+        m_Sampler = VySampler::Builder{}
+            .filters      (VK_FILTER_LINEAR)
+            .mipmapMode   (VK_SAMPLER_MIPMAP_MODE_LINEAR)
+            .addressMode  (VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_BORDER)
+            .enableCompare(VK_COMPARE_OP_LESS)
+            .borderColor  (VK_BORDER_COLOR_FLOAT_OPAQUE_WHITE) // Outside the atlas = no shadow
+            .lodRange     (0.0f, 1.0f)
+            .mipLodBias   (0.0f)
+        .build();
+    }
+
+
+    void VyShadowAtlas::createRenderPass()
+    {
+        // The clear and store only apply to the render area, the tile being rendered. The rest of the atlas must
+        // survive the pass, so the attachment starts in the layout it is sampled in instead of UNDEFINED.
+        VkAttachmentDescription depthAttachment{};
+        {
+            depthAttachment.format         = kDepthFormat;
+            depthAttachment.samples        = VK_SAMPLE_COUNT_1_BIT;
+            depthAttachment.loadOp         = VK_ATTACHMENT_LOAD_OP_CLEAR;
+            depthAttachment.storeOp        = VK_ATTACHMENT_STORE_OP_STORE;
+            depthAttachment.stencilLoadOp  = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+            depthAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+            depthAttachment.initialLayout  = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
+            depthAttachment.finalLayout    = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
+        }
+
+        VkAttachmentReference depthAttachmentRef{};
+        {
+            depthAttachmentRef.attachment = 0;
+            depthAttachmentRef.layout     = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+        }
+
+        VkSubpassDescription subpass{};
+        {
+            subpass.pipelineBindPoint       = VK_PIPELINE_BIND_POINT_GRAPHICS;
+            subpass.colorAttachmentCount    = 0;
+            subpass.pColorAttachments       = nullptr;
+            subpass.pDepthStencilAttachment = &depthAttachmentRef;
+        }
+
+        TArray<VkSubpassDependency, 2> dependencies{};
+        {
+            // The layout transition covers the whole atlas: wait for the last frame's sampling and for the
+            // previous tile's pass. Not by region, the previous writes are outside this tile.
+            dependencies[0].srcSubpass      = VK_SUBPASS_EXTERNAL;
+            dependencies[0].dstSubpass      = 0;
+            dependencies[0].srcStageMask    = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+            dependencies[0].dstStageMask    = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+            dependencies[0].srcAccessMask   = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+            dependencies[0].dstAccessMask   = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+            dependencies[0].dependencyFlags = 0;
+
+            dependencies[1].srcSubpass      = 0;
+            dependencies[1].dstSubpass      = VK_SUBPASS_EXTERNAL;
+            dependencies[1].srcStageMask    = VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+            dependencies[1].dstStageMask    = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+            dependencies[1].srcAccessMask   = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+            dependencies[1].dstAccessMask   = VK_ACCESS_SHADER_READ_BIT;
+            dependencies[1].dependencyFlags = VK_DEPENDENCY_BY_REGION_BIT;
+        }
+
+        VkRenderPassCreateInfo renderPassInfo{ VKInit::renderPassCreateInfo() };
+        {
+            renderPassInfo.attachmentCount = 1;
+            renderPassInfo.pAttachments    = &depthAttachment;
+
+            renderPassInfo.subpassCount    = 1;
+            renderPassInfo.pSubpasses      = &subpass;
+
+            renderPassInfo.dependencyCount = static_cast<U32>(dependencies.size());
+            renderPassInfo.pDependencies   = dependencies.data();
+        }
+
+        if (vkCreateRenderPass(VyContext::device(), &renderPassInfo, nullptr, &m_RenderPass) != VK_SUCCESS)
+        {
+            VY_THROW_RUNTIME_ERROR("Failed to create shadow atlas render pass");
+        }
+    }
+
+
+    void VyShadowAtlas::createFramebuffers()
+    {
+        m_Framebuffers.resize(m_LayerCount, VK_NULL_HANDLE);
+
+        for (U32 layer = 0; layer < m_LayerCount; layer++)
+        {
+            VkFramebufferCreateInfo framebufferInfo{ VKInit::framebufferCreateInfo() };
+            {
+                framebufferInfo.renderPass      = m_RenderPass;
+
+                framebufferInfo.attachmentCount = 1;
+                framebufferInfo.pAttachments    = &m_LayerImageViews[ layer ].handleRef();
+
+                framebufferInfo.width           = m_Size;
+                framebufferInfo.height          = m_Size;
+                framebufferInfo.layers          = 1;
+            }
+
+            if (vkCreateFramebuffer(VyContext::device(), &framebufferInfo, nullptr, &m_Framebuffers[ layer ]) != VK_SUCCESS)
+            {
+                VY_THROW_RUNTIME_ERROR("Failed to create shadow atlas framebuffer");
+            }
+        }
+    }
+
+    // =====================================================================================================================
+
+    void VyShadowAtlas::beginRenderPass(VkCommandBuffer cmdBuffer, const VyShadowAtlasTile& tile, U32 layer, VkSubpassContents contents)
+    {
+        VkClearValue clearValue{};
+        {
+            clearValue.depthStencil = { 1.0f, 0 };
+        }
+
+        VkRenderPassBeginInfo renderPassInfo{ VKInit::renderPassBeginInfo() };
+        {
+            renderPassInfo.renderPass      = m_RenderPass;
+            renderPassInfo.framebuffer     = m_Framebuffers[ layer ];
+
+            renderPassInfo.renderArea      = tile.rect();
+
+            renderPassInfo.clearValueCount = 1;
+            renderPassInfo.pClearValues    = &clearValue;
+        }
+
+        vkCmdBeginRenderPass(cmdBuffer, &renderPassInfo, contents);
+
+        if (contents == VK_SUBPASS_CONTENTS_INLINE)
+        {
+            VKCmd::viewport(cmdBuffer, tile.rect());
+            VKCmd::scissor (cmdBuffer, tile.rect());
+        }
+    }
+
+
+    void VyShadowAtlas::endRenderPass(VkCommandBuffer cmdBuffer)
+    {
+        vkCmdEndRenderPass(cmdBuffer);
+    }
+}
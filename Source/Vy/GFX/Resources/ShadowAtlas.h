@@ -0,0 +1,167 @@
+#pragma once
+
+#include <Vy/GFX/Backend/Device.h>
+
+#include <Vy/GFX/Backend/Image/Image.h>
+#include <Vy/GFX/Backend/Image/ImageView.h>
+#include <Vy/GFX/Backend/Image/Sampler.h>
+
+namespace Vy
+{
+    /**
+     * @brief Square region of a `VyShadowAtlas`, in texels.
+     */
+    struct VyShadowAtlasTile
+    {
+        U32 X   { 0 };
+        U32 Y   { 0 };
+        U32 Size{ 0 }; // 0 if the allocation failed.
+
+        bool valid() const { return Size > 0; }
+
+        VkRect2D rect() const
+        {
+            return VkRect2D{
+                .offset = { static_cast<I32>(X), static_cast<I32>(Y) },
+                .extent = { Size, Size },
+            };
+        }
+
+        bool operator==(const VyShadowAtlasTile&) const = default;
+    };
+
+
+    /**
+     * @brief One depth texture that the 2D shadow maps of all lights are packed into.
+     *
+     * Tiles are power of two squares handed out by a quadtree (buddy) allocator: a free tile is split into four
+     * children until it has the requested size, and four free siblings are merged back into their parent when freed.
+     * Tiles are always aligned to their size, so the atlas never fragments into unusable slivers, and allocating the
+     * same sizes in the same order from an empty atlas always gives the same tiles.
+     *
+     * Every tile is rendered with its own render pass limited to the tile (see `beginRenderPass`), whose clear only
+     * touches the tile, so the other tiles keep their contents. The shaders sample the whole atlas through one
+     * descriptor and map a light's shadow UV into its tile with `uvRect`:
+     *
+     * @code
+     * vec2 atlasUV = uvRect.xy + clamp(shadowUV, halfTexel, 1.0 - halfTexel) * uvRect.zw;
+     * @endcode
+     *
+     * Tiles have no border, so that clamp is what keeps filtering from reading the neighbouring lights.
+     *
+     * The atlas can have several layers with the same tile layout (e.g. cached and per-frame casters), sampled as
+     * one 2D array texture.
+     */
+    class VyShadowAtlas
+    {
+    public:
+        static constexpr VkFormat kDepthFormat = VK_FORMAT_D32_SFLOAT;
+
+        /**
+         * @param size        Width and height of the atlas, a power of two.
+         * @param minTileSize Smallest tile handed out, a power of two.
+         * @param layerCount  Array layers, every tile exists in all of them.
+         */
+        explicit VyShadowAtlas(U32 size = 4096, U32 minTileSize = 256, U32 layerCount = 1);
+
+        ~VyShadowAtlas();
+
+        VyShadowAtlas(const VyShadowAtlas&)            = delete;
+        VyShadowAtlas& operator=(const VyShadowAtlas&) = delete;
+
+        /**
+         * @brief Allocates a tile of `tileSize` (rounded up to a power of two, at least `minTileSize`).
+         *
+         * @return The tile, or an invalid tile if the atlas has no free region of that size left.
+         */
+        VY_NODISCARD VyShadowAtlasTile allocate(U32 tileSize);
+
+        /**
+         * @brief Returns a tile to the atlas, merging it with its free siblings.
+         */
+        void free(const VyShadowAtlasTile& tile);
+
+        /**
+         * @brief Frees every tile.
+         */
+        void reset();
+
+        U32 size()        const { return m_Size;        }
+        U32 minTileSize() const { return m_MinTileSize; }
+        U32 layerCount()  const { return m_LayerCount;  }
+
+        /**
+         * @brief Texels covered by allocated tiles.
+         */
+        U64 usedTexels()  const { return m_UsedTexels;  }
+
+        /**
+         * @brief UV transform of a tile: xy = offset, zw = scale.
+         */
+        Vec4 uvRect(const VyShadowAtlasTile& tile) const
+        {
+            const float invSize = 1.0f / static_cast<float>(m_Size);
+
+            return Vec4(
+                static_cast<float>(tile.X)    * invSize,
+                static_cast<float>(tile.Y)    * invSize,
+                static_cast<float>(tile.Size) * invSize,
+                static_cast<float>(tile.Size) * invSize
+            );
+        }
+
+        VkRenderPass        renderPass()               const { return m_RenderPass;           }
+        VkFramebuffer       framebuffer(U32 layer = 0) const { return m_Framebuffers[ layer ]; }
+        const VyImageView&  imageView()                const { return m_DepthImageView;       } // 2D array of all layers.
+        const VySampler&    sampler()                  const { return m_Sampler;              }
+
+        VkDescriptorImageInfo descriptorImageInfo() const
+        {
+            return VkDescriptorImageInfo{
+                .sampler     = m_Sampler       .handle(),
+                .imageView   = m_DepthImageView.handle(),
+                .imageLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL,
+            };
+        }
+
+        /**
+         * @brief Begins a render pass that clears and renders the tile of a layer only.
+         *
+         * With `VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS` the viewport and scissor are left to the secondary buffers.
+         */
+        void beginRenderPass(
+            VkCommandBuffer          cmdBuffer, 
+            const VyShadowAtlasTile& tile, 
+            U32                      layer    = 0, 
+            VkSubpassContents        contents = VK_SUBPASS_CONTENTS_INLINE
+        );
+
+        void endRenderPass(VkCommandBuffer cmdBuffer);
+
+    private:
+        void createDepthResources();
+        void createRenderPass();
+        void createFramebuffers();
+        void createSampler();
+
+        /**
+         * @brief Quadtree level of a tile size, 0 is the whole atlas.
+         */
+        U32 levelOf(U32 tileSize) const;
+
+        U32 m_Size;
+        U32 m_MinTileSize;
+        U32 m_LayerCount;
+
+        TVector<TVector<VyShadowAtlasTile>> m_FreeTiles; // Per level.
+        U64                                 m_UsedTexels{ 0 };
+
+        VyImage                m_DepthImage;
+        VyImageView            m_DepthImageView;
+        TVector<VyImageView>   m_LayerImageViews; // Per layer, for rendering.
+        VySampler              m_Sampler;
+
+        VkRenderPass           m_RenderPass = VK_NULL_HANDLE;
+        TVector<VkFramebuffer> m_Framebuffers;    // Per layer.
+    };
+}
@@ -196,7 +196,7 @@ namespace Vy
     }
 
 
-    void VyShadowMap::beginRenderPass(VkCommandBuffer cmdBuffer)
+    void VyShadowMap::beginRenderPass(VkCommandBuffer cmdBuffer, VkSubpassContents contents)
     {
         VkClearValue clearValue{};
         {
@@ -215,11 +215,14 @@ namespace Vy
             renderPassInfo.pClearValues      = &clearValue;
         }
 
-        vkCmdBeginRenderPass(cmdBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+        vkCmdBeginRenderPass(cmdBuffer, &renderPassInfo, contents);
 
-        // Set viewport and scissor rect.
-        VKCmd::viewport(cmdBuffer, VkExtent2D{ m_Width, m_Height });
-        VKCmd::scissor (cmdBuffer, VkExtent2D{ m_Width, m_Height });
+        if (contents == VK_SUBPASS_CONTENTS_INLINE)
+        {
+            // Set viewport and scissor rect.
+            VKCmd::viewport(cmdBuffer, VkExtent2D{ m_Width, m_Height });
+            VKCmd::scissor (cmdBuffer, VkExtent2D{ m_Width, m_Height });
+        }
     }
 
 
@@ -238,18 +241,14 @@ namespace Vy
     {
         createDepthResources();
         createRenderPass();
-        createFramebuffers();
+        createFramebuffer();
         createSampler();
     }
 
 
     VyCubeShadowMap::~VyCubeShadowMap()
     {
-        for (int i = 0; i < 6; i++)
-        {
-            vkDestroyFramebuffer(VyContext::device(), m_Framebuffers[i], nullptr);
-        }
-
+        vkDestroyFramebuffer(VyContext::device(), m_Framebuffer, nullptr);
         vkDestroyRenderPass(VyContext::device(), m_RenderPass, nullptr);
     }
 
@@ -281,17 +280,14 @@ namespace Vy
             .arrayLayers(0, 6)
         .build(m_DepthImage);
 
-        // Create individual face image views (for rendering)
-        for (int i = 0; i < 6; i++)
-        {
-            m_FaceImageViews[i] = VyImageView::Builder{}
-                .viewType   (VK_IMAGE_VIEW_TYPE_2D)
-                .format     (m_DepthFormat)
-                .aspectMask (VK_IMAGE_ASPECT_DEPTH_BIT)
-                .mipLevels  (0, 1)
-                .arrayLayers(i, 1)
-            .build(m_DepthImage);
-        }
+        // Create layered image view (for rendering, one layer per view of the multiview pass)
+        m_LayeredImageView = VyImageView::Builder{}
+            .viewType   (VK_IMAGE_VIEW_TYPE_2D_ARRAY)
+            .format     (m_DepthFormat)
+            .aspectMask (VK_IMAGE_ASPECT_DEPTH_BIT)
+            .mipLevels  (0, 1)
+            .arrayLayers(0, kFaceCount)
+        .build(m_DepthImage);
 
         // Transition to READ_ONLY_OPTIMAL initially so it's valid for binding
         VkCommandBuffer cmdBuffer = VyContext::device().beginSingleTimeCommands();
@@ -337,9 +333,9 @@ namespace Vy
             depthAttachment.stencilLoadOp  = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
             depthAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
 
-            // Since we transition per-layer before and after, use same layout
-            depthAttachment.initialLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
-            depthAttachment.finalLayout   = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+            // Every face is cleared, the previous contents are not needed.
+            depthAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+            depthAttachment.finalLayout   = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
         }
 
         VkAttachmentReference depthAttachmentRef{};
@@ -375,8 +371,24 @@ namespace Vy
             dependencies[1].dependencyFlags = VK_DEPENDENCY_BY_REGION_BIT;
         }
 
+        // Broadcast the subpass to the six faces, gl_ViewIndex selects the face in the vertex shader.
+        const U32 viewMask = kViewMask;
+
+        VkRenderPassMultiviewCreateInfo multiviewInfo{};
+        {
+            multiviewInfo.sType                = VK_STRUCTURE_TYPE_RENDER_PASS_MULTIVIEW_CREATE_INFO;
+            multiviewInfo.subpassCount         = 1;
+            multiviewInfo.pViewMasks           = &viewMask;
+
+            // The faces see different geometry, there is nothing to gain from rendering them as correlated views.
+            multiviewInfo.correlationMaskCount = 0;
+            multiviewInfo.pCorrelationMasks    = nullptr;
+        }
+
         VkRenderPassCreateInfo renderPassInfo{ VKInit::renderPassCreateInfo() };
         {
+            renderPassInfo.pNext           = &multiviewInfo;
+
             renderPassInfo.attachmentCount = 1;
             renderPassInfo.pAttachments    = &depthAttachment;
 
@@ -394,26 +406,23 @@ namespace Vy
     }
 
 
-    void VyCubeShadowMap::createFramebuffers()
+    void VyCubeShadowMap::createFramebuffer()
     {
-        for (int i = 0; i < 6; i++)
+        VkFramebufferCreateInfo framebufferInfo{ VKInit::framebufferCreateInfo() };
         {
-            VkFramebufferCreateInfo framebufferInfo{ VKInit::framebufferCreateInfo() };
-            {
-                framebufferInfo.renderPass      = m_RenderPass;
+            framebufferInfo.renderPass      = m_RenderPass;
 
-                framebufferInfo.attachmentCount = 1;
-                framebufferInfo.pAttachments    = &m_FaceImageViews[i].handleRef();
+            framebufferInfo.attachmentCount = 1;
+            framebufferInfo.pAttachments    = &m_LayeredImageView.handleRef();
 
-                framebufferInfo.width           = m_Size;
-                framebufferInfo.height          = m_Size;
-                framebufferInfo.layers          = 1;
-            }
+            framebufferInfo.width           = m_Size;
+            framebufferInfo.height          = m_Size;
+            framebufferInfo.layers          = 1; // Multiview passes address the layers through the view mask.
+        }
 
-            if (vkCreateFramebuffer(VyContext::device(), &framebufferInfo, nullptr, &m_Framebuffers[i]) != VK_SUCCESS)
-            {
-                VY_THROW_RUNTIME_ERROR("Failed to create cube shadow map framebuffer");
-            }
+        if (vkCreateFramebuffer(VyContext::device(), &framebufferInfo, nullptr, &m_Framebuffer) != VK_SUCCESS)
+        {
+            VY_THROW_RUNTIME_ERROR("Failed to create cube shadow map framebuffer");
         }
     }
 
@@ -462,14 +471,14 @@ namespace Vy
         // 90 degree FOV for cube faces
         Mat4 proj = glm::perspective(glm::radians(90.0f), 1.0f, nearPlane, farPlane);
         
-        // Vulkan Y flip
-        proj[1][1] *= -1;
+        // No Y flip: with the face views' ups the first row of a face is the one cube map sampling expects,
+        // flipping it would mirror every face vertically.
         
         return proj;
     }
 
 
-    void VyCubeShadowMap::beginRenderPass(VkCommandBuffer cmdBuffer, int face)
+    void VyCubeShadowMap::beginRenderPass(VkCommandBuffer cmdBuffer, VkSubpassContents contents)
     {
         VkClearValue clearValue{};
         {
@@ -479,7 +488,7 @@ namespace Vy
         VkRenderPassBeginInfo renderPassInfo{ VKInit::renderPassBeginInfo() };
         {
             renderPassInfo.renderPass        = m_RenderPass;
-            renderPassInfo.framebuffer       = m_Framebuffers[face];
+            renderPassInfo.framebuffer       = m_Framebuffer;
             
             renderPassInfo.renderArea.offset = {0, 0};
             renderPassInfo.renderArea.extent = {m_Size, m_Size};
@@ -488,78 +497,19 @@ namespace Vy
             renderPassInfo.pClearValues      = &clearValue;
         }
 
-        vkCmdBeginRenderPass(cmdBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
-
-        // Set viewport and scissor rect.
-        VKCmd::viewport(cmdBuffer, VkExtent2D{ m_Size, m_Size });
-        VKCmd::scissor (cmdBuffer, VkExtent2D{ m_Size, m_Size });
-    }
-
+        vkCmdBeginRenderPass(cmdBuffer, &renderPassInfo, contents);
 
-    void VyCubeShadowMap::endRenderPass(VkCommandBuffer cmdBuffer)
-    {
-        vkCmdEndRenderPass(cmdBuffer);
-    }
-
-
-    void VyCubeShadowMap::transitionToAttachmentLayout(VkCommandBuffer cmdBuffer)
-    {
-        // Transition ALL 6 layers from shader read (or undefined) to attachment optimal
-        VkImageMemoryBarrier barrier{ VKInit::imageMemoryBarrier() };
+        if (contents == VK_SUBPASS_CONTENTS_INLINE)
         {
-            barrier.oldLayout                       = VK_IMAGE_LAYOUT_UNDEFINED; // Don't care about previous contents
-            barrier.newLayout                       = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
-            barrier.srcQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
-            barrier.dstQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
-            barrier.image                           = m_DepthImage;
-
-            barrier.subresourceRange.aspectMask     = VK_IMAGE_ASPECT_DEPTH_BIT;
-            barrier.subresourceRange.baseMipLevel   = 0;
-            barrier.subresourceRange.levelCount     = 1;
-            barrier.subresourceRange.baseArrayLayer = 0;
-            barrier.subresourceRange.layerCount     = 6; // All 6 faces
-            
-            barrier.srcAccessMask = VK_ACCESS_SHADER_READ_BIT;
-            barrier.dstAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+            // Set viewport and scissor rect.
+            VKCmd::viewport(cmdBuffer, VkExtent2D{ m_Size, m_Size });
+            VKCmd::scissor (cmdBuffer, VkExtent2D{ m_Size, m_Size });
         }
-
-        vkCmdPipelineBarrier(cmdBuffer,
-            VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
-            VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT, 0,
-            0, nullptr,
-            0, nullptr,
-            1, &barrier
-        );
     }
 
 
-    void VyCubeShadowMap::transitionToShaderReadLayout(VkCommandBuffer cmdBuffer)
+    void VyCubeShadowMap::endRenderPass(VkCommandBuffer cmdBuffer)
     {
-        // Transition ALL 6 layers from attachment optimal to shader read
-        VkImageMemoryBarrier barrier{ VKInit::imageMemoryBarrier() };
-        {
-            barrier.oldLayout                       = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
-            barrier.newLayout                       = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
-            barrier.srcQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
-            barrier.dstQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
-            barrier.image                           = m_DepthImage;
-
-            barrier.subresourceRange.aspectMask     = VK_IMAGE_ASPECT_DEPTH_BIT;
-            barrier.subresourceRange.baseMipLevel   = 0;
-            barrier.subresourceRange.levelCount     = 1;
-            barrier.subresourceRange.baseArrayLayer = 0;
-            barrier.subresourceRange.layerCount     = 6; // All 6 faces
-            
-            barrier.srcAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
-            barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-        }
-
-        vkCmdPipelineBarrier(cmdBuffer,
-            VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
-            VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0,
-            0, nullptr,
-            0, nullptr,
-            1, &barrier
-        );
+        vkCmdEndRenderPass(cmdBuffer);
     }
 }
\ No newline at end of file
@@ -42,8 +42,10 @@ namespace Vy
 
         /**
          * @brief Begin shadow map render pass
+         * 
+         * With `VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS` the viewport and scissor are left to the secondary buffers.
          */
-        void beginRenderPass(VkCommandBuffer cmdBuffer);
+        void beginRenderPass(VkCommandBuffer cmdBuffer, VkSubpassContents contents = VK_SUBPASS_CONTENTS_INLINE);
 
         /**
          * @brief End shadow map render pass
@@ -76,10 +78,23 @@ namespace Vy
      *
      * Creates a depth cube map (6 faces) for point light shadow mapping.
      * Each face captures depth from the light's position in one direction.
+     *
+     * All six faces are rendered in a single multiview render pass: the pass broadcasts every draw to the six layers
+     * and the vertex shader picks the face with `gl_ViewIndex` (see CubeShadow.vert), so a caster is recorded once
+     * instead of once per face.
+     *
+     * The faces follow the cube map conventions of Vulkan (no Y flip in `projectionMatrix`), so the lighting
+     * shaders sample the map with the light to fragment direction.
+     *
+     * @note The multiview pass, alone or with the secondary command buffers of `VyParallelRecorder`, has not been
+     *       run on a device, and its savings have not been measured.
      */
     class VyCubeShadowMap
     {
     public:
+        static constexpr U32 kFaceCount = 6;
+        static constexpr U32 kViewMask  = (1u << kFaceCount) - 1; // Every face.
+
         VyCubeShadowMap(U32 size = 1024);
 
         ~VyCubeShadowMap();
@@ -87,24 +102,16 @@ namespace Vy
         VyCubeShadowMap(const VyCubeShadowMap&)            = delete;
         VyCubeShadowMap& operator=(const VyCubeShadowMap&) = delete;
 
-        VkRenderPass       renderPass()    const { return m_RenderPass;    }
+        VkRenderPass       renderPass()    const { return m_RenderPass;    } // Multiview, all faces.
+        VkFramebuffer      framebuffer()   const { return m_Framebuffer;   }
         const VyImageView& cubeImageView()       { return m_CubeImageView; }
         const VySampler&   sampler()             { return m_Sampler;       }
         U32                size()          const { return m_Size;          }
 
-        /**
-         * @brief Get framebuffer for a specific cube face
-         * @param face Face index (0-5: +X, -X, +Y, -Y, +Z, -Z)
-         */
-        VkFramebuffer framebuffer(int face) const 
-        { 
-            return m_Framebuffers[face]; 
-        }
-
         /**
          * @brief Get view matrix for a specific cube face
          * @param lightPos Position of the point light
-         * @param face Face index (0-5)
+         * @param face Face index (0-5: +X, -X, +Y, -Y, +Z, -Z)
          */
         static Mat4 faceViewMatrix(const Vec3& lightPos, int face);
 
@@ -125,21 +132,12 @@ namespace Vy
         }
 
         /**
-         * @brief Transition all faces to attachment optimal before rendering
-         * Call this ONCE before rendering all 6 faces
+         * @brief Begin the render pass that clears and renders all six faces
+         * 
+         * The faces are left in `VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL` when the pass ends.
+         * With `VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS` the viewport and scissor are left to the secondary buffers.
          */
-        void transitionToAttachmentLayout(VkCommandBuffer cmdBuffer);
-
-        /**
-         * @brief Transition all faces to shader read layout after rendering
-         * Call this ONCE after rendering all 6 faces
-         */
-        void transitionToShaderReadLayout(VkCommandBuffer cmdBuffer);
-
-        /**
-         * @brief Begin render pass for a specific cube face
-         */
-        void beginRenderPass(VkCommandBuffer cmdBuffer, int face);
+        void beginRenderPass(VkCommandBuffer cmdBuffer, VkSubpassContents contents = VK_SUBPASS_CONTENTS_INLINE);
 
         /**
          * @brief End render pass
@@ -149,20 +147,18 @@ namespace Vy
     private:
         void createDepthResources();
         void createRenderPass();
-        void createFramebuffers();
+        void createFramebuffer();
         void createSampler();
 
         U32 m_Size;
 
         VyImage        m_DepthImage;
-        VyImageView    m_CubeImageView;     // View for the entire cube
-        VyImageView    m_FaceImageViews[6]; // Views for each face
+        VyImageView    m_CubeImageView;     // View for the entire cube (sampling)
+        VyImageView    m_LayeredImageView;  // 2D array of the six faces (rendering)
         VySampler      m_Sampler;
 
         VkRenderPass   m_RenderPass        = VK_NULL_HANDLE;
-        VkFramebuffer  m_Framebuffers[6]   = {VK_NULL_HANDLE};
+        VkFramebuffer  m_Framebuffer       = VK_NULL_HANDLE;
         VkFormat       m_DepthFormat       = VK_FORMAT_D32_SFLOAT;
-
-        VkImage depthImage() const { return m_DepthImage; }
     };
-}
\ No newline at end of file
+}
@@ -52,83 +52,95 @@ namespace Vy
 
     VyStaticMesh::VyStaticMesh(TVector<VyVertex>& vertices, TVector<U32>& indices)
     {
-        createVertexBuffers(vertices);
-        createIndexBuffers(indices);
+        computeBounds(vertices);
+
+        createGeometry(vertices, indices);
     }
 
 
     VyStaticMesh::~VyStaticMesh() 
     {
+        if (m_Geometry != kInvalidGeometry)
+        {
+            VyContext::geometry().free(m_Geometry);
+        }
     }
 
 
-    void VyStaticMesh::createVertexBuffers(TVector<VyVertex>& vertices) 
+    void VyStaticMesh::computeBounds(const TVector<VyVertex>& vertices)
     {
-        m_VertexCount = static_cast<U32>(vertices.size());
+        m_Bounds = VyAABB{};
 
-        VY_ASSERT(m_VertexCount >= 3, "Vertex count must be at least 3");
-
-        VkDeviceSize bufferSize = sizeof(vertices[0]) * m_VertexCount;
-        U32          vertexSize = sizeof(vertices[0]);
+        for (const auto& vertex : vertices)
+        {
+            m_Bounds.expand(vertex.Position);
+        }
 
-        VyBuffer stagingBuffer{ VyBuffer::stagingBuffer(vertexSize, m_VertexCount) };
+        // Sphere around the box center, tighter than the box's circumscribed sphere.
+        float radiusSq = 0.0f;
+        Vec3  center   = m_Bounds.center();
 
-        stagingBuffer.map();
-        stagingBuffer.writeToBuffer((void*)vertices.data(), bufferSize);
+        for (const auto& vertex : vertices)
+        {
+            Vec3 offset = vertex.Position - center;
 
-        m_VertexBuffer = MakeUnique<VyBuffer>( VyBuffer::vertexBuffer(vertexSize, m_VertexCount), false );
+            radiusSq = glm::max(radiusSq, glm::dot(offset, offset));
+        }
 
-        VyContext::device().copyBuffer(stagingBuffer.handle(), m_VertexBuffer->handle(), bufferSize);
+        m_BoundingSphere = VyBoundingSphere{
+            .Center = center,
+            .Radius = glm::sqrt(radiusSq)
+        };
     }
 
 
-    void VyStaticMesh::createIndexBuffers(TVector<U32>& indices) 
+    void VyStaticMesh::createGeometry(TVector<VyVertex>& vertices, TVector<U32>& indices) 
     {
-        m_IndexCount = static_cast<U32>(indices.size());
+        m_VertexCount = static_cast<U32>(vertices.size());
+        m_IndexCount  = static_cast<U32>(indices.size());
 
-        if (m_IndexCount <= 0)
-        {
-            return;
-        }
+        VY_ASSERT(m_VertexCount >= 3, "Vertex count must be at least 3");
 
-        VkDeviceSize bufferSize = sizeof(indices[0]) * m_IndexCount;
-        U32          indexSize  = sizeof(indices[0]);
+        m_Geometry = VyContext::geometry().allocate(vertices.data(), m_VertexCount, indices.data(), m_IndexCount);
+    }
 
-        VyBuffer stagingBuffer{ VyBuffer::stagingBuffer(indexSize, m_IndexCount) };
 
-        stagingBuffer.map();
-        stagingBuffer.writeToBuffer((void*)indices.data(), bufferSize);
+    VyGeometryRange VyStaticMesh::geometryRange() const
+    {
+        return VyContext::geometry().range(m_Geometry);
+    }
 
-        m_IndexBuffer = MakeUnique<VyBuffer>( VyBuffer::indexBuffer(indexSize, m_IndexCount), false );
 
-        VyContext::device().copyBuffer(stagingBuffer.handle(), m_IndexBuffer->handle(), bufferSize);
+    void VyStaticMesh::draw(VkCommandBuffer cmdBuffer) 
+    {
+        draw(cmdBuffer, 1, 0);
     }
 
 
-    void VyStaticMesh::draw(VkCommandBuffer cmdBuffer) 
+    void VyStaticMesh::draw(VkCommandBuffer cmdBuffer, U32 instanceCount, U32 firstInstance) 
     {
-        if (m_IndexBuffer) 
+        const VyGeometryRange range = geometryRange();
+
+        if (hasIndices()) 
         {
-            vkCmdDrawIndexed(cmdBuffer, m_IndexCount, 1, 0, 0, 0);
+            vkCmdDrawIndexed(cmdBuffer, m_IndexCount, instanceCount, range.FirstIndex, static_cast<I32>(range.FirstVertex), firstInstance);
         } 
         else 
         {
-            vkCmdDraw(cmdBuffer, m_VertexCount, 1, 0, 0);
+            vkCmdDraw(cmdBuffer, m_VertexCount, instanceCount, range.FirstVertex, firstInstance);
         }
     }
 
 
     void VyStaticMesh::bind(VkCommandBuffer cmdBuffer) 
     {
-        VkBuffer     buffers[] = { m_VertexBuffer->handle() };
-        VkDeviceSize offsets[] = { 0 };
+        VyContext::geometry().bind(cmdBuffer);
+    }
 
-        vkCmdBindVertexBuffers(cmdBuffer, 0, 1, buffers, offsets);
 
-        if (m_IndexBuffer) 
-        {
-            vkCmdBindIndexBuffer(cmdBuffer, m_IndexBuffer->handle(), 0, VK_INDEX_TYPE_UINT32);
-        }
+    void VyStaticMesh::bind(VyCommandContext& context)
+    {
+        VyContext::geometry().bind(context);
     }
 
 
@@ -1,7 +1,9 @@
 #pragma once
 
 #include <Vy/GFX/Backend/Device.h>
-#include <Vy/GFX/Backend/Buffer/Buffer.h>
+#include <Vy/GFX/Backend/Buffer/GeometryBuffer.h>
+
+#include <Vy/Math/Bounds.h>
 
 #include <VyLib/Util/Hash.h>
 
@@ -16,6 +18,8 @@ struct aiMaterial;
 
 namespace Vy
 {
+    class VyCommandContext;
+
     /**
      * @struct VyVertex
      *
@@ -90,11 +94,18 @@ namespace Vy
         VyStaticMesh& operator=(const VyStaticMesh&) = delete;
 
         /**
-         * @brief Binds the model's vertex and index buffers to a command buffer.
+         * @brief Binds the geometry arenas holding the model's vertices and indices to a command buffer.
+         * 
+         * @note Every mesh lives in the same arenas, a bind is valid for the draws of all meshes.
          * 
          * @param cmdBuffer The Vulkan command buffer.
          */
         void bind(VkCommandBuffer cmdBuffer);
+
+        /**
+         * @brief Binds the geometry arenas through a command context, skipped if already bound.
+         */
+        void bind(VyCommandContext& context);
         
         /**
          * @brief Draws the model using the bound buffers.
@@ -103,23 +114,52 @@ namespace Vy
          */
         void draw(VkCommandBuffer cmdBuffer);
 
+        /**
+         * @brief Draws multiple instances of the model using the bound buffers.
+         * 
+         * @param cmdBuffer     The Vulkan command buffer.
+         * @param instanceCount The number of instances to draw.
+         * @param firstInstance The first instance index (offsets `gl_InstanceIndex`).
+         */
+        void draw(VkCommandBuffer cmdBuffer, U32 instanceCount, U32 firstInstance);
+
+        VY_NODISCARD U32  vertexCount() const { return m_VertexCount; }
+        VY_NODISCARD U32  indexCount()  const { return m_IndexCount; }
+        VY_NODISCARD bool hasIndices()  const { return m_IndexCount > 0; }
+
+        /**
+         * @brief Gets the current location of the vertices and indices in the geometry arenas.
+         */
+        VY_NODISCARD VyGeometryRange geometryRange() const;
+
+        /**
+         * @brief Gets the local space bounding box of the mesh, computed from the vertices at build time.
+         */
+        const VyAABB& bounds() const { return m_Bounds; }
+
+        /**
+         * @brief Gets the local space bounding sphere of the mesh, computed from the vertices at build time.
+         */
+        const VyBoundingSphere& boundingSphere() const { return m_BoundingSphere; }
+
     private:
         /**
-         * @brief Creates and allocates vertex buffers.
+         * @brief Computes the local bounding box and sphere of the vertices.
          */
-        void createVertexBuffers(TVector<VyVertex>& vertices);
+        void computeBounds(const TVector<VyVertex>& vertices);
 
         /**
-         * @brief Creates and allocates index buffers.
+         * @brief Allocates the vertices and indices in the geometry arenas and uploads them.
          */
-        void createIndexBuffers(TVector<U32>& indices);
+        void createGeometry(TVector<VyVertex>& vertices, TVector<U32>& indices);
 
 
-        Unique<VyBuffer> m_VertexBuffer;
-        U32              m_VertexCount;
+        VyGeometryHandle m_Geometry{ kInvalidGeometry };
+        U32              m_VertexCount{ 0 };
+        U32              m_IndexCount { 0 };
 
-        Unique<VyBuffer> m_IndexBuffer;
-        U32              m_IndexCount;
+        VyAABB           m_Bounds{};
+        VyBoundingSphere m_BoundingSphere{};
     };
 }
 
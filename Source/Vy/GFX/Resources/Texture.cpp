@@ -59,15 +59,6 @@ namespace Vy
 		// Calculate mip levels
 		m_MipLevels = static_cast<U32>(std::floor(std::log2(std::max(m_Width, m_Height)))) + 1;
 
-		// Create staging buffer
-		VyBuffer stagingBuffer{ VyBuffer::stagingBuffer(imageSize) };
-
-		stagingBuffer.map();
-		stagingBuffer.writeToBuffer(pPixels);
-		stagingBuffer.unmap();
-
-		stbi_image_free(pPixels);
-
 		// Choose format based on whether this is an sRGB texture (color) or linear (data)
 		VkFormat format = bSRGB ? VK_FORMAT_R8G8B8A8_SRGB : VK_FORMAT_R8G8B8A8_UNORM;
 
@@ -85,11 +76,10 @@ namespace Vy
             .memoryUsage(VMA_MEMORY_USAGE_AUTO)
         .build();
 
-		// Transition image layout and copy buffer to image.
-		m_Image.copyFrom(stagingBuffer, false /*toShaderReadOnly*/);
+		// Upload the first level and generate the mipmaps (this also transitions to SHADER_READ_ONLY_OPTIMAL).
+		VyContext::uploader().uploadImage(m_Image, pPixels, imageSize, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, true /*bGenerateMipmaps*/);
 
-		// Generate mipmaps (this also transitions to SHADER_READ_ONLY_OPTIMAL)
-		m_Image.generateMipmaps(VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+		stbi_image_free(pPixels);
 
 		// Create image view and sampler
 		createImageView(format);
@@ -113,13 +103,6 @@ namespace Vy
 
 		m_MipLevels = 1; // No mipmaps for default textures
 
-		// Create staging buffer
-		VyBuffer stagingBuffer{ VyBuffer::stagingBuffer(imageSize) };
-
-		stagingBuffer.map();
-		stagingBuffer.writeToBuffer((void*)pPixels);
-		stagingBuffer.unmap();
-
 		// Create Vulkan image
         m_Image = VyImage::Builder{}
             .imageType  (VK_IMAGE_TYPE_2D)
@@ -134,8 +117,7 @@ namespace Vy
             .memoryUsage(VMA_MEMORY_USAGE_AUTO)
         .build();
 
-		// Transition image layout and copy buffer to image.
-		m_Image.copyFrom(stagingBuffer, true /*toShaderReadOnly*/);
+		VyContext::uploader().uploadImage(m_Image, pPixels, imageSize);
 
 		// Create image view and sampler
 		createImageView(format);
@@ -14,6 +14,7 @@
 
 #define ENGINE_DIR PROJECT_DIR "/"
 #define SHADER_DIR BUILD_DIR   "/Data/Shaders/"
+#define CACHE_DIR  BUILD_DIR   "/Cache/"
 #define ASSETS_DIR ENGINE_DIR  "Data/"
 #define SCENES_DIR ASSETS_DIR  "Scenes/"
 #define MODELS_DIR ASSETS_DIR  "Models/"
@@ -1,23 +1,243 @@
-
 #include <Vy/Engine.h>
+#include <Vy/Math/TransformBatch.h>
 
+#include <algorithm>
+#include <charconv>
+#include <cmath>
 #include <cstdlib>
 #include <iostream>
+#include <optional>
 #include <stdexcept>
+#include <string_view>
+
+/**
+ * @brief Parses a strictly positive number, the whole string must be the number.
+ */
+template <typename T>
+static bool parsePositive(std::string_view text, T& out)
+{
+    T parsed{};
+
+    const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), parsed);
+
+    if (error != std::errc{} || end != text.data() + text.size() || !(parsed > T{ 0 }))
+    {
+        return false;
+    }
+
+    if constexpr (std::is_floating_point_v<T>)
+    {
+        if (!std::isfinite(parsed))
+        {
+            return false;
+        }
+    }
+
+    out = parsed;
+
+    return true;
+}
+
+
+/**
+ * @brief Parses the headless benchmark options and checks that every other argument is a known flag.
+ *
+ * --headless            Render offscreen without a window.
+ * --frames <count>      Number of frames to render.
+ * --dt <seconds>        Fixed time step.
+ * --width  <pixels>     Render target width.
+ * --height <pixels>     Render target height.
+ * --output <path>       JSON file the frame timings are written to.
+ *
+ * @return The settings, or nothing (the error is logged) if an argument is unknown, misses its value, or a value is
+ *         not a positive number.
+ */
+static std::optional<Vy::VyHeadlessSettings> parseHeadlessSettings(int argc, char** argv)
+{
+    // Flags parsed by the other parse functions, validated here so a typo is not silently ignored.
+    static constexpr std::string_view kFlags[]      = { "--no-occlusion", "--deferred", "--inline-recording", "--sequential-systems" };
+    static constexpr std::string_view kValueFlags[] = { "--render-path", "--bench-transforms" };
+
+    Vy::VyHeadlessSettings settings{};
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string_view arg{ argv[i] };
+
+        if (arg == "--headless")
+        {
+            settings.Enabled = true;
+
+            continue;
+        }
+
+        if (std::ranges::find(kFlags, arg) != std::end(kFlags))
+        {
+            continue;
+        }
+
+        const bool bHeadlessValue = 
+            arg == "--frames" || arg == "--dt"     || 
+            arg == "--width"  || arg == "--height" || 
+            arg == "--output";
+
+        if (!bHeadlessValue && std::ranges::find(kValueFlags, arg) == std::end(kValueFlags))
+        {
+            VY_ERROR_TAG("Main", "Unknown argument '{}'", arg);
+
+            return std::nullopt;
+        }
+
+        if (i + 1 >= argc)
+        {
+            VY_ERROR_TAG("Main", "Missing value for '{}'", arg);
+
+            return std::nullopt;
+        }
+
+        std::string_view value{ argv[++i] };
+
+        bool bValid = true;
+
+        if      (arg == "--frames") { bValid = parsePositive(value, settings.FrameCount); }
+        else if (arg == "--dt")     { bValid = parsePositive(value, settings.DeltaTime);  }
+        else if (arg == "--width")  { bValid = parsePositive(value, settings.Width);      }
+        else if (arg == "--height") { bValid = parsePositive(value, settings.Height);     }
+        else if (arg == "--output") { bValid = !value.empty(); settings.OutputPath = value; }
+        else if (arg == "--render-path")
+        {
+            if (value != "cpu" && value != "gpu")
+            {
+                VY_ERROR_TAG("Main", "Invalid value '{}' for '{}', expected cpu or gpu", value, arg);
+
+                return std::nullopt;
+            }
+        }
+
+        if (!bValid)
+        {
+            VY_ERROR_TAG("Main", "Invalid value '{}' for '{}', expected a positive number", value, arg);
+
+            return std::nullopt;
+        }
+    }
+
+    return settings;
+}
+
+
+static bool hasFlag(int argc, char** argv, std::string_view flag)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        if (std::string_view{ argv[i] } == flag)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+/**
+ * @brief Parses the main pass render path.
+ *
+ * --render-path <cpu|gpu>  CPU culled instanced draws (default) or GPU culled indirect draws.
+ * --no-occlusion           Disables the HZB occlusion culling of the GPU path.
+ */
+static Vy::ERenderPath parseRenderPath(int argc, char** argv)
+{
+    for (int i = 1; i + 1 < argc; i++)
+    {
+        if (std::string_view{ argv[i] } == "--render-path")
+        {
+            return std::string_view{ argv[i + 1] } == "gpu" ? Vy::ERenderPath::GPUDriven : Vy::ERenderPath::CPU;
+        }
+    }
+
+    return Vy::ERenderPath::CPU;
+}
+
+
+/**
+ * @brief Runs the transform batch microbenchmark instead of the engine when requested.
+ *
+ * --bench-transforms <count>  Converts <count> random transforms with the scalar and the SIMD path and logs the timings.
+ *
+ * @return True if the benchmark ran.
+ */
+static bool runTransformBenchmark(int argc, char** argv)
+{
+    for (int i = 1; i + 1 < argc; i++)
+    {
+        if (std::string_view{ argv[i] } != "--bench-transforms")
+        {
+            continue;
+        }
+
+        const auto count  = static_cast<Vy::U32>(std::strtoul(argv[i + 1], nullptr, 10));
+        const auto result = Vy::TransformBatch::benchmark(count, 100);
+
+        VY_INFO_TAG("Main", "Transform batch: {} transforms, {} iterations", result.Count, result.Iterations);
+        VY_INFO_TAG("Main", "  Scalar: {:.4f} ms", result.ScalarMs);
+        VY_INFO_TAG("Main", "  {:<6}: {:.4f} ms ({:.2f}x)", Vy::TransformBatch::pathName(result.Path), result.SimdMs, result.ScalarMs / result.SimdMs);
+        VY_INFO_TAG("Main", "  Bit exact: {}", result.bBitExact);
+
+        return true;
+    }
 
-int main() 
+    return false;
+}
+
+
+int main(int argc, char** argv)
 {
     Vy::VyLogger::init();
-    
-    Vy::VyEngine app{};
 
-    try 
+    if (runTransformBenchmark(argc, argv))
+    {
+        Vy::VyLogger::shutdown();
+
+        return EXIT_SUCCESS;
+    }
+
+    const auto headless = parseHeadlessSettings(argc, argv);
+
+    if (!headless)
+    {
+        Vy::VyLogger::shutdown();
+
+        return EXIT_FAILURE;
+    }
+
+    Vy::VyEngine app{ *headless };
+
+    try
     {
         app.initialize();
 
+        app.renderSystem().setRenderPath(parseRenderPath(argc, argv));
+        app.renderSystem().setOcclusionCulling(!hasFlag(argc, argv, "--no-occlusion"));
+
+        // --deferred  Lights the CPU render path from a G-buffer instead of in the material pass.
+        if (hasFlag(argc, argv, "--deferred"))
+        {
+            app.renderSystem().setShadingPath(Vy::EShadingPath::Deferred);
+        }
+
+        // --inline-recording  Records every draw into the primary command buffer on the render thread.
+        app.renderSystem().setParallelRecording(!hasFlag(argc, argv, "--inline-recording"));
+
+        // --sequential-systems  Runs the logic systems one after another, deterministic order for debugging.
+        if (hasFlag(argc, argv, "--sequential-systems"))
+        {
+            app.scene().setLogicScheduling(Vy::ELogicScheduling::Sequential);
+        }
+
         app.run();
-    } 
-    catch (const std::exception& e) 
+    }
+    catch (const std::exception& e)
     {
         VY_ERROR_TAG("Main", "VyEngine failed to start - Error: {}", e.what());
 
@@ -27,4 +247,4 @@ int main()
     Vy::VyLogger::shutdown();
 
     return EXIT_SUCCESS;
-}
\ No newline at end of file
+}
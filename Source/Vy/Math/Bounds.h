@@ -0,0 +1,117 @@
+#pragma once
+
+#include <VyLib/VyLib.h>
+
+#include <limits>
+
+namespace Vy
+{
+    /**
+     * @brief Bounding sphere used for visibility tests.
+     */
+    struct VyBoundingSphere
+    {
+        Vec3  Center{ 0.0f };
+        float Radius{ 0.0f };
+
+        /**
+         * @brief Transforms the sphere by an affine matrix.
+         *
+         * The radius is scaled by the largest axis scale so the result always encloses
+         * the transformed geometry (non-uniform scale makes it conservative).
+         */
+        VY_NODISCARD VyBoundingSphere transformed(const Mat4& matrix) const
+        {
+            float maxScaleSq = glm::max(
+                glm::dot(Vec3(matrix[0]), Vec3(matrix[0])), glm::max(
+                glm::dot(Vec3(matrix[1]), Vec3(matrix[1])),
+                glm::dot(Vec3(matrix[2]), Vec3(matrix[2])))
+            );
+
+            return VyBoundingSphere{
+                .Center = Vec3(matrix * Vec4(Center, 1.0f)),
+                .Radius = Radius * glm::sqrt(maxScaleSq)
+            };
+        }
+    };
+
+
+    /**
+     * @brief Axis aligned bounding box.
+     */
+    struct VyAABB
+    {
+        Vec3 Min{ std::numeric_limits<float>::max()    };
+        Vec3 Max{ std::numeric_limits<float>::lowest() };
+
+        VY_NODISCARD bool isValid() const
+        {
+            return Min.x <= Max.x && Min.y <= Max.y && Min.z <= Max.z;
+        }
+
+        VY_NODISCARD Vec3 center()  const { return (Min + Max) * 0.5f; }
+        VY_NODISCARD Vec3 extents() const { return (Max - Min) * 0.5f; }
+
+        /**
+         * @brief Grows the box to contain the point.
+         */
+        void expand(const Vec3& point)
+        {
+            Min = glm::min(Min, point);
+            Max = glm::max(Max, point);
+        }
+
+        /**
+         * @brief Transforms the box by an affine matrix, returning the box enclosing the result.
+         */
+        VY_NODISCARD VyAABB transformed(const Mat4& matrix) const
+        {
+            // Arvo's method: project the extents onto each world axis.
+            Vec3 newCenter = Vec3(matrix * Vec4(center(), 1.0f));
+            Vec3 ext       = extents();
+
+            Vec3 newExtents =
+                glm::abs(Vec3(matrix[0])) * ext.x +
+                glm::abs(Vec3(matrix[1])) * ext.y +
+                glm::abs(Vec3(matrix[2])) * ext.z;
+
+            return VyAABB{
+                .Min = newCenter - newExtents,
+                .Max = newCenter + newExtents
+            };
+        }
+
+        /**
+         * @brief Gets the sphere enclosing the box.
+         */
+        VY_NODISCARD VyBoundingSphere boundingSphere() const
+        {
+            return VyBoundingSphere{
+                .Center = center(),
+                .Radius = glm::length(extents())
+            };
+        }
+    };
+
+
+    /**
+     * @brief Number of objects that passed / failed a visibility test in a pass.
+     */
+    struct VyCullStats
+    {
+        U32 Visible{ 0 };
+        U32 Culled { 0 };
+
+        void reset() { Visible = 0; Culled = 0; }
+
+        VY_NODISCARD U32 total() const { return Visible + Culled; }
+
+        VyCullStats& operator+=(const VyCullStats& other)
+        {
+            Visible += other.Visible;
+            Culled  += other.Culled;
+
+            return *this;
+        }
+    };
+}
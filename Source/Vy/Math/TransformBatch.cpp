@@ -0,0 +1,578 @@
+#include <Vy/Math/TransformBatch.h>
+
+#include <bit>
+#include <chrono>
+#include <cstring>
+#include <random>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define VY_TRANSFORM_BATCH_SSE2 1
+    #include <immintrin.h>
+#endif
+
+#if defined(VY_TRANSFORM_BATCH_SSE2) && defined(__AVX2__)
+    #define VY_TRANSFORM_BATCH_AVX2 1
+#endif
+
+// The scalar and SIMD paths only agree bit for bit if no multiply-add is fused.
+#if defined(__clang__)
+    #pragma clang fp contract(off)
+#elif defined(__GNUC__)
+    #pragma GCC optimize("fp-contract=off")
+#endif
+
+namespace Vy::TransformBatch
+{
+    static_assert(sizeof(Vec3) == 3 * sizeof(float), "The SIMD loads expect tightly packed Vec3");
+    static_assert(sizeof(Mat4) == 16 * sizeof(float), "The SIMD stores expect tightly packed Mat4");
+
+    namespace
+    {
+        // Cephes sinf / cosf: reduction by pi/4 (subtracted in three parts) and a polynomial per octant.
+        constexpr float kFourOverPi = 1.27323954473516f;
+        constexpr float kDP1        = 0.78515625f;
+        constexpr float kDP2        = 2.4187564849853515625e-4f;
+        constexpr float kDP3        = 3.77489497744594108e-8f;
+
+        constexpr float kSinP0      = -1.9515295891e-4f;
+        constexpr float kSinP1      =  8.3321608736e-3f;
+        constexpr float kSinP2      = -1.6666654611e-1f;
+
+        constexpr float kCosP0      =  2.443315711809948e-5f;
+        constexpr float kCosP1      = -1.388731625493765e-3f;
+        constexpr float kCosP2      =  4.166664568298827e-2f;
+
+        constexpr U32   kSignMask   = 0x80000000u;
+
+        /**
+         * @brief Rotation * scale part of the matrix (column major, [column][row]), shared by every lane type.
+         *
+         * (s1, c1) = Rotation.y, (s2, c2) = Rotation.x, (s3, c3) = Rotation.z.
+         */
+        template <typename T>
+        inline void rotationScale(
+            const T& s1, const T& c1,
+            const T& s2, const T& c2,
+            const T& s3, const T& c3,
+            const T& sx, const T& sy, const T& sz,
+            T        out[3][3])
+        {
+            out[0][0] = sx * ( c1 * c3 + s1 * s2 * s3 );
+            out[0][1] = sx * ( c2 * s3                );
+            out[0][2] = sx * ( c1 * s2 * s3 - c3 * s1 );
+
+            out[1][0] = sy * ( c3 * s1 * s2 - c1 * s3 );
+            out[1][1] = sy * ( c2 * c3                );
+            out[1][2] = sy * ( c1 * c3 * s2 + s1 * s3 );
+
+            out[2][0] = sz * ( c2 * s1 );
+            out[2][1] = sz * (-s2      );
+            out[2][2] = sz * ( c1 * c2 );
+        }
+
+        // ========================================================================================
+
+        struct ScalarLanes
+        {
+            using F = float;
+
+            static constexpr size_t kWidth = 1;
+
+            static F set1(float value) { return value; }
+
+            static void load(const Vec3* pData, F& x, F& y, F& z)
+            {
+                x = pData->x;
+                y = pData->y;
+                z = pData->z;
+            }
+
+            static void sincos(F angle, F& outSin, F& outCos)
+            {
+                TransformBatch::sincos(angle, outSin, outCos);
+            }
+
+            static void store(const F m[3][3], F tx, F ty, F tz, F tw, Mat4* pOut)
+            {
+                *pOut = Mat4{
+                    Vec4{ m[0][0], m[0][1], m[0][2], 0.0f },
+                    Vec4{ m[1][0], m[1][1], m[1][2], 0.0f },
+                    Vec4{ m[2][0], m[2][1], m[2][2], 0.0f },
+                    Vec4{ tx,      ty,      tz,      tw   },
+                };
+            }
+        };
+
+        // ========================================================================================
+
+#if defined(VY_TRANSFORM_BATCH_SSE2)
+
+        struct F4 { __m128 V; };
+
+        inline F4 operator+(F4 a, F4 b) { return { _mm_add_ps(a.V, b.V) }; }
+        inline F4 operator-(F4 a, F4 b) { return { _mm_sub_ps(a.V, b.V) }; }
+        inline F4 operator*(F4 a, F4 b) { return { _mm_mul_ps(a.V, b.V) }; }
+        inline F4 operator/(F4 a, F4 b) { return { _mm_div_ps(a.V, b.V) }; }
+        inline F4 operator-(F4 a)       { return { _mm_xor_ps(a.V, _mm_set1_ps(-0.0f)) }; }
+
+        struct SSE2Lanes
+        {
+            using F = F4;
+
+            static constexpr size_t kWidth = 4;
+
+            static F set1(float value) { return { _mm_set1_ps(value) }; }
+
+            /**
+             * @brief Loads 4 consecutive Vec3 and transposes them into x, y and z lanes.
+             */
+            static void load(const Vec3* pData, F& x, F& y, F& z)
+            {
+                const float* p = &pData->x;
+
+                const __m128 a = _mm_loadu_ps(p + 0); // x0 y0 z0 x1
+                const __m128 b = _mm_loadu_ps(p + 4); // y1 z1 x2 y2
+                const __m128 c = _mm_loadu_ps(p + 8); // z2 x3 y3 z3
+
+                x.V = _mm_shuffle_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 3, 0)), _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 1, 0));
+                y.V = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)), _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+                z.V = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)), _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+            }
+
+            static void sincos(F angle, F& outSin, F& outCos)
+            {
+                const __m128  signMask = _mm_castsi128_ps(_mm_set1_epi32(static_cast<int>(kSignMask)));
+
+                __m128        signSin  = _mm_and_ps   (angle.V, signMask);
+                __m128        x        = _mm_andnot_ps(signMask, angle.V);
+
+                __m128i       j        = _mm_cvttps_epi32(_mm_mul_ps(x, _mm_set1_ps(kFourOverPi)));
+                j                      = _mm_and_si128(_mm_add_epi32(j, _mm_set1_epi32(1)), _mm_set1_epi32(~1));
+
+                const __m128  y        = _mm_cvtepi32_ps(j);
+
+                const __m128  swapSin  = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(j, _mm_set1_epi32(4)), 29));
+                const __m128  signCos  = _mm_castsi128_ps(_mm_slli_epi32(_mm_andnot_si128(_mm_sub_epi32(j, _mm_set1_epi32(2)), _mm_set1_epi32(4)), 29));
+                const __m128  polyMask = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(j, _mm_set1_epi32(2)), _mm_setzero_si128()));
+
+                signSin = _mm_xor_ps(signSin, swapSin);
+
+                x = _mm_sub_ps(x, _mm_mul_ps(y, _mm_set1_ps(kDP1)));
+                x = _mm_sub_ps(x, _mm_mul_ps(y, _mm_set1_ps(kDP2)));
+                x = _mm_sub_ps(x, _mm_mul_ps(y, _mm_set1_ps(kDP3)));
+
+                const __m128 z = _mm_mul_ps(x, x);
+
+                __m128 c = _mm_set1_ps(kCosP0);
+                c = _mm_add_ps(_mm_mul_ps(c, z), _mm_set1_ps(kCosP1));
+                c = _mm_add_ps(_mm_mul_ps(c, z), _mm_set1_ps(kCosP2));
+                c = _mm_mul_ps(_mm_mul_ps(c, z), z);
+                c = _mm_sub_ps(c, _mm_mul_ps(z, _mm_set1_ps(0.5f)));
+                c = _mm_add_ps(c, _mm_set1_ps(1.0f));
+
+                __m128 s = _mm_set1_ps(kSinP0);
+                s = _mm_add_ps(_mm_mul_ps(s, z), _mm_set1_ps(kSinP1));
+                s = _mm_add_ps(_mm_mul_ps(s, z), _mm_set1_ps(kSinP2));
+                s = _mm_mul_ps(_mm_mul_ps(s, z), x);
+                s = _mm_add_ps(s, x);
+
+                const __m128 sinValue = _mm_or_ps(_mm_and_ps(polyMask, s), _mm_andnot_ps(polyMask, c));
+                const __m128 cosValue = _mm_or_ps(_mm_and_ps(polyMask, c), _mm_andnot_ps(polyMask, s));
+
+                outSin.V = _mm_xor_ps(sinValue, signSin);
+                outCos.V = _mm_xor_ps(cosValue, signCos);
+            }
+
+            /**
+             * @brief Transposes the lanes back into 4 consecutive column major Mat4.
+             */
+            static void store(const F m[3][3], F tx, F ty, F tz, F tw, Mat4* pOut)
+            {
+                float* p = &pOut[0][0][0];
+
+                for (int column = 0; column < 3; column++)
+                {
+                    __m128 c0 = m[column][0].V;
+                    __m128 c1 = m[column][1].V;
+                    __m128 c2 = m[column][2].V;
+                    __m128 c3 = _mm_setzero_ps();
+
+                    _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+
+                    _mm_storeu_ps(p +  0 + 4 * column, c0);
+                    _mm_storeu_ps(p + 16 + 4 * column, c1);
+                    _mm_storeu_ps(p + 32 + 4 * column, c2);
+                    _mm_storeu_ps(p + 48 + 4 * column, c3);
+                }
+
+                __m128 t0 = tx.V;
+                __m128 t1 = ty.V;
+                __m128 t2 = tz.V;
+                __m128 t3 = tw.V;
+
+                _MM_TRANSPOSE4_PS(t0, t1, t2, t3);
+
+                _mm_storeu_ps(p + 12, t0);
+                _mm_storeu_ps(p + 28, t1);
+                _mm_storeu_ps(p + 44, t2);
+                _mm_storeu_ps(p + 60, t3);
+            }
+        };
+
+#endif // VY_TRANSFORM_BATCH_SSE2
+
+        // ========================================================================================
+
+#if defined(VY_TRANSFORM_BATCH_AVX2)
+
+        struct F8 { __m256 V; };
+
+        inline F8 operator+(F8 a, F8 b) { return { _mm256_add_ps(a.V, b.V) }; }
+        inline F8 operator-(F8 a, F8 b) { return { _mm256_sub_ps(a.V, b.V) }; }
+        inline F8 operator*(F8 a, F8 b) { return { _mm256_mul_ps(a.V, b.V) }; }
+        inline F8 operator/(F8 a, F8 b) { return { _mm256_div_ps(a.V, b.V) }; }
+        inline F8 operator-(F8 a)       { return { _mm256_xor_ps(a.V, _mm256_set1_ps(-0.0f)) }; }
+
+        struct AVX2Lanes
+        {
+            using F = F8;
+
+            static constexpr size_t kWidth = 8;
+
+            static F set1(float value) { return { _mm256_set1_ps(value) }; }
+
+            static void load(const Vec3* pData, F& x, F& y, F& z)
+            {
+                F4 lx, ly, lz;
+                F4 hx, hy, hz;
+
+                SSE2Lanes::load(pData,     lx, ly, lz);
+                SSE2Lanes::load(pData + 4, hx, hy, hz);
+
+                x.V = _mm256_set_m128(hx.V, lx.V);
+                y.V = _mm256_set_m128(hy.V, ly.V);
+                z.V = _mm256_set_m128(hz.V, lz.V);
+            }
+
+            static void sincos(F angle, F& outSin, F& outCos)
+            {
+                const __m256  signMask = _mm256_castsi256_ps(_mm256_set1_epi32(static_cast<int>(kSignMask)));
+
+                __m256        signSin  = _mm256_and_ps   (angle.V, signMask);
+                __m256        x        = _mm256_andnot_ps(signMask, angle.V);
+
+                __m256i       j        = _mm256_cvttps_epi32(_mm256_mul_ps(x, _mm256_set1_ps(kFourOverPi)));
+                j                      = _mm256_and_si256(_mm256_add_epi32(j, _mm256_set1_epi32(1)), _mm256_set1_epi32(~1));
+
+                const __m256  y        = _mm256_cvtepi32_ps(j);
+
+                const __m256  swapSin  = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(j, _mm256_set1_epi32(4)), 29));
+                const __m256  signCos  = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_andnot_si256(_mm256_sub_epi32(j, _mm256_set1_epi32(2)), _mm256_set1_epi32(4)), 29));
+                const __m256  polyMask = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(j, _mm256_set1_epi32(2)), _mm256_setzero_si256()));
+
+                signSin = _mm256_xor_ps(signSin, swapSin);
+
+                x = _mm256_sub_ps(x, _mm256_mul_ps(y, _mm256_set1_ps(kDP1)));
+                x = _mm256_sub_ps(x, _mm256_mul_ps(y, _mm256_set1_ps(kDP2)));
+                x = _mm256_sub_ps(x, _mm256_mul_ps(y, _mm256_set1_ps(kDP3)));
+
+                const __m256 z = _mm256_mul_ps(x, x);
+
+                __m256 c = _mm256_set1_ps(kCosP0);
+                c = _mm256_add_ps(_mm256_mul_ps(c, z), _mm256_set1_ps(kCosP1));
+                c = _mm256_add_ps(_mm256_mul_ps(c, z), _mm256_set1_ps(kCosP2));
+                c = _mm256_mul_ps(_mm256_mul_ps(c, z), z);
+                c = _mm256_sub_ps(c, _mm256_mul_ps(z, _mm256_set1_ps(0.5f)));
+                c = _mm256_add_ps(c, _mm256_set1_ps(1.0f));
+
+                __m256 s = _mm256_set1_ps(kSinP0);
+                s = _mm256_add_ps(_mm256_mul_ps(s, z), _mm256_set1_ps(kSinP1));
+                s = _mm256_add_ps(_mm256_mul_ps(s, z), _mm256_set1_ps(kSinP2));
+                s = _mm256_mul_ps(_mm256_mul_ps(s, z), x);
+                s = _mm256_add_ps(s, x);
+
+                const __m256 sinValue = _mm256_blendv_ps(c, s, polyMask);
+                const __m256 cosValue = _mm256_blendv_ps(s, c, polyMask);
+
+                outSin.V = _mm256_xor_ps(sinValue, signSin);
+                outCos.V = _mm256_xor_ps(cosValue, signCos);
+            }
+
+            static void store(const F m[3][3], F tx, F ty, F tz, F tw, Mat4* pOut)
+            {
+                F4 low [3][3];
+                F4 high[3][3];
+
+                for (int column = 0; column < 3; column++)
+                {
+                    for (int row = 0; row < 3; row++)
+                    {
+                        low [column][row].V = _mm256_castps256_ps128 (m[column][row].V);
+                        high[column][row].V = _mm256_extractf128_ps(m[column][row].V, 1);
+                    }
+                }
+
+                SSE2Lanes::store(low,
+                    { _mm256_castps256_ps128(tx.V) }, { _mm256_castps256_ps128(ty.V) },
+                    { _mm256_castps256_ps128(tz.V) }, { _mm256_castps256_ps128(tw.V) },
+                    pOut
+                );
+
+                SSE2Lanes::store(high,
+                    { _mm256_extractf128_ps(tx.V, 1) }, { _mm256_extractf128_ps(ty.V, 1) },
+                    { _mm256_extractf128_ps(tz.V, 1) }, { _mm256_extractf128_ps(tw.V, 1) },
+                    pOut + 4
+                );
+            }
+        };
+
+#endif // VY_TRANSFORM_BATCH_AVX2
+
+        // ========================================================================================
+
+        /**
+         * @brief Converts `Lanes::kWidth` transforms starting at the given pointers.
+         */
+        template <typename Lanes>
+        inline void computeBlock(const Vec3* pTranslations, const Vec3* pRotations, const Vec3* pScales, Mat4* pMatrices, Mat4* pNormals)
+        {
+            using F = typename Lanes::F;
+
+            F tx, ty, tz;
+            F rx, ry, rz;
+            F sx, sy, sz;
+
+            Lanes::load(pTranslations, tx, ty, tz);
+            Lanes::load(pRotations,    rx, ry, rz);
+            Lanes::load(pScales,       sx, sy, sz);
+
+            F s1, c1, s2, c2, s3, c3;
+
+            Lanes::sincos(ry, s1, c1);
+            Lanes::sincos(rx, s2, c2);
+            Lanes::sincos(rz, s3, c3);
+
+            const F one = Lanes::set1(1.0f);
+
+            F m[3][3];
+
+            rotationScale(s1, c1, s2, c2, s3, c3, sx, sy, sz, m);
+
+            Lanes::store(m, tx, ty, tz, one, pMatrices);
+
+            if (pNormals)
+            {
+                const F zero = Lanes::set1(0.0f);
+
+                // Same rotation with the inverse scale is the inverse transpose of the upper 3x3.
+                rotationScale(s1, c1, s2, c2, s3, c3, one / sx, one / sy, one / sz, m);
+
+                Lanes::store(m, zero, zero, zero, one, pNormals);
+            }
+        }
+
+
+        template <typename Lanes>
+        inline size_t computeRange(
+            size_t      first,
+            size_t      count,
+            const Vec3* pTranslations,
+            const Vec3* pRotations,
+            const Vec3* pScales,
+            Mat4*       pMatrices,
+            Mat4*       pNormals)
+        {
+            size_t i = first;
+
+            for (; i + Lanes::kWidth <= count; i += Lanes::kWidth)
+            {
+                computeBlock<Lanes>(pTranslations + i, pRotations + i, pScales + i, pMatrices + i, pNormals ? pNormals + i : nullptr);
+            }
+
+            return i;
+        }
+    }
+
+    // ============================================================================================
+
+    EPath simdPath()
+    {
+#if defined(VY_TRANSFORM_BATCH_AVX2)
+        return EPath::AVX2;
+#elif defined(VY_TRANSFORM_BATCH_SSE2)
+        return EPath::SSE2;
+#else
+        return EPath::Scalar;
+#endif
+    }
+
+
+    const char* pathName(EPath path)
+    {
+        switch (path)
+        {
+            case EPath::Scalar: return "Scalar";
+            case EPath::SSE2:   return "SSE2";
+            case EPath::AVX2:   return "AVX2";
+        }
+
+        return "Unknown";
+    }
+
+
+    void sincos(float angle, float& outSin, float& outCos)
+    {
+        U32   signSin = std::bit_cast<U32>(angle) & kSignMask;
+        float x       = std::bit_cast<float>(std::bit_cast<U32>(angle) & ~kSignMask);
+
+        I32 j = static_cast<I32>(x * kFourOverPi);
+        j     = (j + 1) & ~1;
+
+        const float y = static_cast<float>(j);
+
+        const U32  swapSin   = static_cast<U32>(j & 4) << 29;
+        const U32  signCos   = static_cast<U32>(~(j - 2) & 4) << 29;
+        const bool bSinPoly  = (j & 2) == 0;
+
+        signSin ^= swapSin;
+
+        x = x - y * kDP1;
+        x = x - y * kDP2;
+        x = x - y * kDP3;
+
+        const float z = x * x;
+
+        float c = kCosP0;
+        c = c * z + kCosP1;
+        c = c * z + kCosP2;
+        c = c * z * z;
+        c = c - z * 0.5f;
+        c = c + 1.0f;
+
+        float s = kSinP0;
+        s = s * z + kSinP1;
+        s = s * z + kSinP2;
+        s = s * z * x;
+        s = s + x;
+
+        outSin = std::bit_cast<float>(std::bit_cast<U32>(bSinPoly ? s : c) ^ signSin);
+        outCos = std::bit_cast<float>(std::bit_cast<U32>(bSinPoly ? c : s) ^ signCos);
+    }
+
+
+    Mat4 matrix(const Vec3& translation, const Vec3& rotation, const Vec3& scale)
+    {
+        Mat4 result;
+
+        computeBlock<ScalarLanes>(&translation, &rotation, &scale, &result, nullptr);
+
+        return result;
+    }
+
+
+    Mat3 normalMatrix(const Vec3& rotation, const Vec3& scale)
+    {
+        const Vec3 translation{ 0.0f };
+
+        Mat4 matrix;
+        Mat4 normal;
+
+        computeBlock<ScalarLanes>(&translation, &rotation, &scale, &matrix, &normal);
+
+        return Mat3{ normal };
+    }
+
+
+    void compute(
+        TSpan<const Vec3> translations,
+        TSpan<const Vec3> rotations,
+        TSpan<const Vec3> scales,
+        TSpan<Mat4>       outMatrices,
+        TSpan<Mat4>       outNormals,
+        EPath             path)
+    {
+        const size_t count = translations.size();
+
+        VY_ASSERT(rotations.size() == count && scales.size() == count && outMatrices.size() == count, "TransformBatch: Span sizes differ");
+        VY_ASSERT(outNormals.empty() || outNormals.size() == count,                                     "TransformBatch: Span sizes differ");
+
+        const Vec3* pT = translations.data();
+        const Vec3* pR = rotations   .data();
+        const Vec3* pS = scales      .data();
+        Mat4*       pM = outMatrices .data();
+        Mat4*       pN = outNormals.empty() ? nullptr : outNormals.data();
+
+        size_t i = 0;
+
+#if defined(VY_TRANSFORM_BATCH_AVX2)
+        if (path == EPath::AVX2)
+        {
+            i = computeRange<AVX2Lanes>(i, count, pT, pR, pS, pM, pN);
+        }
+#endif
+
+#if defined(VY_TRANSFORM_BATCH_SSE2)
+        if (path == EPath::AVX2 || path == EPath::SSE2)
+        {
+            i = computeRange<SSE2Lanes>(i, count, pT, pR, pS, pM, pN);
+        }
+#endif
+
+        computeRange<ScalarLanes>(i, count, pT, pR, pS, pM, pN);
+    }
+
+
+    BenchmarkResult benchmark(U32 count, U32 iterations)
+    {
+        using Clock = std::chrono::high_resolution_clock;
+
+        BenchmarkResult result{};
+        {
+            result.Count      = count;
+            result.Iterations = std::max(iterations, 1u);
+            result.Path       = simdPath();
+        }
+
+        std::mt19937                          rng{ 42 };
+        std::uniform_real_distribution<float> translationDist{ -100.0f, 100.0f };
+        std::uniform_real_distribution<float> rotationDist   { -glm::two_pi<float>(), glm::two_pi<float>() };
+        std::uniform_real_distribution<float> scaleDist      { 0.1f, 4.0f };
+
+        TVector<Vec3> translations(count);
+        TVector<Vec3> rotations   (count);
+        TVector<Vec3> scales      (count);
+
+        for (U32 i = 0; i < count; i++)
+        {
+            translations[i] = Vec3{ translationDist(rng), translationDist(rng), translationDist(rng) };
+            rotations   [i] = Vec3{ rotationDist   (rng), rotationDist   (rng), rotationDist   (rng) };
+            scales      [i] = Vec3{ scaleDist      (rng), scaleDist      (rng), scaleDist      (rng) };
+        }
+
+        TVector<Mat4> scalarMatrices(count), scalarNormals(count);
+        TVector<Mat4> simdMatrices  (count), simdNormals  (count);
+
+        auto run = [&](EPath path, TVector<Mat4>& matrices, TVector<Mat4>& normals)
+        {
+            // Warm up the caches (and the output pages) before timing.
+            compute(translations, rotations, scales, matrices, normals, path);
+
+            const auto start = Clock::now();
+
+            for (U32 iteration = 0; iteration < result.Iterations; iteration++)
+            {
+                compute(translations, rotations, scales, matrices, normals, path);
+            }
+
+            return std::chrono::duration<double, std::milli>(Clock::now() - start).count() / result.Iterations;
+        };
+
+        result.ScalarMs  = run(EPath::Scalar, scalarMatrices, scalarNormals);
+        result.SimdMs    = run(result.Path,   simdMatrices,   simdNormals  );
+
+        result.bBitExact = std::memcmp(scalarMatrices.data(), simdMatrices.data(), count * sizeof(Mat4)) == 0 &&
+                           std::memcmp(scalarNormals .data(), simdNormals .data(), count * sizeof(Mat4)) == 0;
+
+        return result;
+    }
+}
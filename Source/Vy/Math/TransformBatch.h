@@ -0,0 +1,74 @@
+#pragma once
+
+#include <VyLib/VyLib.h>
+
+namespace Vy
+{
+    /**
+     * @brief Batch conversion of translations / Euler rotations / scales into world and normal matrices.
+     *
+     * Same convention as `TransformComponent::matrix()`: Translate * Ry * Rx * Rz * Scale (YXZ Tait-Bryan angles).
+     * `TransformComponent::matrix()` and `normalMatrix()` go through `TransformBatch::matrix` / `normalMatrix`.
+     *
+     * The SIMD paths convert 4 (SSE2) or 8 (AVX2, built with `VY_ENABLE_AVX2`) transforms per iteration with a
+     * vectorized sincos, the remainder goes through the scalar path. All paths perform the same IEEE operations in
+     * the same order (no FMA contraction), their results are bit identical.
+     */
+    namespace TransformBatch
+    {
+        enum class EPath : U8
+        {
+            Scalar,
+            SSE2,
+            AVX2
+        };
+
+        /**
+         * @brief The widest path this build supports.
+         */
+        VY_NODISCARD EPath simdPath();
+
+        VY_NODISCARD const char* pathName(EPath path);
+
+        /**
+         * @brief Sine and cosine of `angle`, the scalar reference of the vectorized sincos (Cephes polynomials).
+         *
+         * @note Within a couple of ulp of std::sin / std::cos for |angle| < 8192.
+         */
+        void sincos(float angle, float& outSin, float& outCos);
+
+        VY_NODISCARD Mat4 matrix(const Vec3& translation, const Vec3& rotation, const Vec3& scale);
+
+        VY_NODISCARD Mat3 normalMatrix(const Vec3& rotation, const Vec3& scale);
+
+        /**
+         * @brief Computes the world matrix, and the normal matrix unless `outNormals` is empty, of every transform.
+         *
+         * The input spans and `outMatrices` must have the same size, so must `outNormals` if it is not empty.
+         * Normal matrices are stored as 4x4 (upper 3x3, like LocalToWorldComponent).
+         */
+        void compute(
+            TSpan<const Vec3> translations,
+            TSpan<const Vec3> rotations,
+            TSpan<const Vec3> scales,
+            TSpan<Mat4>       outMatrices,
+            TSpan<Mat4>       outNormals,
+            EPath             path = simdPath()
+        );
+
+        struct BenchmarkResult
+        {
+            U32    Count     { 0 };
+            U32    Iterations{ 0 };
+            EPath  Path      { EPath::Scalar }; // SIMD path compared with the scalar path.
+            double ScalarMs  { 0.0 };           // Average time of one `compute` call.
+            double SimdMs    { 0.0 };
+            bool   bBitExact { false };         // Both paths produced identical matrices.
+        };
+
+        /**
+         * @brief Microbenchmark of the scalar path against `simdPath()` on `count` random transforms.
+         */
+        BenchmarkResult benchmark(U32 count, U32 iterations);
+    }
+}
@@ -227,13 +227,12 @@ namespace Vy
 
     // ---------------------------------------------------------------------------------------------------------------------
 
-    void VyCamera::updateFrustum()
+    VyFrustum VyFrustum::fromMatrix(const Mat4& vp)
     {
-        // Extract frustum planes from view-projection matrix.
-        Mat4 vp = m_ProjectionMatrix * m_ViewMatrix;
+        VyFrustum frustum{};
 
         // Left plane
-        m_Frustum.Planes[0] = Vec4(
+        frustum.Planes[0] = Vec4(
             vp[0][3] + vp[0][0], 
             vp[1][3] + vp[1][0], 
             vp[2][3] + vp[2][0], 
@@ -241,7 +240,7 @@ namespace Vy
         );
 
         // Right plane
-        m_Frustum.Planes[1] = Vec4(
+        frustum.Planes[1] = Vec4(
             vp[0][3] - vp[0][0], 
             vp[1][3] - vp[1][0], 
             vp[2][3] - vp[2][0], 
@@ -249,7 +248,7 @@ namespace Vy
         );
         
         // Bottom plane
-        m_Frustum.Planes[2] = Vec4(
+        frustum.Planes[2] = Vec4(
             vp[0][3] + vp[0][1], 
             vp[1][3] + vp[1][1], 
             vp[2][3] + vp[2][1], 
@@ -257,7 +256,7 @@ namespace Vy
         );
         
         // Top plane
-        m_Frustum.Planes[3] = Vec4(
+        frustum.Planes[3] = Vec4(
             vp[0][3] - vp[0][1], 
             vp[1][3] - vp[1][1], 
             vp[2][3] - vp[2][1], 
@@ -265,7 +264,7 @@ namespace Vy
         );
         
         // Near plane
-        m_Frustum.Planes[4] = Vec4(
+        frustum.Planes[4] = Vec4(
             vp[0][3] + vp[0][2], 
             vp[1][3] + vp[1][2], 
             vp[2][3] + vp[2][2], 
@@ -273,7 +272,7 @@ namespace Vy
         );
         
         // Far plane
-        m_Frustum.Planes[5] = Vec4(
+        frustum.Planes[5] = Vec4(
             vp[0][3] - vp[0][2], 
             vp[1][3] - vp[1][2], 
             vp[2][3] - vp[2][2], 
@@ -283,19 +282,21 @@ namespace Vy
         // Normalize planes
         for (int i = 0; i < 6; i++)
         {
-            float length = glm::length(Vec3(m_Frustum.Planes[i]));
+            float length = glm::length(Vec3(frustum.Planes[i]));
 
-            m_Frustum.Planes[i] /= length;
+            frustum.Planes[i] /= length;
         }
+
+        return frustum;
     }
 
 
-    bool VyCamera::isInFrustum(const Vec3& center, float radius) const
+    bool VyFrustum::intersects(const Vec3& center, float radius) const
     {
         // Test sphere against all 6 frustum planes
         for (int i = 0; i < 6; i++)
         {
-            float distance = glm::dot(Vec3(m_Frustum.Planes[i]), center) + m_Frustum.Planes[i].w;
+            float distance = glm::dot(Vec3(Planes[i]), center) + Planes[i].w;
 
             if (distance < -radius)
             {
@@ -307,6 +308,43 @@ namespace Vy
     }
 
 
+    bool VyFrustum::intersects(const VyAABB& box) const
+    {
+        Vec3 center  = box.center();
+        Vec3 extents = box.extents();
+
+        for (int i = 0; i < 6; i++)
+        {
+            Vec3 normal = Vec3(Planes[i]);
+
+            // Projected radius of the box onto the plane normal.
+            float radius   = glm::dot(extents, glm::abs(normal));
+            float distance = glm::dot(normal, center) + Planes[i].w;
+
+            if (distance < -radius)
+            {
+                return false; // Box is completely outside this plane
+            }
+        }
+
+        return true;
+    }
+
+    // ---------------------------------------------------------------------------------------------------------------------
+
+    void VyCamera::updateFrustum()
+    {
+        // Extract frustum planes from view-projection matrix.
+        m_Frustum = VyFrustum::fromMatrix(m_ProjectionMatrix * m_ViewMatrix);
+    }
+
+
+    bool VyCamera::isInFrustum(const Vec3& center, float radius) const
+    {
+        return m_Frustum.intersects(center, radius);
+    }
+
+
 
     // void VyCamera::setView(Vec3 position, Quat rotation)
     // {
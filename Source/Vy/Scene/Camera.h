@@ -1,6 +1,8 @@
 #pragma once
 
 // #include <Vy/GFX/FrameInfo.h>
+#include <Vy/Math/Bounds.h>
+
 #include <VyLib/VyLib.h>
 
 namespace Vy
@@ -17,6 +19,23 @@ namespace Vy
     struct VyFrustum
     {
         Vec4 Planes[6]; // Left, Right, Bottom, Top, Near, Far
+
+        /**
+         * @brief Extracts the normalized frustum planes from a (view-)projection matrix.
+         */
+        static VyFrustum fromMatrix(const Mat4& viewProjection);
+
+        /**
+         * @brief Tests whether a sphere intersects or is inside the frustum.
+         */
+        bool intersects(const Vec3& center, float radius) const;
+
+        bool intersects(const VyBoundingSphere& sphere) const { return intersects(sphere.Center, sphere.Radius); }
+
+        /**
+         * @brief Tests whether an axis aligned box intersects or is inside the frustum.
+         */
+        bool intersects(const VyAABB& box) const;
     };
 
     namespace 
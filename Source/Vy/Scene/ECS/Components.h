@@ -6,6 +6,7 @@
 #include <Vy/Scene/ECS/Components/IDComponent.h>
 #include <Vy/Scene/ECS/Components/TagComponent.h>
 #include <Vy/Scene/ECS/Components/TransformComponent.h>
+#include <Vy/Scene/ECS/Components/LocalToWorldComponent.h>
 #include <Vy/Scene/ECS/Components/RelationshipComponent.h>
 
 // Optional
@@ -31,6 +32,7 @@ namespace Vy
 		IDComponent,
         TagComponent, 
         TransformComponent,
+        LocalToWorldComponent,
 		// GlobalTransformComponent,
 		ParentComponent,
 		// SiblingsComponent,
@@ -40,6 +40,7 @@ namespace Vy
 		Vec3  Color{ 1.0f, 1.0f, 1.0f };
 		float Intensity{1.0f};
         float Radius{0.1f};
+        float Range{0.0f}; // Distance the light reaches, 0 derives it from the intensity.
 
         // PointLightComponent(const Vec3& color, float intensity) : 
         //     Color{ color }, 
@@ -60,5 +61,6 @@ namespace Vy
         float QuadraticAttenuation{0.032f};
         bool  UseTargetPoint{false};
         Vec3  TargetPoint{0.0f, 0.0f, 0.0f};
+        float Range{0.0f}; // Distance the light reaches, 0 derives it from the intensity.
     };
 }
\ No newline at end of file
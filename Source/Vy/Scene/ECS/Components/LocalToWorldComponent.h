@@ -0,0 +1,42 @@
+#pragma once
+
+#include <Vy/Scene/ECS/Components/TransformComponent.h>
+
+namespace Vy
+{
+	/**
+	 * LocalToWorldComponent - Cached world and normal matrix of an entity
+	 *
+	 * Written once per frame, and only when the transform changed since the matrices were computed: by
+	 * VyTransformSystem for root entities and by VyHierarchySystem (parent world * local) for children.
+	 * Render and shadow passes read it instead of evaluating `TransformComponent::matrix()` per entity and pass.
+	 *
+	 * Separation: TransformComponent has raw data (pos, rot, scale),
+	 * LocalToWorld has computed matrix (for rendering).
+	 */
+	struct LocalToWorldComponent
+	{
+		Mat4 Matrix      { 1.0f }; // Local-to-world transform
+		Mat4 NormalMatrix{ 1.0f }; // For transforming normals (inverse transpose), 4x4 like the GPU side.
+
+		/**
+		 * @brief Whether the matrices are up to date with `transform` (the entity's local transform).
+		 */
+		bool isCurrent(const TransformComponent& transform) const
+		{
+			return Version     != 0                     &&
+			       Translation == transform.Translation &&
+			       Scale       == transform.Scale       &&
+			       Rotation    == transform.Rotation;
+		}
+
+		// Transform the matrices were computed from.
+		Vec3 Translation{ 0.0f };
+		Vec3 Scale      { 1.0f };
+		Vec3 Rotation   { 0.0f };
+
+		// Incremented every time the matrices are recomputed, 0 until they are computed once.
+		// Children compare it with the version they were computed against to notice a moved parent.
+		U32  Version    { 0 };
+	};
+}
@@ -7,8 +7,11 @@ namespace Vy
 	/**
 	 * ParentComponent - Reference to parent entity
 	 *
-	 * When present, this entity's transform is relative to its parent.
-	 * HierarchySystem computes world-space transform by combining with parent's LocalToWorld.
+	 * When the parent is valid, this entity's transform is relative to its parent.
+	 * VyHierarchySystem computes world-space transform by combining with parent's LocalToWorld.
+	 *
+	 * Only change it through VyScene::setParent() / VyScene::removeParent(), they keep the parent's
+	 * ChildrenComponent in sync and notify VyHierarchySystem.
 	 */
 	struct ParentComponent
 	{
@@ -24,7 +27,7 @@ namespace Vy
 	/**
 	 * ChildrenComponent - List of child entities
 	 *
-	 * Automatically maintained by Scene::setParent() / Scene::removeParent().
+	 * Automatically maintained by VyScene::setParent() / VyScene::removeParent().
 	 * Used for efficient hierarchy traversal and cascade operations (e.g., delete with children).
 	 */
 	struct ChildrenComponent 
@@ -1,5 +1,7 @@
 #include <Vy/Scene/ECS/Components/TransformComponent.h>
 
+#include <Vy/Math/TransformBatch.h>
+
 #include <glm/gtx/matrix_decompose.hpp>
 
 namespace Vy
@@ -92,84 +94,16 @@ namespace Vy
     };
 
 
-    Mat4 TransformComponent::matrix() 
+    Mat4 TransformComponent::matrix() const
     {
-        // return MatrixCalculator::YXZ( *this );
-
-        const float c3 = glm::cos(Rotation.z);
-        const float s3 = glm::sin(Rotation.z);
-
-        const float c2 = glm::cos(Rotation.x);
-        const float s2 = glm::sin(Rotation.x);
-        
-        const float c1 = glm::cos(Rotation.y);
-        const float s1 = glm::sin(Rotation.y);
-
-        return Mat4{
-            {
-                Scale.x * ( c1 * c3 + s1 * s2 * s3 ),
-                Scale.x * ( c2 * s3                ),
-                Scale.x * ( c1 * s2 * s3 - c3 * s1 ),
-                0.0f,
-            },
-            {
-                Scale.y * ( c3 * s1 * s2 - c1 * s3 ),
-                Scale.y * ( c2 * c3                ),
-                Scale.y * ( c1 * c3 * s2 + s1 * s3 ),
-                0.0f,
-            },
-            {
-                Scale.z * ( c2 * s1 ),
-                Scale.z * (-s2      ),
-                Scale.z * ( c1 * c2 ),
-                0.0f,
-            },
-            { 
-                Translation.x, 
-                Translation.y, 
-                Translation.z, 
-                1.0f 
-            }
-        };
+        // Shares the kernel of the batch path, VyTransformSystem's batched matrices are bit identical to this one.
+        return TransformBatch::matrix(Translation, Rotation, Scale);
     }
 
 
-    Mat3 TransformComponent::normalMatrix() 
+    Mat3 TransformComponent::normalMatrix() const
     {
-        const float c3 = glm::cos(Rotation.z);
-        const float s3 = glm::sin(Rotation.z);
-
-        const float c2 = glm::cos(Rotation.x);
-        const float s2 = glm::sin(Rotation.x);
-        
-        const float c1 = glm::cos(Rotation.y);
-        const float s1 = glm::sin(Rotation.y);
-
-        const Vec3 invScale = 1.0f / Scale;
-
-        return Mat3{
-            {
-                invScale.x * ( c1 * c3 + s1 * s2 * s3 ),
-                invScale.x * ( c2 * s3                ),
-                invScale.x * ( c1 * s2 * s3 - c3 * s1 ),
-            },
-            {
-                invScale.y * ( c3 * s1 * s2 - c1 * s3 ),
-                invScale.y * ( c2 * c3                ),
-                invScale.y * ( c1 * c3 * s2 + s1 * s3 ),
-            },
-            {
-                invScale.z * ( c2 * s1 ),
-                invScale.z * (-s2      ),
-                invScale.z * ( c1 * c2 ),
-            }, 
-//             {
-//                 0.0f, 
-//                 0.0f, 
-//                 0.0f, 
-//                 0.0f
-//             }
-        };
+        return TransformBatch::normalMatrix(Rotation, Scale);
     }
 }
 
@@ -28,9 +28,9 @@ namespace Vy
 		 *
 		 * @return Mat4
 		 */
-		Mat4 matrix();
+		Mat4 matrix() const;
 
-		Mat3 normalMatrix();
+		Mat3 normalMatrix() const;
 
 		inline Vec3 forward() const
 			{
@@ -97,7 +97,7 @@ namespace Vy
 		}
 
 		// Conversion operator calling the matrix function
-		operator Mat4() 
+		operator Mat4() const
 		{ 
 			return matrix(); 
 		}
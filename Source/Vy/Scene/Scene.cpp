@@ -6,6 +6,7 @@
 #include <Vy/Systems/Logic/CameraSystem.h>
 #include <Vy/Systems/Logic/TransformSystem.h>
 #include <Vy/Systems/Logic/HierarchySystem.h>
+#include <Vy/Systems/Logic/LightAnimationSystem.h>
 
 #include <Vy/Scripting/Scripts/CameraController.h>
 #include <Vy/Scripting/Scripts/KinematicMovementController.h>
@@ -15,13 +16,10 @@ namespace Vy
 {
 	void VyScene::update(float deltaTime)
 	{
+        // Scripts may create and destroy entities, they run before the systems go parallel.
         m_ScriptManager.update(deltaTime);
 
-        for (auto& system : m_LogicSystem)
-        {
-            system->update(m_Registry, deltaTime);
-        }
-        
+        m_LogicScheduler.update(m_Registry, deltaTime);
 	}
 
 
@@ -34,6 +32,7 @@ namespace Vy
         entity.add<TagComponent>(name.empty() ? "Unnamed-Entity" : name);
         
         entity.add<TransformComponent>();
+        entity.add<LocalToWorldComponent>();
 
         entity.add<ParentComponent>();
         entity.add<ChildrenComponent>();
@@ -54,12 +53,62 @@ namespace Vy
 
     void VyScene::destroyEntity(VyEntity entity)
     {
+        // Children outlive their parent as roots.
+        removeParent(entity);
+
+        const TVector<VyEntity> children = entity.get<ChildrenComponent>().Children;
+
+        for (VyEntity child : children)
+        {
+            removeParent(child);
+        }
+
         m_EntityMap.erase(entity.getUUID());
         
         m_Registry.destroy(entity);
     }
 
     
+    void VyScene::setParent(VyEntity child, VyEntity parent)
+    {
+        VY_ASSERT(child.isValid() && parent.isValid(), "Cannot set parent: Invalid entity");
+
+        // The child must not be an ancestor of its new parent.
+        for (VyEntity ancestor = parent; ancestor; ancestor = ancestor.get<ParentComponent>().Parent)
+        {
+            VY_ASSERT(ancestor != child, "Cannot set parent: The hierarchy would contain a cycle");
+        }
+
+        removeParent(child);
+
+        parent.get<ChildrenComponent>().Children.push_back(child);
+
+        // Patch (rather than write) so the hierarchy system notices the new layout.
+        m_Registry.patch<ParentComponent>(child, [&](ParentComponent& component) 
+        { 
+            component.Parent = parent; 
+        });
+    }
+
+
+    void VyScene::removeParent(VyEntity child)
+    {
+        VyEntity parent = child.get<ParentComponent>().Parent;
+
+        if (!parent)
+        {
+            return;
+        }
+
+        std::erase(parent.get<ChildrenComponent>().Children, child);
+
+        m_Registry.patch<ParentComponent>(child, [](ParentComponent& component) 
+        { 
+            component.Parent = VyEntity{}; 
+        });
+    }
+
+
     void VyScene::reset()
     {
         // Add Systems to the scene.
@@ -101,8 +150,9 @@ namespace Vy
 
     void VyScene::addBuiltinSystems()
     {
-		// addLogicSystem<VyTransformSystem>();
-        // addLogicSystem<HierarchySystem>();
+        addLogicSystem<VyLightAnimationSystem>();
+		addLogicSystem<VyTransformSystem>();
+        addLogicSystem<VyHierarchySystem>();
 		// addLogicSystem<CameraSystem>();
     }
 }
\ No newline at end of file
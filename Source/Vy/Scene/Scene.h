@@ -3,7 +3,7 @@
 #include <Vy/Scene/ECS/Entity.h>
 
 #include <Vy/Scripting/ScriptManager.h>
-#include <Vy/Systems/Logic/ILogicSystem.h>
+#include <Vy/Systems/Logic/LogicScheduler.h>
 #include <Vy/Scene/Environment.h>
 
 #include <Vy/Scene/ECS/Components/PostProcessingComponent.h>
@@ -91,6 +91,21 @@ namespace Vy
 		 */
 		void destroyEntity(VyEntity entity);
 
+		/**
+		 * @brief Makes `parent` the parent of `child`, the TransformComponent of `child` becomes relative to `parent`.
+		 * 
+		 * @param child  The VyEntity to attach, detached from its previous parent first.
+		 * @param parent The new parent. Must not be `child` or one of its descendants.
+		 */
+		void setParent(VyEntity child, VyEntity parent);
+
+		/**
+		 * @brief Detaches `child` from its parent, its TransformComponent becomes a world space transform again.
+		 * 
+		 * @param child The VyEntity to detach. Nothing happens if it has no parent.
+		 */
+		void removeParent(VyEntity child);
+
         /**
          * @brief Retrieves all entities that have the specified components.
          * 
@@ -143,7 +158,20 @@ namespace Vy
 			requires std::constructible_from<T, Args...>
 		void addLogicSystem(Args&&... args)
 		{
-			m_LogicSystem.emplace_back(std::make_unique<T>(std::forward<Args>(args)...));
+			m_LogicScheduler.add(MakeUnique<T>(std::forward<Args>(args)...));
+		}
+
+		/**
+		 * @brief Runs the logic systems concurrently (default) or one after another for debugging.
+		 */
+		void setLogicScheduling(ELogicScheduling mode)
+		{
+			m_LogicScheduler.setMode(mode);
+		}
+
+		VY_NODISCARD ELogicScheduling logicScheduling() const
+		{
+			return m_LogicScheduler.mode();
 		}
 
 
@@ -164,7 +192,7 @@ namespace Vy
 		entt::registry m_Registry;
 
         VyScriptManager               m_ScriptManager;
-		TVector<Unique<ILogicSystem>> m_LogicSystem;
+		VyLogicScheduler              m_LogicScheduler;
 
 		Shared<VyEnvironment> m_Environment = MakeShared<VyEnvironment>();
 
@@ -5,36 +5,444 @@
 
 namespace Vy
 {
+    VyMaterialSystem::VyMaterialSystem()
+    {
+        createDefaultTexture();
+        createDescriptors();
+
+        // Material 0 is the default material, it is never released.
+        m_Materials.push_back(MaterialSlot{ .bActive = true });
+
+        for (int i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
+        {
+            reserveMaterials(i, kInitialMaterialCapacity);
+        }
+    }
+
+
     VyMaterialSystem::~VyMaterialSystem()
     {
+        vkDestroyDescriptorUpdateTemplate(VyContext::device(), m_BufferUpdateTemplate, nullptr);
+
+        // The sets are freed with the pool.
     }
 
 
-    Shared<VyDescriptorSetLayout> VyMaterialSystem::createMaterialSetLayout()
+    void VyMaterialSystem::createDefaultTexture()
     {
-        return VyDescriptorSetLayout::Builder()
-            .addBinding(0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_FRAGMENT_BIT) // Albedo
-            .addBinding(1, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_FRAGMENT_BIT) // Normal
-            .addBinding(2, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_FRAGMENT_BIT) // Roughness
-            .addBinding(3, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_FRAGMENT_BIT) // Metallic
-            .buildUnique();
+        // Create a simple 1x1 white texture as default
+        unsigned char pixels[4] = { 255, 255, 255, 255 }; // White pixel
+
+        VyBuffer stagingBuffer{ VyBuffer::stagingBuffer(sizeof(pixels)) };
+
+        stagingBuffer.singleWrite(pixels);
+
+        m_DefaultTextureImage = VyImage::Builder{}
+            .imageType  (VK_IMAGE_TYPE_2D)
+            .format     (VK_FORMAT_R8G8B8A8_SRGB)
+            .extent     (VkExtent2D{ 1, 1 })
+            .mipLevels  (1)
+            .arrayLayers(1)
+            .tiling     (VK_IMAGE_TILING_OPTIMAL)
+            .imageLayout(VK_IMAGE_LAYOUT_UNDEFINED)
+            .usage      (VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT)
+            .sampleCount(VK_SAMPLE_COUNT_1_BIT)
+            .sharingMode(VK_SHARING_MODE_EXCLUSIVE)
+            .memoryUsage(VMA_MEMORY_USAGE_AUTO)
+        .build();
+
+        // Transition image layout and copy buffer to image.
+        m_DefaultTextureImage.copyFrom(stagingBuffer);
+
+        m_DefaultTextureImageView = VyImageView::Builder{}
+            .viewType   (VK_IMAGE_VIEW_TYPE_2D)
+            .format     (VK_FORMAT_R8G8B8A8_SRGB)
+            .aspectMask (VK_IMAGE_ASPECT_COLOR_BIT)
+            .mipLevels  (0, 1)
+            .arrayLayers(0, 1)
+        .build(m_DefaultTextureImage);
+
+        m_DefaultTextureSampler = VySampler::Builder{}
+            .filters         (VK_FILTER_LINEAR)
+            .mipmapMode      (VK_SAMPLER_MIPMAP_MODE_LINEAR)
+            .addressMode     (VK_SAMPLER_ADDRESS_MODE_REPEAT)
+            .borderColor     (VK_BORDER_COLOR_INT_OPAQUE_BLACK)
+            .enableAnisotropy(false)
+            .lodRange        (0.0f, 1.0f)
+            .mipLodBias      (0.0f)
+        .build();
     }
 
 
-    void VyMaterialSystem::updateMaterials(
-        const VyFrameInfo&     frameInfo, 
-        VyDescriptorSetLayout& materialSetLayout, 
-        VyDescriptorPool&      materialPool)
+    void VyMaterialSystem::createDescriptors()
     {
-        // Iterate over entities with a MaterialComponent and update material descriptor sets.
-        auto view = frameInfo.Scene->getEntitiesWith<MaterialComponent>();
+        constexpr VkDescriptorBindingFlags textureFlags =
+            VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT          |
+            VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT |
+            VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT;
 
-        for (auto&& [ entity, material ] : view.each())
+        // Material set layout ( 1 ).
+        m_SetLayout = VyDescriptorSetLayout::Builder{}
+            .addBinding    (0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_FRAGMENT_BIT, kMaxTextures, textureFlags) // Textures
+            .addBinding    (1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,         VK_SHADER_STAGE_FRAGMENT_BIT)                             // Material Data
+            .setLayoutFlags(VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT)
+        .buildUnique();
+
+        m_Pool = VyDescriptorPool::Builder{}
+            .setMaxSets  (MAX_FRAMES_IN_FLIGHT)
+            .setPoolFlags(VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT)
+            .addPoolSize (VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, kMaxTextures * MAX_FRAMES_IN_FLIGHT)
+            .addPoolSize (VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,         MAX_FRAMES_IN_FLIGHT)
+        .buildUnique();
+
+        for (auto& set : m_Sets)
         {
-            if (material.Material)
+            if (!m_Pool->allocateDescriptorSet(m_SetLayout->handle(), set))
             {
-                material.Material->updateDescriptorSet(materialSetLayout, materialPool);
+                VY_THROW_RUNTIME_ERROR("Failed to allocate the bindless material descriptor set!");
             }
         }
+
+        // Texture slot 0 is the default texture.
+        VkDescriptorImageInfo defaultImageInfo{};
+        {
+            defaultImageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+            defaultImageInfo.imageView   = m_DefaultTextureImageView.handle();
+            defaultImageInfo.sampler     = m_DefaultTextureSampler  .handle();
+        }
+
+        allocateTexture(defaultImageInfo);
+
+        flushTextureWrites();
+
+        // The material buffer binding is rewritten whenever a frame's buffer grows.
+        VkDescriptorUpdateTemplateEntry templateEntry{};
+        {
+            templateEntry.dstBinding      = 1;
+            templateEntry.dstArrayElement = 0;
+            templateEntry.descriptorCount = 1;
+            templateEntry.descriptorType  = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            templateEntry.offset          = 0;
+            templateEntry.stride          = sizeof(VkDescriptorBufferInfo);
+        }
+
+        VkDescriptorUpdateTemplateCreateInfo templateInfo{};
+        {
+            templateInfo.sType                      = VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO;
+            templateInfo.descriptorUpdateEntryCount = 1;
+            templateInfo.pDescriptorUpdateEntries   = &templateEntry;
+            templateInfo.templateType               = VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET;
+            templateInfo.descriptorSetLayout        = m_SetLayout->handle();
+        }
+
+        VK_CHECK(vkCreateDescriptorUpdateTemplate(VyContext::device(), &templateInfo, nullptr, &m_BufferUpdateTemplate));
+    }
+
+
+    void VyMaterialSystem::reserveMaterials(int frameIndex, U32 materialCount)
+    {
+        if (m_MaterialBuffers[frameIndex] && materialCount <= m_MaterialCapacity[frameIndex])
+        {
+            return;
+        }
+
+        U32 capacity = std::max(m_MaterialCapacity[frameIndex], kInitialMaterialCapacity);
+
+        while (capacity < materialCount)
+        {
+            capacity *= 2;
+        }
+
+        // The previous submission using this frame's buffer has completed (the frame fence was waited on),
+        // and binding 1 is not update-after-bind, so it is rewritten before the set is bound this frame.
+        m_MaterialBuffers [frameIndex] = MakeUnique<VyBuffer>( VyBuffer::storageBuffer(sizeof(GPUMaterialData) * capacity) );
+        m_MaterialCapacity[frameIndex] = capacity;
+
+        auto bufferInfo = m_MaterialBuffers[frameIndex]->descriptorBufferInfo();
+
+        vkUpdateDescriptorSetWithTemplate(VyContext::device(), m_Sets[frameIndex], m_BufferUpdateTemplate, &bufferInfo);
+
+        // The new buffer is empty, every material has to be written into it again.
+        for (MaterialSlot& slot : m_Materials)
+        {
+            slot.WrittenVersions[frameIndex] = 0;
+        }
+
+        VY_DEBUG_TAG("VyMaterialSystem", "Material buffer [{}] capacity: {}", frameIndex, capacity);
+    }
+
+    // =====================================================================================================================
+
+    U32 VyMaterialSystem::registerMaterial(const Shared<VyMaterial>& material)
+    {
+        U32 materialIndex;
+
+        if (!m_FreeMaterials.empty())
+        {
+            materialIndex = m_FreeMaterials.back();
+
+            m_FreeMaterials.pop_back();
+        }
+        else
+        {
+            materialIndex = static_cast<U32>(m_Materials.size());
+
+            m_Materials.emplace_back();
+        }
+
+        MaterialSlot& slot = m_Materials[ materialIndex ];
+        {
+            slot          = MaterialSlot{};
+            slot.Material = material;
+            slot.Key      = material.get();
+            slot.bActive  = true;
+
+            slot.Textures  .fill(kDefaultTexture);
+            slot.ImageViews.fill(VK_NULL_HANDLE);
+        }
+
+        // Replaces the entry of a destroyed material that had the same address, its slot is released on its own.
+        m_MaterialLookup[ material.get() ] = materialIndex;
+
+        return materialIndex;
+    }
+
+
+    void VyMaterialSystem::releaseMaterial(U32 materialIndex, int frameIndex)
+    {
+        MaterialSlot& slot = m_Materials[ materialIndex ];
+
+        if (auto it = m_MaterialLookup.find(slot.Key); it != m_MaterialLookup.end() && it->second == materialIndex)
+        {
+            m_MaterialLookup.erase(it);
+        }
+
+        for (U32 texture : slot.Textures)
+        {
+            if (texture != kDefaultTexture)
+            {
+                m_RetiredTextures[ frameIndex ].push_back(texture);
+            }
+        }
+
+        slot = MaterialSlot{};
+
+        m_RetiredMaterials[ frameIndex ].push_back(materialIndex);
+    }
+
+
+    U32 VyMaterialSystem::allocateTexture(const VkDescriptorImageInfo& imageInfo)
+    {
+        U32 texture;
+
+        if (!m_FreeTextures.empty())
+        {
+            texture = m_FreeTextures.back();
+
+            m_FreeTextures.pop_back();
+        }
+        else if (m_TextureCount < kMaxTextures)
+        {
+            texture = m_TextureCount++;
+        }
+        else
+        {
+            VY_WARN_TAG("VyMaterialSystem", "All {} bindless texture slots are in use, using the default texture", kMaxTextures);
+
+            return kDefaultTexture;
+        }
+
+        m_TextureWrites.push_back(TextureWrite{ texture, imageInfo });
+
+        return texture;
+    }
+
+
+    void VyMaterialSystem::flushTextureWrites()
+    {
+        if (m_TextureWrites.empty())
+        {
+            return;
+        }
+
+        // The slots are not used by any frame in flight, so they can be written while the sets are bound.
+        for (auto& set : m_Sets)
+        {
+            VyDescriptorWriter writer{ *m_SetLayout, *m_Pool };
+
+            for (TextureWrite& write : m_TextureWrites)
+            {
+                writer.writeImageElement(0, write.Slot, &write.ImageInfo);
+            }
+
+            writer.update(set);
+        }
+
+        m_TextureWrites.clear();
+    }
+
+
+    void VyMaterialSystem::updateTextures(MaterialSlot& slot, const VyMaterialProxy& material, int frameIndex)
+    {
+        for (U32 i = 0; i < static_cast<U32>(EMaterialTexture::Count); i++)
+        {
+            const VkDescriptorImageInfo& imageInfo = material.Textures[i];
+
+            if (imageInfo.imageView == VK_NULL_HANDLE)
+            {
+                continue;
+            }
+
+            if (slot.ImageViews[i] == imageInfo.imageView)
+            {
+                continue;
+            }
+
+            // A reloaded texture gets a new slot, the old one may still be sampled by a frame in flight.
+            if (slot.Textures[i] != kDefaultTexture)
+            {
+                m_RetiredTextures[ frameIndex ].push_back(slot.Textures[i]);
+            }
+
+            slot.Textures  [i] = allocateTexture(imageInfo);
+            slot.ImageViews[i] = imageInfo.imageView;
+        }
+    }
+
+    // =====================================================================================================================
+
+    void VyMaterialSystem::updateMaterials(VyFrameInfo& frameInfo)
+    {
+        const int frameIndex = frameInfo.FrameIndex;
+
+        // The slots retired the last time this frame slot was used are no longer referenced by any frame in flight.
+        {
+            auto& retiredMaterials = m_RetiredMaterials[ frameIndex ];
+            auto& retiredTextures  = m_RetiredTextures [ frameIndex ];
+
+            m_FreeMaterials.insert(m_FreeMaterials.end(), retiredMaterials.begin(), retiredMaterials.end());
+            m_FreeTextures .insert(m_FreeTextures .end(), retiredTextures .begin(), retiredTextures .end());
+
+            retiredMaterials.clear();
+            retiredTextures .clear();
+        }
+
+        const auto& packetMaterials = frameInfo.Packet.Materials;
+        const U64   packetFrame     = frameInfo.Packet.FrameNumber;
+
+        // Resolve the packet's materials, registering the ones that are new to the system.
+        m_PacketMaterialIndices.resize(packetMaterials.size());
+
+        for (U32 m = 0; m < static_cast<U32>(packetMaterials.size()); m++)
+        {
+            const Shared<VyMaterial>& material = packetMaterials[m].Material;
+
+            U32 materialIndex;
+
+            // The address alone may belong to a destroyed material whose slot was not released yet.
+            if (auto it = m_MaterialLookup.find(material.get()); it != m_MaterialLookup.end() && m_Materials[ it->second ].Material.lock() == material)
+            {
+                materialIndex = it->second;
+            }
+            else
+            {
+                materialIndex = registerMaterial(material);
+            }
+
+            m_Materials[ materialIndex ].PacketFrame    = packetFrame;
+            m_Materials[ materialIndex ].PacketMaterial = m;
+
+            m_PacketMaterialIndices[m] = materialIndex;
+        }
+
+        frameInfo.MaterialIndices = m_PacketMaterialIndices.data();
+
+        const U32 materialCount = static_cast<U32>(m_Materials.size());
+
+        reserveMaterials(frameIndex, materialCount);
+
+        auto& materialBuffer = *m_MaterialBuffers[ frameIndex ];
+        auto* materials      = static_cast<GPUMaterialData*>(materialBuffer.mappedData());
+
+        U32 firstWritten = materialCount;
+        U32 lastWritten  = 0;
+
+        for (U32 i = 0; i < materialCount; i++)
+        {
+            MaterialSlot& slot = m_Materials[i];
+
+            if (!slot.bActive)
+            {
+                continue;
+            }
+
+            // Release the destroyed materials.
+            if (i != kDefaultMaterial && slot.Material.expired())
+            {
+                releaseMaterial(i, frameIndex);
+
+                continue;
+            }
+
+            // Only the materials of this packet have a copy to read, the others are not drawn this frame.
+            if (i != kDefaultMaterial && slot.PacketFrame != packetFrame)
+            {
+                continue;
+            }
+
+            // The default material never changes.
+            const VyMaterialProxy* material = i != kDefaultMaterial ? &packetMaterials[ slot.PacketMaterial ] : nullptr;
+            const U32              version  = material ? material->Version : 1;
+
+            if (slot.WrittenVersions[ frameIndex ] == version)
+            {
+                continue;
+            }
+
+            GPUMaterialData data{};
+
+            if (material)
+            {
+                // Textures are only (re)loaded through the versioned loaders, the other frames reuse the slots.
+                if (slot.TextureVersion != version)
+                {
+                    updateTextures(slot, *material, frameIndex);
+
+                    slot.TextureVersion = version;
+                }
+
+                const VyMaterialData& matData = material->Data;
+                {
+                    data.Albedo           = matData.Albedo;
+                    data.Metallic         = matData.Metallic;
+                    data.Roughness        = matData.Roughness;
+                    data.AO               = matData.AO;
+                    data.TextureOffset    = matData.TextureOffset;
+                    data.TextureScale     = matData.TextureScale;
+
+                    data.EmissionColor    = matData.EmissionColor;
+                    data.EmissionStrength = matData.EmissionStrength;
+                }
+
+                for (U32 t = 0; t < static_cast<U32>(EMaterialTexture::Count); t++)
+                {
+                    data.Textures[t] = slot.Textures[t];
+                }
+            }
+
+            materials[i] = data;
+
+            slot.WrittenVersions[ frameIndex ] = version;
+
+            firstWritten = std::min(firstWritten, i);
+            lastWritten  = std::max(lastWritten,  i);
+        }
+
+        flushTextureWrites();
+
+        if (firstWritten <= lastWritten)
+        {
+            materialBuffer.flush(sizeof(GPUMaterialData) * (lastWritten - firstWritten + 1), sizeof(GPUMaterialData) * firstWritten);
+        }
     }
-}
\ No newline at end of file
+}
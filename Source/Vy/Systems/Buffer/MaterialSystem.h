@@ -5,20 +5,153 @@
 #include <Vy/GFX/Backend/Descriptors.h>
 #include <Vy/GFX/Backend/Device.h>
 
-namespace Vy 
+namespace Vy
 {
+    /**
+     * @brief Owns the bindless material descriptor set ( 1 ) shared by every material draw.
+     *
+     * - Binding 0: `sampler2D Textures[]`, every loaded material texture gets a slot. Slot 0 is a 1x1 white texture
+     *              used for the textures a material does not have. Update-after-bind and partially bound, so new slots
+     *              can be written while the set is used by the frames in flight.
+     * - Binding 1: `MaterialData[]`, the parameters and texture slots of every registered material.
+     *              Material 0 is the default material used by entities without a MaterialComponent.
+     *
+     * Materials are registered the first time they are seen in a frame packet and released once the last reference
+     * to them is gone. Released material and texture slots are only reused after `MAX_FRAMES_IN_FLIGHT` frames.
+     *
+     * Runs on the render thread and only reads the copies in `VyFramePacket::Materials`, never the live `VyMaterial`,
+     * which the main thread may change meanwhile.
+     *
+     * Updates are driven by the material version: a material's entry in a frame's buffer is only rewritten, and its
+     * textures only checked for new slots, when its version differs from the one last written. Unchanged materials
+     * cost a version compare per frame.
+     *
+     * One set per frame in flight, the texture slots are written into all of them (batched into one update per set).
+     */
     class VyMaterialSystem //: public IRenderSystem
     {
     public:
-        VyMaterialSystem() = default;
-        
+        static constexpr U32 kMaxTextures     = 4096;
+        static constexpr U32 kDefaultTexture  = 0;
+        static constexpr U32 kDefaultMaterial = 0;
+
+        VyMaterialSystem();
+
         VyMaterialSystem(const VyMaterialSystem&)            = delete;
         VyMaterialSystem& operator=(const VyMaterialSystem&) = delete;
 
         ~VyMaterialSystem();// override;
 
-        Shared<VyDescriptorSetLayout> createMaterialSetLayout();
+        VY_NODISCARD VkDescriptorSetLayout setLayout() const { return m_SetLayout->handle(); }
+
+        VY_NODISCARD VkDescriptorSet descriptorSet(int frameIndex) const { return m_Sets[ frameIndex ]; }
+
+        /**
+         * @brief Registers new materials, releases the destroyed ones and writes the frame's material buffer.
+         *
+         * Sets `frameInfo.MaterialIndices` to the buffer index of every packet material.
+         */
+        void updateMaterials(VyFrameInfo& frameInfo);
+
+    private:
+        /**
+         * @brief Matches `MaterialData` in Material.frag (std430).
+         */
+        struct GPUMaterialData
+        {
+            alignas(16) Vec3 Albedo          { 1.0f, 1.0f, 1.0f };
+            float            Metallic        { 0.0f };
+            float            Roughness       { 0.5f };
+            float            AO              { 1.0f };
+            Vec2             TextureOffset   { 0.0f, 0.0f };
+            Vec2             TextureScale    { 1.0f, 1.0f };
+            U32              Textures[ static_cast<U32>(EMaterialTexture::Count) ]{}; // Texture slots, kDefaultTexture if not loaded.
+            U32              _pad0           { 0 };
+            U32              _pad1           { 0 };
+            alignas(16) Vec3 EmissionColor   { 0.0f, 0.0f, 0.0f };
+            float            EmissionStrength{ 0.0f };
+        };
+
+        static_assert(sizeof(GPUMaterialData) == 80, "GPUMaterialData must match the std430 layout of MaterialData");
+
+        struct MaterialSlot
+        {
+            WeakRef<VyMaterial> Material;
+            const VyMaterial*   Key           { nullptr }; // Key in m_MaterialLookup, only compared, never dereferenced.
+            bool                bActive       { false };
+
+            U64                 PacketFrame   { 0 };       // Frame number of the last packet that used the material.
+            U32                 PacketMaterial{ 0 };       // Its index in that packet's Materials.
+
+            TArray<U32,         static_cast<U32>(EMaterialTexture::Count)> Textures  {}; // Texture slots.
+            TArray<VkImageView, static_cast<U32>(EMaterialTexture::Count)> ImageViews{}; // Image views written into the slots.
+
+            U32                               TextureVersion { 0 }; // Material version the texture slots were updated for.
+            TArray<U32, MAX_FRAMES_IN_FLIGHT> WrittenVersions{};    // Material version in each frame's buffer, 0 = not written.
+        };
+
+        struct TextureWrite
+        {
+            U32                   Slot;
+            VkDescriptorImageInfo ImageInfo;
+        };
+
+        void createDefaultTexture();
+        void createDescriptors();
+
+        /**
+         * @brief Grows the material buffer of a frame so it can hold at least `materialCount` materials.
+         */
+        void reserveMaterials(int frameIndex, U32 materialCount);
+
+        /**
+         * @return The material index of the material.
+         */
+        U32  registerMaterial(const Shared<VyMaterial>& material);
+        void releaseMaterial(U32 materialIndex, int frameIndex);
+
+        /**
+         * @brief Writes the material's loaded textures into texture slots, if they are not written yet.
+         */
+        void updateTextures(MaterialSlot& slot, const VyMaterialProxy& material, int frameIndex);
+
+        /**
+         * @brief Allocates a texture slot and queues its write.
+         *
+         * @return The slot, or kDefaultTexture if all slots are used.
+         */
+        U32 allocateTexture(const VkDescriptorImageInfo& imageInfo);
+
+        /**
+         * @brief Writes the queued texture slots into every frame's set.
+         */
+        void flushTextureWrites();
+
+        static constexpr U32 kInitialMaterialCapacity = 64;
+
+        // Default white texture for the texture slots a material does not have.
+        VyImage                                        m_DefaultTextureImage;
+        VyImageView                                    m_DefaultTextureImageView;
+        VySampler                                      m_DefaultTextureSampler;
+
+        Unique<VyDescriptorSetLayout>                  m_SetLayout;
+        Unique<VyDescriptorPool>                       m_Pool;
+        TArray<VkDescriptorSet,  MAX_FRAMES_IN_FLIGHT> m_Sets{};
+        VkDescriptorUpdateTemplate                     m_BufferUpdateTemplate{ VK_NULL_HANDLE }; // Material buffer ( binding 1 ).
+
+        TArray<Unique<VyBuffer>, MAX_FRAMES_IN_FLIGHT> m_MaterialBuffers;
+        TArray<U32,              MAX_FRAMES_IN_FLIGHT> m_MaterialCapacity{};
+
+        TVector<MaterialSlot>                          m_Materials;     // Indexed by material index, 0 is the default material.
+        TVector<U32>                                   m_FreeMaterials;
+        THashMap<const VyMaterial*, U32>               m_MaterialLookup;        // Registered material to its material index.
+        TVector<U32>                                   m_PacketMaterialIndices; // Material index of each material of the current packet.
+        U32                                            m_TextureCount{ 0 };
+        TVector<U32>                                   m_FreeTextures;
+        TVector<TextureWrite>                          m_TextureWrites;
 
-        void updateMaterials(const VyFrameInfo& frameInfo, VyDescriptorSetLayout& materialSetLayout, VyDescriptorPool& materialPool);
+        // Slots released during a frame, reusable once that frame slot comes around again.
+        TArray<TVector<U32>, MAX_FRAMES_IN_FLIGHT>     m_RetiredMaterials;
+        TArray<TVector<U32>, MAX_FRAMES_IN_FLIGHT>     m_RetiredTextures;
     };
-}
\ No newline at end of file
+}
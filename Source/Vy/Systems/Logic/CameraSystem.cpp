@@ -5,11 +5,11 @@
 
 namespace Vy
 {
-    void VyCameraSystem::update(const VyFrameInfo& frameInfo, float aspectRatio) const
+    void VyCameraSystem::update(VyScene& scene, VyCamera& camera, float aspectRatio) const
     {
-        auto& registry = frameInfo.Scene->registry();
+        auto& registry = scene.registry();
 
-        if (VyEntity mainCameraEntity = frameInfo.Scene->mainCamera())
+        if (VyEntity mainCameraEntity = scene.mainCamera())
         {
             // Check if the entity has the required components.
             if (registry.valid(mainCameraEntity) && registry.all_of<CameraComponent, TransformComponent>(mainCameraEntity))
@@ -19,9 +19,9 @@ namespace Vy
 
                 updateCamera(cameraComp, transform, aspectRatio);
 
-                // Sync the frameInfo camera with the component camera
+                // Sync the given camera with the component camera
                 // This ensures the renderer uses the updated camera matrices
-                frameInfo.Camera = cameraComp.Camera;
+                camera = cameraComp.Camera;
             }
         }
     }
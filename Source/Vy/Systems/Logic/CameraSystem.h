@@ -4,7 +4,6 @@
 
 #include <Vy/Scene/Scene.h>
 #include <Vy/Scene/ECS/Components.h>
-#include <Vy/GFX/FrameInfo.h>
 
 namespace Vy
 {
@@ -14,7 +13,7 @@ namespace Vy
 		VyCameraSystem()  = default;
 		~VyCameraSystem() = default;
 
-		void update(const VyFrameInfo& frameInfo, float aspectRatio) const;
+		void update(VyScene& scene, VyCamera& camera, float aspectRatio) const;
 
 	private:
 		void updateCamera(CameraComponent& cameraComp, const TransformComponent& transform, float aspectRatio) const;
@@ -1,108 +1,210 @@
-// #include <Vy/Systems/Logic/HierarchySystem.h>
-
-// #include <Vy/Math/Math.h>
-// #include <Vy/Engine.h>
-
-// namespace Vy
-// {
-//     void HierarchySystem::update(entt::registry& registry, float /*deltaTime*/) 
-//     {
-//         // Process all entities with a parent
-//         // We iterate through children and update their world transforms based on their parent's LocalToWorld
-//         auto view = registry.view<TransformComponent, ParentComponent>();
-
-//         for (auto&& [ entity, transform, parent ] : view.each()) 
-//         {
-//             // Ensure parent is valid and has a world transform.
-//             if (!registry.valid(parent.Parent)) 
-//             {
-//                 // Parent is invalid, skip this child.
-//                 continue;
-//             }
-
-//             const auto* parentLocalToWorld = registry.try_get<LocalToWorldComponent>(parent.Parent);
-
-//             if (!parentLocalToWorld) 
-//             {
-//                 // Parent has no world transform yet, skip.
-//                 continue;  
-//             }
-
-//             // Get child's local transform.
-//             const auto& childTransform = view.get<TransformComponent>(entity);
-
-//             // Compute child's local matrix.
-//             Mat4 childLocalMatrix = computeLocalMatrix(childTransform);
-
-//             // Compute child's world matrix: Parent world * Child local.
-//             Mat4 childWorldMatrix = parentLocalToWorld->Matrix * childLocalMatrix;
-
-//             // Compute normal matrix for lighting (inverse transpose of upper-left 3x3).
-//             Mat3 normalMatrix = glm::transpose(glm::inverse(Mat3(childWorldMatrix)));
-//             Mat4 normalMatrix4(normalMatrix);  // Convert to mat4 for storage.
-
-//             // Update or create LocalToWorld for child.
-//             registry.emplace_or_replace<LocalToWorldComponent>(entity, childWorldMatrix, normalMatrix4);
-
-//             // If this child has children, recursively update them
-//             // This handles deep hierarchies (grandchildren, etc.).
-//             const auto* childrenComp = registry.try_get<ChildrenComponent>(entity);
-
-//             if (childrenComp) 
-//             {
-//                 for (EntityHandle grandchild : childrenComp->Children) 
-//                 {
-//                     updateChildRecursive(registry, grandchild, childWorldMatrix);
-//                 }
-//             }
-//         }
-//     }
-
-
-//     void HierarchySystem::updateChildRecursive(entt::registry& registry, EntityHandle entity, const Mat4& parentWorldMatrix) 
-//     {
-//         // Get child's local transform.
-//         const auto* childTransform = registry.try_get<TransformComponent>(entity);
-
-//         if (!childTransform) 
-//         {
-//             // No transform, skip.
-//             return;  
-//         }
-
-//         // Compute child's local matrix
-//         Mat4 childLocalMatrix = computeLocalMatrix(*childTransform);
-
-//         // Compute child's world matrix
-//         Mat4 childWorldMatrix = parentWorldMatrix * childLocalMatrix;
-
-//         // Compute normal matrix
-//         Mat3 normalMatrix = glm::transpose(glm::inverse(Mat3(childWorldMatrix)));
-//         Mat4 normalMatrix4(normalMatrix);
-
-//         // Update LocalToWorld
-//         registry.emplace_or_replace<LocalToWorldComponent>(entity, childWorldMatrix, normalMatrix4);
-
-//         // Recurse to grandchildren
-//         const auto* childrenComp = registry.try_get<ChildrenComponent>(entity);
-        
-//         if (childrenComp) 
-//         {
-//             for (EntityHandle grandchild : childrenComp->Children) 
-//             {
-//                 updateChildRecursive(registry, grandchild, childWorldMatrix);
-//             }
-//         }
-//     }
-
-
-//     Mat4 HierarchySystem::computeLocalMatrix(const TransformComponent& transform) 
-//     {
-//         // Compute T * R * S
-//         Mat4 translation = glm::translate(Mat4(1.0f), transform.Position);
-//         Mat4 rotation    = glm::mat4_cast(transform.Rotation);
-//         Mat4 scale       = glm::scale(Mat4(1.0f), transform.Scale);
-
-//         return translation * rotation * scale;
-//     }
-// }
\ No newline at end of file
+#include <Vy/Systems/Logic/HierarchySystem.h>
+
+#include <Vy/Scene/ECS/Components.h>
+
+#include <VyLib/Util/JobSystem.h>
+
+namespace Vy
+{
+    VyHierarchySystem::VyHierarchySystem() = default;
+
+
+    VyHierarchySystem::~VyHierarchySystem()
+    {
+        disconnect();
+    }
+
+
+    void VyHierarchySystem::update(entt::registry& registry, float /*deltaTime*/) 
+    {
+        if (m_Registry != &registry)
+        {
+            disconnect();
+            connect(registry);
+        }
+
+        if (m_bLayoutDirty)
+        {
+            rebuildLayout(registry);
+
+            m_bLayoutDirty = false;
+        }
+
+        if (m_Nodes.empty())
+        {
+            return;
+        }
+
+        const auto view           = registry.view<const TransformComponent, LocalToWorldComponent>();
+        const U32  hierarchyCount = static_cast<U32>(m_Hierarchies.size()) - 1;
+
+        if (m_Nodes.size() < kParallelNodeThreshold || hierarchyCount < 2)
+        {
+            updateHierarchies(view, 0, hierarchyCount);
+
+            return;
+        }
+
+        VyJobSystem& jobs = VyJobSystem::shared();
+
+        // Split the hierarchies into chunks of about the same node count, a few per thread so idle threads can
+        // steal the remaining ones.
+        const U32 chunkCount    = std::min((jobs.workerCount() + 1) * 4, hierarchyCount);
+        const U32 nodesPerChunk = (static_cast<U32>(m_Nodes.size()) + chunkCount - 1) / chunkCount;
+
+        m_Chunks.clear();
+
+        for (U32 first = 0; first < hierarchyCount; )
+        {
+            U32 last = first + 1;
+
+            while (last < hierarchyCount && m_Hierarchies[ last ] - m_Hierarchies[ first ] < nodesPerChunk)
+            {
+                last++;
+            }
+
+            m_Chunks.push_back(first);
+
+            first = last;
+        }
+
+        m_Chunks.push_back(hierarchyCount);
+
+        jobs.parallelFor(static_cast<U32>(m_Chunks.size()) - 1, 1, [this, &view](U32 begin, U32 end)
+        {
+            for (U32 chunk = begin; chunk < end; chunk++)
+            {
+                updateHierarchies(view, m_Chunks[ chunk ], m_Chunks[ chunk + 1 ]);
+            }
+        });
+    }
+
+
+    void VyHierarchySystem::declareAccess(VySystemAccess& access) const
+    {
+        access.read<TransformComponent, ParentComponent, ChildrenComponent>()
+              .write<LocalToWorldComponent>();
+    }
+
+
+    void VyHierarchySystem::connect(entt::registry& registry)
+    {
+        m_Registry     = &registry;
+        m_bLayoutDirty = true;
+
+        registry.on_construct<ParentComponent>().connect<&VyHierarchySystem::onHierarchyChanged>(this);
+        registry.on_update   <ParentComponent>().connect<&VyHierarchySystem::onHierarchyChanged>(this);
+        registry.on_destroy  <ParentComponent>().connect<&VyHierarchySystem::onHierarchyChanged>(this);
+    }
+
+
+    void VyHierarchySystem::disconnect()
+    {
+        if (!m_Registry)
+        {
+            return;
+        }
+
+        m_Registry->on_construct<ParentComponent>().disconnect<&VyHierarchySystem::onHierarchyChanged>(this);
+        m_Registry->on_update   <ParentComponent>().disconnect<&VyHierarchySystem::onHierarchyChanged>(this);
+        m_Registry->on_destroy  <ParentComponent>().disconnect<&VyHierarchySystem::onHierarchyChanged>(this);
+
+        m_Registry = nullptr;
+    }
+
+
+    void VyHierarchySystem::onHierarchyChanged(entt::registry& /*registry*/, entt::entity /*entity*/)
+    {
+        m_bLayoutDirty = true;
+    }
+
+
+    void VyHierarchySystem::rebuildLayout(entt::registry& registry)
+    {
+        m_Nodes      .clear();
+        m_Hierarchies.clear();
+
+        auto view = registry.view<const ParentComponent, const ChildrenComponent, const TransformComponent, const LocalToWorldComponent>();
+
+        for (auto&& [ entity, parent, children, transform, world ] : view.each())
+        {
+            // Only roots with children start a hierarchy, childless roots are fully handled by VyTransformSystem.
+            if (registry.valid(parent.Parent) || children.Children.empty())
+            {
+                continue;
+            }
+
+            const U32 first = static_cast<U32>(m_Nodes.size());
+
+            m_Hierarchies.push_back(first);
+            m_Nodes      .push_back(Node{ .Entity = entity, .Parent = kNoParent });
+
+            // Breadth-first, so every node is stored after its parent.
+            for (U32 index = first; index < m_Nodes.size(); index++)
+            {
+                const auto& nodeChildren = view.get<const ChildrenComponent>(m_Nodes[ index ].Entity);
+
+                for (const VyEntity& child : nodeChildren.Children)
+                {
+                    if (!view.contains(child))
+                    {
+                        continue;
+                    }
+
+                    m_Nodes.push_back(Node{ .Entity = child, .Parent = index });
+                }
+            }
+        }
+
+        m_Hierarchies.push_back(static_cast<U32>(m_Nodes.size()));
+
+        VY_DEBUG_TAG("VyHierarchySystem", "Hierarchy layout: {} hierarchies, {} nodes", m_Hierarchies.size() - 1, m_Nodes.size());
+    }
+
+
+    void VyHierarchySystem::updateHierarchies(const TransformView& view, U32 first, U32 last)
+    {
+        for (U32 index = m_Hierarchies[ first ]; index < m_Hierarchies[ last ]; index++)
+        {
+            Node& node = m_Nodes[ index ];
+
+            node.World = &view.get<LocalToWorldComponent>(node.Entity);
+
+            // Roots are computed by VyTransformSystem.
+            if (node.Parent == kNoParent)
+            {
+                continue;
+            }
+
+            const LocalToWorldComponent& parentWorld = *m_Nodes[ node.Parent ].World;
+            const TransformComponent&    transform   = view.get<const TransformComponent>(node.Entity);
+            LocalToWorldComponent&       world       = *node.World;
+
+            const bool bLocalChanged  = !node.bLocalValid || !world.isCurrent(transform);
+            const bool bParentChanged = node.ParentVersion != parentWorld.Version;
+
+            if (!bLocalChanged && !bParentChanged)
+            {
+                continue;
+            }
+
+            if (bLocalChanged)
+            {
+                node.Local       = transform.matrix();
+                node.LocalNormal = Mat4{ transform.normalMatrix() };
+                node.bLocalValid = true;
+
+                world.Translation = transform.Translation;
+                world.Scale       = transform.Scale;
+                world.Rotation    = transform.Rotation;
+            }
+
+            // (P * L)^-T = P^-T * L^-T, the normal matrices compose like the matrices.
+            world.Matrix       = parentWorld.Matrix       * node.Local;
+            world.NormalMatrix = parentWorld.NormalMatrix * node.LocalNormal;
+            world.Version++;
+
+            node.ParentVersion = parentWorld.Version;
+        }
+    }
+}
@@ -1,67 +1,92 @@
-// #pragma once
+#pragma once
 
-// #include <Vy/Systems/Logic/ILogicSystem.h>
+#include <Vy/Systems/Logic/ILogicSystem.h>
 
-// #include <Vy/Scene/Scene.h>
-// #include <Vy/Scene/ECS/Components.h>
+#include <Vy/Scene/ECS/Components/TransformComponent.h>
+#include <Vy/Scene/ECS/Components/LocalToWorldComponent.h>
 
-// namespace Vy
-// {
-//     /**
-//      * HierarchySystem - Propagates transforms through parent-child hierarchy
-//      *
-//      * Updates entities with ParentComponent to have world-space transforms
-//      * based on their parent's LocalToWorld matrix.
-//      *
-//      * Execution order:
-//      * 1. TransformSystem computes LocalToWorld for root entities (no parent)
-//      * 2. HierarchySystem propagates LocalToWorld down the hierarchy
-//      *    - Child's world transform = Parent's LocalToWorld * Child's local transform
-//      *
-//      * Design:
-//      * - Processes hierarchy level-by-level (breadth-first) for correctness
-//      * - Root entities (no ParentComponent) are unaffected
-//      * - Child entities have their TransformComponent treated as LOCAL space
-//      * - Final world-space matrix stored in LocalToWorld component
-//      *
-//      * Performance:
-//      * - Uses EnTT views for cache-friendly iteration
-//      * - Only processes entities with both TransformComponent AND ParentComponent
-//      * - Handles deep hierarchies efficiently
-//      */
-//     class HierarchySystem : public ILogicSystem 
-//     {
-//     public:
-//         HierarchySystem() = default;
-//         ~HierarchySystem() override = default;
+namespace Vy
+{
+    /**
+     * HierarchySystem - Propagates transforms through parent-child hierarchy
+     *
+     * Updates entities with a parent to have world-space transforms based on their parent's LocalToWorld matrix.
+     *
+     * Execution order:
+     * 1. TransformSystem computes LocalToWorld for root entities (no parent)
+     * 2. HierarchySystem propagates LocalToWorld down the hierarchy
+     *    - Child's world transform = Parent's LocalToWorld * Child's local transform
+     *
+     * Design:
+     * - Every hierarchy (a root with children) is flattened into one contiguous range of nodes in breadth-first
+     *   order, so each node comes after its parent and a single linear pass over the range is enough.
+     * - The layout is only rebuilt when a ParentComponent is added, patched or removed (see `VyScene::setParent`).
+     * - Child entities have their TransformComponent treated as LOCAL space
+     * - Final world-space matrix stored in LocalToWorld component
+     *
+     * Performance:
+     * - A node is only recomputed when its local transform changed or its parent's LocalToWorld version moved on,
+     *   static subtrees cost one comparison per node and no matrix math.
+     * - The local matrices of children are cached, a moving parent only costs a matrix multiply per descendant.
+     * - Hierarchies are independent of each other, large scenes split them over worker threads.
+     */
+    class VyHierarchySystem : public ILogicSystem 
+    {
+    public:
+        VyHierarchySystem();
+        ~VyHierarchySystem() override;
 
-//         /**
-//          * Update hierarchy transforms
-//          *
-//          * Propagates parent transforms to children recursively.
-//          * Assumes TransformSystem has already run this frame.
-//          *
-//          * @param world ECS world
-//          * @param deltaTime Time since last update (unused)
-//          */
-//         void update(entt::registry& registry, float deltaTime) override;
+        /**
+         * @brief Update hierarchy transforms
+         *
+         * Assumes VyTransformSystem has already run this frame.
+         */
+        void update(entt::registry& registry, float deltaTime) override;
 
-//     private:
-//         /**
-//          * Recursively update a child entity's world transform
-//          *
-//          * @param registry EnTT registry
-//          * @param entity Child entity to update
-//          * @param parentWorldMatrix Parent's world-space transform matrix
-//          */
-//         void updateChildRecursive(entt::registry& registry, EntityHandle entity, const Mat4& parentWorldMatrix);
+        void declareAccess(VySystemAccess& access) const override;
 
-//         /**
-//          * Compute local transform matrix from TransformComponent
-//          *
-//          * @param transform Transform component
-//          * @return 4x4 transformation matrix
-//          */
-//         static Mat4 computeLocalMatrix(const TransformComponent& transform);
-//     };
-// }
\ No newline at end of file
+    private:
+        using TransformView = decltype(std::declval<entt::registry&>().view<const TransformComponent, LocalToWorldComponent>());
+
+        static constexpr U32 kNoParent = ~0u;
+
+        // Below this many nodes a single thread is faster than dispatching to workers.
+        static constexpr U32 kParallelNodeThreshold = 4096;
+
+        struct Node
+        {
+            EntityHandle           Entity;
+            U32                    Parent;                 // Index of the parent node, kNoParent for the root of the hierarchy.
+            U32                    ParentVersion{ 0 };     // Parent LocalToWorld version the node was computed against.
+            bool                   bLocalValid  { false }; // Local and LocalNormal match the LocalToWorld inputs.
+            Mat4                   Local        { 1.0f };
+            Mat4                   LocalNormal  { 1.0f };
+            LocalToWorldComponent* World        { nullptr }; // Refreshed every update, parents are resolved before their children.
+        };
+
+        void connect(entt::registry& registry);
+        void disconnect();
+
+        void onHierarchyChanged(entt::registry& registry, entt::entity entity);
+
+        /**
+         * @brief Flattens every hierarchy into `m_Nodes`, each one breadth-first starting with its root.
+         */
+        void rebuildLayout(entt::registry& registry);
+
+        /**
+         * @brief Propagates the transforms of the hierarchies [first, last).
+         *
+         * @note Only reads the views and writes the nodes and components of those hierarchies, safe to run
+         *       concurrently for disjoint ranges.
+         */
+        void updateHierarchies(const TransformView& view, U32 first, U32 last);
+
+        entt::registry*         m_Registry    { nullptr };
+        bool                    m_bLayoutDirty{ true };
+
+        TVector<Node>           m_Nodes;
+        TVector<U32>            m_Hierarchies; // First node of each hierarchy, plus m_Nodes.size() at the end.
+        TVector<U32>            m_Chunks;      // First hierarchy of each parallel chunk, plus the hierarchy count.
+    };
+}
@@ -6,16 +6,122 @@
 
 namespace Vy
 {
+	/**
+	 * @brief Components a logic system reads and writes, used to schedule systems concurrently.
+	 *
+	 * Two systems conflict when one writes a component the other reads or writes, conflicting systems run in the
+	 * order they were added. A system that declares nothing is exclusive: it conflicts with every other system.
+	 *
+	 * @note Declared systems may only access the contents of the declared components, creating or destroying
+	 *       entities and adding or removing components requires an exclusive system.
+	 */
+	class VySystemAccess
+	{
+	public:
+		template <typename... Components>
+		VySystemAccess& read()
+		{
+			(add<Components>(false), ...);
+
+			return *this;
+		}
+
+		template <typename... Components>
+		VySystemAccess& write()
+		{
+			(add<Components>(true), ...);
+
+			return *this;
+		}
+
+		VY_NODISCARD bool isExclusive() const
+		{
+			return m_Components.empty();
+		}
+
+		VY_NODISCARD bool conflictsWith(const VySystemAccess& other) const
+		{
+			if (isExclusive() || other.isExclusive())
+			{
+				return true;
+			}
+
+			for (const auto& component : m_Components)
+			{
+				for (const auto& otherComponent : other.m_Components)
+				{
+					if (component.Type == otherComponent.Type && (component.bWrite || otherComponent.bWrite))
+					{
+						return true;
+					}
+				}
+			}
+
+			return false;
+		}
+
+		/**
+		 * @brief Creates the storage of every declared component that does not have one yet.
+		 *
+		 * Views create missing storages, which modifies the registry, so this runs before systems go parallel.
+		 */
+		void assureStorage(entt::registry& registry) const
+		{
+			for (const auto& component : m_Components)
+			{
+				component.Assure(registry);
+			}
+		}
+
+	private:
+		struct ComponentAccess
+		{
+			entt::id_type Type;
+			void        (*Assure)(entt::registry& registry);
+			bool          bWrite;
+		};
+
+		template <typename Component>
+		void add(bool bWrite)
+		{
+			const entt::id_type type = entt::type_hash<std::remove_const_t<Component>>::value();
+
+			for (auto& component : m_Components)
+			{
+				if (component.Type == type)
+				{
+					component.bWrite |= bWrite;
+
+					return;
+				}
+			}
+
+			m_Components.push_back(ComponentAccess{
+				type,
+				[](entt::registry& registry) { registry.storage<std::remove_const_t<Component>>(); },
+				bWrite
+			});
+		}
+
+		TVector<ComponentAccess> m_Components;
+	};
+
+
 	class ILogicSystem
 	{
 	public:
 		ILogicSystem()          = default;
 		virtual ~ILogicSystem() = default;
-		
+
         virtual void update(entt::registry& registry, float deltaTime) {}
+
+		/**
+		 * @brief Declares the components `update` reads and writes. Systems that do not override it are exclusive.
+		 */
+		virtual void declareAccess(VySystemAccess& access) const {}
 	};
-	
+
 
 	template <typename T>
 	concept LogicSystemDerived = std::derived_from<T, ILogicSystem>;
-}
\ No newline at end of file
+}
@@ -0,0 +1,68 @@
+#include <Vy/Systems/Logic/LightAnimationSystem.h>
+
+#include <Vy/Scene/Scene.h>
+#include <Vy/Scene/ECS/Components.h>
+
+namespace Vy
+{
+    void VyLightAnimationSystem::update(entt::registry& registry, float deltaTime)
+    {
+        const Mat4 rotateLight = glm::rotate(Mat4(1.0f), deltaTime * m_RotationSpeed, Vec3(0.0f, -1.0f, 0.0f)); // Axis of rotation
+
+        for (auto&& [ entity, pointLight, transform ] : registry.view<const PointLightComponent, TransformComponent>().each())
+        {
+            transform.Translation = Vec3(rotateLight * Vec4(transform.Translation, 1.0f));
+        }
+
+        for (auto&& [ entity, dirLight, transform ] : registry.view<const DirectionalLightComponent, TransformComponent>().each())
+        {
+            if (dirLight.UseTargetPoint)
+            {
+                transform.lookAt(dirLight.TargetPoint);
+            }
+        }
+
+        for (auto&& [ entity, spotLight, transform ] : registry.view<const SpotLightComponent, TransformComponent>().each())
+        {
+            if (spotLight.UseTargetPoint)
+            {
+                transform.lookAt(spotLight.TargetPoint);
+            }
+        }
+    }
+
+
+    void VyLightAnimationSystem::declareAccess(VySystemAccess& access) const
+    {
+        access.read<PointLightComponent, DirectionalLightComponent, SpotLightComponent>()
+              .write<TransformComponent>();
+    }
+
+
+    void VyLightAnimationSystem::updateTargetLockedLight(EntityHandle entity, VyScene* scene)
+    {
+        auto& registry = scene->registry();
+
+        // Update directional light target tracking
+        if (registry.all_of<DirectionalLightComponent>(entity))
+        {
+            auto& dirLight = registry.get<DirectionalLightComponent>(entity);
+
+            if (dirLight.UseTargetPoint)
+            {
+                registry.get<TransformComponent>(entity).lookAt(dirLight.TargetPoint);
+            }
+        }
+
+        // Update spot light target tracking
+        if (registry.all_of<SpotLightComponent>(entity))
+        {
+            auto& spotLight = registry.get<SpotLightComponent>(entity);
+
+            if (spotLight.UseTargetPoint)
+            {
+                registry.get<TransformComponent>(entity).lookAt(spotLight.TargetPoint);
+            }
+        }
+    }
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <Vy/Systems/Logic/ILogicSystem.h>
+
+namespace Vy
+{
+    class VyScene;
+
+    /**
+     * LightAnimationSystem - Animates the scene lights
+     *
+     * - Orbits the point lights around the world Y axis.
+     * - Turns directional and spot lights with `UseTargetPoint` towards their target.
+     *
+     * Runs before VyTransformSystem so the light transforms of a frame are final when it is extracted for rendering.
+     */
+    class VyLightAnimationSystem : public ILogicSystem
+    {
+    public:
+        VyLightAnimationSystem()  = default;
+        ~VyLightAnimationSystem() = default;
+
+        void update(entt::registry& registry, float deltaTime) override;
+
+        void declareAccess(VySystemAccess& access) const override;
+
+        /**
+         * @brief Updates the rotation of a target-locked light, call when its position or target changes.
+         */
+        static void updateTargetLockedLight(EntityHandle entity, VyScene* scene);
+
+    private:
+        float m_RotationSpeed{ 0.5f }; // Point light orbit speed in radians per second.
+    };
+}
@@ -0,0 +1,171 @@
+#include <Vy/Systems/Logic/LogicScheduler.h>
+
+namespace Vy
+{
+    void VyLogicScheduler::add(Unique<ILogicSystem> system)
+    {
+        VY_ASSERT(system != nullptr, "Logic system is null");
+
+        m_Systems.push_back(std::move(system));
+
+        m_bGraphDirty = true;
+    }
+
+
+    void VyLogicScheduler::clear()
+    {
+        m_Systems.clear();
+
+        m_bGraphDirty = true;
+    }
+
+
+    void VyLogicScheduler::update(entt::registry& registry, float deltaTime)
+    {
+        if (m_bGraphDirty)
+        {
+            rebuildGraph();
+
+            m_bGraphDirty = false;
+        }
+
+        if (m_Mode == ELogicScheduling::Sequential || m_Systems.size() < 2 || m_bChain)
+        {
+            for (auto& system : m_Systems)
+            {
+                system->update(registry, deltaTime);
+            }
+
+            return;
+        }
+
+        runParallel(registry, deltaTime);
+    }
+
+
+    void VyLogicScheduler::rebuildGraph()
+    {
+        m_Graph.clear();
+        m_Nodes.clear();
+
+        for (auto& system : m_Systems)
+        {
+            SystemNode* node = m_Graph.createNode<SystemNode>();
+
+            node->System = system.get();
+            node->System->declareAccess(node->Access);
+
+            m_Nodes.push_back(node);
+        }
+
+        // Conflicting systems keep the order they were added in.
+        for (size_t i = 0; i < m_Nodes.size(); i++)
+        {
+            for (size_t j = i + 1; j < m_Nodes.size(); j++)
+            {
+                if (m_Nodes[ i ]->Access.conflictsWith(m_Nodes[ j ]->Access))
+                {
+                    m_Graph.link(m_Nodes[ i ], m_Nodes[ j ], m_Graph.createEdge());
+                }
+            }
+        }
+
+        // Flatten the graph for dispatch, the node IDs match the system indices.
+        m_Dependents  .assign(m_Nodes.size(), {});
+        m_Dependencies.assign(m_Nodes.size(), 0);
+        m_Remaining = TVector<AtomicU32>(m_Nodes.size());
+
+        for (SystemNode* node : m_Nodes)
+        {
+            for (VyDAGraph::Edge* edge : node->getOutEdges())
+            {
+                m_Dependents[ node->getID() ].push_back(edge->to()->getID());
+            }
+
+            m_Dependencies[ node->getID() ] = static_cast<U32>(node->getInEdges().size());
+        }
+
+        // Edges only point to later systems, so one pass in order finds the longest dependency chain. If it holds
+        // every system no two of them can overlap, and dispatching them to the job system would only add latency.
+        TVector<U32> depth(m_Nodes.size(), 0);
+        U32          longestChain = 0;
+
+        for (U32 i = 0; i < static_cast<U32>(m_Nodes.size()); i++)
+        {
+            longestChain = std::max(longestChain, depth[ i ] + 1);
+
+            for (U32 dependent : m_Dependents[ i ])
+            {
+                depth[ dependent ] = std::max(depth[ dependent ], depth[ i ] + 1);
+            }
+        }
+
+        m_bChain = longestChain == m_Nodes.size();
+    }
+
+
+    void VyLogicScheduler::runParallel(entt::registry& registry, float deltaTime)
+    {
+        // Create missing storages up front, systems must not modify the registry structure concurrently.
+        for (SystemNode* node : m_Nodes)
+        {
+            node->Access.assureStorage(registry);
+        }
+
+        for (size_t i = 0; i < m_Nodes.size(); i++)
+        {
+            m_Remaining[ i ].store(m_Dependencies[ i ], std::memory_order_relaxed);
+        }
+
+        VyJobSystem& jobs = VyJobSystem::shared();
+        VyJobCounter counter;
+
+        Dispatch dispatch{ &registry, deltaTime, &counter };
+
+        for (U32 i = 0; i < static_cast<U32>(m_Nodes.size()); i++)
+        {
+            if (m_Dependencies[ i ] == 0)
+            {
+                schedule(i, dispatch);
+            }
+        }
+
+        // Only help with the logic jobs, the render thread's recording jobs must not delay the simulation.
+        jobs.waitLocal(counter);
+
+        if (dispatch.Error)
+        {
+            std::rethrow_exception(dispatch.Error);
+        }
+    }
+
+
+    void VyLogicScheduler::schedule(U32 index, Dispatch& dispatch)
+    {
+        VyJobSystem::shared().run([this, index, &dispatch]()
+        {
+            try
+            {
+                m_Nodes[ index ]->System->update(*dispatch.Registry, dispatch.DeltaTime);
+            }
+            catch (...)
+            {
+                LockGuard<Mutex> lock(dispatch.ErrorMutex);
+
+                if (!dispatch.Error)
+                {
+                    dispatch.Error = std::current_exception();
+                }
+            }
+
+            // Dependents still run after a failure, like the remaining systems of a sequential update.
+            for (U32 dependent : m_Dependents[ index ])
+            {
+                if (m_Remaining[ dependent ].fetch_sub(1, std::memory_order_acq_rel) == 1)
+                {
+                    schedule(dependent, dispatch);
+                }
+            }
+        }, dispatch.Counter);
+    }
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <Vy/Systems/Logic/ILogicSystem.h>
+
+#include <VyLib/Graph/VyDAGraph.h>
+#include <VyLib/Util/JobSystem.h>
+
+#include <exception>
+
+namespace Vy
+{
+    enum class ELogicScheduling : U8
+    {
+        Parallel,   // Systems without conflicting component access run concurrently on the job system.
+        Sequential  // Systems run one after another in the order they were added, for debugging.
+    };
+
+    /**
+     * @brief Runs the logic systems of a scene, concurrently where their declared component access allows it.
+     *
+     * The systems form a VyDAGraph with an edge from every system to each later added system it conflicts with
+     * (see VySystemAccess). The graph is rebuilt when the system list changed. In parallel mode a system is
+     * submitted to the shared VyJobSystem once all of its dependencies finished, the calling thread helps until
+     * every system ran, without picking up the jobs of other threads. Sequential mode runs the systems in the order
+     * they were added, which is a valid order of the graph, so both modes compute the same results for correctly
+     * declared systems.
+     *
+     * When the graph is a single chain (every system conflicts with the one before it) the systems run inline in
+     * parallel mode as well. That is the case for the builtin systems: light animation writes TransformComponent,
+     * which the transform system reads, and the transform and hierarchy systems both write LocalToWorldComponent.
+     * The hierarchy system still spreads its own work over the job system.
+     */
+    class VyLogicScheduler
+    {
+    public:
+        VyLogicScheduler() = default;
+
+        VyLogicScheduler(const VyLogicScheduler&)            = delete;
+        VyLogicScheduler& operator=(const VyLogicScheduler&) = delete;
+
+        void add(Unique<ILogicSystem> system);
+
+        void clear();
+
+        /**
+         * @brief Runs every system once.
+         *
+         * @note The first exception thrown by a system is rethrown once the other systems finished.
+         */
+        void update(entt::registry& registry, float deltaTime);
+
+        void setMode(ELogicScheduling mode) { m_Mode = mode; }
+
+        VY_NODISCARD ELogicScheduling mode() const { return m_Mode; }
+
+        VY_NODISCARD size_t systemCount() const { return m_Systems.size(); }
+
+    private:
+        class SystemNode : public VyDAGraph::Node
+        {
+        public:
+            ILogicSystem*   System{ nullptr };
+            VySystemAccess  Access;
+        };
+
+        struct Dispatch
+        {
+            entt::registry*    Registry;
+            float              DeltaTime;
+            VyJobCounter*      Counter;
+            Mutex              ErrorMutex;
+            std::exception_ptr Error;
+        };
+
+        void rebuildGraph();
+
+        void runParallel(entt::registry& registry, float deltaTime);
+
+        void schedule(U32 index, Dispatch& dispatch);
+
+        TVector<Unique<ILogicSystem>> m_Systems;
+        ELogicScheduling              m_Mode{ ELogicScheduling::Parallel };
+
+        VyDAGraph                     m_Graph;
+        bool                          m_bGraphDirty{ true };
+        bool                          m_bChain     { false }; // No two systems can overlap, run them inline.
+        TVector<SystemNode*>          m_Nodes;         // Indexed like m_Systems.
+        TVector<TVector<U32>>         m_Dependents;    // Systems waiting on each system, from the graph's out edges.
+        TVector<U32>                  m_Dependencies;  // In edge count of each system.
+        TVector<AtomicU32>            m_Remaining;     // Unfinished dependencies during an update.
+    };
+}
@@ -1,64 +1,86 @@
-// #include <Vy/Systems/Logic/TransformSystem.h>
-
-// #include <Vy/Scene/Scene.h>
-// #include <Vy/Scene/ECS/Entity.h>
-// #include <Vy/Scene/ECS/Components.h>
-
-// namespace Vy
-// {
-// 	void VyTransformSystem::update(entt::registry& registry, float deltaTime)
-// 	{
-// 		// // Process all entities with TransformComponent
-		
-// 		// Note: This lags 1 frame per parent behind the actual local transform (but this is fine for now).
-
-// 		auto view = registry.view<TransformComponent>();
-
-// 		for (auto&& [ entity, transform ] : view.each())
-// 		{
-// 			// Compute local-to-world matrix: T * R * S
-// 			Mat4 translation = glm::translate(Mat4(1.0f), transform.Position);
-// 			Mat4 rotation    = glm::mat4_cast(transform.Rotation);
-// 			Mat4 scaleMatrix = glm::scale(Mat4(1.0f), transform.Scale);
-
-// 			Mat4 localToWorld = translation * rotation * scaleMatrix;
-
-// 			// Compute normal matrix (inverse transpose of upper-left 3x3)
-// 			// For non-uniform scaling, normals need to be transformed differently
-// 			Mat3 normalMat    = glm::transpose(glm::inverse(Mat3(localToWorld)));
-// 			Mat4 normalMatrix = Mat4(normalMat);
-
-// 			// Store result in LocalToWorld component (separate from input!)
-// 			registry.emplace_or_replace<LocalToWorldComponent>(entity, localToWorld, normalMatrix);
-// 		}
-// 	}
-
-
-
-// 	// void VyTransformSystem::update(entt::registry& registry, float deltaTime)
-// 	// {
-// 	// 	// // Process all entities with TransformComponent
-		
-// 	// 	// Note: This lags 1 frame per parent behind the actual local transform (but this is fine for now).
-
-// 	// 	auto view = registry.view<TransformComponent, GlobalTransformComponent, ParentComponent>();
-
-// 	// 	for (auto&& [ entity, transform, globalTransform, parent ] : view.each())
-// 	// 	{
-// 	// 		if (!parent.Parent || !parent.Parent.has<GlobalTransformComponent>())
-// 	// 		{
-// 	// 			globalTransform.Position = transform.Position;
-// 	// 			globalTransform.Rotation = transform.Rotation;
-// 	// 			globalTransform.Scale    = transform.Scale;
-
-// 	// 			continue;
-// 	// 		}
-
-// 	// 		auto& parentGlobal = parent.Parent.get<GlobalTransformComponent>();
-            
-// 	// 		globalTransform.Position = parentGlobal.Position + transform.Position;
-// 	// 		globalTransform.Rotation = parentGlobal.Rotation * transform.Rotation;
-// 	// 		globalTransform.Scale    = parentGlobal.Scale    * transform.Scale;
-// 	// 	}
-// 	// }
-// }
\ No newline at end of file
+#include <Vy/Systems/Logic/TransformSystem.h>
+
+#include <Vy/Scene/Scene.h>
+#include <Vy/Scene/ECS/Entity.h>
+#include <Vy/Scene/ECS/Components.h>
+
+#include <Vy/Math/TransformBatch.h>
+
+namespace Vy
+{
+	void VyTransformSystem::update(entt::registry& registry, float deltaTime)
+	{
+		auto view = registry.view<const TransformComponent, const ParentComponent, LocalToWorldComponent>();
+
+		m_Changed     .clear();
+		m_Translations.clear();
+		m_Rotations   .clear();
+		m_Scales      .clear();
+
+		// [ Gather ] the changed roots into contiguous arrays for the batch kernel.
+		for (auto&& [ entity, transform, parent, world ] : view.each())
+		{
+			// Children are handled by VyHierarchySystem.
+			if (registry.valid(parent.Parent) || world.isCurrent(transform))
+			{
+				continue;
+			}
+
+			m_Changed     .push_back(&world);
+			m_Translations.push_back(transform.Translation);
+			m_Rotations   .push_back(transform.Rotation);
+			m_Scales      .push_back(transform.Scale);
+		}
+
+		if (m_Changed.empty())
+		{
+			return;
+		}
+
+		// [ Compute ]
+		m_Matrices.resize(m_Changed.size());
+		m_Normals .resize(m_Changed.size());
+
+		TransformBatch::compute(m_Translations, m_Rotations, m_Scales, m_Matrices, m_Normals);
+
+		// [ Scatter ]
+		for (size_t i = 0; i < m_Changed.size(); i++)
+		{
+			LocalToWorldComponent& world = *m_Changed[i];
+
+			world.Matrix       = m_Matrices[i];
+			world.NormalMatrix = m_Normals [i];
+
+			world.Translation  = m_Translations[i];
+			world.Scale        = m_Scales      [i];
+			world.Rotation     = m_Rotations   [i];
+			world.Version++;
+		}
+	}
+
+
+	void VyTransformSystem::declareAccess(VySystemAccess& access) const
+	{
+		access.read<TransformComponent, ParentComponent>()
+		      .write<LocalToWorldComponent>();
+	}
+
+
+	bool VyTransformSystem::updateLocalToWorld(const TransformComponent& transform, LocalToWorldComponent& world)
+	{
+		if (world.isCurrent(transform))
+		{
+			return false;
+		}
+
+		world.Matrix       = transform.matrix();
+		world.NormalMatrix = Mat4{ transform.normalMatrix() };
+
+		world.Translation  = transform.Translation;
+		world.Scale        = transform.Scale;
+		world.Rotation     = transform.Rotation;
+		world.Version++;
+
+		return true;
+	}
+}
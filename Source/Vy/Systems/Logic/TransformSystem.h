@@ -1,32 +1,54 @@
-// #pragma once
+#pragma once
 
-// #include <Vy/Systems/Logic/ILogicSystem.h>
+#include <Vy/Systems/Logic/ILogicSystem.h>
+#include <Vy/Scene/ECS/Components/LocalToWorldComponent.h>
 
-// namespace Vy
-// {
-// 	/**
-// 	 * TransformSystem - Computes transform matrices from TransformComponent
-// 	 *
-// 	 * Responsibilities:
-// 	 * - Compute LocalToWorld matrices from TransformComponent (pos/rot/scale)
-// 	 * - Compute normal matrices for lighting calculations
-// 	 * - Cache-friendly iteration using EnTT views
-// 	 *
-// 	 * Component requirements:
-// 	 * - TransformComponent (input - pure data: pos, rot, scale)
-// 	 * - LocalToWorld (output - computed matrix data)
-// 	 *
-// 	 * Performance:
-// 	 * - Uses EnTT view for cache-friendly iteration
-// 	 * - Processes all transforms each frame (still very fast due to cache locality)
-// 	 * - Future: Could add change tracking via entt::sigh for minimal overhead
-// 	 */
-// 	class VyTransformSystem : public ILogicSystem
-// 	{
-// 	public:
-// 		VyTransformSystem()  = default;
-// 		~VyTransformSystem() = default;
+namespace Vy
+{
+	/**
+	 * TransformSystem - Computes transform matrices from TransformComponent
+	 *
+	 * Responsibilities:
+	 * - Compute LocalToWorld matrices of root entities from TransformComponent (pos/rot/scale)
+	 * - Compute normal matrices for lighting calculations
+	 * - Cache-friendly iteration using EnTT views
+	 *
+	 * Component requirements:
+	 * - TransformComponent (input - pure data: pos, rot, scale)
+	 * - LocalToWorld (output - computed matrix data)
+	 *
+	 * Entities with a parent are skipped, VyHierarchySystem propagates their world transform after this system ran.
+	 *
+	 * Performance:
+	 * - Only recomputes the matrices of entities whose transform changed since the last update.
+	 * - The changed transforms are gathered into contiguous arrays and converted by the SIMD TransformBatch kernel.
+	 *   Transforms are written in place all over the engine (scripts, editor, serializer), so a change is detected
+	 *   by comparing the transform with the one LocalToWorld was computed from rather than with entt signals.
+	 */
+	class VyTransformSystem : public ILogicSystem
+	{
+	public:
+		VyTransformSystem()  = default;
+		~VyTransformSystem() = default;
 
-// 		void update(entt::registry& registry, float deltaTime) override;
-// 	};
-// }
\ No newline at end of file
+		void update(entt::registry& registry, float deltaTime) override;
+
+		void declareAccess(VySystemAccess& access) const override;
+
+		/**
+		 * @brief Recomputes the matrices of `world` if they are out of date with `transform`.
+		 * 
+		 * @return True if the matrices were recomputed.
+		 */
+		static bool updateLocalToWorld(const TransformComponent& transform, LocalToWorldComponent& world);
+
+	private:
+		// Scratch arrays of the changed roots, kept to avoid reallocating every frame.
+		TVector<LocalToWorldComponent*> m_Changed;
+		TVector<Vec3>                   m_Translations;
+		TVector<Vec3>                   m_Rotations;
+		TVector<Vec3>                   m_Scales;
+		TVector<Mat4>                   m_Matrices;
+		TVector<Mat4>                   m_Normals;
+	};
+}
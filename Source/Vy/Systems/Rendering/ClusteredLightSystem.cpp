@@ -0,0 +1,259 @@
+#include <Vy/Systems/Rendering/ClusteredLightSystem.h>
+
+#include <Vy/Systems/Rendering/ShadowSystem.h>
+
+#include <Vy/GFX/Context.h>
+
+#include <algorithm>
+
+namespace Vy
+{
+    static constexpr U32 kClusterGroupSize = 128; // Matches local_size_x of ClusterLights.comp.
+
+    // =====================================================================================================================
+
+    VyClusteredLightSystem::VyClusteredLightSystem(VkExtent2D extent) :
+        m_Extent{ extent }
+    {
+        // Cluster set layout ( compute 0 ).
+        m_ClusterSetLayout = VyDescriptorSetLayout::Builder{}
+            .addBinding(0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT) // Lights
+            .addBinding(1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT) // Cluster Light Counts
+            .addBinding(2, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT) // Cluster Light Indices
+        .buildUnique();
+
+        // Device local, GPU only.
+        m_ClusterCountBuffer = MakeUnique<VyBuffer>( VyBuffer::indirectBuffer(sizeof(U32) * kClusterCount), false );
+        m_ClusterIndexBuffer = MakeUnique<VyBuffer>( VyBuffer::indirectBuffer(sizeof(U32) * kClusterCount * kMaxLightsPerCluster), false );
+
+        auto countInfo = m_ClusterCountBuffer->descriptorBufferInfo();
+        auto indexInfo = m_ClusterIndexBuffer->descriptorBufferInfo();
+
+        for (FrameResources& frame : m_Frames)
+        {
+            frame.LightBuffer = MakeUnique<VyBuffer>( VyBuffer::storageBuffer(sizeof(LightData) * kMaxLights) );
+
+            auto lightInfo = frame.LightBuffer->descriptorBufferInfo();
+
+            VyDescriptorWriter{ *m_ClusterSetLayout, *VyContext::globalPool() }
+                .writeBuffer(0, &lightInfo)
+                .writeBuffer(1, &countInfo)
+                .writeBuffer(2, &indexInfo)
+            .build(frame.ClusterSet);
+        }
+
+        m_LightScratch.reserve(kMaxLights);
+    }
+
+
+    VyClusteredLightSystem::~VyClusteredLightSystem()
+    {
+        TVector<VkDescriptorSet> sets;
+
+        for (const FrameResources& frame : m_Frames)
+        {
+            sets.push_back(frame.ClusterSet);
+        }
+
+        std::erase(sets, VK_NULL_HANDLE);
+
+        VyContext::releaseSets(sets);
+    }
+
+
+    void VyClusteredLightSystem::createPipeline()
+    {
+        m_ClusterPipeline = VyPipeline::ComputeBuilder{}
+            .addDescriptorSetLayout(m_ClusterSetLayout->handle())
+            .addPushConstantRange  (VK_SHADER_STAGE_COMPUTE_BIT, sizeof(ClusterPushConstants))
+            .setShaderStage        ("Lighting/ClusterLights.comp.spv")
+        .buildUnique();
+    }
+
+    // =====================================================================================================================
+
+    float VyClusteredLightSystem::lightRange(const Vec3& color, float intensity, float range)
+    {
+        if (range > 0.0f)
+        {
+            return range;
+        }
+
+        // Inverse square falloff: the distance at which the brightest channel drops below the cutoff.
+        const float peak = intensity * std::max({ color.r, color.g, color.b });
+
+        return peak > 0.0f ? glm::sqrt(peak / kLightCutoff) : 0.0f;
+    }
+
+
+    U32 VyClusteredLightSystem::shadowIndex(ELightType type, size_t index) const
+    {
+        return m_ShadowSystem ? m_ShadowSystem->shadowIndex(type, index) : kNoShadow;
+    }
+
+
+    void VyClusteredLightSystem::update(VyFrameInfo& frameInfo, GlobalUBO& ubo)
+    {
+        FrameResources&      frame  = m_Frames[ frameInfo.FrameIndex ];
+        const VyFramePacket& packet = frameInfo.Packet;
+
+        m_LightScratch.clear();
+
+        // ----------------------------------------------------------------------------------------
+        // [ Directional Lights ]
+
+        for (size_t i = 0; i < packet.DirectionalLights.size(); i++)
+        {
+            const VyDirectionalLightProxy& dirLight = packet.DirectionalLights[i];
+
+            if (m_LightScratch.size() == kMaxLights)
+            {
+                break;
+            }
+
+            LightData& light = m_LightScratch.emplace_back();
+            {
+                light.Direction   = Vec4(glm::normalize(dirLight.Transform.forward()), 0.0f);
+                light.Color       = Vec4(dirLight.Light.Color, dirLight.Light.Intensity);
+                light.Type        = LightType_Directional;
+                light.ShadowIndex = shadowIndex(LightType_Directional, i);
+            }
+        }
+
+        frame.DirectionalCount = static_cast<U32>(m_LightScratch.size());
+
+        // ----------------------------------------------------------------------------------------
+        // [ Point Lights ]
+
+        for (size_t i = 0; i < packet.PointLights.size(); i++)
+        {
+            const VyPointLightProxy& pointLight = packet.PointLights[i];
+
+            const float range = lightRange(pointLight.Light.Color, pointLight.Light.Intensity, pointLight.Light.Range);
+
+            if (range <= 0.0f || m_LightScratch.size() == kMaxLights)
+            {
+                continue;
+            }
+
+            LightData& light = m_LightScratch.emplace_back();
+            {
+                light.Position    = Vec4(pointLight.Transform.Translation, range);
+                light.Color       = Vec4(pointLight.Light.Color, pointLight.Light.Intensity);
+                light.Type        = LightType_Point;
+                light.ShadowIndex = shadowIndex(LightType_Point, i);
+            }
+        }
+
+        // ----------------------------------------------------------------------------------------
+        // [ Spot Lights ]
+
+        for (size_t i = 0; i < packet.SpotLights.size(); i++)
+        {
+            const VySpotLightProxy& spotLight = packet.SpotLights[i];
+
+            const float range = lightRange(spotLight.Light.Color, spotLight.Light.Intensity, spotLight.Light.Range);
+
+            if (range <= 0.0f || m_LightScratch.size() == kMaxLights)
+            {
+                continue;
+            }
+
+            LightData& light = m_LightScratch.emplace_back();
+            {
+                light.Position    = Vec4(spotLight.Transform.Translation, range);
+                light.Direction   = Vec4(glm::normalize(spotLight.Transform.forward()), 0.0f);
+                light.Color       = Vec4(spotLight.Light.Color, spotLight.Light.Intensity);
+                light.InnerCutoff = glm::cos(glm::radians(spotLight.Light.InnerCutoffAngle));
+                light.OuterCutoff = glm::cos(glm::radians(spotLight.Light.OuterCutoffAngle));
+                light.Type        = LightType_Spot;
+                light.ShadowIndex = shadowIndex(LightType_Spot, i);
+            }
+        }
+
+        const size_t requested = packet.DirectionalLights.size() + packet.PointLights.size() + packet.SpotLights.size();
+
+        if (requested > kMaxLights && !m_bWarnedOverflow)
+        {
+            VY_WARN_TAG("VyClusteredLightSystem", "{} lights exceed the light buffer, only the first {} are shaded", requested, kMaxLights);
+
+            m_bWarnedOverflow = true;
+        }
+
+        m_LightCount     = static_cast<U32>(m_LightScratch.size());
+        frame.LocalCount = m_LightCount - frame.DirectionalCount;
+
+        // [ Upload Lights ]
+        if (m_LightCount > 0)
+        {
+            frame.LightBuffer->write(m_LightScratch.data(), sizeof(LightData) * m_LightCount, 0);
+        }
+
+        // ----------------------------------------------------------------------------------------
+        // [ Update UBO ]
+
+        // Exponential slices: slice = log(z) * scale + bias maps [ near, far ] onto [ 0, kClusterCountZ ].
+        const float zNear    = frameInfo.Camera.nearPlane();
+        const float zFar     = frameInfo.Camera.farPlane();
+        const float slices   = static_cast<float>(kClusterCountZ);
+        const float logRange = glm::log(zFar / zNear);
+
+        ubo.NumDirectionalLights = frame.DirectionalCount;
+        ubo.NumLocalLights       = frame.LocalCount;
+
+        ubo.ClusterGrid   = UVec4(kClusterCountX, kClusterCountY, kClusterCountZ, kMaxLightsPerCluster);
+        ubo.ClusterParams = Vec4(
+            static_cast<float>(m_Extent.width)  / kClusterCountX,
+            static_cast<float>(m_Extent.height) / kClusterCountY,
+             slices / logRange,
+            -slices * glm::log(zNear) / logRange
+        );
+    }
+
+
+    void VyClusteredLightSystem::prepare(const VyFrameInfo& frameInfo)
+    {
+        const FrameResources& frame = m_Frames[ frameInfo.FrameIndex ];
+
+        VkCommandBuffer cmdBuffer = frameInfo.CommandBuffer;
+
+        VKCmd::beginDebugUtilsLabel(cmdBuffer, "Light Clustering");
+
+        // The previous frame's material pass must be done reading the clusters before they are rewritten.
+        VKCmd::memoryBarrier(cmdBuffer,
+            VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,  VK_ACCESS_SHADER_WRITE_BIT
+        );
+
+        m_ClusterPipeline->bind(cmdBuffer);
+        m_ClusterPipeline->bindDescriptorSet(cmdBuffer, 0, frame.ClusterSet);
+
+        // Always dispatched, clusters without lights still need their count reset.
+        ClusterPushConstants push{};
+        {
+            push.View              = frameInfo.Camera.view();
+            push.InverseProjection = glm::inverse(frameInfo.Camera.projection());
+            push.Grid              = UVec4(kClusterCountX, kClusterCountY, kClusterCountZ, kClusterCount);
+            push.ScreenSize        = Vec4(
+                static_cast<float>(m_Extent.width),
+                static_cast<float>(m_Extent.height),
+                frameInfo.Camera.nearPlane(),
+                frameInfo.Camera.farPlane()
+            );
+            push.FirstLight        = frame.DirectionalCount;
+            push.LightCount        = frame.LocalCount;
+        }
+
+        m_ClusterPipeline->pushConstants(cmdBuffer, VK_SHADER_STAGE_COMPUTE_BIT, push);
+
+        vkCmdDispatch(cmdBuffer, (kClusterCount + kClusterGroupSize - 1) / kClusterGroupSize, 1, 1);
+
+        // The material pass reads the cluster lists.
+        VKCmd::memoryBarrier(cmdBuffer,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,  VK_ACCESS_SHADER_WRITE_BIT,
+            VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT
+        );
+
+        VKCmd::endDebugUtilsLabel(cmdBuffer);
+    }
+}
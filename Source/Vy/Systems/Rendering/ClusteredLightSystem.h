@@ -0,0 +1,137 @@
+#pragma once
+
+#include <Vy/Systems/Rendering/IRenderSystem.h>
+
+#include <Vy/GFX/Backend/Descriptors.h>
+
+namespace Vy
+{
+    class VyShadowSystem;
+
+    /**
+     * @brief Clustered forward lighting: bins the point and spot lights of the frame into a 3D grid of view frustum cells.
+     *
+     * `update` writes every light of the frame packet into the frame's light storage buffer (directional lights first)
+     * and fills the light and cluster fields of the GlobalUBO. `prepare` dispatches ClusterLights.comp, which splits the
+     * frustum into `kClusterCountX * kClusterCountY` screen tiles and `kClusterCountZ` exponentially spaced depth slices
+     * and writes the indices of the lights whose range touches each cluster. The material shader finds its cluster from
+     * the fragment position and only shades the lights in it, so the cost per fragment follows the local light density
+     * instead of the total light count.
+     *
+     * The light and cluster buffers are bound to the global set (bindings 1 - 3), see `lightBufferInfo`,
+     * `clusterCountInfo` and `clusterIndexInfo`. With a shadow system set, every light carries the index of its
+     * shadow in the shadow buffer (`LightData::ShadowIndex`).
+     *
+     * @note Lights past `kMaxLights`, and the lights of a cluster past `kMaxLightsPerCluster`, are dropped.
+     */
+    class VyClusteredLightSystem : public IRenderSystem
+    {
+    public:
+        static constexpr U32 kClusterCountX       = 16;
+        static constexpr U32 kClusterCountY       = 9;
+        static constexpr U32 kClusterCountZ       = 24;
+        static constexpr U32 kClusterCount        = kClusterCountX * kClusterCountY * kClusterCountZ;
+
+        static constexpr U32 kMaxLights           = 4096;
+        static constexpr U32 kMaxLightsPerCluster = 256; // Matches MAX_LIGHTS_PER_CLUSTER in ClusterLights.comp.
+
+        /**
+         * @brief Intensity at which a light without an explicit range is cut off.
+         */
+        static constexpr float kLightCutoff = 1.0f / 256.0f;
+
+        explicit VyClusteredLightSystem(VkExtent2D extent);
+
+        VyClusteredLightSystem(const VyClusteredLightSystem&)            = delete;
+        VyClusteredLightSystem& operator=(const VyClusteredLightSystem&) = delete;
+
+        ~VyClusteredLightSystem() override;
+
+        /**
+         * @brief Creates the compute pipeline, separate from the constructor so it is compiled with the other systems.
+         */
+        void createPipeline();
+
+        void recreate(VkExtent2D newExtent) { m_Extent = newExtent; }
+
+        /**
+         * @brief Shadows to link the lights to. Its `update` must run before this system's `update` in a frame.
+         */
+        void setShadowSystem(const VyShadowSystem* shadowSystem) { m_ShadowSystem = shadowSystem; }
+
+        /**
+         * @brief Writes the lights of the frame packet into the frame's light buffer and the light / cluster fields of the UBO.
+         */
+        void update(VyFrameInfo& frameInfo, GlobalUBO& ubo) override;
+
+        /**
+         * @brief Records the light binning compute pass. Must be outside of a render pass.
+         */
+        void prepare(const VyFrameInfo& frameInfo) override;
+
+        /**
+         * @brief Nothing to draw, the lights are shaded by the material pass.
+         */
+        void render(const VyFrameInfo& frameInfo) override {}
+
+        VY_NODISCARD VkDescriptorBufferInfo lightBufferInfo(int frameIndex) const
+        {
+            return m_Frames[ frameIndex ].LightBuffer->descriptorBufferInfo();
+        }
+
+        VY_NODISCARD VkDescriptorBufferInfo clusterCountInfo() const { return m_ClusterCountBuffer->descriptorBufferInfo(); }
+        VY_NODISCARD VkDescriptorBufferInfo clusterIndexInfo() const { return m_ClusterIndexBuffer->descriptorBufferInfo(); }
+
+        /**
+         * @brief Lights written into the light buffer of the last updated frame.
+         */
+        VY_NODISCARD U32 lightCount() const { return m_LightCount; }
+
+        /**
+         * @brief Range of a point or spot light, from its intensity unless it has an explicit one.
+         */
+        VY_NODISCARD static float lightRange(const Vec3& color, float intensity, float range);
+
+    private:
+        struct ClusterPushConstants
+        {
+            Mat4  View;
+            Mat4  InverseProjection;
+            UVec4 Grid;       // xyz = clusters per axis, w = cluster count
+            Vec4  ScreenSize; // xy  = size in pixels, z = near plane, w = far plane
+            U32   FirstLight; // First point / spot light in the light buffer.
+            U32   LightCount;
+        };
+
+        struct FrameResources
+        {
+            Unique<VyBuffer> LightBuffer;                   // Host visible, rewritten every frame.
+            VkDescriptorSet  ClusterSet{ VK_NULL_HANDLE };
+            U32              DirectionalCount{ 0 };
+            U32              LocalCount      { 0 };
+        };
+
+        /**
+         * @brief Shadow buffer index of the light at `index` in the packet's lights of `type`.
+         */
+        VY_NODISCARD U32 shadowIndex(ELightType type, size_t index) const;
+
+        VkExtent2D                              m_Extent;
+
+        TArray<FrameResources, MAX_FRAMES_IN_FLIGHT> m_Frames;
+
+        // Written and read on the same queue, the barriers in `prepare` order the frames.
+        Unique<VyBuffer>                        m_ClusterCountBuffer;
+        Unique<VyBuffer>                        m_ClusterIndexBuffer;
+
+        Unique<VyDescriptorSetLayout>           m_ClusterSetLayout;
+        Unique<VyPipeline>                      m_ClusterPipeline;
+
+        TVector<LightData>                      m_LightScratch;
+
+        const VyShadowSystem*                   m_ShadowSystem{ nullptr };
+
+        U32                                     m_LightCount{ 0 };
+        bool                                    m_bWarnedOverflow{ false };
+    };
+}
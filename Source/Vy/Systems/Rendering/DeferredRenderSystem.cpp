@@ -0,0 +1,436 @@
+#include <Vy/Systems/Rendering/DeferredRenderSystem.h>
+
+#include <Vy/Systems/Rendering/PostProcessSystem.h>
+
+#include <Vy/GFX/Context.h>
+
+namespace Vy
+{
+    /**
+     * @brief Memory for attachments that only live inside a render pass: lazily allocated where the device has it
+     *        (tile based GPUs, which never back it), device local otherwise.
+     */
+    static VmaMemoryUsage transientMemoryUsage()
+    {
+        VkPhysicalDeviceMemoryProperties memProperties;
+        vkGetPhysicalDeviceMemoryProperties(VyContext::device().physicalDevice(), &memProperties);
+
+        for (U32 i = 0; i < memProperties.memoryTypeCount; i++)
+        {
+            if (memProperties.memoryTypes[i].propertyFlags & VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT)
+            {
+                return VMA_MEMORY_USAGE_GPU_LAZILY_ALLOCATED;
+            }
+        }
+
+        return VMA_MEMORY_USAGE_AUTO;
+    }
+
+    // =====================================================================================================================
+
+    VyDeferredRenderSystem::VyDeferredRenderSystem(
+        VkExtent2D                 extent,
+        VkDescriptorSetLayout      globalSetLayout,
+        const VyPostProcessSystem& postProcessSystem
+    ) :
+        m_Extent{ extent }
+    {
+        // G-buffer set layout ( 1 ).
+        m_GBufferSetLayout = VyDescriptorSetLayout::Builder{}
+            .addBinding(0, VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT, VK_SHADER_STAGE_FRAGMENT_BIT) // Albedo / Metallic
+            .addBinding(1, VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT, VK_SHADER_STAGE_FRAGMENT_BIT) // Normal / Roughness
+            .addBinding(2, VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT, VK_SHADER_STAGE_FRAGMENT_BIT) // Depth
+        .buildUnique();
+
+        createGBuffer();
+        createRenderPass();
+        createFramebuffers(postProcessSystem);
+        writeDescriptorSets(postProcessSystem);
+        createPipeline(globalSetLayout);
+    }
+
+
+    VyDeferredRenderSystem::~VyDeferredRenderSystem()
+    {
+        TVector<VkDescriptorSet> sets{ m_GBufferSets.begin(), m_GBufferSets.end() };
+
+        std::erase(sets, VK_NULL_HANDLE);
+
+        VyContext::releaseSets(sets);
+
+        destroyFramebuffers();
+
+        if (m_RenderPass != VK_NULL_HANDLE)
+        {
+            vkDestroyRenderPass(VyContext::device(), m_RenderPass, nullptr);
+        }
+    }
+
+
+    void VyDeferredRenderSystem::recreate(VkExtent2D newExtent, const VyPostProcessSystem& postProcessSystem)
+    {
+        m_Extent = newExtent;
+
+        VyContext::waitIdle();
+
+        destroyFramebuffers();
+
+        m_NormalImageViews.clear();
+        m_NormalImages    .clear();
+        m_AlbedoImageViews.clear();
+        m_AlbedoImages    .clear();
+
+        // The render pass does not depend on the extent, the pipeline stays valid.
+        createGBuffer();
+        createFramebuffers(postProcessSystem);
+        writeDescriptorSets(postProcessSystem);
+    }
+
+
+    TArray<VkClearValue, 4> VyDeferredRenderSystem::clearValues() const
+    {
+        TArray<VkClearValue, 4> clearValues{};
+        {
+            clearValues[0].color        = {{ 0.01f, 0.01f, 0.01f, 1.0f }};
+            clearValues[1].depthStencil = { 1.0f, 0 };
+        }
+
+        // The G-buffer is not cleared, the lighting pass only reads the pixels the geometry pass wrote.
+        return clearValues;
+    }
+
+// =========================================================================================================================
+#pragma region [ Resources ]
+// =========================================================================================================================
+
+    void VyDeferredRenderSystem::createGBuffer()
+    {
+        m_AlbedoImages    .resize( MAX_FRAMES_IN_FLIGHT );
+        m_AlbedoImageViews.resize( MAX_FRAMES_IN_FLIGHT );
+        m_NormalImages    .resize( MAX_FRAMES_IN_FLIGHT );
+        m_NormalImageViews.resize( MAX_FRAMES_IN_FLIGHT );
+
+        const VmaMemoryUsage    memoryUsage = transientMemoryUsage();
+        const VkImageUsageFlags usage       = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT |
+                                              VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT |
+                                              VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT;
+
+        for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
+        {
+            m_AlbedoImages[i] = VyImage::Builder{}
+                .extent     (m_Extent)
+                .format     (kGBufferAlbedoFormat)
+                .tiling     (VK_IMAGE_TILING_OPTIMAL)
+                .usage      (usage)
+                .memoryUsage(memoryUsage)
+            .build();
+
+            m_AlbedoImageViews[i] = VyImageView::Builder{}
+                .format    (kGBufferAlbedoFormat)
+                .aspectMask(VK_IMAGE_ASPECT_COLOR_BIT)
+            .build(m_AlbedoImages[i]);
+
+            m_NormalImages[i] = VyImage::Builder{}
+                .extent     (m_Extent)
+                .format     (kGBufferNormalFormat)
+                .tiling     (VK_IMAGE_TILING_OPTIMAL)
+                .usage      (usage)
+                .memoryUsage(memoryUsage)
+            .build();
+
+            m_NormalImageViews[i] = VyImageView::Builder{}
+                .format    (kGBufferNormalFormat)
+                .aspectMask(VK_IMAGE_ASPECT_COLOR_BIT)
+            .build(m_NormalImages[i]);
+        }
+    }
+
+
+    void VyDeferredRenderSystem::createRenderPass()
+    {
+        // 0 - HDR Color Attachment
+        VkAttachmentDescription colorAttachment{};
+        {
+            colorAttachment.format         = VK_FORMAT_R16G16B16A16_SFLOAT;
+            colorAttachment.samples        = VK_SAMPLE_COUNT_1_BIT;
+            colorAttachment.loadOp         = VK_ATTACHMENT_LOAD_OP_CLEAR;
+            colorAttachment.storeOp        = VK_ATTACHMENT_STORE_OP_STORE;
+            colorAttachment.stencilLoadOp  = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+            colorAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+            colorAttachment.initialLayout  = VK_IMAGE_LAYOUT_UNDEFINED;
+            // Initial layout of the HDR load render pass.
+            colorAttachment.finalLayout    = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        }
+
+        // 1 - Depth Attachment
+        VkAttachmentDescription depthAttachment{};
+        {
+            depthAttachment.format         = VyContext::device().findDepthFormat();
+            depthAttachment.samples        = VK_SAMPLE_COUNT_1_BIT;
+            depthAttachment.loadOp         = VK_ATTACHMENT_LOAD_OP_CLEAR;
+            // Stored so the forward passes can depth test against the scene.
+            depthAttachment.storeOp        = VK_ATTACHMENT_STORE_OP_STORE;
+            depthAttachment.stencilLoadOp  = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+            depthAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+            depthAttachment.initialLayout  = VK_IMAGE_LAYOUT_UNDEFINED;
+            // Initial layout of the HDR load render pass.
+            depthAttachment.finalLayout    = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
+        }
+
+        // 2 / 3 - G-buffer Attachments (never loaded or stored, so they can stay in tile memory)
+        VkAttachmentDescription gbufferAttachment{};
+        {
+            gbufferAttachment.samples        = VK_SAMPLE_COUNT_1_BIT;
+            gbufferAttachment.loadOp         = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+            gbufferAttachment.storeOp        = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+            gbufferAttachment.stencilLoadOp  = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+            gbufferAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+            gbufferAttachment.initialLayout  = VK_IMAGE_LAYOUT_UNDEFINED;
+            gbufferAttachment.finalLayout    = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        }
+
+        VkAttachmentDescription albedoAttachment = gbufferAttachment;
+        VkAttachmentDescription normalAttachment = gbufferAttachment;
+        {
+            albedoAttachment.format = kGBufferAlbedoFormat;
+            normalAttachment.format = kGBufferNormalFormat;
+        }
+
+        // ----------------------------------------------------------------------------------------
+        // [ Geometry Subpass ]
+
+        TArray<VkAttachmentReference, 3> geometryColorRefs{{
+            { 0, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL }, // HDR (ambient + emission)
+            { 2, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL }, // Albedo / Metallic
+            { 3, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL }, // Normal / Roughness
+        }};
+
+        VkAttachmentReference geometryDepthRef{ 1, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL };
+
+        // ----------------------------------------------------------------------------------------
+        // [ Lighting Subpass ]
+
+        VkAttachmentReference lightingColorRef{ 0, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL };
+
+        TArray<VkAttachmentReference, 3> lightingInputRefs{{
+            { 2, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL        },
+            { 3, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL        },
+            { 1, VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL },
+        }};
+
+        // Also bound read-only for the depth test, which skips the background pixels before shading them.
+        VkAttachmentReference lightingDepthRef{ 1, VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL };
+
+        TArray<VkSubpassDescription, 2> subpasses{};
+        {
+            subpasses[kGeometrySubpass].pipelineBindPoint       = VK_PIPELINE_BIND_POINT_GRAPHICS;
+            subpasses[kGeometrySubpass].colorAttachmentCount    = static_cast<U32>(geometryColorRefs.size());
+            subpasses[kGeometrySubpass].pColorAttachments       = geometryColorRefs.data();
+            subpasses[kGeometrySubpass].pDepthStencilAttachment = &geometryDepthRef;
+
+            subpasses[kLightingSubpass].pipelineBindPoint       = VK_PIPELINE_BIND_POINT_GRAPHICS;
+            subpasses[kLightingSubpass].colorAttachmentCount    = 1;
+            subpasses[kLightingSubpass].pColorAttachments       = &lightingColorRef;
+            subpasses[kLightingSubpass].inputAttachmentCount    = static_cast<U32>(lightingInputRefs.size());
+            subpasses[kLightingSubpass].pInputAttachments       = lightingInputRefs.data();
+            subpasses[kLightingSubpass].pDepthStencilAttachment = &lightingDepthRef;
+        }
+
+        TArray<VkSubpassDependency, 3> dependencies{};
+        {
+            // Same as the HDR render pass.
+            dependencies[0].srcSubpass      = VK_SUBPASS_EXTERNAL;
+            dependencies[0].dstSubpass      = kGeometrySubpass;
+            dependencies[0].srcStageMask    = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
+            dependencies[0].srcAccessMask   = 0;
+            dependencies[0].dstStageMask    = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
+            dependencies[0].dstAccessMask   = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+
+            // The lighting subpass reads the G-buffer and depth of its own pixel only, so the dependency is local.
+            dependencies[1].srcSubpass      = kGeometrySubpass;
+            dependencies[1].dstSubpass      = kLightingSubpass;
+            dependencies[1].srcStageMask    = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+            dependencies[1].srcAccessMask   = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+            dependencies[1].dstStageMask    = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+            dependencies[1].dstAccessMask   = VK_ACCESS_INPUT_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT |
+                                              VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+            dependencies[1].dependencyFlags = VK_DEPENDENCY_BY_REGION_BIT;
+
+            // The forward passes continue on the lit scene with the HDR load render pass.
+            dependencies[2].srcSubpass      = kLightingSubpass;
+            dependencies[2].dstSubpass      = VK_SUBPASS_EXTERNAL;
+            dependencies[2].srcStageMask    = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+            dependencies[2].srcAccessMask   = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+            dependencies[2].dstStageMask    = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
+            dependencies[2].dstAccessMask   = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT |
+                                              VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+        }
+
+        TArray<VkAttachmentDescription, 4> attachments = { colorAttachment, depthAttachment, albedoAttachment, normalAttachment };
+
+        VkRenderPassCreateInfo renderPassInfo{ VKInit::renderPassCreateInfo() };
+        {
+            renderPassInfo.attachmentCount = static_cast<U32>(attachments.size());
+            renderPassInfo.pAttachments    = attachments.data();
+
+            renderPassInfo.subpassCount    = static_cast<U32>(subpasses.size());
+            renderPassInfo.pSubpasses      = subpasses.data();
+
+            renderPassInfo.dependencyCount = static_cast<U32>(dependencies.size());
+            renderPassInfo.pDependencies   = dependencies.data();
+        }
+
+        if (vkCreateRenderPass(VyContext::device(), &renderPassInfo, nullptr, &m_RenderPass) != VK_SUCCESS)
+        {
+            VY_THROW_RUNTIME_ERROR("Failed to create deferred render pass!");
+        }
+    }
+
+
+    void VyDeferredRenderSystem::createFramebuffers(const VyPostProcessSystem& postProcessSystem)
+    {
+        m_Framebuffers.resize( MAX_FRAMES_IN_FLIGHT );
+
+        for (size_t i = 0; i < m_Framebuffers.size(); i++)
+        {
+            TArray<VkImageView, 4> attachments = {
+                postProcessSystem.getHDRImageView     (static_cast<int>(i)),
+                postProcessSystem.getHDRDepthImageView(static_cast<int>(i)),
+                m_AlbedoImageViews[i].handle(),
+                m_NormalImageViews[i].handle()
+            };
+
+            VkFramebufferCreateInfo framebufferInfo{ VKInit::framebufferCreateInfo() };
+            {
+                framebufferInfo.renderPass      = m_RenderPass;
+
+                framebufferInfo.attachmentCount = static_cast<U32>(attachments.size());
+                framebufferInfo.pAttachments    = attachments.data();
+
+                framebufferInfo.width           = m_Extent.width;
+                framebufferInfo.height          = m_Extent.height;
+                framebufferInfo.layers          = 1;
+            }
+
+            if (vkCreateFramebuffer(VyContext::device(), &framebufferInfo, nullptr, &m_Framebuffers[i]) != VK_SUCCESS)
+            {
+                VY_THROW_RUNTIME_ERROR("Failed to create deferred Framebuffer!");
+            }
+        }
+    }
+
+
+    void VyDeferredRenderSystem::destroyFramebuffers()
+    {
+        for (VkFramebuffer framebuffer : m_Framebuffers)
+        {
+            vkDestroyFramebuffer(VyContext::device(), framebuffer, nullptr);
+        }
+
+        m_Framebuffers.clear();
+    }
+
+
+    void VyDeferredRenderSystem::writeDescriptorSets(const VyPostProcessSystem& postProcessSystem)
+    {
+        for (int i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
+        {
+            VkDescriptorImageInfo albedoInfo{ VK_NULL_HANDLE, m_AlbedoImageViews[i].handle(),              VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL        };
+            VkDescriptorImageInfo normalInfo{ VK_NULL_HANDLE, m_NormalImageViews[i].handle(),              VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL        };
+            VkDescriptorImageInfo depthInfo { VK_NULL_HANDLE, postProcessSystem.getHDRDepthImageView(i), VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL };
+
+            VyDescriptorWriter writer{ *m_GBufferSetLayout, *VyContext::globalPool() };
+
+            writer
+                .writeImage(0, &albedoInfo)
+                .writeImage(1, &normalInfo)
+                .writeImage(2, &depthInfo);
+
+            // The sets are allocated once and rewritten when the views are recreated.
+            if (m_GBufferSets[i] == VK_NULL_HANDLE)
+            {
+                writer.build(m_GBufferSets[i]);
+            }
+            else
+            {
+                writer.update(m_GBufferSets[i]);
+            }
+        }
+    }
+
+
+    void VyDeferredRenderSystem::createPipeline(VkDescriptorSetLayout globalSetLayout)
+    {
+        // Adds the light to what the geometry pass wrote (ambient and emission).
+        VkPipelineColorBlendAttachmentState additiveBlend{};
+        {
+            additiveBlend.blendEnable         = VK_TRUE;
+            additiveBlend.srcColorBlendFactor = VK_BLEND_FACTOR_ONE;
+            additiveBlend.dstColorBlendFactor = VK_BLEND_FACTOR_ONE;
+            additiveBlend.colorBlendOp        = VK_BLEND_OP_ADD;
+            additiveBlend.srcAlphaBlendFactor = VK_BLEND_FACTOR_ZERO;
+            additiveBlend.dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+            additiveBlend.alphaBlendOp        = VK_BLEND_OP_ADD;
+            additiveBlend.colorWriteMask      = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT |
+                                                VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+        }
+
+        m_LightingPipeline = VyPipeline::GraphicsBuilder{}
+            .addDescriptorSetLayout (globalSetLayout)
+            .addDescriptorSetLayout (m_GBufferSetLayout->handle())
+            .addPushConstantRange   (VK_SHADER_STAGE_FRAGMENT_BIT, sizeof(LightingPushConstants))
+            .addShaderStage         (VK_SHADER_STAGE_VERTEX_BIT,   "Deferred/DeferredLighting.vert.spv")
+            .addShaderStage         (VK_SHADER_STAGE_FRAGMENT_BIT, "Deferred/DeferredLighting.frag.spv")
+            // The triangle is at the far plane: only pixels in front of it (with geometry) pass.
+            .setDepthTest           (true, false, VK_COMPARE_OP_GREATER)
+            .setCullMode            (VK_CULL_MODE_NONE)
+            .addColorAttachment     (VK_FORMAT_R16G16B16A16_SFLOAT)
+            .setColorBlendAttachment(0, additiveBlend)
+            .setDepthAttachment     (VK_FORMAT_D32_SFLOAT)
+            .clearVertexDescriptions() // Clear default vertex bindings and attributes.
+            .setRenderPass          (m_RenderPass)
+            .setSubpass             (kLightingSubpass)
+        .buildUnique();
+    }
+
+#pragma endregion Resources
+
+// =========================================================================================================================
+#pragma region [ Rendering ]
+// =========================================================================================================================
+
+    void VyDeferredRenderSystem::render(const VyFrameInfo& frameInfo)
+    {
+        VkCommandBuffer cmdBuffer = frameInfo.CommandBuffer;
+
+        VKCmd::beginDebugUtilsLabel(cmdBuffer, "Deferred Lighting");
+
+        const TArray<VkDescriptorSet, 2> sets{
+            frameInfo.GlobalDescriptorSet,         // Global ( 0 ).
+            m_GBufferSets[ frameInfo.FrameIndex ]  // G-buffer ( 1 ).
+        };
+
+        m_LightingPipeline->bind(cmdBuffer);
+        m_LightingPipeline->bindDescriptorSets(cmdBuffer, 0, sets);
+
+        LightingPushConstants push{};
+        {
+            push.InverseProjection = glm::inverse(frameInfo.Camera.projection());
+            push.ScreenSize        = Vec4(
+                static_cast<float>(m_Extent.width),
+                static_cast<float>(m_Extent.height),
+                1.0f / static_cast<float>(m_Extent.width),
+                1.0f / static_cast<float>(m_Extent.height)
+            );
+        }
+
+        m_LightingPipeline->pushConstants(cmdBuffer, VK_SHADER_STAGE_FRAGMENT_BIT, push);
+
+        // Fullscreen triangle.
+        vkCmdDraw(cmdBuffer, 3, 1, 0, 0);
+
+        VKCmd::endDebugUtilsLabel(cmdBuffer);
+    }
+
+#pragma endregion Rendering
+}
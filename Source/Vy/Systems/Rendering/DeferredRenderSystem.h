@@ -0,0 +1,102 @@
+#pragma once
+
+#include <Vy/Systems/Rendering/IRenderSystem.h>
+
+#include <Vy/GFX/Backend/Descriptors.h>
+#include <Vy/GFX/Backend/Device.h>
+
+namespace Vy
+{
+    class VyPostProcessSystem;
+
+    /**
+     * @brief Owns the render pass, the G-buffer and the lighting pass of the deferred shading path.
+     *
+     * The deferred pass renders into the HDR color and depth targets of `VyPostProcessSystem` in two subpasses:
+     *
+     * - Geometry (subpass 0): `VyRenderSystem` draws the opaque scene with GBuffer.frag, which writes the ambient and
+     *   emissive term into the HDR target and the surface into the G-buffer.
+     * - Lighting (subpass 1): `render` draws a fullscreen triangle that reads the G-buffer and the depth as input
+     *   attachments, reconstructs the position and adds the directional and clustered lights to the HDR target.
+     *
+     * The G-buffer is compact (8 bytes per pixel) and only lives inside the pass: its attachments are transient and never
+     * stored, so tile based GPUs keep it on-chip and, where the device has lazily allocated memory, never back it.
+     *
+     * | Attachment | Format                      | Contents                                    |
+     * |------------|-----------------------------|---------------------------------------------|
+     * | G-buffer 0 | R8G8B8A8_SRGB               | rgb = albedo, a = metallic                  |
+     * | G-buffer 1 | A2B10G10R10_UNORM_PACK32    | rg = octahedral normal, b = roughness       |
+     *
+     * The HDR color and depth are stored and left in the layouts of the HDR load render pass, so the forward passes
+     * (skybox, light gizmos, grid) continue on top of the lit scene.
+     */
+    class VyDeferredRenderSystem : public IRenderSystem
+    {
+    public:
+        static constexpr VkFormat kGBufferAlbedoFormat = VK_FORMAT_R8G8B8A8_SRGB;
+        static constexpr VkFormat kGBufferNormalFormat = VK_FORMAT_A2B10G10R10_UNORM_PACK32;
+
+        static constexpr U32 kGeometrySubpass = 0;
+        static constexpr U32 kLightingSubpass = 1;
+
+        VyDeferredRenderSystem(
+            VkExtent2D                 extent,
+            VkDescriptorSetLayout      globalSetLayout,
+            const VyPostProcessSystem& postProcessSystem
+        );
+
+        VyDeferredRenderSystem(const VyDeferredRenderSystem&)            = delete;
+        VyDeferredRenderSystem& operator=(const VyDeferredRenderSystem&) = delete;
+
+        ~VyDeferredRenderSystem() override;
+
+        /**
+         * @brief Records the lighting subpass. Must be inside the deferred pass, after moving on to `kLightingSubpass`.
+         */
+        void render(const VyFrameInfo& frameInfo) override;
+
+        /**
+         * @brief Recreates the G-buffer and the framebuffers. The post-process system must have been recreated first.
+         */
+        void recreate(VkExtent2D newExtent, const VyPostProcessSystem& postProcessSystem);
+
+        VkRenderPass  renderPass()                const { return m_RenderPass; }
+        VkFramebuffer framebuffer(int frameIndex) const { return m_Framebuffers[frameIndex]; }
+
+        /**
+         * @brief Clear values of the pass' attachments (HDR color, depth, G-buffer 0 and 1).
+         */
+        VY_NODISCARD TArray<VkClearValue, 4> clearValues() const;
+
+    private:
+        struct LightingPushConstants
+        {
+            Mat4 InverseProjection;
+            Vec4 ScreenSize; // xy = size in pixels, zw = 1 / size
+        };
+
+        void createGBuffer();
+        void createRenderPass();
+        void createFramebuffers(const VyPostProcessSystem& postProcessSystem);
+        void writeDescriptorSets(const VyPostProcessSystem& postProcessSystem);
+        void createPipeline(VkDescriptorSetLayout globalSetLayout);
+
+        void destroyFramebuffers();
+
+        VkExtent2D                 m_Extent;
+
+        VkRenderPass               m_RenderPass{ VK_NULL_HANDLE };
+        TVector<VkFramebuffer>     m_Framebuffers;
+
+        // One G-buffer per frame in flight, like the HDR targets they are rendered with.
+        TVector<VyImage>           m_AlbedoImages;
+        TVector<VyImageView>       m_AlbedoImageViews;
+        TVector<VyImage>           m_NormalImages;
+        TVector<VyImageView>       m_NormalImageViews;
+
+        Unique<VyDescriptorSetLayout>                 m_GBufferSetLayout;
+        TArray<VkDescriptorSet, MAX_FRAMES_IN_FLIGHT> m_GBufferSets{};
+
+        Unique<VyPipeline>         m_LightingPipeline;
+    };
+}
@@ -0,0 +1,755 @@
+#include <Vy/Systems/Rendering/GPUDrivenRenderSystem.h>
+
+#include <Vy/Systems/Rendering/RenderSystem.h>
+
+#include <Vy/GFX/Context.h>
+#include <Vy/Globals.h>
+
+#include <algorithm>
+#include <numeric>
+
+namespace Vy
+{
+    static_assert(sizeof(VkDrawIndexedIndirectCommand) == 20, "InstanceCull.comp writes 20 byte draw commands");
+
+    // =====================================================================================================================
+
+    VyGPUDrivenRenderSystem::VyGPUDrivenRenderSystem(
+        VkRenderPass                   renderPass,
+        TVector<VkDescriptorSetLayout> descSetLayouts,
+        VkExtent2D                     extent) :
+        m_Extent{ extent }
+    {
+        VY_ASSERT(VyContext::device().supportsDrawIndirectCount(),
+            "GPU-driven rendering requires drawIndirectCount, multiDrawIndirect and drawIndirectFirstInstance");
+
+        createDescriptorSetLayouts();
+
+        m_HZB = MakeUnique<VyHZBFramebuffer>(m_Extent, MAX_FRAMES_IN_FLIGHT);
+
+        for (int i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
+        {
+            updateFrameResources(i);
+        }
+
+        descSetLayouts.push_back(m_InstanceSetLayout->handle());
+
+        createPipelines(renderPass, descSetLayouts);
+    }
+
+
+    VyGPUDrivenRenderSystem::~VyGPUDrivenRenderSystem()
+    {
+        TVector<VkDescriptorSet> sets;
+
+        for (auto& frame : m_Frames)
+        {
+            sets.push_back(frame.CullSet);
+            sets.push_back(frame.LateCullSet);
+            sets.push_back(frame.InstanceSet);
+
+            sets.insert(sets.end(), frame.HZBSets.begin(), frame.HZBSets.end());
+        }
+
+        std::erase(sets, VK_NULL_HANDLE);
+
+        VyContext::releaseSets(sets);
+    }
+
+
+    void VyGPUDrivenRenderSystem::recreate(VkExtent2D newExtent)
+    {
+        m_Extent = newExtent;
+
+        m_HZB->resize(m_Extent);
+
+        // The HZB mip views changed, force the reduction sets to be rewritten.
+        for (auto& frame : m_Frames)
+        {
+            frame.HZBSource        = VK_NULL_HANDLE;
+            frame.bVisibilityValid = false;
+        }
+    }
+
+    // =====================================================================================================================
+
+    void VyGPUDrivenRenderSystem::createDescriptorSetLayouts()
+    {
+        // Instance set layout ( 2 ), same as VyRenderSystem.
+        m_InstanceSetLayout = VyDescriptorSetLayout::Builder{}
+            .addBinding(0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT) // Instance Data
+        .buildUnique();
+
+        // Cull set layout ( compute 0 ).
+        m_CullSetLayout = VyDescriptorSetLayout::Builder{}
+            .addBinding(0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,         VK_SHADER_STAGE_COMPUTE_BIT) // Instance Data
+            .addBinding(1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,         VK_SHADER_STAGE_COMPUTE_BIT) // Cull Instances
+            .addBinding(2, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,         VK_SHADER_STAGE_COMPUTE_BIT) // Draw Groups
+            .addBinding(3, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,         VK_SHADER_STAGE_COMPUTE_BIT) // Draw Commands
+            .addBinding(4, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,         VK_SHADER_STAGE_COMPUTE_BIT) // Draw Counts
+            .addBinding(5, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,         VK_SHADER_STAGE_COMPUTE_BIT) // Previous Visibility
+            .addBinding(6, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,         VK_SHADER_STAGE_COMPUTE_BIT) // Visibility
+            .addBinding(7, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_COMPUTE_BIT) // HZB
+        .buildUnique();
+
+        // HZB reduction set layout ( compute 0 ).
+        m_HZBSetLayout = VyDescriptorSetLayout::Builder{}
+            .addBinding(0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_COMPUTE_BIT) // Input Depth
+            .addBinding(1, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,          VK_SHADER_STAGE_COMPUTE_BIT) // Output Depth
+        .buildUnique();
+    }
+
+
+    void VyGPUDrivenRenderSystem::createPipelines(VkRenderPass renderPass, TVector<VkDescriptorSetLayout> descSetLayouts)
+    {
+        // Same shaders as the CPU path, the instance index comes from the command's firstInstance.
+        m_Pipeline = VyPipeline::GraphicsBuilder{}
+            .addDescriptorSetLayouts(descSetLayouts)
+            .addShaderStage         (VK_SHADER_STAGE_VERTEX_BIT,   "Material.vert.spv")
+            .addShaderStage         (VK_SHADER_STAGE_FRAGMENT_BIT, "Material.frag.spv")
+            .addColorAttachment     (VK_FORMAT_R16G16B16A16_SFLOAT)
+            .setDepthAttachment     (VK_FORMAT_D32_SFLOAT)
+            .setRenderPass          (renderPass)
+        .buildUnique();
+
+        m_CullPipeline = VyPipeline::ComputeBuilder{}
+            .addDescriptorSetLayout(m_CullSetLayout->handle())
+            .addPushConstantRange  (VK_SHADER_STAGE_COMPUTE_BIT, sizeof(CullPushConstants))
+            .setShaderStage        ("Culling/InstanceCull.comp.spv")
+        .buildUnique();
+
+        m_HZBPipeline = VyPipeline::ComputeBuilder{}
+            .addDescriptorSetLayout(m_HZBSetLayout->handle())
+            .setShaderStage        ("HIZGenerate.comp.spv")
+        .buildUnique();
+    }
+
+    // =====================================================================================================================
+
+    void VyGPUDrivenRenderSystem::updateScene(const VyFrameInfo& frameInfo)
+    {
+        m_Renderables    .clear();
+        m_InstanceScratch.clear();
+
+        for (const VyRenderProxy& proxy : frameInfo.Packet.Objects)
+        {
+            MaterialInstanceData instance{};
+
+            VyRenderSystem::fillInstanceData(frameInfo, proxy, instance);
+
+            m_Renderables    .push_back(Renderable{ proxy.Mesh.get() });
+            m_InstanceScratch.push_back(instance);
+        }
+
+        // Only regroup when an entity was added / removed or changed its mesh, material changes only touch the instance data.
+        // Defragmenting the geometry arenas moves the meshes, the groups hold their offsets.
+        const U32 geometryGeneration = VyContext::geometry().generation();
+
+        if (m_Renderables != m_PreviousRenderables || geometryGeneration != m_GeometryGeneration)
+        {
+            rebuildGroups();
+
+            m_PreviousRenderables = m_Renderables;
+            m_GeometryGeneration  = geometryGeneration;
+            m_SceneVersion++;
+        }
+    }
+
+
+    void VyGPUDrivenRenderSystem::rebuildGroups()
+    {
+        const U32 count = static_cast<U32>(m_Renderables.size());
+
+        m_GPUGroups    .clear();
+        m_CullInstances.resize(count);
+        m_DrawLists    .fill(DrawList{});
+
+        // The materials are bindless (looked up per instance), so groups only need to share the mesh.
+        TVector<U32> order(count);
+        std::iota(order.begin(), order.end(), 0u);
+
+        std::stable_sort(order.begin(), order.end(), [this](U32 a, U32 b)
+        {
+            return m_Renderables[a].Mesh < m_Renderables[b].Mesh;
+        });
+
+        const VyStaticMesh* groupMesh = nullptr;
+
+        for (U32 i = 0; i < count; i++)
+        {
+            const U32         index      = order[i];
+            const Renderable& renderable = m_Renderables[index];
+
+            const bool indexed = renderable.Mesh->hasIndices();
+
+            // Groups only describe the mesh, the commands of every group go into the draw list matching its indexing.
+            if (m_GPUGroups.empty() || groupMesh != renderable.Mesh)
+            {
+                const VyGeometryRange range = renderable.Mesh->geometryRange();
+
+                m_GPUGroups.push_back(GPUDrawGroup{
+                    .Count        = indexed ? range.IndexCount : range.VertexCount,
+                    .Indexed      = indexed ? 1u : 0u,
+                    .First        = indexed ? range.FirstIndex : range.FirstVertex,
+                    .VertexOffset = static_cast<I32>(range.FirstVertex)
+                });
+
+                groupMesh = renderable.Mesh;
+            }
+
+            m_DrawLists[ indexed ? DrawList_Indexed : DrawList_NonIndexed ].CommandCount++;
+
+            const VyBoundingSphere& sphere = renderable.Mesh->boundingSphere();
+            const VyAABB&           bounds = renderable.Mesh->bounds();
+
+            m_CullInstances[index] = GPUCullInstance{
+                .Sphere     = Vec4(sphere.Center, sphere.Radius),
+                .BoxCenter  = Vec4(bounds.center(),  0.0f),
+                .BoxExtents = Vec4(bounds.extents(), 0.0f),
+                .Group      = static_cast<U32>(m_GPUGroups.size() - 1)
+            };
+        }
+
+        // The non-indexed commands follow the indexed ones in the command buffer.
+        m_DrawLists[ DrawList_NonIndexed ].FirstCommand = m_DrawLists[ DrawList_Indexed ].CommandCount;
+
+        for (GPUDrawGroup& group : m_GPUGroups)
+        {
+            group.FirstCommand = m_DrawLists[ group.Indexed != 0 ? DrawList_Indexed : DrawList_NonIndexed ].FirstCommand;
+        }
+
+        VY_DEBUG_TAG("VyGPUDrivenRenderSystem", "Scene rebuilt: {} instances of {} meshes in {} draw lists",
+            count, m_GPUGroups.size(), drawCallCount());
+    }
+
+
+    U32 VyGPUDrivenRenderSystem::drawCallCount() const
+    {
+        U32 drawCalls = 0;
+
+        for (const DrawList& list : m_DrawLists)
+        {
+            drawCalls += (list.CommandCount > 0) ? 1 : 0;
+        }
+
+        return drawCalls;
+    }
+
+    // =====================================================================================================================
+
+    void VyGPUDrivenRenderSystem::updateFrameResources(int frameIndex)
+    {
+        FrameResources& frame = m_Frames[ frameIndex ];
+
+        const U32 instanceCount = std::max(static_cast<U32>(m_Renderables.size()), 1u);
+        const U32 groupCount    = std::max(static_cast<U32>(m_GPUGroups  .size()), 1u);
+
+        bool bResized = false;
+
+        // The previous submission using this frame's buffers has completed (the frame fence was waited on),
+        // so they can be replaced directly.
+        if (!frame.InstanceBuffer || instanceCount > frame.InstanceCapacity)
+        {
+            U32 capacity = std::max(frame.InstanceCapacity, kInitialInstanceCapacity);
+
+            while (capacity < instanceCount)
+            {
+                capacity *= 2;
+            }
+
+            frame.InstanceBuffer     = MakeUnique<VyBuffer>( VyBuffer::storageBuffer(sizeof(MaterialInstanceData) * capacity) );
+            frame.CullInstanceBuffer = MakeUnique<VyBuffer>( VyBuffer::storageBuffer(sizeof(GPUCullInstance)      * capacity) );
+            frame.CommandBuffer      = MakeUnique<VyBuffer>( VyBuffer::indirectBuffer(sizeof(VkDrawIndexedIndirectCommand) * capacity), false );
+            frame.LateCommandBuffer  = MakeUnique<VyBuffer>( VyBuffer::indirectBuffer(sizeof(VkDrawIndexedIndirectCommand) * capacity), false );
+            frame.VisibilityBuffer   = MakeUnique<VyBuffer>( VyBuffer::indirectBuffer(sizeof(U32) * capacity), false ); // Device local, GPU only.
+            frame.InstanceCapacity   = capacity;
+            frame.bVisibilityValid   = false;
+
+            bResized = true;
+        }
+
+        if (!frame.GroupBuffer || groupCount > frame.GroupCapacity)
+        {
+            U32 capacity = std::max(frame.GroupCapacity, kInitialGroupCapacity);
+
+            while (capacity < groupCount)
+            {
+                capacity *= 2;
+            }
+
+            frame.GroupBuffer     = MakeUnique<VyBuffer>( VyBuffer::storageBuffer(sizeof(GPUDrawGroup) * capacity) );
+            frame.GroupCapacity   = capacity;
+
+            bResized = true;
+        }
+
+        // One count per draw list, independent of the scene.
+        if (!frame.CountBuffer)
+        {
+            frame.CountBuffer     = MakeUnique<VyBuffer>( VyBuffer::indirectBuffer(sizeof(U32) * DrawList_Count), false );
+            frame.LateCountBuffer = MakeUnique<VyBuffer>( VyBuffer::indirectBuffer(sizeof(U32) * DrawList_Count), false );
+            frame.ReadbackBuffer  = MakeUnique<VyBuffer>( VyBuffer::readbackBuffer(sizeof(U32) * DrawList_Count * 2) ); // Early and late counts.
+            frame.ReadbackCounts  = 0;
+        }
+
+        if (bResized)
+        {
+            writeInstanceSet(frame);
+        }
+
+        // Upload the scene layout (bounds, groups) once per change into each frame's buffers.
+        if (bResized || frame.SceneVersion != m_SceneVersion)
+        {
+            if (!m_CullInstances.empty())
+            {
+                frame.CullInstanceBuffer->write(m_CullInstances.data(), sizeof(GPUCullInstance) * m_CullInstances.size(), 0);
+            }
+
+            if (!m_GPUGroups.empty())
+            {
+                frame.GroupBuffer->write(m_GPUGroups.data(), sizeof(GPUDrawGroup) * m_GPUGroups.size(), 0);
+            }
+
+            frame.SceneVersion = m_SceneVersion;
+        }
+    }
+
+
+    void VyGPUDrivenRenderSystem::writeInstanceSet(FrameResources& frame)
+    {
+        auto instanceInfo = frame.InstanceBuffer->descriptorBufferInfo();
+
+        VyDescriptorWriter instanceWriter{ *m_InstanceSetLayout, *VyContext::globalPool() };
+        {
+            instanceWriter.writeBuffer(0, &instanceInfo);
+        }
+
+        if (frame.InstanceSet == VK_NULL_HANDLE)
+        {
+            instanceWriter.build(frame.InstanceSet);
+        }
+        else
+        {
+            instanceWriter.update(frame.InstanceSet);
+        }
+    }
+
+
+    void VyGPUDrivenRenderSystem::writeCullSets(int frameIndex)
+    {
+        FrameResources& frame    = m_Frames[ frameIndex ];
+        FrameResources& previous = m_Frames[ (frameIndex + MAX_FRAMES_IN_FLIGHT - 1) % MAX_FRAMES_IN_FLIGHT ];
+
+        auto instanceInfo           = frame.InstanceBuffer     ->descriptorBufferInfo();
+        auto cullInstanceInfo       = frame.CullInstanceBuffer ->descriptorBufferInfo();
+        auto groupInfo              = frame.GroupBuffer        ->descriptorBufferInfo();
+        auto commandInfo            = frame.CommandBuffer      ->descriptorBufferInfo();
+        auto countInfo              = frame.CountBuffer        ->descriptorBufferInfo();
+        auto lateCommandInfo        = frame.LateCommandBuffer  ->descriptorBufferInfo();
+        auto lateCountInfo          = frame.LateCountBuffer    ->descriptorBufferInfo();
+        auto previousVisibilityInfo = previous.VisibilityBuffer->descriptorBufferInfo();
+        auto visibilityInfo         = frame.VisibilityBuffer   ->descriptorBufferInfo();
+        auto hzbInfo                = m_HZB->descriptorImageInfo(frameIndex);
+
+        // Both phases share everything but the command and count buffers.
+        auto writeCullSet = [&](VkDescriptorSet& set, VkDescriptorBufferInfo* pCommandInfo, VkDescriptorBufferInfo* pCountInfo)
+        {
+            VyDescriptorWriter writer{ *m_CullSetLayout, *VyContext::globalPool() };
+            {
+                writer
+                    .writeBuffer(0, &instanceInfo)
+                    .writeBuffer(1, &cullInstanceInfo)
+                    .writeBuffer(2, &groupInfo)
+                    .writeBuffer(3, pCommandInfo)
+                    .writeBuffer(4, pCountInfo)
+                    .writeBuffer(5, &previousVisibilityInfo)
+                    .writeBuffer(6, &visibilityInfo)
+                    .writeImage (7, &hzbInfo);
+            }
+
+            if (set == VK_NULL_HANDLE)
+            {
+                writer.build(set);
+            }
+            else
+            {
+                writer.update(set);
+            }
+        };
+
+        writeCullSet(frame.CullSet,     &commandInfo,     &countInfo);
+        writeCullSet(frame.LateCullSet, &lateCommandInfo, &lateCountInfo);
+    }
+
+
+    void VyGPUDrivenRenderSystem::writeHZBSets(int frameIndex, VkImageView depthImageView)
+    {
+        FrameResources& frame = m_Frames[ frameIndex ];
+
+        const U32 mipLevels = m_HZB->mipLevels();
+
+        if (frame.HZBSource == depthImageView && frame.HZBSets.size() == mipLevels)
+        {
+            return;
+        }
+
+        if (!frame.HZBSets.empty())
+        {
+            VyContext::releaseSets(frame.HZBSets);
+        }
+
+        frame.HZBSets.assign(mipLevels, VK_NULL_HANDLE);
+
+        for (U32 mip = 0; mip < mipLevels; mip++)
+        {
+            // Mip 0 reduces the scene depth, every other mip the previous level.
+            VkDescriptorImageInfo inputInfo = (mip == 0)
+                ? VkDescriptorImageInfo{ m_HZB->sampler(), depthImageView, VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL }
+                : m_HZB->mipDescriptorImageInfo(frameIndex, mip - 1);
+
+            VkDescriptorImageInfo outputInfo = m_HZB->mipDescriptorImageInfo(frameIndex, mip);
+
+            VyDescriptorWriter{ *m_HZBSetLayout, *VyContext::globalPool() }
+                .writeImage(0, &inputInfo)
+                .writeImage(1, &outputInfo)
+            .build(frame.HZBSets[ mip ]);
+        }
+
+        frame.HZBSource = depthImageView;
+    }
+
+
+    void VyGPUDrivenRenderSystem::readCullStats(int frameIndex)
+    {
+        FrameResources& frame = m_Frames[ frameIndex ];
+
+        if (frame.ReadbackCounts == 0)
+        {
+            return;
+        }
+
+        frame.ReadbackBuffer->invalidate();
+
+        const U32* counts = static_cast<const U32*>(frame.ReadbackBuffer->mappedData());
+
+        U32 visible = 0;
+
+        for (U32 i = 0; i < frame.ReadbackCounts; i++)
+        {
+            visible += counts[i];
+        }
+
+        m_CullStats.Visible = visible;
+        m_CullStats.Culled  = frame.ReadbackTotal - visible;
+    }
+
+
+    bool VyGPUDrivenRenderSystem::hasVisibilityHistory(int frameIndex) const
+    {
+        const FrameResources& previous = m_Frames[ (frameIndex + MAX_FRAMES_IN_FLIGHT - 1) % MAX_FRAMES_IN_FLIGHT ];
+
+        return previous.bVisibilityValid && previous.VisibilityVersion == m_SceneVersion;
+    }
+
+    // =====================================================================================================================
+
+    void VyGPUDrivenRenderSystem::dispatchCull(
+        VkCommandBuffer    cmdBuffer,
+        const VyFrameInfo& frameInfo,
+        VkDescriptorSet    cullSet,
+        ECullPhase         phase,
+        bool               bHistoryValid)
+    {
+        const U32 instanceCount = static_cast<U32>(m_Renderables.size());
+
+        m_CullPipeline->bind(cmdBuffer);
+        m_CullPipeline->bindDescriptorSet(cmdBuffer, 0, cullSet);
+
+        CullPushConstants push{};
+        {
+            const VyFrustum& frustum = frameInfo.Camera.frustum();
+
+            push.ViewProjection = frameInfo.Camera.projection() * frameInfo.Camera.view();
+
+            for (int i = 0; i < 6; i++)
+            {
+                push.FrustumPlanes[i] = frustum.Planes[i];
+            }
+
+            push.DepthWidth    = m_Extent.width;
+            push.DepthHeight   = m_Extent.height;
+            push.InstanceCount = instanceCount;
+            push.Phase         = phase;
+            push.HistoryValid  = bHistoryValid ? 1u : 0u;
+        }
+
+        m_CullPipeline->pushConstants(cmdBuffer, VK_SHADER_STAGE_COMPUTE_BIT, push);
+
+        vkCmdDispatch(cmdBuffer, (instanceCount + kCullGroupSize - 1) / kCullGroupSize, 1, 1);
+    }
+
+
+    void VyGPUDrivenRenderSystem::buildHZB(VkCommandBuffer cmdBuffer, int frameIndex, VkImage depthImage)
+    {
+        const FrameResources& frame = m_Frames[ frameIndex ];
+
+        // Early phase depth -> sampled.
+        VkImageMemoryBarrier depthBarrier{ VKInit::imageMemoryBarrier() };
+        {
+            depthBarrier.image               = depthImage;
+            depthBarrier.oldLayout           = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+            depthBarrier.newLayout           = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
+            depthBarrier.srcAccessMask       = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+            depthBarrier.dstAccessMask       = VK_ACCESS_SHADER_READ_BIT;
+            depthBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            depthBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            depthBarrier.subresourceRange    = { VKUtil::aspectFlags(VyContext::device().findDepthFormat()), 0, 1, 0, 1 };
+        }
+
+        // The last late phase of this frame slot is done reading the pyramid.
+        VkImageMemoryBarrier hzbBarrier{ VKInit::imageMemoryBarrier() };
+        {
+            hzbBarrier.image               = m_HZB->image(frameIndex);
+            hzbBarrier.oldLayout           = VK_IMAGE_LAYOUT_GENERAL;
+            hzbBarrier.newLayout           = VK_IMAGE_LAYOUT_GENERAL;
+            hzbBarrier.srcAccessMask       = VK_ACCESS_SHADER_READ_BIT;
+            hzbBarrier.dstAccessMask       = VK_ACCESS_SHADER_WRITE_BIT;
+            hzbBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            hzbBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            hzbBarrier.subresourceRange    = { VK_IMAGE_ASPECT_COLOR_BIT, 0, m_HZB->mipLevels(), 0, 1 };
+        }
+
+        VKCmd::pipelineBarrier(cmdBuffer,
+            VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            { depthBarrier, hzbBarrier }
+        );
+
+        m_HZBPipeline->bind(cmdBuffer);
+
+        VkExtent2D mipExtent = m_HZB->extent();
+
+        for (U32 mip = 0; mip < m_HZB->mipLevels(); mip++)
+        {
+            m_HZBPipeline->bindDescriptorSet(cmdBuffer, 0, frame.HZBSets[ mip ]);
+
+            VKCmd::dispatch(cmdBuffer, mipExtent, VkExtent2D{ kHZBGroupSize, kHZBGroupSize });
+
+            // The next level (and the late cull) reads this one.
+            VKCmd::memoryBarrier(cmdBuffer,
+                VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT,
+                VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT
+            );
+
+            mipExtent.width  = std::max(mipExtent.width  / 2, 1u);
+            mipExtent.height = std::max(mipExtent.height / 2, 1u);
+        }
+    }
+
+    // =====================================================================================================================
+
+    void VyGPUDrivenRenderSystem::prepare(const VyFrameInfo& frameInfo)
+    {
+        const int frameIndex = frameInfo.FrameIndex;
+
+        // The frame's fence was waited on in `beginFrame`, the counts of its last submission are available.
+        readCullStats(frameIndex);
+
+        updateScene(frameInfo);
+        updateFrameResources(frameIndex);
+
+        FrameResources& frame = m_Frames[ frameIndex ];
+
+        const U32 instanceCount = static_cast<U32>(m_Renderables.size());
+
+        frame.ReadbackCounts   = 0;
+        frame.bVisibilityValid = false;
+
+        if (instanceCount == 0)
+        {
+            m_CullStats.reset();
+
+            return;
+        }
+
+        // [ Upload Instances ]
+        frame.InstanceBuffer->write(m_InstanceScratch.data(), sizeof(MaterialInstanceData) * instanceCount, 0);
+
+        writeCullSets(frameIndex);
+
+        VkCommandBuffer cmdBuffer = frameInfo.CommandBuffer;
+
+        VKCmd::beginDebugUtilsLabel(cmdBuffer, "GPU Culling");
+
+        // [ Reset Counts ]
+        vkCmdFillBuffer(cmdBuffer, frame.CountBuffer->handle(), 0, sizeof(U32) * DrawList_Count, 0);
+
+        if (m_OcclusionCulling)
+        {
+            vkCmdFillBuffer(cmdBuffer, frame.LateCountBuffer->handle(), 0, sizeof(U32) * DrawList_Count, 0);
+        }
+
+        // Also orders the previous frame's visibility writes before the reads below.
+        VKCmd::memoryBarrier(cmdBuffer,
+            VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT | VK_ACCESS_SHADER_WRITE_BIT,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,                                  VK_ACCESS_SHADER_READ_BIT   | VK_ACCESS_SHADER_WRITE_BIT
+        );
+
+        // [ Cull ]
+        dispatchCull(cmdBuffer, frameInfo, frame.CullSet,
+            m_OcclusionCulling ? CullPhase_Early : CullPhase_Frustum,
+            hasVisibilityHistory(frameIndex)
+        );
+
+        // Commands and counts are consumed by the indirect draws and copied for the stats.
+        VKCmd::memoryBarrier(cmdBuffer,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT,
+            VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_TRANSFER_READ_BIT
+        );
+
+        // [ Readback Counts ]
+        VkBufferCopy region{};
+        {
+            region.srcOffset = 0;
+            region.dstOffset = 0;
+            region.size      = sizeof(U32) * DrawList_Count;
+        }
+
+        vkCmdCopyBuffer(cmdBuffer, frame.CountBuffer->handle(), frame.ReadbackBuffer->handle(), 1, &region);
+
+        VKCmd::memoryBarrier(cmdBuffer,
+            VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT,
+            VK_PIPELINE_STAGE_HOST_BIT,     VK_ACCESS_HOST_READ_BIT
+        );
+
+        frame.ReadbackCounts = DrawList_Count;
+        frame.ReadbackTotal  = instanceCount;
+
+        VKCmd::endDebugUtilsLabel(cmdBuffer);
+    }
+
+
+    void VyGPUDrivenRenderSystem::prepareLatePass(const VyFrameInfo& frameInfo, VkImage depthImage, VkImageView depthImageView)
+    {
+        const int frameIndex = frameInfo.FrameIndex;
+
+        FrameResources& frame = m_Frames[ frameIndex ];
+
+        const U32 instanceCount = static_cast<U32>(m_Renderables.size());
+
+        VkCommandBuffer cmdBuffer = frameInfo.CommandBuffer;
+
+        VKCmd::beginDebugUtilsLabel(cmdBuffer, "HZB Occlusion Culling");
+
+        // [ Build HZB ]
+        // Always built, it also moves the depth into the layout the late HDR pass expects.
+        writeHZBSets(frameIndex, depthImageView);
+        buildHZB(cmdBuffer, frameIndex, depthImage);
+
+        if (instanceCount == 0)
+        {
+            VKCmd::endDebugUtilsLabel(cmdBuffer);
+
+            return;
+        }
+
+        // [ Late Cull ]
+        dispatchCull(cmdBuffer, frameInfo, frame.LateCullSet, CullPhase_Late, hasVisibilityHistory(frameIndex));
+
+        VKCmd::memoryBarrier(cmdBuffer,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT,
+            VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_TRANSFER_READ_BIT
+        );
+
+        // [ Readback Counts ]
+        // Placed after the early counts.
+        VkBufferCopy region{};
+        {
+            region.srcOffset = 0;
+            region.dstOffset = sizeof(U32) * DrawList_Count;
+            region.size      = sizeof(U32) * DrawList_Count;
+        }
+
+        vkCmdCopyBuffer(cmdBuffer, frame.LateCountBuffer->handle(), frame.ReadbackBuffer->handle(), 1, &region);
+
+        VKCmd::memoryBarrier(cmdBuffer,
+            VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT,
+            VK_PIPELINE_STAGE_HOST_BIT,     VK_ACCESS_HOST_READ_BIT
+        );
+
+        frame.ReadbackCounts    = DrawList_Count * 2;
+        frame.VisibilityVersion = m_SceneVersion;
+        frame.bVisibilityValid  = true;
+
+        VKCmd::endDebugUtilsLabel(cmdBuffer);
+    }
+
+    // =====================================================================================================================
+
+    void VyGPUDrivenRenderSystem::render(const VyFrameInfo& frameInfo)
+    {
+        const FrameResources& frame = m_Frames[ frameInfo.FrameIndex ];
+
+        drawLists(frameInfo.CommandBuffer, frameInfo, frame.CommandBuffer->handle(), frame.CountBuffer->handle());
+    }
+
+
+    void VyGPUDrivenRenderSystem::renderLatePass(const VyFrameInfo& frameInfo)
+    {
+        const FrameResources& frame = m_Frames[ frameInfo.FrameIndex ];
+
+        drawLists(frameInfo.CommandBuffer, frameInfo, frame.LateCommandBuffer->handle(), frame.LateCountBuffer->handle());
+    }
+
+
+    void VyGPUDrivenRenderSystem::drawLists(
+        VkCommandBuffer    cmdBuffer,
+        const VyFrameInfo& frameInfo,
+        VkBuffer           commandBuffer,
+        VkBuffer           countBuffer)
+    {
+        if (m_Renderables.empty())
+        {
+            return;
+        }
+
+        const FrameResources& frame = m_Frames[ frameInfo.FrameIndex ];
+
+        // Bind pipeline.
+        m_Pipeline->bind(cmdBuffer);
+
+        // Bind Global descriptor set ( 0 ).
+        m_Pipeline->bindDescriptorSet(cmdBuffer, 0, frameInfo.GlobalDescriptorSet);
+
+        // Bind bindless Material descriptor set ( 1 ).
+        m_Pipeline->bindDescriptorSet(cmdBuffer, 1, frameInfo.MaterialDescriptorSet);
+
+        // Bind Instance descriptor set ( 2 ).
+        m_Pipeline->bindDescriptorSet(cmdBuffer, 2, frame.InstanceSet);
+
+        // Every mesh lives in the geometry arenas, the commands carry the offsets into them.
+        VyContext::geometry().bind(cmdBuffer);
+
+        const DrawList& indexed    = m_DrawLists[ DrawList_Indexed    ];
+        const DrawList& nonIndexed = m_DrawLists[ DrawList_NonIndexed ];
+
+        if (indexed.CommandCount > 0)
+        {
+            vkCmdDrawIndexedIndirectCount(cmdBuffer,
+                commandBuffer, sizeof(VkDrawIndexedIndirectCommand) * indexed.FirstCommand,
+                countBuffer,   sizeof(U32) * DrawList_Indexed,
+                indexed.CommandCount, sizeof(VkDrawIndexedIndirectCommand)
+            );
+        }
+
+        // Non-indexed meshes need the other draw command layout, they get their own list and draw.
+        if (nonIndexed.CommandCount > 0)
+        {
+            vkCmdDrawIndirectCount(cmdBuffer,
+                commandBuffer, sizeof(VkDrawIndexedIndirectCommand) * nonIndexed.FirstCommand,
+                countBuffer,   sizeof(U32) * DrawList_NonIndexed,
+                nonIndexed.CommandCount, sizeof(VkDrawIndexedIndirectCommand)
+            );
+        }
+    }
+}
@@ -0,0 +1,282 @@
+#pragma once
+
+#include <Vy/Systems/Rendering/IRenderSystem.h>
+
+#include <Vy/GFX/Backend/Descriptors.h>
+#include <Vy/GFX/Backend/Device.h>
+#include <Vy/GFX/Backend/Resources/HZBFramebuffer.h>
+
+namespace Vy
+{
+    /**
+     * @brief GPU-driven alternative to VyRenderSystem.
+     *
+     * All renderable entities live in a per-frame scene buffer (the same instance data as the batched
+     * material pass). The grouping of the instances into draw groups (per mesh, materials are bindless) is only
+     * rebuilt when the set of renderables changes, otherwise only the instance data is rewritten in place.
+     *
+     * `prepare` dispatches a compute pass that frustum culls every instance and appends a
+     * `VkDrawIndexedIndirectCommand` per visible instance into one of two draw lists, one for indexed and one for
+     * non-indexed meshes, each with a single draw count. The commands carry their mesh's offsets into the geometry
+     * arenas, so `render` issues one `vkCmdDrawIndexedIndirectCount` for the whole indexed list (plus one
+     * `vkCmdDrawIndirectCount` if the scene has non-indexed meshes).
+     *
+     * With occlusion culling enabled the pass is split in two phases:
+     *  1. Early: `prepare` / `render` draw the instances that were visible last frame (and pass the frustum test).
+     *  2. Late:  `prepareLatePass` builds the HZB from the early depth and tests every instance's bounding box
+     *            against it, `renderLatePass` draws the visible instances that were not drawn in the early phase.
+     *            The late test also records the visibility used by the next frame's early phase.
+     *
+     * @note Requires `VyDevice::supportsDrawIndirectCount()`.
+     * @note Only the HDR pass consumes the culled commands. Shadow passes would need a cull against each light's
+     *       frustum (and their own command lists), which is out of scope for this path.
+     */
+    class VyGPUDrivenRenderSystem : public IRenderSystem
+    {
+    public:
+        VyGPUDrivenRenderSystem(
+            VkRenderPass                   renderPass,
+            TVector<VkDescriptorSetLayout> descSetLayouts,
+            VkExtent2D                     extent
+        );
+
+        VyGPUDrivenRenderSystem(const VyGPUDrivenRenderSystem&)            = delete;
+        VyGPUDrivenRenderSystem& operator=(const VyGPUDrivenRenderSystem&) = delete;
+
+        ~VyGPUDrivenRenderSystem() override;
+
+        /**
+         * @brief Updates the scene buffer and records the culling compute pass (the early phase with occlusion culling).
+         */
+        void prepare(const VyFrameInfo& frameInfo) override;
+
+        /**
+         * @brief Records the indirect draws of the visible instances. Must be inside the render pass.
+         */
+        void render(const VyFrameInfo& frameInfo) override;
+
+        /**
+         * @brief Builds the HZB from the early phase's depth and records the late culling pass.
+         * 
+         * Must be outside of the render pass, with the depth written by the early phase in 
+         * `VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL`. Leaves it in `VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL`.
+         */
+        void prepareLatePass(const VyFrameInfo& frameInfo, VkImage depthImage, VkImageView depthImageView);
+
+        /**
+         * @brief Records the indirect draws of the instances found visible by the late phase. Must be inside the render pass.
+         */
+        void renderLatePass(const VyFrameInfo& frameInfo);
+
+        /**
+         * @brief Recreates the HZB for a new render target size.
+         */
+        void recreate(VkExtent2D newExtent);
+
+        /**
+         * @brief Enables the two-phase HZB occlusion culling. When disabled `prepare` only frustum culls.
+         */
+        void setOcclusionCulling(bool bEnabled) { m_OcclusionCulling = bEnabled; }
+
+        VY_NODISCARD bool occlusionCulling() const { return m_OcclusionCulling; }
+
+        /**
+         * @brief Number of indirect draw calls recorded per pass, one per non-empty draw list.
+         */
+        VY_NODISCARD U32 drawCallCount() const;
+
+        /**
+         * @brief Visible / culled (frustum and occlusion) instance counts, read back from the GPU.
+         *
+         * @note The counts lag `MAX_FRAMES_IN_FLIGHT` frames behind, they are read once the frame's fence was waited on.
+         */
+        VY_NODISCARD const VyCullStats& cullStats() const { return m_CullStats; }
+
+    private:
+        /**
+         * @brief Matches `CullInstance` in InstanceCull.comp (std430).
+         */
+        struct GPUCullInstance
+        {
+            Vec4 Sphere    { 0.0f }; // xyz = local center, w = local radius
+            Vec4 BoxCenter { 0.0f }; // xyz = local AABB center
+            Vec4 BoxExtents{ 0.0f }; // xyz = local AABB half size
+            U32  Group     { 0 };
+            U32  _pad0     { 0 };
+            U32  _pad1     { 0 };
+            U32  _pad2     { 0 };
+        };
+
+        /**
+         * @brief Matches `DrawGroup` in InstanceCull.comp (std430).
+         */
+        struct GPUDrawGroup
+        {
+            U32 Count       { 0 }; // Index count (indexed) or vertex count.
+            U32 FirstCommand{ 0 }; // First command of the group's draw list.
+            U32 Indexed     { 0 };
+            U32 First       { 0 }; // First index (indexed) or first vertex in the geometry arenas.
+            I32 VertexOffset{ 0 }; // Added to the indices, indexed only.
+            U32 _pad0       { 0 };
+            U32 _pad1       { 0 };
+            U32 _pad2       { 0 };
+        };
+
+        /**
+         * @brief Matches `Push` in InstanceCull.comp.
+         */
+        struct CullPushConstants
+        {
+            Mat4 ViewProjection;
+            Vec4 FrustumPlanes[6];
+            U32  DepthWidth;
+            U32  DepthHeight;
+            U32  InstanceCount;
+            U32  Phase;
+            U32  HistoryValid; // The previous frame's visibility matches the current instances.
+        };
+
+        /**
+         * @brief Matches the `PHASE_*` defines in InstanceCull.comp.
+         */
+        enum ECullPhase : U32
+        {
+            CullPhase_Frustum = 0, // Frustum only, no occlusion culling.
+            CullPhase_Early   = 1, // Frustum and visible last frame.
+            CullPhase_Late    = 2, // Frustum and HZB, not drawn in the early phase.
+        };
+
+        /**
+         * @brief Matches the `DRAW_LIST_*` defines in InstanceCull.comp, also the index of the list's draw count.
+         */
+        enum EDrawList : U32
+        {
+            DrawList_Indexed    = 0,
+            DrawList_NonIndexed = 1,
+            DrawList_Count      = 2,
+        };
+
+        /**
+         * @brief A range of draw commands drawn with one indirect count draw.
+         */
+        struct DrawList
+        {
+            U32 FirstCommand{ 0 };
+            U32 CommandCount{ 0 }; // Maximum number of commands, i.e. instances drawn through the list.
+        };
+
+        struct Renderable
+        {
+            VyStaticMesh* Mesh;
+
+            bool operator==(const Renderable&) const = default;
+        };
+
+        struct FrameResources
+        {
+            Unique<VyBuffer> InstanceBuffer;     // MaterialInstanceData[], host written every frame.
+            Unique<VyBuffer> CullInstanceBuffer; // GPUCullInstance[],      host written on scene changes.
+            Unique<VyBuffer> GroupBuffer;        // GPUDrawGroup[],         host written on scene changes.
+            Unique<VyBuffer> CommandBuffer;      // VkDrawIndexedIndirectCommand[], written by the (early) cull pass.
+            Unique<VyBuffer> CountBuffer;        // U32[] per draw list,    written by the (early) cull pass.
+            Unique<VyBuffer> LateCommandBuffer;  // VkDrawIndexedIndirectCommand[], written by the late cull pass.
+            Unique<VyBuffer> LateCountBuffer;    // U32[] per draw list,    written by the late cull pass.
+            Unique<VyBuffer> VisibilityBuffer;   // U32[] per instance,     written by the late cull pass, read by the next frame.
+            Unique<VyBuffer> ReadbackBuffer;     // Copy of the early and late counts for the cull stats.
+
+            VkDescriptorSet  CullSet     { VK_NULL_HANDLE };
+            VkDescriptorSet  LateCullSet { VK_NULL_HANDLE };
+            VkDescriptorSet  InstanceSet { VK_NULL_HANDLE };
+
+            TVector<VkDescriptorSet> HZBSets;    // One per HZB mip.
+            VkImageView      HZBSource{ VK_NULL_HANDLE }; // Depth view the HZB sets were written with.
+
+            U32  InstanceCapacity { 0 };
+            U32  GroupCapacity    { 0 };
+            U32  SceneVersion     { 0 };     // Scene layout last written into this frame's buffers.
+            U32  VisibilityVersion{ 0 };     // Scene layout the visibility buffer was written for.
+            bool bVisibilityValid { false }; // The last submission of this frame ran the late phase.
+            U32  ReadbackCounts   { 0 };     // Number of counts copied into the readback buffer.
+            U32  ReadbackTotal    { 0 };     // Number of instances culled when the counts were copied.
+        };
+
+        void createDescriptorSetLayouts();
+        void createPipelines(VkRenderPass renderPass, TVector<VkDescriptorSetLayout> descSetLayouts);
+
+        /**
+         * @brief Gathers the renderables and the instance data. Rebuilds the mesh groups if the renderables changed.
+         */
+        void updateScene(const VyFrameInfo& frameInfo);
+
+        /**
+         * @brief Groups the renderables by mesh and sizes the draw lists.
+         */
+        void rebuildGroups();
+
+        /**
+         * @brief Makes sure the frame's buffers can hold the scene and writes the scene layout if it is outdated.
+         */
+        void updateFrameResources(int frameIndex);
+
+        /**
+         * @brief Reads the draw counts of the last submission of this frame slot.
+         */
+        void readCullStats(int frameIndex);
+
+        void writeInstanceSet(FrameResources& frame);
+
+        /**
+         * @brief Rewrites the cull sets, they reference the previous frame's visibility buffer.
+         */
+        void writeCullSets(int frameIndex);
+
+        /**
+         * @brief (Re)writes the HZB reduction sets if the depth view or the HZB changed.
+         */
+        void writeHZBSets(int frameIndex, VkImageView depthImageView);
+
+        /**
+         * @brief Whether the previous frame's late phase recorded visibility for the current instances.
+         */
+        VY_NODISCARD bool hasVisibilityHistory(int frameIndex) const;
+
+        void dispatchCull(VkCommandBuffer cmdBuffer, const VyFrameInfo& frameInfo, VkDescriptorSet cullSet, ECullPhase phase, bool bHistoryValid);
+
+        void drawLists(VkCommandBuffer cmdBuffer, const VyFrameInfo& frameInfo, VkBuffer commandBuffer, VkBuffer countBuffer);
+
+        void buildHZB(VkCommandBuffer cmdBuffer, int frameIndex, VkImage depthImage);
+
+        static constexpr U32 kInitialInstanceCapacity = 1024;
+        static constexpr U32 kInitialGroupCapacity    = 64;
+        static constexpr U32 kCullGroupSize           = 64;
+        static constexpr U32 kHZBGroupSize            = 32;
+
+        Unique<VyPipeline>            m_Pipeline;
+        Unique<VyPipeline>            m_CullPipeline;
+        Unique<VyPipeline>            m_HZBPipeline;
+
+        Unique<VyDescriptorSetLayout> m_InstanceSetLayout;
+        Unique<VyDescriptorSetLayout> m_CullSetLayout;
+        Unique<VyDescriptorSetLayout> m_HZBSetLayout;
+
+        Unique<VyHZBFramebuffer>      m_HZB;
+        VkExtent2D                    m_Extent;
+        bool                          m_OcclusionCulling{ true };
+
+        TArray<FrameResources, MAX_FRAMES_IN_FLIGHT> m_Frames;
+
+        // Scene layout, rebuilt when the renderables change.
+        TVector<Renderable>           m_Renderables;
+        TVector<Renderable>           m_PreviousRenderables;
+        TArray<DrawList, DrawList_Count> m_DrawLists;
+        TVector<GPUCullInstance>      m_CullInstances;
+        TVector<GPUDrawGroup>         m_GPUGroups;
+        U32                           m_SceneVersion{ 0 };
+        U32                           m_GeometryGeneration{ 0 }; // Geometry arena layout the groups were built for.
+
+        // Instance data gathered every frame.
+        TVector<MaterialInstanceData> m_InstanceScratch;
+
+        VyCullStats m_CullStats{};
+    };
+}
@@ -37,12 +37,29 @@ namespace Vy
 
     void VyGridSystem::render(const VyFrameInfo& frameInfo) 
     {
-        m_Pipeline->bind(frameInfo.CommandBuffer);
+        VyCommandContext context{ frameInfo.CommandBuffer };
+
+        recordPacket(context, frameInfo, 0);
+    }
+
+
+    void VyGridSystem::submit(const VyFrameInfo& frameInfo, VyRenderQueue& queue)
+    {
+        // The grid spans the whole ground plane, it is sorted as the farthest transparent draw.
+        constexpr U16 kFarthest = 0xFFFF;
+
+        queue.submit(*this, VyRenderKey::make(ERenderLayer::Transparent, queue.pipelineId(*m_Pipeline), 0, 0, kFarthest));
+    }
+
+
+    void VyGridSystem::recordPacket(VyCommandContext& context, const VyFrameInfo& frameInfo, U32 payload) const
+    {
+        context.bindPipeline(*m_Pipeline);
 
         // Set: 0 - Global Descriptor Set
-        m_Pipeline->bindDescriptorSet(frameInfo.CommandBuffer, 0, frameInfo.GlobalDescriptorSet);
+        context.bindDescriptorSet(*m_Pipeline, 0, frameInfo.GlobalDescriptorSet);
 
         // Draw grid (assuming full-screen quad).
-        vkCmdDraw(frameInfo.CommandBuffer, 6, 1, 0, 0);
+        vkCmdDraw(context.commandBuffer(), 6, 1, 0, 0);
     }
 }
\ No newline at end of file
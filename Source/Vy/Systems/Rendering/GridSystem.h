@@ -19,6 +19,13 @@ namespace Vy
 
         virtual void render(const VyFrameInfo& frameInfo) override;
 
+        /**
+         * @brief Submits the grid as the farthest transparent draw, blended over everything else.
+         */
+        virtual void submit(const VyFrameInfo& frameInfo, VyRenderQueue& queue) override;
+
+        virtual void recordPacket(VyCommandContext& context, const VyFrameInfo& frameInfo, U32 payload) const override;
+
     private:
 
         void createPipeline(VkRenderPass& renderPass, TVector<VkDescriptorSetLayout> descSetLayouts);
@@ -4,6 +4,7 @@
 #include <Vy/Scene/ECS/Components.h>
 #include <Vy/GFX/Backend/Pipeline.h>
 #include <Vy/GFX/Backend/Resources/Framebuffer.h>
+#include <Vy/Systems/Rendering/RenderQueue.h>
 
 namespace Vy
 {
@@ -13,12 +14,48 @@ namespace Vy
 		IRenderSystem()          = default;
 		virtual ~IRenderSystem() = default;
 
+		/**
+		 * @brief Records work that must happen outside of a render pass (compute, transfers) before `render`.
+		 */
+		virtual void prepare(const VyFrameInfo& frameInfo) {}
+
 		virtual void render(const VyFrameInfo& frameInfo) = 0;
 
 		virtual void update(VyFrameInfo& frameInfo, GlobalUBO& ubo) {}
+
+		/**
+		 * @brief Submits the draws of the system to a render queue instead of recording them in `render`.
+		 *
+		 * The queue records them later, in key order, through `recordPacket`.
+		 */
+		virtual void submit(const VyFrameInfo& frameInfo, VyRenderQueue& queue) {}
+
+		/**
+		 * @brief Records a packet submitted by `submit` through `context`.
+		 *
+		 * Binds everything the draw needs, the context skips what the previous packet already bound. Packets of one
+		 * frame may be recorded concurrently into different command buffers.
+		 */
+		virtual void recordPacket(VyCommandContext& context, const VyFrameInfo& frameInfo, U32 payload) const {}
 	};
 
 
+	/**
+	 * @brief Tests the bounds of a mesh, transformed by `modelMatrix`, against a frustum.
+	 *
+	 * The cheap sphere test rejects most objects, the box test refines the ones that pass it.
+	 */
+	inline bool isMeshVisible(const VyFrustum& frustum, const VyStaticMesh& mesh, const Mat4& modelMatrix)
+	{
+		if (!frustum.intersects(mesh.boundingSphere().transformed(modelMatrix)))
+		{
+			return false;
+		}
+
+		return frustum.intersects(mesh.bounds().transformed(modelMatrix));
+	}
+
+
 	template <typename T>
 	concept RenderSystemDerived = std::derived_from<T, IRenderSystem>;
 }
\ No newline at end of file
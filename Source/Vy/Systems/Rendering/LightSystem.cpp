@@ -40,229 +40,155 @@ namespace Vy
     }
 
 
-    void VyLightSystem::update(VyFrameInfo& frameInfo, GlobalUBO& ubo) 
+    void VyLightSystem::render(const VyFrameInfo& frameInfo) 
     {
-        ubo.NumPointLights       = 0;
-        ubo.NumDirectionalLights = 0;
-        ubo.NumSpotLights        = 0;
-
-        auto rotateLight = glm::rotate(Mat4(1.0f), frameInfo.FrameTime * m_RotationSpeed, Vec3(0.0f, -1.0f, 0.0f)); // Axis of rotation
-
-        auto& registry = frameInfo.Scene->registry();
-        
-        // ----------------------------------------------------------------------------------------
-        // [ Process Point Lights ]
-
-        auto pointView = registry.view<PointLightComponent, TransformComponent>();
+        VyCommandContext context{ frameInfo.CommandBuffer };
 
-        for (auto&& [ entity, pointLight, transform ] : pointView.each())
+        // Render point lights.
+        for (U32 i = 0; i < static_cast<U32>(frameInfo.Packet.PointLights.size()); i++)
         {
-            VY_ASSERT(ubo.NumPointLights < MAX_POINT_LIGHTS, "Exceeded maximum point light count!");
-
-            // Update light Position. (Temporary)
-            transform.Translation = Vec3(rotateLight * Vec4(transform.Translation, 1.0f));
-
-            // Copy light to UBO.
-            {
-                ubo.PointLights[ubo.NumPointLights].Position = Vec4(transform.Translation, 1.0f);
-                ubo.PointLights[ubo.NumPointLights].Color    = Vec4(pointLight.Color, pointLight.Intensity);
-            }
-
-            // Increment Point Lights
-            ubo.NumPointLights++;
+            recordPacket(context, frameInfo, packPayload(ELightKind::Point, i));
         }
-        
-        // ----------------------------------------------------------------------------------------
-        // [ Process Directional Lights ]
 
-        auto dirView = registry.view<DirectionalLightComponent, TransformComponent>();
-
-        for (auto&& [ entity, dirLight, transform ] : dirView.each())
+        // Render directional lights as arrows.
+        for (U32 i = 0; i < static_cast<U32>(frameInfo.Packet.DirectionalLights.size()); i++)
         {
-            VY_ASSERT(ubo.NumDirectionalLights < MAX_DIRECT_LIGHTS, "Exceeded maximum directional light count!");
-
-            // Update rotation to look at target if enabled.
-            if (dirLight.UseTargetPoint)
-            {
-                transform.lookAt(dirLight.TargetPoint);
-            }
-
-            Vec3 direction = transform.forward();
-
-            // Copy light to UBO.
-            {
-                ubo.DirectionalLights[ubo.NumDirectionalLights].Direction = Vec4(glm::normalize(direction), 0.0f);
-                ubo.DirectionalLights[ubo.NumDirectionalLights].Color     = Vec4(dirLight.Color, dirLight.Intensity);
-            }
-
-            // Increment Directional Lights
-            ubo.NumDirectionalLights++;
+            recordPacket(context, frameInfo, packPayload(ELightKind::Directional, i));
         }
 
-        // ----------------------------------------------------------------------------------------
-        // [ Process Spot Lights ]
-
-        auto spotView = registry.view<SpotLightComponent, TransformComponent>();
-
-        for (auto&& [ entity, spotLight, transform ] : spotView.each())
+        // Render spot lights as cones.
+        for (U32 i = 0; i < static_cast<U32>(frameInfo.Packet.SpotLights.size()); i++)
         {
-            VY_ASSERT(ubo.NumSpotLights < MAX_SPOT_LIGHTS, "Exceeded maximum spot light count!");
-
-            // Update rotation to look at target if enabled.
-            if (spotLight.UseTargetPoint)
-            {
-                transform.lookAt(spotLight.TargetPoint);
-            }
-
-            Vec3 direction = transform.forward();
-
-            // Copy light to UBO.
-            {
-                ubo.SpotLights[ubo.NumSpotLights].Position    = Vec4(transform.Translation, 1.0f);
-                ubo.SpotLights[ubo.NumSpotLights].Direction   = Vec4(glm::normalize(direction), glm::cos(glm::radians(spotLight.InnerCutoffAngle)));
-                ubo.SpotLights[ubo.NumSpotLights].Color       = Vec4(spotLight.Color, spotLight.Intensity);
-                ubo.SpotLights[ubo.NumSpotLights].OuterCutoff = glm::cos(glm::radians(spotLight.OuterCutoffAngle));
-                ubo.SpotLights[ubo.NumSpotLights].InnerCutoff = glm::cos(glm::radians(spotLight.InnerCutoffAngle));
-            }
-
-            // Increment Spot Lights
-            ubo.NumSpotLights++;
+            recordPacket(context, frameInfo, packPayload(ELightKind::Spot, i));
         }
     }
 
 
-    void VyLightSystem::updateTargetLockedLight(EntityHandle entity, VyScene* scene)
+    void VyLightSystem::submit(const VyFrameInfo& frameInfo, VyRenderQueue& queue)
     {
-        auto& registry = scene->registry();
+        const Mat4& view     = frameInfo.Camera.view();
+        const float farPlane = frameInfo.Camera.farPlane();
 
-        // Update directional light target tracking
-        if (registry.all_of<DirectionalLightComponent>(entity))
+        // The gizmos are blended, they are sorted back to front with the other transparent draws.
+        auto submitLights = [&](const auto& lights, const VyPipeline& pipeline, ELightKind kind)
         {
-            auto& dirLight = registry.get<DirectionalLightComponent>(entity);
+            const U16 pipelineId = queue.pipelineId(pipeline);
 
-            if (dirLight.UseTargetPoint)
+            for (U32 i = 0; i < static_cast<U32>(lights.size()); i++)
             {
-                registry.get<TransformComponent>(entity).lookAt(dirLight.TargetPoint);
-            }
-        }
+                const U16 depth = VyRenderKey::quantizeDepth(VyRenderKey::viewDepth(view, lights[i].Transform.Translation), farPlane);
 
-        // Update spot light target tracking
-        if (registry.all_of<SpotLightComponent>(entity))
-        {
-            auto& spotLight = registry.get<SpotLightComponent>(entity);
-
-            if (spotLight.UseTargetPoint)
-            {
-                registry.get<TransformComponent>(entity).lookAt(spotLight.TargetPoint);
+                queue.submit(*this, VyRenderKey::make(ERenderLayer::Transparent, pipelineId, 0, 0, depth), packPayload(kind, i));
             }
-        }
+        };
+
+        submitLights(frameInfo.Packet.PointLights,       *m_PointPipeline,       ELightKind::Point);
+        submitLights(frameInfo.Packet.DirectionalLights, *m_DirectionalPipeline, ELightKind::Directional);
+        submitLights(frameInfo.Packet.SpotLights,        *m_SpotPipeline,        ELightKind::Spot);
     }
 
 
-    void VyLightSystem::render(const VyFrameInfo& frameInfo) 
+    void VyLightSystem::recordPacket(VyCommandContext& context, const VyFrameInfo& frameInfo, U32 payload) const
     {
-        auto& registry = frameInfo.Scene->registry();
+        const ELightKind kind  = static_cast<ELightKind>(payload >> 24);
+        const U32        index = payload & 0x00FFFFFF;
 
-        // ----------------------------------------------------------------------------------------
+        const VyPipeline& pipeline = 
+            kind == ELightKind::Point       ? *m_PointPipeline       : 
+            kind == ELightKind::Directional ? *m_DirectionalPipeline : 
+                                              *m_SpotPipeline;
 
-        // Render point lights.
-        m_PointPipeline->bind(frameInfo.CommandBuffer);
+        context.bindPipeline(pipeline);
 
         // Set: 0 - Global Descriptor Set
-        m_PointPipeline->bindDescriptorSet(frameInfo.CommandBuffer, 0, frameInfo.GlobalDescriptorSet);
+        context.bindDescriptorSet(pipeline, 0, frameInfo.GlobalDescriptorSet);
 
-        auto pointView = registry.view<PointLightComponent, TransformComponent>();
-
-        for (auto&& [ entity, pointLight, transform ] : pointView.each())
+        switch (kind)
         {
-            PointLightPushConstantData push{};
-            {
-                push.Position = Vec4( transform.Translation, 1.0f );
-                push.Color    = Vec4( pointLight.Color, pointLight.Intensity );
-                push.Radius   = transform.Scale.x; 
-            }
-
-            m_PointPipeline->pushConstants(frameInfo.CommandBuffer, 
-                VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 
-                push
-            );
-            
-            // inefficient to draw a quad for each light, but okay for demo purposes.
-            vkCmdDraw(frameInfo.CommandBuffer, 6, 1, 0, 0);
+            case ELightKind::Point:       drawPointLight      (context, frameInfo.Packet.PointLights      [ index ]); break;
+            case ELightKind::Directional: drawDirectionalLight(context, frameInfo.Packet.DirectionalLights[ index ]); break;
+            case ELightKind::Spot:        drawSpotLight       (context, frameInfo.Packet.SpotLights       [ index ]); break;
         }
+    }
 
-        // ----------------------------------------------------------------------------------------
 
-        // Render directional lights as arrows.
-        m_DirectionalPipeline->bind(frameInfo.CommandBuffer);
+    void VyLightSystem::drawPointLight(VyCommandContext& context, const VyPointLightProxy& pointLight) const
+    {
+        const TransformComponent& transform = pointLight.Transform;
 
-        // Set: 0 - Global Descriptor Set
-        m_DirectionalPipeline->bindDescriptorSet(frameInfo.CommandBuffer, 0, frameInfo.GlobalDescriptorSet);
+        PointLightPushConstantData push{};
+        {
+            push.Position = Vec4( transform.Translation, 1.0f );
+            push.Color    = Vec4( pointLight.Light.Color, pointLight.Light.Intensity );
+            push.Radius   = transform.Scale.x; 
+        }
 
-        auto dirView = registry.view<DirectionalLightComponent, TransformComponent>();
+        context.pushConstants(*m_PointPipeline, 
+            VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 
+            push
+        );
+        
+        // inefficient to draw a quad for each light, but okay for demo purposes.
+        vkCmdDraw(context.commandBuffer(), 6, 1, 0, 0);
+    }
 
-        for (auto&& [ entity, dirLight, transform ] : dirView.each())
-        {
-            // Create a model matrix that orients the arrow in the light direction.
-            Mat4 modelMatrix = Mat4(1.0f);
-            modelMatrix      = glm::translate(modelMatrix, transform.Translation);
 
-            // Apply rotation to orient arrow
-            modelMatrix = glm::rotate(modelMatrix, transform.Rotation.y, Vec3(0.0f, 1.0f, 0.0f));
-            modelMatrix = glm::rotate(modelMatrix, transform.Rotation.x, Vec3(1.0f, 0.0f, 0.0f));
-            modelMatrix = glm::rotate(modelMatrix, transform.Rotation.z, Vec3(0.0f, 0.0f, 1.0f));
+    void VyLightSystem::drawDirectionalLight(VyCommandContext& context, const VyDirectionalLightProxy& dirLight) const
+    {
+        const TransformComponent& transform = dirLight.Transform;
 
-            DirectionalLightPushConstantData push{};
-            {
-                push.ModelMatrix = modelMatrix;
-                push.Color       = Vec4(dirLight.Color, dirLight.Intensity);
-            }
+        // Create a model matrix that orients the arrow in the light direction.
+        Mat4 modelMatrix = Mat4(1.0f);
+        modelMatrix      = glm::translate(modelMatrix, transform.Translation);
 
-            m_DirectionalPipeline->pushConstants(frameInfo.CommandBuffer, 
-                VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 
-                push
-            );
+        // Apply rotation to orient arrow
+        modelMatrix = glm::rotate(modelMatrix, transform.Rotation.y, Vec3(0.0f, 1.0f, 0.0f));
+        modelMatrix = glm::rotate(modelMatrix, transform.Rotation.x, Vec3(1.0f, 0.0f, 0.0f));
+        modelMatrix = glm::rotate(modelMatrix, transform.Rotation.z, Vec3(0.0f, 0.0f, 1.0f));
 
-            // 18 vertices for arrow.
-            vkCmdDraw(frameInfo.CommandBuffer, 18, 1, 0, 0);
+        DirectionalLightPushConstantData push{};
+        {
+            push.ModelMatrix = modelMatrix;
+            push.Color       = Vec4(dirLight.Light.Color, dirLight.Light.Intensity);
         }
 
-        // ----------------------------------------------------------------------------------------
+        context.pushConstants(*m_DirectionalPipeline, 
+            VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 
+            push
+        );
 
-        // Render spot lights as cones.
-        m_SpotPipeline->bind(frameInfo.CommandBuffer);
+        // 18 vertices for arrow.
+        vkCmdDraw(context.commandBuffer(), 18, 1, 0, 0);
+    }
 
-        // Set: 0 - Global Descriptor Set
-        m_SpotPipeline->bindDescriptorSet(frameInfo.CommandBuffer, 0, frameInfo.GlobalDescriptorSet);
 
-        auto spotView = registry.view<SpotLightComponent, TransformComponent>();
+    void VyLightSystem::drawSpotLight(VyCommandContext& context, const VySpotLightProxy& spotLight) const
+    {
+        const TransformComponent& transform = spotLight.Transform;
 
-        for (auto&& [ entity, spotLight, transform ] : spotView.each())
-        {
-            // Create a model matrix that positions and orients the cone.
-            Mat4 modelMatrix = Mat4(1.0f);
-            modelMatrix      = glm::translate(modelMatrix, transform.Translation);
+        // Create a model matrix that positions and orients the cone.
+        Mat4 modelMatrix = Mat4(1.0f);
+        modelMatrix      = glm::translate(modelMatrix, transform.Translation);
 
-            // Apply rotation to orient cone.
-            modelMatrix = glm::rotate(modelMatrix, transform.Rotation.y, Vec3(0.0f, 1.0f, 0.0f));
-            modelMatrix = glm::rotate(modelMatrix, transform.Rotation.x, Vec3(1.0f, 0.0f, 0.0f));
-            modelMatrix = glm::rotate(modelMatrix, transform.Rotation.z, Vec3(0.0f, 0.0f, 1.0f));
+        // Apply rotation to orient cone.
+        modelMatrix = glm::rotate(modelMatrix, transform.Rotation.y, Vec3(0.0f, 1.0f, 0.0f));
+        modelMatrix = glm::rotate(modelMatrix, transform.Rotation.x, Vec3(1.0f, 0.0f, 0.0f));
+        modelMatrix = glm::rotate(modelMatrix, transform.Rotation.z, Vec3(0.0f, 0.0f, 1.0f));
 
-            SpotLightPushConstantData push{};
-            {
-                push.ModelMatrix = modelMatrix;
-                push.Color       = Vec4(spotLight.Color, spotLight.Intensity);
-                push.ConeAngle   = glm::radians(spotLight.OuterCutoffAngle);
-            }
+        SpotLightPushConstantData push{};
+        {
+            push.ModelMatrix = modelMatrix;
+            push.Color       = Vec4(spotLight.Light.Color, spotLight.Light.Intensity);
+            push.ConeAngle   = glm::radians(spotLight.Light.OuterCutoffAngle);
+        }
 
-            m_SpotPipeline->pushConstants(frameInfo.CommandBuffer, 
-                VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 
-                push
-            );
+        context.pushConstants(*m_SpotPipeline, 
+            VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 
+            push
+        );
 
-            // Draw cone base circle (16 vertices) + 8 lines from apex = 24 vertices.
-            vkCmdDraw(frameInfo.CommandBuffer, 25, 1, 0, 0);
-        }
+        // Draw cone base circle (16 vertices) + 8 lines from apex = 24 vertices.
+        vkCmdDraw(context.commandBuffer(), 25, 1, 0, 0);
     }
 
 
@@ -4,6 +4,9 @@
 
 namespace Vy 
 {
+    /**
+     * @brief Draws the light gizmos, the lights themselves are shaded by the material pass (see VyClusteredLightSystem).
+     */
     class VyLightSystem : public IRenderSystem
     {
     public:
@@ -19,12 +22,26 @@ namespace Vy
 
         virtual void render(const VyFrameInfo& frameInfo) override;
 
-        virtual void update(VyFrameInfo& frameInfo, GlobalUBO& ubo) override;
-        
-        // Update target-locked light rotation (call when light position or target changes)
-        static void updateTargetLockedLight(EntityHandle entity, VyScene* scene);
+        /**
+         * @brief Submits one transparent packet per light gizmo, the payload holds the light kind and index.
+         */
+        virtual void submit(const VyFrameInfo& frameInfo, VyRenderQueue& queue) override;
+
+        virtual void recordPacket(VyCommandContext& context, const VyFrameInfo& frameInfo, U32 payload) const override;
 
     private:
+        enum class ELightKind : U8
+        {
+            Point,
+            Directional,
+            Spot
+        };
+
+        static U32 packPayload(ELightKind kind, U32 index) { return (static_cast<U32>(kind) << 24) | index; }
+
+        void drawPointLight      (VyCommandContext& context, const VyPointLightProxy&       pointLight) const;
+        void drawDirectionalLight(VyCommandContext& context, const VyDirectionalLightProxy& dirLight  ) const;
+        void drawSpotLight       (VyCommandContext& context, const VySpotLightProxy&        spotLight ) const;
 
         void createPointLightPipeline      (VkRenderPass renderPass, VkDescriptorSetLayout globalSetLayout);
         void createDirectionalLightPipeline(VkRenderPass renderPass, VkDescriptorSetLayout globalSetLayout);
@@ -32,8 +49,6 @@ namespace Vy
     
         Unique<VyPipeline> m_Pipeline;
 
-        float m_RotationSpeed{ 0.5f };
-
         // Point light rendering
         Unique<VyPipeline> m_PointPipeline;
 
@@ -1,5 +1,6 @@
 #include <Vy/Systems/Rendering/MasterRenderSystem.h>
 
+#include <Vy/GFX/Backend/Pipeline/PipelineCompiler.h>
 #include <Vy/GFX/Context.h>
 
 namespace Vy
@@ -16,7 +17,6 @@ namespace Vy
 		m_IsRunning = true;
 
 		// Create the descriptor resources and UBO buffers.
-        createDescriptorPools();
 		createUniformBuffers();
         createDescriptors();
 
@@ -46,42 +46,41 @@ namespace Vy
 
 #pragma region [ Resources ]
 
-	void VyMasterRenderSystem::createDescriptorPools()
-	{
-		// Global pool is created by VyContext when VyRenderer is created.
-
-        // Create the material pool.
-        m_MaterialPool = VyDescriptorPool::Builder{}
-            .setMaxSets (1000)
-            .addPoolSize(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 4000)
-        .buildUnique();
-	}
-
-
 	void VyMasterRenderSystem::createDescriptors()
 	{
         // Global set layout.
         m_GlobalSetLayout = VyDescriptorSetLayout::Builder{}
             .addBinding(0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_SHADER_STAGE_ALL_GRAPHICS) // Global UBO
-        .buildUnique();
-
-        // Material set layout.
-        m_MaterialSetLayout = VyDescriptorSetLayout::Builder()
-            .addBinding(0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_FRAGMENT_BIT) // Albedo
-            .addBinding(1, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_FRAGMENT_BIT) // Normal
-            .addBinding(2, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_FRAGMENT_BIT) // Roughness
-            .addBinding(3, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_FRAGMENT_BIT) // Metallic
+            .addBinding(1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_FRAGMENT_BIT) // Lights
+            .addBinding(2, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_FRAGMENT_BIT) // Cluster Light Counts
+            .addBinding(3, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_FRAGMENT_BIT) // Cluster Light Indices
+            .addBinding(4, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_FRAGMENT_BIT) // Shadows
+            .addBinding(5, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_FRAGMENT_BIT) // Shadow Atlas
+            .addBinding(6, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_FRAGMENT_BIT, VyShadowSystem::kCubeShadowMapCount) // Shadow Cube Maps
         .buildUnique();
 
 		// ----------------------------------------------------------------------------------------
 
+        auto clusterCountInfo = m_ClusteredLightSystem->clusterCountInfo();
+        auto clusterIndexInfo = m_ClusteredLightSystem->clusterIndexInfo();
+        auto atlasInfo        = m_ShadowSystem->shadowAtlasDescriptorInfo();
+        auto cubeInfos        = m_ShadowSystem->cubeShadowMapDescriptorInfos();
+
         // Write the global descriptor sets.
         for (int i = 0; i < m_GlobalSets.size(); i++)
         {
             auto bufferInfo = m_UBOBuffers[i]->descriptorBufferInfo();
+            auto lightInfo  = m_ClusteredLightSystem->lightBufferInfo(i);
+            auto shadowInfo = m_ShadowSystem->shadowBufferInfo(i);
 
             VyDescriptorWriter{ *m_GlobalSetLayout, *VyContext::globalPool() }
                 .writeBuffer(0, &bufferInfo)
+                .writeBuffer(1, &lightInfo)
+                .writeBuffer(2, &clusterCountInfo)
+                .writeBuffer(3, &clusterIndexInfo)
+                .writeBuffer(4, &shadowInfo)
+                .writeImage(5, &atlasInfo)
+                .writeImages(6, cubeInfos.data(), VyShadowSystem::kCubeShadowMapCount)
             .build(m_GlobalSets[i]);
         }
 
@@ -105,6 +104,16 @@ namespace Vy
             // Map the buffer's memory so that it can be written to in the update loop.
             m_UBOBuffers[i]->map();
         }
+
+        // The light and cluster buffers are bound to the global sets next to the UBO.
+        m_ClusteredLightSystem = MakeUnique<VyClusteredLightSystem>(
+            m_Renderer.swapchainExtent()
+        );
+
+        // The shadow buffer and atlas are bound next to the lights, which carry their index into the buffer.
+        m_ShadowSystem = MakeUnique<VyShadowSystem>();
+
+        m_ClusteredLightSystem->setShadowSystem(m_ShadowSystem.get());
 	}
 
 #pragma endregion Resources
@@ -114,6 +123,9 @@ namespace Vy
 
 	void VyMasterRenderSystem::createRenderSystems()
 	{
+		// The systems' pipelines are only queued while they are created, then compiled in parallel below.
+		VyPipelineCompiler compiler;
+
 		m_PostProcessSystem = MakeUnique<VyPostProcessSystem>(
 			m_Renderer.swapchainExtent()
 		);
@@ -122,12 +134,31 @@ namespace Vy
 
 		// ----------------------------------------------------------------------------------------
 
+		m_DeferredRenderSystem = MakeUnique<VyDeferredRenderSystem>(
+			m_Renderer.swapchainExtent(),
+			m_GlobalSetLayout->handle(),
+			*m_PostProcessSystem
+		);
+
+		VY_INFO_TAG("VyMasterRenderSystem", "- VyDeferredRenderSystem Complete");
+
+		// ----------------------------------------------------------------------------------------
+
 		m_RenderSystem = MakeUnique<VyRenderSystem>(
 			// m_Renderer.swapchainRenderPass(),
 			m_PostProcessSystem->getHDRRenderPass(),
 			TVector{
-				m_GlobalSetLayout  ->handle(),
-				m_MaterialSetLayout->handle()
+				m_GlobalSetLayout->handle(),
+				m_MaterialSystem ->setLayout()
+			}
+		);
+
+		m_RenderSystem->createGBufferPipeline(
+			m_DeferredRenderSystem->renderPass(),
+			VyDeferredRenderSystem::kGeometrySubpass,
+			TVector{
+				m_GlobalSetLayout->handle(),
+				m_MaterialSystem ->setLayout()
 			}
 		);
 
@@ -135,6 +166,22 @@ namespace Vy
 
 		// ----------------------------------------------------------------------------------------
 
+		if (VyContext::device().supportsDrawIndirectCount())
+		{
+			m_GPUDrivenRenderSystem = MakeUnique<VyGPUDrivenRenderSystem>(
+				m_PostProcessSystem->getHDRRenderPass(),
+				TVector{
+					m_GlobalSetLayout->handle(),
+					m_MaterialSystem ->setLayout()
+				},
+				m_Renderer.swapchainExtent()
+			);
+
+			VY_INFO_TAG("VyMasterRenderSystem", "- VyGPUDrivenRenderSystem Complete");
+		}
+
+		// ----------------------------------------------------------------------------------------
+
 		m_LightSystem = MakeUnique<VyLightSystem>(
 			// m_Renderer.swapchainRenderPass(),
 			m_PostProcessSystem->getHDRRenderPass(),
@@ -145,6 +192,18 @@ namespace Vy
 
 		// ----------------------------------------------------------------------------------------
 
+		m_ClusteredLightSystem->createPipeline();
+
+		VY_INFO_TAG("VyMasterRenderSystem", "- VyClusteredLightSystem Complete");
+
+		// ----------------------------------------------------------------------------------------
+
+		m_ShadowSystem->createPipelines();
+
+		VY_INFO_TAG("VyMasterRenderSystem", "- VyShadowSystem Complete");
+
+		// ----------------------------------------------------------------------------------------
+
 		m_GridSystem = MakeUnique<VyGridSystem>(
 			// m_Renderer.swapchainRenderPass(),
 			m_PostProcessSystem->getHDRRenderPass(),
@@ -165,6 +224,34 @@ namespace Vy
 		VY_INFO_TAG("VyMasterRenderSystem", "- VySkyboxSystem Complete");
 
 		// ----------------------------------------------------------------------------------------
+
+		compiler.compile();
+
+		VyContext::pipelineCache().save();
+
+		VY_INFO_TAG("VyMasterRenderSystem", "- Pipelines Complete");
+	}
+
+
+	void VyMasterRenderSystem::setRenderPath(ERenderPath renderPath)
+	{
+		if (renderPath == ERenderPath::GPUDriven && !m_GPUDrivenRenderSystem)
+		{
+			VY_WARN_TAG("VyMasterRenderSystem", "GPU-driven rendering is not supported by the device, using the CPU render path");
+
+			renderPath = ERenderPath::CPU;
+		}
+
+		m_RenderPath = renderPath;
+	}
+
+
+	void VyMasterRenderSystem::setOcclusionCulling(bool bEnabled)
+	{
+		if (m_GPUDrivenRenderSystem)
+		{
+			m_GPUDrivenRenderSystem->setOcclusionCulling(bEnabled);
+		}
 	}
 
 #pragma endregion Systems
@@ -175,8 +262,8 @@ namespace Vy
 
 	void VyMasterRenderSystem::updateUniformBuffers(VyFrameInfo& frameInfo, GlobalUBO& ubo)
 	{
-		// Update material descriptor sets.
-		m_MaterialSystem->updateMaterials(frameInfo, *m_MaterialSetLayout, *m_MaterialPool);
+		// Update the bindless material textures and parameters.
+		m_MaterialSystem->updateMaterials(frameInfo);
 
 		// [ Update UBO Data ]
 		{
@@ -185,8 +272,11 @@ namespace Vy
 			ubo.CameraData.InverseView = frameInfo.Camera.inverseView();
 		}
 
-		// Update light values into UBO.
-		m_LightSystem->update( frameInfo, ubo );
+		// Pick the shadowed lights first, the lights carry their shadow index.
+		m_ShadowSystem->update( frameInfo );
+
+		// Upload the lights and their cluster parameters.
+		m_ClusteredLightSystem->update( frameInfo, ubo );
 
 		// Write Global UBO buffers.
 		m_UBOBuffers[ frameInfo.FrameIndex ]->writeToBuffer( &ubo, sizeof(GlobalUBO), 0 );
@@ -199,6 +289,55 @@ namespace Vy
 	{
 		auto cmdBuffer = frameInfo.CommandBuffer;
 
+		const bool bGPUDriven = (m_RenderPath == ERenderPath::GPUDriven);
+		const bool bOcclusion = bGPUDriven && m_GPUDrivenRenderSystem->occlusionCulling();
+
+		// The GPU-driven path records a handful of indirect draws, only the CPU path is worth splitting.
+		const bool bParallel  = m_bParallelRecording && !bGPUDriven;
+
+		const bool bDeferred  = !bGPUDriven && m_ShadingPath == EShadingPath::Deferred;
+
+		// The frame fence was waited on in `beginFrame`, the frame's secondary command pools can be reset.
+		m_Recorder.beginFrame(frameInfo.FrameIndex);
+
+		m_RenderQueueStats.reset();
+
+		// [ Render Queue ]
+		// The CPU path submits its draws as sorted packets, the GPU-driven path draws through indirect buffers.
+		if (!bGPUDriven)
+		{
+			m_RenderQueue.clear();
+
+			m_RenderSystem->setGBufferPass(bDeferred);
+
+			if (bDeferred)
+			{
+				// The other systems are not written to the G-buffer, they are drawn after the lighting subpass.
+				m_RenderSystem->submit(frameInfo, m_RenderQueue);
+			}
+			else
+			{
+				m_SkyboxSystem->submit(frameInfo, m_RenderQueue);
+				m_RenderSystem->submit(frameInfo, m_RenderQueue);
+				m_LightSystem ->submit(frameInfo, m_RenderQueue);
+				m_GridSystem  ->submit(frameInfo, m_RenderQueue);
+			}
+
+			m_RenderQueue.sort();
+		}
+
+		// [ Pre-Pass Work ]
+		// Shadow maps, light binning and compute culling must be recorded outside of the render pass.
+		m_ShadowSystem->setParallelRecorder(m_bParallelRecording ? &m_Recorder : nullptr);
+		m_ShadowSystem->renderShadowMaps(frameInfo);
+
+		m_ClusteredLightSystem->prepare(frameInfo);
+
+		if (bGPUDriven)
+		{
+			m_GPUDrivenRenderSystem->prepare(frameInfo);
+		}
+
 		TArray<VkClearValue, 2> clearValues{};
 		{
 			clearValues[0].color        = {{ 0.01f, 0.01f, 0.01f, 1.0f }};
@@ -219,24 +358,86 @@ namespace Vy
 		}
 
 		// [ HDR Render Pass ]
-		vkCmdBeginRenderPass(cmdBuffer, &hdrRenderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+		if (bDeferred)
 		{
-			// Set viewport and scissor for HDR rendering.
-			VKCmd::viewport(cmdBuffer, m_Renderer.swapchainExtent());
-			VKCmd::scissor (cmdBuffer, m_Renderer.swapchainExtent());
-			
-			// [ Render Systems ]
+			renderDeferredPass(frameInfo, bParallel);
+		}
+		else if (bParallel)
+		{
+			const VyRecordingPass pass{
+				.RenderPass  = m_PostProcessSystem->getHDRRenderPass(),
+				.Subpass     = 0,
+				.Framebuffer = m_PostProcessSystem->getHDRFramebuffer(frameInfo.FrameIndex),
+				.Extent      = m_Renderer.swapchainExtent()
+			};
+
+			vkCmdBeginRenderPass(cmdBuffer, &hdrRenderPassInfo, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+			{
+				renderHDRPassParallel(frameInfo, pass);
+			}
+			vkCmdEndRenderPass(cmdBuffer);
+		}
+		else
+		{
+			vkCmdBeginRenderPass(cmdBuffer, &hdrRenderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
 			{
+				// Set viewport and scissor for HDR rendering.
+				VKCmd::viewport(cmdBuffer, m_Renderer.swapchainExtent());
+				VKCmd::scissor (cmdBuffer, m_Renderer.swapchainExtent());
+				
+				// [ Render Systems ]
+				if (bOcclusion)
+				{
+					// Early phase: last frame's visible set, its depth is used to build the HZB.
+					m_GPUDrivenRenderSystem->render(frameInfo);
+				}
+				else if (bGPUDriven)
+				{
+					m_SkyboxSystem         ->render(frameInfo);
+					m_GPUDrivenRenderSystem->render(frameInfo);
+					m_LightSystem          ->render(frameInfo);
+					m_GridSystem           ->render(frameInfo);
+				}
+				else
+				{
+					m_RenderQueue.record(frameInfo, 0, m_RenderQueue.size(), m_RenderQueueStats);
+				}
+			}
+			vkCmdEndRenderPass(cmdBuffer);
+		}
+
+		// [ Occlusion Culling ]
+		if (bOcclusion)
+		{
+			m_GPUDrivenRenderSystem->prepareLatePass(
+				frameInfo, 
+				m_PostProcessSystem->getHDRDepthImage    (frameInfo.FrameIndex), 
+				m_PostProcessSystem->getHDRDepthImageView(frameInfo.FrameIndex)
+			);
+
+			// Continue the HDR scene on top of the early phase.
+			hdrRenderPassInfo.renderPass      = m_PostProcessSystem->getHDRLoadRenderPass();
+			hdrRenderPassInfo.clearValueCount = 0;
+			hdrRenderPassInfo.pClearValues    = nullptr;
+
+			// [ HDR Render Pass (Late) ]
+			vkCmdBeginRenderPass(cmdBuffer, &hdrRenderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+			{
+				VKCmd::viewport(cmdBuffer, m_Renderer.swapchainExtent());
+				VKCmd::scissor (cmdBuffer, m_Renderer.swapchainExtent());
+
+				// The skybox only fills what the geometry left at the far plane, so drawing it after is equivalent.
+				m_GPUDrivenRenderSystem->renderLatePass(frameInfo);
+
 				m_SkyboxSystem->render(frameInfo);
-				m_RenderSystem->render(frameInfo);
 				m_LightSystem ->render(frameInfo);
 				m_GridSystem  ->render(frameInfo);
 			}
+			vkCmdEndRenderPass(cmdBuffer);
 		}
-		vkCmdEndRenderPass(cmdBuffer);
 
 		// [ Apply Post-Processing ]
-		const auto& postProcSettings = frameInfo.Scene->getPostProcessingComponent();
+		const auto& postProcSettings = frameInfo.Packet.PostProcessing;
 		{
 			m_PostProcessSystem->renderPostProcess(cmdBuffer, frameInfo.FrameIndex, postProcSettings);
 		}
@@ -258,5 +459,114 @@ namespace Vy
 		// [ End of Frame ]
 	}
 
+	// ---------------------------------------------------------------------------------------------------------------------
+
+	void VyMasterRenderSystem::renderHDRPassParallel(VyFrameInfo& frameInfo, const VyRecordingPass& pass)
+	{
+		// Each chunk starts with a fresh command context, the counters are kept per chunk and summed.
+		m_ChunkQueueStats.assign(m_Recorder.chunkCount(m_RenderQueue.size(), kMinPacketsPerChunk), VyCommandStats{});
+
+		m_SecondaryBuffers.clear();
+
+		m_Recorder.record(frameInfo.FrameIndex, pass, m_RenderQueue.size(), kMinPacketsPerChunk, m_SecondaryBuffers, 
+			[&](VkCommandBuffer commandBuffer, U32 chunk, U32 firstPacket, U32 lastPacket)
+			{
+				VyFrameInfo secondaryInfo = frameInfo;
+				secondaryInfo.CommandBuffer = commandBuffer;
+
+				m_RenderQueue.record(secondaryInfo, firstPacket, lastPacket, m_ChunkQueueStats[ chunk ]);
+			}
+		);
+
+		for (const VyCommandStats& chunkStats : m_ChunkQueueStats)
+		{
+			m_RenderQueueStats += chunkStats;
+		}
+
+		if (!m_SecondaryBuffers.empty())
+		{
+			vkCmdExecuteCommands(frameInfo.CommandBuffer, static_cast<U32>(m_SecondaryBuffers.size()), m_SecondaryBuffers.data());
+		}
+	}
+
+	// ---------------------------------------------------------------------------------------------------------------------
+
+	void VyMasterRenderSystem::renderDeferredPass(VyFrameInfo& frameInfo, bool bParallel)
+	{
+		auto cmdBuffer = frameInfo.CommandBuffer;
+
+		const TArray<VkClearValue, 4> clearValues = m_DeferredRenderSystem->clearValues();
+
+		VkRenderPassBeginInfo deferredPassInfo{ VKInit::renderPassBeginInfo() };
+		{
+			deferredPassInfo.renderPass        = m_DeferredRenderSystem->renderPass();
+			deferredPassInfo.framebuffer       = m_DeferredRenderSystem->framebuffer(frameInfo.FrameIndex);
+
+			deferredPassInfo.renderArea.offset = { 0, 0 };
+			deferredPassInfo.renderArea.extent = m_Renderer.swapchainExtent();
+
+			deferredPassInfo.clearValueCount   = static_cast<U32>(clearValues.size());
+			deferredPassInfo.pClearValues      = clearValues.data();
+		}
+
+		// [ Geometry Subpass ]
+		if (bParallel)
+		{
+			const VyRecordingPass pass{
+				.RenderPass  = m_DeferredRenderSystem->renderPass(),
+				.Subpass     = VyDeferredRenderSystem::kGeometrySubpass,
+				.Framebuffer = m_DeferredRenderSystem->framebuffer(frameInfo.FrameIndex),
+				.Extent      = m_Renderer.swapchainExtent()
+			};
+
+			vkCmdBeginRenderPass(cmdBuffer, &deferredPassInfo, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+
+			renderHDRPassParallel(frameInfo, pass);
+		}
+		else
+		{
+			vkCmdBeginRenderPass(cmdBuffer, &deferredPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+
+			VKCmd::viewport(cmdBuffer, m_Renderer.swapchainExtent());
+			VKCmd::scissor (cmdBuffer, m_Renderer.swapchainExtent());
+
+			m_RenderQueue.record(frameInfo, 0, m_RenderQueue.size(), m_RenderQueueStats);
+		}
+
+		// [ Lighting Subpass ]
+		vkCmdNextSubpass(cmdBuffer, VK_SUBPASS_CONTENTS_INLINE);
+		{
+			// The dynamic state of the secondaries does not carry over to the primary.
+			VKCmd::viewport(cmdBuffer, m_Renderer.swapchainExtent());
+			VKCmd::scissor (cmdBuffer, m_Renderer.swapchainExtent());
+
+			m_DeferredRenderSystem->render(frameInfo);
+		}
+		vkCmdEndRenderPass(cmdBuffer);
+
+		// Continue the HDR scene on top of the lit geometry.
+		VkRenderPassBeginInfo hdrLoadPassInfo{ VKInit::renderPassBeginInfo() };
+		{
+			hdrLoadPassInfo.renderPass        = m_PostProcessSystem->getHDRLoadRenderPass();
+			hdrLoadPassInfo.framebuffer       = m_PostProcessSystem->getHDRFramebuffer(frameInfo.FrameIndex);
+
+			hdrLoadPassInfo.renderArea.offset = { 0, 0 };
+			hdrLoadPassInfo.renderArea.extent = m_Renderer.swapchainExtent();
+		}
+
+		// [ HDR Render Pass (Forward) ]
+		vkCmdBeginRenderPass(cmdBuffer, &hdrLoadPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+		{
+			VKCmd::viewport(cmdBuffer, m_Renderer.swapchainExtent());
+			VKCmd::scissor (cmdBuffer, m_Renderer.swapchainExtent());
+
+			// The skybox only fills what the geometry left at the far plane, so drawing it after is equivalent.
+			m_SkyboxSystem->render(frameInfo);
+			m_LightSystem ->render(frameInfo);
+			m_GridSystem  ->render(frameInfo);
+		}
+		vkCmdEndRenderPass(cmdBuffer);
+	}
+
 #pragma endregion Processes
 }
\ No newline at end of file
@@ -4,13 +4,17 @@
 
 #include <Vy/GFX/Renderer.h>
 #include <Vy/GFX/Backend/Descriptors.h>
+#include <Vy/GFX/Backend/ParallelRecorder.h>
 
 #include <Vy/Systems/Rendering/RenderSystem.h>
+#include <Vy/Systems/Rendering/ClusteredLightSystem.h>
+#include <Vy/Systems/Rendering/DeferredRenderSystem.h>
+#include <Vy/Systems/Rendering/GPUDrivenRenderSystem.h>
 #include <Vy/Systems/Rendering/GridSystem.h>
 #include <Vy/Systems/Rendering/LightSystem.h>
 #include <Vy/Systems/Rendering/SkyboxSystem.h>
 #include <Vy/Systems/Rendering/PostProcessSystem.h>
-// #include <Vy/Systems/Rendering/ShadowSystem.h>
+#include <Vy/Systems/Rendering/ShadowSystem.h>
 #include <Vy/Systems/Rendering/ShadowMapSystem.h>
 
 #include <Vy/Systems/Buffer/MaterialSystem.h>
@@ -18,6 +22,24 @@
 
 namespace Vy
 {
+    /**
+     * @brief Selects how the main (material) pass culls and draws the scene.
+     */
+    enum class ERenderPath
+    {
+        CPU,       // VyRenderSystem: CPU frustum culling and instanced draws.
+        GPUDriven, // VyGPUDrivenRenderSystem: compute culling and indirect count draws.
+    };
+
+    /**
+     * @brief Selects how the opaque scene of the CPU render path is lit.
+     */
+    enum class EShadingPath
+    {
+        Forward,  // Material.frag shades every fragment in the HDR pass.
+        Deferred, // VyDeferredRenderSystem: G-buffer subpass, then a fullscreen lighting subpass.
+    };
+
     class VyMasterRenderSystem
     {
     public:
@@ -41,10 +63,16 @@ namespace Vy
 
         void recreate(VkExtent2D newExtent)
         {
-            m_PostProcessSystem->recreate(newExtent);
+            m_PostProcessSystem   ->recreate(newExtent);
+            m_DeferredRenderSystem->recreate(newExtent, *m_PostProcessSystem);
+            m_ClusteredLightSystem->recreate(newExtent);
+
+            if (m_GPUDrivenRenderSystem)
+            {
+                m_GPUDrivenRenderSystem->recreate(newExtent);
+            }
         }
 
-        void createDescriptorPools();
         void createDescriptors();
 		void createUniformBuffers();
 
@@ -53,16 +81,84 @@ namespace Vy
             return m_GlobalSets[ frameIndex ];
         }
 
+        VkDescriptorSet materialSet(int frameIndex)
+        {
+            return m_MaterialSystem->descriptorSet(frameIndex);
+        }
+
+        /**
+         * @brief Visible / culled entity counts of the main (material) pass of the last frame.
+         */
+        const VyCullStats& mainPassCullStats() const
+        {
+            return m_RenderPath == ERenderPath::GPUDriven ? m_GPUDrivenRenderSystem->cullStats() : m_RenderSystem->cullStats();
+        }
+
+        /**
+         * @brief Selects the main pass render path. Falls back to the CPU path if the device does not support GPU-driven rendering.
+         */
+        void setRenderPath(ERenderPath renderPath);
+
+        ERenderPath renderPath() const { return m_RenderPath; }
+
+        /**
+         * @brief Enables the two-phase HZB occlusion culling of the GPU-driven path (on by default).
+         */
+        void setOcclusionCulling(bool bEnabled);
+
+        bool occlusionCulling() const
+        {
+            return m_RenderPath == ERenderPath::GPUDriven && m_GPUDrivenRenderSystem->occlusionCulling();
+        }
+
+        /**
+         * @brief Selects the shading path of the CPU render path. The GPU-driven path always shades forward.
+         */
+        void setShadingPath(EShadingPath shadingPath) { m_ShadingPath = shadingPath; }
+
+        EShadingPath shadingPath() const { return m_ShadingPath; }
+
+        /**
+         * @brief Records the HDR pass of the CPU render path in parallel into secondary command buffers (on by default).
+         */
+        void setParallelRecording(bool bEnabled) { m_bParallelRecording = bEnabled; }
+
+        bool parallelRecording() const { return m_bParallelRecording; }
+
+        /**
+         * @brief Binds recorded by the render queue of the CPU path in the last frame, and the redundant ones elided.
+         */
+        const VyCommandStats& renderQueueStats() const { return m_RenderQueueStats; }
+
+        /**
+         * @brief Shadowed lights and shadow views re-rendered in the last frame, see VyShadowSystem.
+         */
+        const VyShadowSystem& shadowSystem() const { return *m_ShadowSystem; }
+
     private:
+        /**
+         * @brief Records the sorted render queue of the CPU path in chunks into secondary command buffers and executes them.
+         * 
+         * The pass must have been begun with `VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS`.
+         */
+        void renderHDRPassParallel(VyFrameInfo& frameInfo, const VyRecordingPass& pass);
+
+        /**
+         * @brief Records the deferred pass (G-buffer and lighting subpasses), then the forward systems in the HDR load pass.
+         */
+        void renderDeferredPass(VyFrameInfo& frameInfo, bool bParallel);
 
         VyRenderer&                 m_Renderer;
 
-        Unique<VyRenderSystem>      m_RenderSystem;
+        Unique<VyRenderSystem>          m_RenderSystem;
+        Unique<VyGPUDrivenRenderSystem> m_GPUDrivenRenderSystem;
         Unique<VyLightSystem>       m_LightSystem;
+        Unique<VyClusteredLightSystem> m_ClusteredLightSystem;
+        Unique<VyDeferredRenderSystem> m_DeferredRenderSystem;
         Unique<VyGridSystem>        m_GridSystem;
         Unique<VySkyboxSystem>      m_SkyboxSystem;
         Unique<VyPostProcessSystem> m_PostProcessSystem;
-        // Unique<VyShadowSystem>      m_ShadowSystem;
+        Unique<VyShadowSystem>      m_ShadowSystem;
         // Unique<VyShadowMapSystem>      m_ShadowMapSystem;
 
         Shared<VyMaterialSystem>     m_MaterialSystem;
@@ -70,19 +166,27 @@ namespace Vy
         // UBO Buffers
         TVector<Unique<VyBuffer>>     m_UBOBuffers{ MAX_FRAMES_IN_FLIGHT };
         
-        // Descriptor Pools
-        Shared<VyDescriptorPool>      m_MaterialPool{};
-
         // Descriptor Sets
         TVector<VkDescriptorSet>      m_GlobalSets  { MAX_FRAMES_IN_FLIGHT };
-        TVector<VkDescriptorSet>      m_MaterialSets;
 
         // Descriptor Set Layouts
-        Shared<VyDescriptorSetLayout> m_GlobalSetLayout  {};
-        Shared<VyDescriptorSetLayout> m_MaterialSetLayout{};
+        Shared<VyDescriptorSetLayout> m_GlobalSetLayout{};
 
         Shared<VyEnvironment> m_Environment;
 
+        ERenderPath  m_RenderPath  = ERenderPath::CPU;
+        EShadingPath m_ShadingPath = EShadingPath::Forward;
+
+        static constexpr U32 kMinPacketsPerChunk = 32; // Smaller chunks cost more in secondary buffer overhead than they save.
+
+        VyRenderQueue               m_RenderQueue;
+        VyCommandStats              m_RenderQueueStats{};
+        TVector<VyCommandStats>     m_ChunkQueueStats;
+
+        VyParallelRecorder       m_Recorder;
+        TVector<VkCommandBuffer> m_SecondaryBuffers; // HDR pass secondaries in draw order, reused between frames.
+        bool                     m_bParallelRecording = true;
+
         bool m_IsRunning = false;
     };
 }
\ No newline at end of file
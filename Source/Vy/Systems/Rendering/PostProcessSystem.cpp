@@ -93,7 +93,14 @@ namespace Vy
         m_HDRImageViews     .clear();
         m_HDRImages         .clear();
 
-        // Cleanup HDR RenderPass.
+        // Cleanup HDR RenderPasses.
+        if (m_HDRLoadRenderPass != VK_NULL_HANDLE) 
+        {
+            vkDestroyRenderPass(VyContext::device(), m_HDRLoadRenderPass, nullptr);
+
+            m_HDRLoadRenderPass = VK_NULL_HANDLE;
+        }
+
         if (m_HDRRenderPass != VK_NULL_HANDLE) 
         {
             vkDestroyRenderPass(VyContext::device(), m_HDRRenderPass, nullptr);
@@ -160,7 +167,8 @@ namespace Vy
                 .extent     (m_Extent)
                 .format     (depthFormat)
                 .tiling     (VK_IMAGE_TILING_OPTIMAL)
-                .usage      (VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT)
+                // Sampled to build the HZB, read as an input attachment by the deferred lighting subpass.
+                .usage      (VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT)
                 .memoryUsage(VMA_MEMORY_USAGE_AUTO)
             .build();
 
@@ -263,7 +271,8 @@ namespace Vy
                 // One sample per pixel (more samples used for multisampling).
                 depthAttachment.samples        = VK_SAMPLE_COUNT_1_BIT;
                 depthAttachment.loadOp         = VK_ATTACHMENT_LOAD_OP_CLEAR;
-                depthAttachment.storeOp        = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+                // Stored so the HZB can be built from it and the scene pass continued with `m_HDRLoadRenderPass`.
+                depthAttachment.storeOp        = VK_ATTACHMENT_STORE_OP_STORE;
                 depthAttachment.stencilLoadOp  = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
                 depthAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
                 depthAttachment.initialLayout  = VK_IMAGE_LAYOUT_UNDEFINED;
@@ -325,6 +334,92 @@ namespace Vy
             }
         }
 
+        // [ HDR Load Render Pass ]
+        // Continues the HDR scene after a pass outside of it (e.g. building the HZB from the depth buffer).
+        // Compatible with the HDR render pass, so it uses the same framebuffers and pipelines.
+        {
+            // 0 - Color Attachment
+            VkAttachmentDescription colorAttachment{};
+            {
+                colorAttachment.format         = VK_FORMAT_R16G16B16A16_SFLOAT;
+                colorAttachment.samples        = VK_SAMPLE_COUNT_1_BIT;
+                colorAttachment.loadOp         = VK_ATTACHMENT_LOAD_OP_LOAD;
+                colorAttachment.storeOp        = VK_ATTACHMENT_STORE_OP_STORE;
+                colorAttachment.stencilLoadOp  = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+                colorAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+                colorAttachment.initialLayout  = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+                colorAttachment.finalLayout    = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+            }
+
+            // 1 - Depth Attachment
+            VkAttachmentDescription depthAttachment{};
+            {
+                depthAttachment.format         = VyContext::device().findDepthFormat();
+                depthAttachment.samples        = VK_SAMPLE_COUNT_1_BIT;
+                depthAttachment.loadOp         = VK_ATTACHMENT_LOAD_OP_LOAD;
+                depthAttachment.storeOp        = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+                depthAttachment.stencilLoadOp  = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+                depthAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+                depthAttachment.initialLayout  = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
+                depthAttachment.finalLayout    = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+            }
+
+            VkAttachmentReference colorAttachmentRef{};
+            {
+                colorAttachmentRef.attachment = 0;
+                colorAttachmentRef.layout     = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+            }
+
+            VkAttachmentReference depthAttachmentRef{};
+            {
+                depthAttachmentRef.attachment = 1;
+                depthAttachmentRef.layout     = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+            }
+
+            VkSubpassDescription subpass{};
+            {
+                subpass.pipelineBindPoint       = VK_PIPELINE_BIND_POINT_GRAPHICS;
+
+                subpass.colorAttachmentCount    = 1;
+                subpass.pColorAttachments       = &colorAttachmentRef;
+                
+                subpass.pDepthStencilAttachment = &depthAttachmentRef;
+            }
+
+            // Wait for the depth reads of the compute pass and the attachment writes of the first HDR pass.
+            VkSubpassDependency dependency{};
+            {
+                dependency.srcSubpass    = VK_SUBPASS_EXTERNAL;
+                dependency.dstSubpass    = 0;
+                
+                dependency.srcStageMask  = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+                dependency.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+                
+                dependency.dstStageMask  = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
+                dependency.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | 
+                                           VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+            }
+
+            TArray<VkAttachmentDescription, 2> attachments = { colorAttachment, depthAttachment };
+
+            VkRenderPassCreateInfo renderPassInfo{ VKInit::renderPassCreateInfo() };
+            {
+                renderPassInfo.attachmentCount = static_cast<U32>(attachments.size());
+                renderPassInfo.pAttachments    = attachments.data();
+                
+                renderPassInfo.subpassCount    = 1;
+                renderPassInfo.pSubpasses      = &subpass;
+                
+                renderPassInfo.dependencyCount = 1;
+                renderPassInfo.pDependencies   = &dependency;
+            }
+
+            if (vkCreateRenderPass(VyContext::device(), &renderPassInfo, nullptr, &m_HDRLoadRenderPass) != VK_SUCCESS) 
+            {
+                VY_THROW_RUNTIME_ERROR("Failed to create HDR load render pass!");
+            }
+        }
+
         // [ Bloom Render Pass ] (simple color attachment for bloom buffers)
         {
             // 0 - Color Attachment
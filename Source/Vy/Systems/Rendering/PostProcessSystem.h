@@ -23,6 +23,14 @@ namespace Vy
         // Get the HDR render pass for rendering the scene
         VkRenderPass  getHDRRenderPass()                const { return m_HDRRenderPass; }
         VkFramebuffer getHDRFramebuffer(int frameIndex) const { return m_HDRFramebuffers[frameIndex]; }
+        VkImageView   getHDRImageView  (int frameIndex) const { return m_HDRImageViews[frameIndex].handle(); }
+
+        // Same attachments as the HDR render pass but loads them, to continue the scene after work outside of it.
+        VkRenderPass  getHDRLoadRenderPass()            const { return m_HDRLoadRenderPass; }
+
+        // Scene depth, sampled in `VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL` between the two HDR passes.
+        VkImage       getHDRDepthImage    (int frameIndex) const { return m_HDRDepthImages[frameIndex].handle(); }
+        VkImageView   getHDRDepthImageView(int frameIndex) const { return m_HDRDepthImageViews[frameIndex].handle(); }
         
         // Apply post-processing effects
         void renderPostProcess(
@@ -61,6 +69,7 @@ namespace Vy
         // ---------------------------------------------------------------
         // HDR scene render target
         VkRenderPass           m_HDRRenderPass;
+        VkRenderPass           m_HDRLoadRenderPass{ VK_NULL_HANDLE };
         TVector<VkFramebuffer> m_HDRFramebuffers;
 
         TVector<VyImage>       m_HDRImages;
@@ -0,0 +1,64 @@
+#include <Vy/Systems/Rendering/RenderQueue.h>
+
+#include <Vy/Systems/Rendering/IRenderSystem.h>
+
+namespace Vy
+{
+    void VyRenderQueue::clear()
+    {
+        m_Packets.clear();
+        m_MeshIds.clear();
+    }
+
+
+    void VyRenderQueue::submit(IRenderSystem& system, U64 key, U32 payload)
+    {
+        m_Packets.push_back(Packet{
+            .Key     = key,
+            .System  = &system,
+            .Payload = payload
+        });
+    }
+
+
+    U16 VyRenderQueue::pipelineId(const VyPipeline& pipeline)
+    {
+        auto [ it, bInserted ] = m_PipelineIds.try_emplace(&pipeline, static_cast<U16>(m_PipelineIds.size()));
+
+        VY_ASSERT(it->second < VyRenderKey::kMaxPipelines, "Exceeded the pipeline count of the render key");
+
+        return it->second;
+    }
+
+
+    U16 VyRenderQueue::meshId(const VyStaticMesh& mesh)
+    {
+        auto [ it, bInserted ] = m_MeshIds.try_emplace(&mesh, static_cast<U16>(m_MeshIds.size() + 1));
+
+        VY_ASSERT(m_MeshIds.size() < 0xFFFF, "Exceeded the mesh count of the render key");
+
+        return it->second;
+    }
+
+
+    void VyRenderQueue::sort()
+    {
+        radixSort64(m_Packets, m_Scratch, [](const Packet& packet) { return packet.Key; });
+    }
+
+
+    void VyRenderQueue::record(const VyFrameInfo& frameInfo, U32 firstPacket, U32 lastPacket, VyCommandStats& stats) const
+    {
+        // The sort placed packets with the same state next to each other, the context drops their repeated binds.
+        VyCommandContext context{ frameInfo.CommandBuffer };
+
+        for (U32 i = firstPacket; i < lastPacket; i++)
+        {
+            const Packet& packet = m_Packets[i];
+
+            packet.System->recordPacket(context, frameInfo, packet.Payload);
+        }
+
+        stats += context.stats();
+    }
+}
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <Vy/GFX/FrameInfo.h>
+#include <Vy/GFX/Backend/CommandContext.h>
+
+#include <VyLib/Util/RadixSort.h>
+
+#include <algorithm>
+
+namespace Vy
+{
+    class IRenderSystem;
+    class VyPipeline;
+    class VyStaticMesh;
+
+    /**
+     * @brief Draw order buckets, the most significant field of a render key.
+     */
+    enum class ERenderLayer : U8
+    {
+        Opaque      = 0, // Front to back within a mesh, for early depth rejection.
+        Sky         = 1, // Depth tested against the opaques, only fills what they left at the far plane.
+        Transparent = 2, // Back to front, blended over everything drawn before.
+    };
+
+    /**
+     * @brief Packs the state of a draw into a 64-bit key whose order minimizes state changes.
+     *
+     * @code
+     * Opaque, Sky:  layer (4) | pipeline (12) | material (16) | mesh (16) | depth (16)
+     * Transparent:  layer (4) | inverted depth (16) | pipeline (12) | material (16) | mesh (16)
+     * @endcode
+     *
+     * Transparent draws must stay back to front, so their depth ranks above the state they bind.
+     */
+    struct VyRenderKey
+    {
+        static constexpr U32 kPipelineBits = 12;
+        static constexpr U32 kMaxPipelines = 1u << kPipelineBits;
+
+        VY_NODISCARD static U64 make(ERenderLayer layer, U16 pipeline, U16 material, U16 mesh, U16 depth)
+        {
+            const U64 state = (U64(pipeline & (kMaxPipelines - 1)) << 32) | (U64(material) << 16) | U64(mesh);
+
+            if (layer == ERenderLayer::Transparent)
+            {
+                return (U64(layer) << 60) | (U64(U16(~depth)) << 44) | state;
+            }
+
+            return (U64(layer) << 60) | (state << 16) | U64(depth);
+        }
+
+        /**
+         * @brief Quantizes a view space distance to 16 bits over [0, farPlane].
+         */
+        VY_NODISCARD static U16 quantizeDepth(float viewDepth, float farPlane)
+        {
+            const float normalized = std::clamp(viewDepth / farPlane, 0.0f, 1.0f);
+
+            return static_cast<U16>(normalized * 65535.0f);
+        }
+
+        /**
+         * @brief View space distance of a world space position, along the view direction.
+         */
+        VY_NODISCARD static float viewDepth(const Mat4& view, const Vec3& position)
+        {
+            // The camera looks down +Z in view space (VyCamera's projection divides by the view space z).
+            return (view * Vec4(position, 1.0f)).z;
+        }
+    };
+
+
+    /**
+     * @brief Collects the draw packets of the render systems of a pass and records them in key order.
+     *
+     * Every system submits packets with a key built by `VyRenderKey::make` and a payload it interprets itself (a
+     * batch or light index). After `sort` the packets are replayed through `IRenderSystem::recordPacket` on a
+     * VyCommandContext, which drops the binds the previous packet already made. Any range of packets can be recorded
+     * on its own, so the sorted queue can be split into chunks and recorded in parallel.
+     *
+     * @note Submitting is not thread-safe, recording is.
+     */
+    class VyRenderQueue
+    {
+    public:
+        struct Packet
+        {
+            U64            Key;
+            IRenderSystem* System;
+            U32            Payload;
+        };
+
+        VyRenderQueue() = default;
+
+        VyRenderQueue(const VyRenderQueue&)            = delete;
+        VyRenderQueue& operator=(const VyRenderQueue&) = delete;
+
+        /**
+         * @brief Removes the packets and mesh ids of the previous frame.
+         */
+        void clear();
+
+        void submit(IRenderSystem& system, U64 key, U32 payload = 0);
+
+        /**
+         * @brief Stable id of a pipeline, assigned on first use.
+         */
+        VY_NODISCARD U16 pipelineId(const VyPipeline& pipeline);
+
+        /**
+         * @brief Id of a mesh for the current frame, assigned on first use. Zero is reserved for draws without a mesh.
+         */
+        VY_NODISCARD U16 meshId(const VyStaticMesh& mesh);
+
+        /**
+         * @brief Sorts the packets by key, packets with equal keys keep their submission order.
+         */
+        void sort();
+
+        /**
+         * @brief Records the packets [firstPacket, lastPacket) into `frameInfo.CommandBuffer` and adds the binds made
+         *        and elided to `stats`.
+         */
+        void record(const VyFrameInfo& frameInfo, U32 firstPacket, U32 lastPacket, VyCommandStats& stats) const;
+
+        VY_NODISCARD U32 size() const { return static_cast<U32>(m_Packets.size()); }
+
+        VY_NODISCARD bool empty() const { return m_Packets.empty(); }
+
+        VY_NODISCARD const TVector<Packet>& packets() const { return m_Packets; }
+
+    private:
+        TVector<Packet>                      m_Packets;
+        TVector<Packet>                      m_Scratch; // Radix sort buffer, reused between frames.
+
+        THashMap<const VyPipeline*,   U16>   m_PipelineIds; // Kept for the lifetime of the queue.
+        THashMap<const VyStaticMesh*, U16>   m_MeshIds;     // Rebuilt every frame.
+    };
+}
@@ -1,20 +1,40 @@
 #include <Vy/Systems/Rendering/RenderSystem.h>
 
+#include <Vy/Systems/Rendering/DeferredRenderSystem.h>
+#include <Vy/Systems/Buffer/MaterialSystem.h>
+
 #include <Vy/GFX/Context.h>
 #include <Vy/Globals.h>
 
+#include <algorithm>
+
 namespace Vy 
 {
     VyRenderSystem::VyRenderSystem(
         VkRenderPass                   renderPass, 
         TVector<VkDescriptorSetLayout> descSetLayouts)
     {
+        // Instance set layout ( 2 ).
+        m_InstanceSetLayout = VyDescriptorSetLayout::Builder{}
+            .addBinding(0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT) // Instance Data
+        .buildUnique();
+
+        for (int i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
+        {
+            reserveInstances(i, kInitialInstanceCapacity);
+        }
+
+        descSetLayouts.push_back(m_InstanceSetLayout->handle());
+
         createPipeline(renderPass, descSetLayouts);
     }
 
 
     VyRenderSystem::~VyRenderSystem()
     {
+        TVector<VkDescriptorSet> sets{ m_InstanceSets.begin(), m_InstanceSets.end() };
+
+        VyContext::releaseSets(sets);
     }
 
 
@@ -22,7 +42,6 @@ namespace Vy
     {
         m_Pipeline = VyPipeline::GraphicsBuilder{}
             .addDescriptorSetLayouts(descSetLayouts)
-            .addPushConstantRange   (VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, sizeof(MaterialPushConstantData))
             .addShaderStage         (VK_SHADER_STAGE_VERTEX_BIT,   "Material.vert.spv")
             .addShaderStage         (VK_SHADER_STAGE_FRAGMENT_BIT, "Material.frag.spv")
             .addColorAttachment     (VK_FORMAT_R16G16B16A16_SFLOAT)
@@ -32,73 +51,217 @@ namespace Vy
     }
 
 
-    void VyRenderSystem::render(const VyFrameInfo& frameInfo) 
+    void VyRenderSystem::createGBufferPipeline(VkRenderPass renderPass, U32 subpass, TVector<VkDescriptorSetLayout> descSetLayouts)
     {
-        // Bind pipeline.
-        m_Pipeline->bind(frameInfo.CommandBuffer);
-        
-        // Bind Global descriptor set ( 0 ).
-        m_Pipeline->bindDescriptorSet(frameInfo.CommandBuffer, 0, frameInfo.GlobalDescriptorSet);
+        descSetLayouts.push_back(m_InstanceSetLayout->handle());
 
-        // 
-        auto view = frameInfo.Scene->registry().view<ModelComponent, TransformComponent>();
-        
-        for (auto&& [ entity, model, transform ] : view.each())
+        // Same vertex stage and sets as the material pipeline.
+        m_GBufferPipeline = VyPipeline::GraphicsBuilder{}
+            .addDescriptorSetLayouts(descSetLayouts)
+            .addShaderStage         (VK_SHADER_STAGE_VERTEX_BIT,   "Material.vert.spv")
+            .addShaderStage         (VK_SHADER_STAGE_FRAGMENT_BIT, "Deferred/GBuffer.frag.spv")
+            .addColorAttachment     (VK_FORMAT_R16G16B16A16_SFLOAT)                 // HDR (ambient + emission)
+            .addColorAttachment     (VyDeferredRenderSystem::kGBufferAlbedoFormat) // Albedo / Metallic
+            .addColorAttachment     (VyDeferredRenderSystem::kGBufferNormalFormat) // Normal / Roughness
+            .setDepthAttachment     (VK_FORMAT_D32_SFLOAT)
+            .setRenderPass          (renderPass)
+            .setSubpass             (subpass)
+        .buildUnique();
+    }
+
+
+    void VyRenderSystem::reserveInstances(int frameIndex, U32 instanceCount)
+    {
+        if (m_InstanceBuffers[frameIndex] && instanceCount <= m_InstanceCapacity[frameIndex])
         {
-            MaterialPushConstantData push{};
+            return;
+        }
+
+        // Grow geometrically so a slowly increasing entity count doesn't reallocate every frame.
+        U32 capacity = std::max(m_InstanceCapacity[frameIndex], kInitialInstanceCapacity);
+
+        while (capacity < instanceCount)
+        {
+            capacity *= 2;
+        }
+
+        // The previous submission using this frame's buffer has completed (the frame fence was waited on),
+        // so the buffer and descriptor set can be replaced directly.
+        m_InstanceBuffers [frameIndex] = MakeUnique<VyBuffer>( VyBuffer::storageBuffer(sizeof(MaterialInstanceData) * capacity) );
+        m_InstanceCapacity[frameIndex] = capacity;
+
+        auto bufferInfo = m_InstanceBuffers[frameIndex]->descriptorBufferInfo();
+
+        if (m_InstanceSets[frameIndex] == VK_NULL_HANDLE)
+        {
+            VyDescriptorWriter{ *m_InstanceSetLayout, *VyContext::globalPool() }
+                .writeBuffer(0, &bufferInfo)
+            .build(m_InstanceSets[frameIndex]);
+        }
+        else
+        {
+            VyDescriptorWriter{ *m_InstanceSetLayout, *VyContext::globalPool() }
+                .writeBuffer(0, &bufferInfo)
+            .update(m_InstanceSets[frameIndex]);
+        }
+
+        VY_DEBUG_TAG("VyRenderSystem", "Instance buffer [{}] capacity: {}", frameIndex, capacity);
+    }
+
+
+    void VyRenderSystem::fillInstanceData(const VyFrameInfo& frameInfo, const VyRenderProxy& proxy, MaterialInstanceData& instance)
+    {
+        instance.ModelMatrix   = proxy.Matrix;
+        instance.NormalMatrix  = proxy.NormalMatrix;
+        instance.Color         = proxy.Color;
+        instance.MaterialIndex = VyMaterialSystem::kDefaultMaterial;
+
+        // Materials are registered by VyMaterialSystem::updateMaterials before the frame is rendered.
+        if (proxy.Material != VyRenderProxy::kNoMaterial && frameInfo.MaterialIndices)
+        {
+            instance.MaterialIndex = frameInfo.MaterialIndices[ proxy.Material ];
+        }
+    }
+
+
+    void VyRenderSystem::buildBatches(const VyFrameInfo& frameInfo, VyRenderQueue& queue)
+    {
+        const VyFrustum& frustum  = frameInfo.Camera.frustum();
+        const Mat4&      view     = frameInfo.Camera.view();
+        const float      farPlane = frameInfo.Camera.farPlane();
+
+        m_InstanceScratch.clear();
+        m_DrawItems      .clear();
+        m_Batches        .clear();
+
+        m_CullStats.reset();
+
+        // [ Gather ]
+        for (const VyRenderProxy& proxy : frameInfo.Packet.Objects)
+        {
+            const Mat4& modelMatrix = proxy.Matrix;
+
+            // [ Frustum Culling ]
+            if (!isMeshVisible(frustum, *proxy.Mesh, modelMatrix))
             {
-                push.ModelMatrix  = transform.matrix();
-                push.NormalMatrix = transform.normalMatrix();
+                m_CullStats.Culled++;
+
+                continue;
             }
 
-            // Optional material.
-            if (auto* material = frameInfo.Scene->registry().try_get<MaterialComponent>(entity))
+            m_CullStats.Visible++;
+
+            MaterialInstanceData instance{};
+
+            fillInstanceData(frameInfo, proxy, instance);
+
+            const Vec3 center = Vec3(modelMatrix * Vec4(proxy.Mesh->boundingSphere().Center, 1.0f));
+            const U16  depth  = VyRenderKey::quantizeDepth(VyRenderKey::viewDepth(view, center), farPlane);
+
+            m_DrawItems.push_back(DrawItem{
+                .Key      = (U64(queue.meshId(*proxy.Mesh)) << 16) | depth,
+                .Mesh     = proxy.Mesh.get(),
+                .Instance = static_cast<U32>(m_InstanceScratch.size())
+            });
+
+            m_InstanceScratch.push_back(instance);
+        }
+
+        m_InstanceCount = static_cast<U32>(m_DrawItems.size());
+
+        if (m_DrawItems.empty())
+        {
+            return;
+        }
+
+        // [ Sort ]
+        // The materials are bindless (looked up per instance), so instances only need to share the mesh.
+        // Within a mesh they are drawn front to back, so the nearer instances reject the fragments of the farther ones.
+        radixSort64(m_DrawItems, m_DrawItemScratch, [](const DrawItem& item) { return item.Key; });
+
+        // [ Upload ]
+        reserveInstances(frameInfo.FrameIndex, m_InstanceCount);
+
+        auto& instanceBuffer = *m_InstanceBuffers[ frameInfo.FrameIndex ];
+        auto* instances      = static_cast<MaterialInstanceData*>(instanceBuffer.mappedData());
+
+        for (U32 i = 0; i < m_InstanceCount; i++)
+        {
+            const DrawItem& item = m_DrawItems[i];
+
+            instances[i] = m_InstanceScratch[ item.Instance ];
+
+            // Start a new batch whenever the mesh changes, its first instance is the nearest.
+            if (m_Batches.empty() || m_Batches.back().Mesh != item.Mesh)
             {
-                if (material->Material)
-                {
-                    // Copy material data.
-                    const auto& matData = material->Material->getData();
-                    {
-                        push.Albedo           = matData.Albedo;
-                        push.Metallic         = matData.Metallic;
-                        push.Roughness        = matData.Roughness;
-                        push.AO               = matData.AO;
-                        push.TextureOffset    = matData.TextureOffset;
-                        push.TextureScale     = matData.TextureScale;
-                        
-                        push.EmissionColor    = matData.EmissionColor;
-                        push.EmissionStrength = matData.EmissionStrength;
-                    }
-                    
-                    // Bind material descriptor set ( 1 ). 
-                    VkDescriptorSet materialDescriptorSet = material->Material->descriptorSet();
-                    
-                    m_Pipeline->bindDescriptorSet(frameInfo.CommandBuffer, 1, materialDescriptorSet);
-                }
+                m_Batches.push_back(DrawBatch{
+                    .Mesh          = item.Mesh,
+                    .MeshId        = static_cast<U16>(item.Key >> 16),
+                    .Depth         = static_cast<U16>(item.Key),
+                    .FirstInstance = i,
+                    .InstanceCount = 0
+                });
             }
-            else {
-                // Optional color fallback.
-                if (auto* color = frameInfo.Scene->registry().try_get<ColorComponent>(entity))
-                {
-                    push.Albedo = color->Color;
-                }
 
-                // Default emission for non-material objects.
-                push.EmissionColor    = Vec3(0.0f);
-                push.EmissionStrength =      0.0f;
-            }
+            m_Batches.back().InstanceCount++;
+        }
 
-            // Push material constants data.
-            m_Pipeline->pushConstants(frameInfo.CommandBuffer, 
-                VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 
-                push
-            );
-            
-            // Bind and draw model data.
-            model.Model->bind(frameInfo.CommandBuffer);
-            model.Model->draw(frameInfo.CommandBuffer);
+        instanceBuffer.flush(sizeof(MaterialInstanceData) * m_InstanceCount, 0);
+    }
+
+
+    void VyRenderSystem::render(const VyFrameInfo& frameInfo) 
+    {
+        m_InlineQueue.clear();
+
+        submit(frameInfo, m_InlineQueue);
+
+        m_InlineQueue.sort();
+
+        VyCommandStats stats{};
+
+        m_InlineQueue.record(frameInfo, 0, m_InlineQueue.size(), stats);
+    }
+
+
+    void VyRenderSystem::submit(const VyFrameInfo& frameInfo, VyRenderQueue& queue)
+    {
+        buildBatches(frameInfo, queue);
+
+        m_BatchCount = static_cast<U32>(m_Batches.size());
+
+        const U16 pipeline = queue.pipelineId(activePipeline());
+
+        for (U32 i = 0; i < m_BatchCount; i++)
+        {
+            const DrawBatch& batch = m_Batches[i];
+
+            // Material 0: the materials are bindless, every batch shares the material set.
+            queue.submit(*this, VyRenderKey::make(ERenderLayer::Opaque, pipeline, 0, batch.MeshId, batch.Depth), i);
         }
     }
+
+
+    void VyRenderSystem::recordPacket(VyCommandContext& context, const VyFrameInfo& frameInfo, U32 payload) const
+    {
+        const DrawBatch& batch = m_Batches[ payload ];
+
+        const TArray<VkDescriptorSet, 3> sets{
+            frameInfo.GlobalDescriptorSet,          // Global ( 0 ).
+            frameInfo.MaterialDescriptorSet,        // Bindless Material ( 1 ).
+            m_InstanceSets[ frameInfo.FrameIndex ]  // Instance ( 2 ).
+        };
+
+        const VyPipeline& pipeline = activePipeline();
+
+        context.bindPipeline      (pipeline);
+        context.bindDescriptorSets(pipeline, 0, sets);
+
+        // Bind and draw model data.
+        batch.Mesh->bind(context);
+        batch.Mesh->draw(context.commandBuffer(), batch.InstanceCount, batch.FirstInstance);
+    }
+}
 }
 
 
@@ -130,6 +293,17 @@ namespace Vy
         int CascadeIndex{};
     };
 
+    /**
+     * @brief Direction of the first directional light of the frame, the one the (cascaded) shadow map is rendered from.
+     */
+    static Vec3 shadowLightDirection(const VyFrameInfo& frameInfo)
+    {
+        const auto& dirLights = frameInfo.Packet.DirectionalLights;
+
+        // Arbitrary without a directional light, the shadow map is not sampled then.
+        return dirLights.empty() ? glm::normalize(Vec3(0.5f, 1.0f, 0.25f)) : glm::normalize(dirLights[0].Transform.forward());
+    }
+
     // =====================================================================================================================
 
     SimpleRenderSystem::SimpleRenderSystem(VkRenderPass renderPass, TVector<VkDescriptorSetLayout> setLayouts, VyDescriptorPool& descriptorPool)
@@ -179,7 +353,7 @@ namespace Vy
 
     void SimpleRenderSystem::renderShadowPass(VyFrameInfo frameInfo, GlobalUBO& globalUBO)
     {
-        updateShadowPassBuffer(globalUBO);
+        updateShadowPassBuffer(shadowLightDirection(frameInfo));
 
         VkClearValue clearValues[2];
         {
@@ -217,13 +391,17 @@ namespace Vy
 
         m_ShadowPassPipeline->bind(frameInfo.CommandBuffer);
 
-        TVector<VkDescriptorSet> globSet = { frameInfo.GlobalDescriptorSet /*, m_ShadowPassDescriptorSet*/ };
+        const TArray<VkDescriptorSet, 1> globSet = { frameInfo.GlobalDescriptorSet /*, m_ShadowPassDescriptorSet*/ };
 
         m_ShadowPassPipeline->bindDescriptorSets(frameInfo.CommandBuffer, 0, globSet);
         
         // vkCmdBindDescriptorSets(frameInfo.CommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_ShadowPassPipelineLayout, 0, globSet.size(), globSet.data(), 0, nullptr);
 
-        renderGameObjects(frameInfo, m_ShadowPassPipeline->layout(), PushConstantType::MAIN, globSet.size(), false);
+        m_CullStats.Shadow.reset();
+
+        renderGameObjects(frameInfo, *m_ShadowPassPipeline, PushConstantType::MAIN, globSet.size(), 
+            VyFrustum::fromMatrix(m_ShadowPassUBO.LightProjection), m_CullStats.Shadow, false
+        );
 
         vkCmdEndRenderPass(frameInfo.CommandBuffer);
     }
@@ -232,7 +410,7 @@ namespace Vy
 
     void SimpleRenderSystem::renderCascadedShadowPass(VyFrameInfo frameInfo, GlobalUBO& globalUBO)
     {
-        updateCascades(globalUBO);
+        updateCascades(globalUBO, shadowLightDirection(frameInfo));
 
         m_CascadedShadowPassBuffer->writeToBuffer(&m_CascadedShadowPass.UBO);
         m_CascadedShadowPassBuffer->flush();
@@ -256,12 +434,14 @@ namespace Vy
         VKCmd::viewport(frameInfo.CommandBuffer, VkExtent2D{ m_CascadedShadowMapSize, m_CascadedShadowMapSize });
         VKCmd::scissor (frameInfo.CommandBuffer, VkExtent2D{ m_CascadedShadowMapSize, m_CascadedShadowMapSize });
 
-        TVector<VkDescriptorSet> globSet = { frameInfo.GlobalDescriptorSet, m_CascadedShadowPassDescriptorSet };
+        const TArray<VkDescriptorSet, 2> globSet = { frameInfo.GlobalDescriptorSet, m_CascadedShadowPassDescriptorSet };
 
         m_CascadedShadowPassPipeline->bindDescriptorSets(frameInfo.CommandBuffer, 0, globSet);
 
         // vkCmdBindDescriptorSets(frameInfo.CommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_CascadedShadowPassPipelineLayout, 0, globSet.size(), globSet.data(), 0, nullptr);
 
+        m_CullStats.CascadedShadow.reset();
+
         // One pass per cascade
         // The layer that this pass renders to is defined by the cascade's image view (selected via the cascade's descriptor set)
         for (U32 j = 0; j < CASCADE_SHADOW_MAP_COUNT; j++) 
@@ -274,7 +454,9 @@ namespace Vy
                 
                 m_CascadedShadowPassPipeline->bind(frameInfo.CommandBuffer);
                 
-                renderGameObjects(frameInfo, m_CascadedShadowPassPipeline->layout(), PushConstantType::CASCADEDSHADOW, globSet.size(), false);
+                renderGameObjects(frameInfo, *m_CascadedShadowPassPipeline, PushConstantType::CASCADEDSHADOW, globSet.size(), 
+                    VyFrustum::fromMatrix(m_CascadedShadowPass.UBO.ViewProjMatrices[j]), m_CullStats.CascadedShadow, false
+                );
             }
             vkCmdEndRenderPass(frameInfo.CommandBuffer);
         }
@@ -287,7 +469,11 @@ namespace Vy
         VKCmd::viewport(frameInfo.CommandBuffer, VkExtent2D{ m_PointShadowPass.Width, m_PointShadowPass.Height });
         VKCmd::scissor (frameInfo.CommandBuffer, VkExtent2D{ m_PointShadowPass.Width, m_PointShadowPass.Height });
 
-        for (U32 i = 0; i < globalUBO.NumPointLights; i++)
+        m_CullStats.PointShadow.reset();
+
+        const U32 pointLightCount = static_cast<U32>(std::min<size_t>(frameInfo.Packet.PointLights.size(), MAX_POINT_LIGHTS));
+
+        for (U32 i = 0; i < pointLightCount; i++)
         {
             m_PointLightCount = i;
             
@@ -309,7 +495,7 @@ namespace Vy
 
         m_MainPipeline->bind(frameInfo.CommandBuffer);
 
-        TVector<VkDescriptorSet> globSet = { 
+        const TArray<VkDescriptorSet, 5> globSet = { 
             frameInfo.GlobalDescriptorSet, 
             //m_ShadowPassDescriptorSet, m_ShadowMapDescriptorSet,
             m_CascadedShadowPassDescriptorSet, m_CascadedShadowMapDescriptorSet,
@@ -321,90 +507,85 @@ namespace Vy
 
         // vkCmdBindDescriptorSets(frameInfo.CommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_MainPipelineLayout, 0, globSet.size(), globSet.data(), 0, nullptr);
 
-        renderGameObjects(frameInfo, m_MainPipeline->layout(), PushConstantType::MAIN, globSet.size(), true);
+        m_CullStats.Main.reset();
+
+        renderGameObjects(frameInfo, *m_MainPipeline, PushConstantType::MAIN, globSet.size(), 
+            frameInfo.Camera.frustum(), m_CullStats.Main, true
+        );
     }
 
     // =====================================================================================================================
 
     void SimpleRenderSystem::renderGameObjects(
-        VyFrameInfo      frameInfo, 
-        VkPipelineLayout pipelineLayout, 
-        PushConstantType type, 
-        int              setCount, 
-        bool             bRenderMaterial)
+        VyFrameInfo       frameInfo, 
+        const VyPipeline& pipeline, 
+        PushConstantType  type, 
+        int               setCount, 
+        const VyFrustum&  frustum, 
+        VyCullStats&      cullStats, 
+        bool              bRenderMaterial)
     {
-        auto view = frameInfo.Scene->registry().view<ModelComponent, TransformComponent>();
-        
-        for (auto&& [ entity, model, transform ] : view.each())
+        // Consecutive entities often share the mesh, the context skips rebinding its buffers.
+        VyCommandContext context{ frameInfo.CommandBuffer };
+
+        for (const VyRenderProxy& proxy : frameInfo.Packet.Objects)
         {
+            const Mat4& modelMatrix = proxy.Matrix;
+
+            // Skip entities outside the frustum of the pass (camera or light).
+            if (!isMeshVisible(frustum, *proxy.Mesh, modelMatrix))
+            {
+                cullStats.Culled++;
+
+                continue;
+            }
+
+            cullStats.Visible++;
+
             if (type == PushConstantType::MAIN)
             {
                 MainPushConstantData data{};
                 {
-                    data.ModelMatrix  = transform.matrix();
-                    data.NormalMatrix = transform.normalMatrix();
+                    data.ModelMatrix  = modelMatrix;
+                    data.NormalMatrix = proxy.NormalMatrix;
                 }
 
-                vkCmdPushConstants(
-                    frameInfo.CommandBuffer,
-                    pipelineLayout,
-                    VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0,
-                    sizeof(data),
-                    &data
-                );
+                context.pushConstants(pipeline, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, data);
             }
             else if(type == PushConstantType::POINTSHADOW)
             {
                 PointShadowPassPushConstantData data{};
                 {
-                    data.ModelMatrix = transform.matrix();
+                    data.ModelMatrix = modelMatrix;
                     data.LightCount  = m_PointLightCount;
                     data.FaceCount   = m_FaceCount;
                 }
 
-                vkCmdPushConstants(
-                    frameInfo.CommandBuffer,
-                    pipelineLayout,
-                    VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0,
-                    sizeof(data),
-                    &data
-                );
+                context.pushConstants(pipeline, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, data);
             }
             else if (type == PushConstantType::SPOTSHADOW)
             {
                 SpotShadowPassPushConstantData data{};
                 {
-                    data.ModelMatrix = transform.matrix();
+                    data.ModelMatrix = modelMatrix;
                     data.LightCount  = m_SpotLightIndex;
                 }
 
-                vkCmdPushConstants(
-                    frameInfo.CommandBuffer,
-                    pipelineLayout,
-                    VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0,
-                    sizeof(data),
-                    &data
-                );
+                context.pushConstants(pipeline, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, data);
             }
             else if (type == PushConstantType::CASCADEDSHADOW)
             {
                 CascadedShadowPassPushConstantData data{};
                 {
-                    data.ModelMatrix  = transform.matrix();
+                    data.ModelMatrix  = modelMatrix;
                     data.CascadeIndex = m_CascadeIndex;
                 }
 
-                vkCmdPushConstants(
-                    frameInfo.CommandBuffer,
-                    pipelineLayout,
-                    VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0,
-                    sizeof(data),
-                    &data
-                );
+                context.pushConstants(pipeline, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, data);
             }
 
-            model.Model->bind(frameInfo.CommandBuffer);
-            model.Model->draw(frameInfo.CommandBuffer /*, pipelineLayout, setCount, bRenderMaterial */);
+            proxy.Mesh->bind(context);
+            proxy.Mesh->draw(frameInfo.CommandBuffer /*, pipelineLayout, setCount, bRenderMaterial */);
         }
     }
 
@@ -1004,10 +1185,10 @@ namespace Vy
 
     // =====================================================================================================================
 
-    void SimpleRenderSystem::updateShadowPassBuffer(GlobalUBO& globalUBO)
+    void SimpleRenderSystem::updateShadowPassBuffer(const Vec3& lightDirection)
     {
         Mat4 orthgonalProjection = glm::ortho(-30.0f, 30.0f, -30.0f, 30.0f, 0.1f, 100.0f);
-        Mat4 lightView = glm::lookAt(Vec3(-globalUBO.DirectionalLights[0].Direction), Vec3(0.0f, 0.0f, 0.0f), Vec3(0.0f, 1.0f, 0.0f));
+        Mat4 lightView = glm::lookAt(-lightDirection, Vec3(0.0f, 0.0f, 0.0f), Vec3(0.0f, 1.0f, 0.0f));
         
         m_ShadowPassUBO.LightProjection = orthgonalProjection * lightView;
 
@@ -1140,7 +1321,7 @@ namespace Vy
 
     // =====================================================================================================================
 
-    void SimpleRenderSystem::updateCascades(GlobalUBO& ubo)
+    void SimpleRenderSystem::updateCascades(GlobalUBO& ubo, const Vec3& lightDirection)
     {
         float cascadeSplits[CASCADE_SHADOW_MAP_COUNT];
 
@@ -1222,7 +1403,7 @@ namespace Vy
             Vec3 maxExtents = Vec3(radius);
             Vec3 minExtents = -maxExtents;
 
-            Vec3 lightDir         = glm::normalize(ubo.DirectionalLights[0].Direction);
+            Vec3 lightDir         = lightDirection;
             Mat4 lightViewMatrix  = glm::lookAt(frustumCenter - lightDir * -minExtents.z, frustumCenter, Vec3(0.0f, 1.0f, 0.0f));
             Mat4 lightOrthoMatrix = glm::ortho(minExtents.x, maxExtents.x, minExtents.y, maxExtents.y, 0.0f, maxExtents.z - minExtents.z);
 
@@ -1476,11 +1657,17 @@ namespace Vy
         {
             m_PointShadowPassPipeline->bind(frameInfo.CommandBuffer);
             
-            TVector<VkDescriptorSet> globSet = { frameInfo.GlobalDescriptorSet, m_PointShadowPassDescriptorSet };
+            const TArray<VkDescriptorSet, 2> globSet = { frameInfo.GlobalDescriptorSet, m_PointShadowPassDescriptorSet };
 
             m_PointShadowPassPipeline->bindDescriptorSets(frameInfo.CommandBuffer, 0, globSet);
             
-            renderGameObjects(frameInfo, m_PointShadowPassPipeline->layout(), PushConstantType::POINTSHADOW, globSet.size(), false);
+            // Face matrices are built around the origin, move the face frustum to the light.
+            Mat4 faceMatrix = m_PointShadowPassUBO.FaceViewMatrices[faceIndex] * 
+                glm::translate(Mat4(1.0f), -frameInfo.Packet.PointLights[m_PointLightCount].Transform.Translation);
+
+            renderGameObjects(frameInfo, *m_PointShadowPassPipeline, PushConstantType::POINTSHADOW, globSet.size(), 
+                VyFrustum::fromMatrix(faceMatrix), m_CullStats.PointShadow, false
+            );
         }
         vkCmdEndRenderPass(frameInfo.CommandBuffer);
     }
@@ -1720,12 +1907,12 @@ namespace Vy
 
     void SimpleRenderSystem::updateSpotShadowMaps(U32 lightIndex, VyFrameInfo frameInfo, GlobalUBO& ubo)
     {
-        ShadowPassUBO sUbo;
-        SpotLightUBO  light = ubo.SpotLights[lightIndex];
+        ShadowPassUBO           sUbo;
+        const VySpotLightProxy& light = frameInfo.Packet.SpotLights[lightIndex];
         Mat4 proj = glm::perspective(glm::radians(90.0f), 1.0f, 0.1f, 1000.0f);
         Mat4 view = glm::lookAt(
-            Vec3(light.Position.x, light.Position.y, light.Position.z), 
-            Vec3(light.Position.x, light.Position.y, light.Position.z) + Vec3(light.Direction.x, light.Direction.y, light.Direction.z), 
+            light.Transform.Translation, 
+            light.Transform.Translation + glm::normalize(light.Transform.forward()), 
             Vec3(0.0f, 0.0f, 1.0f)
         );
         
@@ -1756,12 +1943,14 @@ namespace Vy
         {
             m_SpotShadowPassPipeline->bind(frameInfo.CommandBuffer);
             
-            TVector<VkDescriptorSet> globSet = { frameInfo.GlobalDescriptorSet, m_SpotShadowPassDescriptorSet };
-            TVector<U32> dynamicOffset = { static_cast<U32>(lightIndex * m_SpotShadowPassBuffer->alignmentSize()) };
+            const TArray<VkDescriptorSet, 2> globSet       = { frameInfo.GlobalDescriptorSet, m_SpotShadowPassDescriptorSet };
+            const U32                        dynamicOffset = static_cast<U32>(lightIndex * m_SpotShadowPassBuffer->alignmentSize());
 
-            m_SpotShadowPassPipeline->bindDescriptorSets(frameInfo.CommandBuffer, 0, globSet, dynamicOffset.size(), dynamicOffset.data());
+            m_SpotShadowPassPipeline->bindDescriptorSets(frameInfo.CommandBuffer, 0, globSet, 1, &dynamicOffset);
             
-            renderGameObjects(frameInfo, m_SpotShadowPassPipeline->layout(), PushConstantType::SPOTSHADOW, globSet.size(), false);
+            renderGameObjects(frameInfo, *m_SpotShadowPassPipeline, PushConstantType::SPOTSHADOW, globSet.size(), 
+                VyFrustum::fromMatrix(sUbo.LightProjection), m_CullStats.SpotShadow, false
+            );
         }
         vkCmdEndRenderPass(frameInfo.CommandBuffer);
     }
@@ -1773,7 +1962,11 @@ namespace Vy
         VKCmd::viewport(frameInfo.CommandBuffer, VkExtent2D{ m_SpotShadowPass.Width, m_SpotShadowPass.Height });
         VKCmd::scissor (frameInfo.CommandBuffer, VkExtent2D{ m_SpotShadowPass.Width, m_SpotShadowPass.Height });
 
-        for (U32 i = 0; i < ubo.NumSpotLights; i++)
+        m_CullStats.SpotShadow.reset();
+
+        const U32 spotLightCount = static_cast<U32>(std::min<size_t>(frameInfo.Packet.SpotLights.size(), MAX_SPOT_LIGHTS));
+
+        for (U32 i = 0; i < spotLightCount; i++)
         {
             m_SpotLightIndex = i;
 
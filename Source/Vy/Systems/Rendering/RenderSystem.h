@@ -9,6 +9,15 @@
 
 namespace Vy 
 {
+    /**
+     * @brief Draws all entities with a ModelComponent using the material pipeline.
+     * 
+     * Entities outside the camera frustum are culled using the world space bounds of their mesh.
+     * The remaining entities are grouped by mesh. The per-instance matrices and material indices of every entity
+     * are written into a per-frame storage buffer (set 2), front to back within a group, and each group is drawn with a
+     * single instanced draw call.
+     * The material parameters and textures are read from the bindless material set (set 1), bound once per pass.
+     */
     class VyRenderSystem : public IRenderSystem
     {
     public:
@@ -24,10 +33,109 @@ namespace Vy
         
         virtual void render(const VyFrameInfo& frameInfo) override;
 
+        /**
+         * @brief Culls and batches the entities and submits one opaque packet per batch.
+         * 
+         * The key holds the mesh and the depth of the nearest instance of the batch, the payload the batch index.
+         */
+        virtual void submit(const VyFrameInfo& frameInfo, VyRenderQueue& queue) override;
+
+        /**
+         * @brief Draws a batch, with the pipeline, its sets and the mesh bound through the context.
+         */
+        virtual void recordPacket(VyCommandContext& context, const VyFrameInfo& frameInfo, U32 payload) const override;
+
         void createPipeline(VkRenderPass& renderPass, TVector<VkDescriptorSetLayout> descSetLayouts);
 
+        /**
+         * @brief Creates the pipeline that writes the G-buffer in the geometry subpass of the deferred path.
+         * 
+         * @see VyDeferredRenderSystem
+         */
+        void createGBufferPipeline(VkRenderPass renderPass, U32 subpass, TVector<VkDescriptorSetLayout> descSetLayouts);
+
+        /**
+         * @brief Draws into the G-buffer of the deferred path instead of shading (off by default).
+         */
+        void setGBufferPass(bool bEnabled) { m_bGBufferPass = bEnabled; }
+
+        /**
+         * @brief Number of instanced draw calls of the last `render` or `submit` call.
+         */
+        VY_NODISCARD U32 batchCount() const { return m_BatchCount; }
+
+        /**
+         * @brief Number of instances (entities) drawn by the last `render` or `submit` call.
+         */
+        VY_NODISCARD U32 instanceCount() const { return m_InstanceCount; }
+
+        /**
+         * @brief Visible / frustum culled entity counts of the last `render` or `submit` call.
+         */
+        VY_NODISCARD const VyCullStats& cullStats() const { return m_CullStats; }
+
+        /**
+         * @brief Fills the per-instance data (matrices and material index) of a render proxy.
+         * 
+         * Proxies without a material use the default material, tinted by their color.
+         */
+        static void fillInstanceData(const VyFrameInfo& frameInfo, const VyRenderProxy& proxy, MaterialInstanceData& instance);
+
     private:
-        Unique<VyPipeline> m_Pipeline;
+        /**
+         * @brief Pipeline the batches are drawn with, the material or the G-buffer one.
+         */
+        const VyPipeline& activePipeline() const { return m_bGBufferPass ? *m_GBufferPipeline : *m_Pipeline; }
+
+        /**
+         * @brief Groups the renderable entities by mesh, sorts each group front to back and fills the frame's instance buffer.
+         */
+        void buildBatches(const VyFrameInfo& frameInfo, VyRenderQueue& queue);
+
+        /**
+         * @brief Grows the instance buffer of a frame so it can hold at least `instanceCount` instances.
+         */
+        void reserveInstances(int frameIndex, U32 instanceCount);
+
+        struct DrawItem
+        {
+            U64           Key;      // Mesh id (16) | depth (16).
+            VyStaticMesh* Mesh;
+            U32           Instance; // Index into m_InstanceScratch.
+        };
+
+        struct DrawBatch
+        {
+            VyStaticMesh* Mesh;
+            U16           MeshId;
+            U16           Depth;    // Quantized depth of the nearest instance.
+            U32           FirstInstance;
+            U32           InstanceCount;
+        };
+
+        static constexpr U32 kInitialInstanceCapacity = 1024;
+
+        Unique<VyPipeline>                             m_Pipeline;
+        Unique<VyPipeline>                             m_GBufferPipeline;
+        bool                                           m_bGBufferPass{ false };
+
+        Unique<VyDescriptorSetLayout>                  m_InstanceSetLayout;
+        TArray<Unique<VyBuffer>, MAX_FRAMES_IN_FLIGHT> m_InstanceBuffers;
+        TArray<VkDescriptorSet,  MAX_FRAMES_IN_FLIGHT> m_InstanceSets{};
+        TArray<U32,              MAX_FRAMES_IN_FLIGHT> m_InstanceCapacity{};
+
+        // Scratch storage reused between frames to avoid per-frame allocations.
+        TVector<MaterialInstanceData> m_InstanceScratch;
+        TVector<DrawItem>             m_DrawItems;
+        TVector<DrawItem>             m_DrawItemScratch;
+        TVector<DrawBatch>            m_Batches;
+
+        VyRenderQueue                 m_InlineQueue; // Used by `render`, which records without the pass' queue.
+
+        U32 m_BatchCount   { 0 };
+        U32 m_InstanceCount{ 0 };
+
+        VyCullStats m_CullStats{};
     };
 }
 
@@ -139,6 +247,18 @@ namespace Vy
             TArray<Mat4, MAX_SPOT_LIGHTS> LightProjections;
         };
 
+        /**
+         * @brief Visible / culled entity counts of each pass, accumulated over all lights, faces and cascades of the pass.
+         */
+        struct PassCullStats
+        {
+            VyCullStats Main;
+            VyCullStats Shadow;
+            VyCullStats CascadedShadow;
+            VyCullStats PointShadow;
+            VyCullStats SpotShadow;
+        };
+
 
         SimpleRenderSystem(
             VkRenderPass                   renderPass, 
@@ -157,7 +277,17 @@ namespace Vy
         void renderSpotShadowPass(VyFrameInfo frameInfo, GlobalUBO& globalUBO);
         void renderMainPass(VyFrameInfo frameInfo);
 
-        void renderGameObjects(VyFrameInfo frameInfo, VkPipelineLayout pipelineLayout, PushConstantType type, int setCount, bool bRenderMaterial = true);
+        void renderGameObjects(
+            VyFrameInfo       frameInfo, 
+            const VyPipeline& pipeline, 
+            PushConstantType  type, 
+            int               setCount, 
+            const VyFrustum&  frustum, 
+            VyCullStats&      cullStats, 
+            bool              bRenderMaterial = true
+        );
+
+        const PassCullStats& cullStats() const { return m_CullStats; }
 
     private:
 
@@ -175,10 +305,10 @@ namespace Vy
 
         void prepareShadowPassRenderpass();
         void prepareShadowPassFramebuffer();
-        void updateShadowPassBuffer(GlobalUBO& globalUBO);
+        void updateShadowPassBuffer(const Vec3& lightDirection);
 
         void prepareCascadeShadowPass();
-        void updateCascades(GlobalUBO& ubo);
+        void updateCascades(GlobalUBO& ubo, const Vec3& lightDirection);
 
         void preparePointShadowCubeMaps();
         void preparePointShadowPassRenderPass();
@@ -275,5 +405,7 @@ namespace Vy
         SpotShadowPass   m_SpotShadowPass{};
 
         int m_SpotLightIndex = 0;
+
+        PassCullStats m_CullStats{};
     };
 }
\ No newline at end of file
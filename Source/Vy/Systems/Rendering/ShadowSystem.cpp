@@ -1,8 +1,15 @@
 #include <Vy/Systems/Rendering/ShadowSystem.h>
 
+#include <Vy/Systems/Rendering/ClusteredLightSystem.h>
+
 #include <Vy/GFX/Context.h>
 #include <Vy/Globals.h>
 
+#include <VyLib/Util/Hash.h>
+
+#include <algorithm>
+#include <numeric>
+
 namespace Vy
 {
     struct ShadowPushConstants
@@ -14,37 +21,115 @@ namespace Vy
     struct CubeShadowPushConstants
     {
         Mat4 ModelMatrix;
-        Mat4 LightSpaceMatrix;
         Vec4 LightPosAndFarPlane; // xyz = light position, w = far plane
+        Vec4 Projection;          // Non-zero terms of the face projection: [0][0], [1][1], [2][2], [3][2]
+        U32  FaceMask;            // Bit i set if the caster overlaps face i.
     };
 
     // =====================================================================================================================
 
-    VyShadowSystem::VyShadowSystem(U32 shadowMapSize) : 
-        m_ShadowMapSize{ shadowMapSize }
+    template <typename BeginPass, typename RecordDraws>
+    void VyShadowSystem::recordShadowPass(
+        VyFrameInfo&           frameInfo, 
+        const VyRecordingPass& pass, 
+        U32                    itemCount, 
+        BeginPass&&            beginPass, 
+        RecordDraws&&          recordDraws)
     {
-        // Create multiple shadow maps for directional/spot lights.
-        for (int i = 0; i < MAX_SHADOW_MAPS; i++)
+        if (!m_Recorder)
         {
-            m_ShadowMaps.push_back( MakeUnique<VyShadowMap>(shadowMapSize, shadowMapSize) );
+            beginPass(VK_SUBPASS_CONTENTS_INLINE);
+
+            recordDraws(frameInfo.CommandBuffer, 0, itemCount);
+
+            return;
+        }
 
-            m_LightSpaceMatrices[i] = Mat4(1.0f);
+        m_SecondaryBuffers.clear();
+
+        // The secondaries only reference the render pass, they can be recorded before it begins.
+        m_Recorder->record(frameInfo.FrameIndex, pass, itemCount, kMinObjectsPerChunk, m_SecondaryBuffers, 
+            [&](VkCommandBuffer commandBuffer, U32 chunk, U32 first, U32 last)
+            {
+                recordDraws(commandBuffer, first, last);
+            }
+        );
+
+        beginPass(VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+
+        if (!m_SecondaryBuffers.empty())
+        {
+            vkCmdExecuteCommands(frameInfo.CommandBuffer, static_cast<U32>(m_SecondaryBuffers.size()), m_SecondaryBuffers.data());
         }
+    }
+
+
+    template <typename InBounds>
+    void VyShadowSystem::gatherCasters(const VyFramePacket& packet, ShadowSlot& slot, VyCullStats& cullStats, InBounds&& inBounds)
+    {
+        slot.StaticCasters .clear();
+        slot.DynamicCasters.clear();
+
+        size_t staticHash  = 0;
+        size_t dynamicHash = 0;
+
+        for (U32 i = 0; i < static_cast<U32>(packet.Objects.size()); i++)
+        {
+            const VyRenderProxy& proxy = packet.Objects[i];
+
+            if (!inBounds(proxy))
+            {
+                cullStats.Culled++;
+
+                continue;
+            }
+
+            cullStats.Visible++;
+
+            // The version changes whenever the caster moves, the mesh when it is swapped.
+            if (m_bStaticCaster[i])
+            {
+                slot.StaticCasters.push_back(i);
+
+                Hash::hashCombine(staticHash, proxy.Entity, proxy.Version, proxy.Mesh.get());
+            }
+            else
+            {
+                slot.DynamicCasters.push_back(i);
+
+                Hash::hashCombine(dynamicHash, proxy.Entity, proxy.Version, proxy.Mesh.get());
+            }
+        }
+
+        slot.Requested.StaticHash  = staticHash;
+        slot.Requested.DynamicHash = dynamicHash;
+    }
 
-        // Create cube shadow maps for point lights.
+    // =====================================================================================================================
+
+    VyShadowSystem::VyShadowSystem(U32 shadowMapSize) : 
+        m_ShadowMapSize{ shadowMapSize }
+    {
+        // One atlas for the directional/spot lights, room for four tiles of the full size. One layer for the
+        // static casters and one for the dynamic ones.
+        m_Atlas = MakeUnique<VyShadowAtlas>(shadowMapSize * 2, std::min(kMinTileSize, shadowMapSize), kDynamicLayer + 1);
+
+        // Create cube shadow maps for point lights, one per layer.
         for (int i = 0; i < MAX_CUBE_SHADOW_MAPS; i++)
         {
-            m_CubeShadowMaps.push_back( MakeUnique<VyCubeShadowMap>(shadowMapSize) );
+            m_CubeShadowMaps      .push_back( MakeUnique<VyCubeShadowMap>(shadowMapSize) );
+            m_StaticCubeShadowMaps.push_back( MakeUnique<VyCubeShadowMap>(shadowMapSize) );
 
-            m_PointLightPositions[i] = Vec3(0.0f);
-            m_PointLightRanges   [i] = 25.0f;
+            m_CubeSlots[i].Cached.PositionAndRange = Vec4(0.0f, 0.0f, 0.0f, 25.0f);
         }
 
-        createPipeline();
-        createCubeShadowPipeline();
+        for (auto& buffer : m_ShadowBuffers)
+        {
+            buffer = MakeUnique<VyBuffer>( VyBuffer::storageBuffer(sizeof(ShadowData) * kShadowCount) );
+        }
 
-        VY_INFO_TAG("VyShadowSystem", "Initialized with {0} 2D shadow maps and {1} cube shadow maps ({2}x{3})",
-            MAX_SHADOW_MAPS, MAX_CUBE_SHADOW_MAPS, shadowMapSize, shadowMapSize
+        VY_INFO_TAG("VyShadowSystem", "Initialized with a {0}x{0} shadow atlas and {1} cube shadow maps ({2}x{2})",
+            m_Atlas->size(), MAX_CUBE_SHADOW_MAPS, shadowMapSize
         );
     }
 
@@ -55,6 +140,13 @@ namespace Vy
 
     // =====================================================================================================================
 
+    void VyShadowSystem::createPipelines()
+    {
+        createPipeline();
+        createCubeShadowPipeline();
+    }
+
+
     void VyShadowSystem::createPipeline()
     {
         // Only need position for shadow mapping.
@@ -73,8 +165,8 @@ namespace Vy
             // No color attachment - depth only
             .setDepthAttachment(VK_FORMAT_D32_SFLOAT)
 
-            // Use the render pass from the first shadow map (all are identical)
-            .setRenderPass(m_ShadowMaps[0]->renderPass())
+            // Every tile is rendered with the atlas render pass
+            .setRenderPass(m_Atlas->renderPass())
 
         .buildUnique();
     }
@@ -150,59 +242,214 @@ namespace Vy
 
     // =====================================================================================================================
 
-    void VyShadowSystem::renderToShadowMap(VyFrameInfo& frameInfo, VyShadowMap& shadowMap, const Mat4& lightSpaceMatrix)
+    void VyShadowSystem::renderToShadowMap(
+        VyFrameInfo&             frameInfo, 
+        const VyShadowAtlasTile& tile, 
+        U32                      layer, 
+        const Mat4&              lightSpaceMatrix, 
+        const TVector<U32>&      casters)
+    {
+        const VyRecordingPass pass{
+            .RenderPass  = m_Atlas->renderPass(),
+            .Framebuffer = m_Atlas->framebuffer(layer),
+            .Extent      = tile.rect().extent,
+            .Offset      = tile.rect().offset
+        };
+
+        recordShadowPass(frameInfo, pass, static_cast<U32>(casters.size()),
+            [&](VkSubpassContents contents)
+            {
+                // Begin shadow render pass over the tile.
+                m_Atlas->beginRenderPass(frameInfo.CommandBuffer, tile, layer, contents);
+            },
+            [&](VkCommandBuffer commandBuffer, U32 first, U32 last)
+            {
+                // Bind shadow pipeline.
+                m_Pipeline->bind(commandBuffer);
+
+                // The casters were culled against the light frustum when they were gathered.
+                for (U32 i = first; i < last; i++)
+                {
+                    const VyRenderProxy& proxy = frameInfo.Packet.Objects[ casters[i] ];
+
+                    ShadowPushConstants push{};
+                    {
+                        push.ModelMatrix      = proxy.Matrix;
+                        push.LightSpaceMatrix = lightSpaceMatrix;
+                    }
+
+                    m_Pipeline->pushConstants(commandBuffer, VK_SHADER_STAGE_VERTEX_BIT, push);
+
+                    proxy.Mesh->bind(commandBuffer);
+                    proxy.Mesh->draw(commandBuffer);
+                }
+            }
+        );
+
+        // End shadow render pass.
+        m_Atlas->endRenderPass(frameInfo.CommandBuffer);
+    }
+
+    // =====================================================================================================================
+
+    U32 VyShadowSystem::tileSizeFor(float screenCoverage) const
+    {
+        // One tier down for every halving of the coverage, a light filling the screen gets the full size.
+        const float tier = glm::floor(-glm::log2(glm::clamp(screenCoverage, 1e-4f, 1.0f)));
+
+        return std::max(m_ShadowMapSize >> static_cast<U32>(tier), std::min(kMinTileSize, m_ShadowMapSize));
+    }
+
+
+    float VyShadowSystem::screenCoverage(const VyCamera& camera, const Vec3& center, float radius)
     {
-        // Begin shadow render pass.
-        shadowMap.beginRenderPass(frameInfo.CommandBuffer);
+        const float distance    = glm::distance(camera.position(), center);
+        const float tanHalfFovY = glm::tan(glm::radians(camera.fovYDegrees()) * 0.5f);
+
+        return distance > radius ? radius / (distance * tanHalfFovY) : 1.0f;
+    }
+
+    // =====================================================================================================================
+
+    void VyShadowSystem::updateCasterHistory(const VyFramePacket& packet)
+    {
+        const U64 frame = packet.FrameNumber;
+
+        m_bStaticCaster.resize(packet.Objects.size());
+
+        for (size_t i = 0; i < packet.Objects.size(); i++)
         {
-            // Bind shadow pipeline.
-            m_Pipeline->bind(frameInfo.CommandBuffer);
+            const VyRenderProxy& proxy = packet.Objects[i];
 
-            // Render all objects to shadow map.
-            auto view = frameInfo.Scene->registry().view<ModelComponent, TransformComponent>();
-            
-            for (auto&& [entity, modelComp, transform] : view.each())
+            auto [ it, bInserted ] = m_CasterHistory.try_emplace(proxy.Entity, CasterHistory{ proxy.Version, frame, frame });
+
+            CasterHistory& history = it->second;
+
+            if (history.Version != proxy.Version)
+            {
+                history.Version   = proxy.Version;
+                history.LastMoved = frame;
+            }
+
+            history.LastSeen = frame;
+
+            m_bStaticCaster[i] = frame - history.LastMoved >= kStaticFrames;
+        }
+
+        // Forget destroyed entities.
+        std::erase_if(m_CasterHistory, [frame](const auto& entry)
+        {
+            return entry.second.LastSeen != frame;
+        });
+    }
+
+    // =====================================================================================================================
+
+    void VyShadowSystem::allocateShadowTiles()
+    {
+        // Tiles are kept from frame to frame so the cached shadows stay valid. Free those of lights that are gone
+        // or want another size.
+        for (int i = 0; i < MAX_SHADOW_MAPS; i++)
+        {
+            VyShadowAtlasTile& tile = m_ShadowSlots[i].Requested.Tile;
+
+            if (tile.valid() && (i >= m_ShadowLightCount || tile.Size != m_ShadowSlots[i].TileSize))
             {
-                if (!modelComp.Model) continue;
+                m_Atlas->free(tile);
+
+                tile = VyShadowAtlasTile{};
+            }
+        }
 
-                ShadowPushConstants push{};
+        auto allocateMissing = [&]()
+        {
+            // Largest first so the quadtree packs without holes. Equal sizes keep the light order, so repacking
+            // the same lights gives the same tiles.
+            int order[MAX_SHADOW_MAPS];
+
+            std::iota(order, order + m_ShadowLightCount, 0);
+            std::stable_sort(order, order + m_ShadowLightCount, [&](int a, int b)
+            {
+                return m_ShadowSlots[a].TileSize > m_ShadowSlots[b].TileSize;
+            });
+
+            bool bAllFit = true;
+
+            for (int i = 0; i < m_ShadowLightCount; i++)
+            {
+                VyShadowAtlasTile& tile = m_ShadowSlots[ order[i] ].Requested.Tile;
+
+                // Shrink the light until it fits.
+                for (U32 size = m_ShadowSlots[ order[i] ].TileSize; !tile.valid() && size >= m_Atlas->minTileSize(); size /= 2)
                 {
-                    push.ModelMatrix      = transform.matrix();
-                    push.LightSpaceMatrix = lightSpaceMatrix;
+                    tile = m_Atlas->allocate(size);
                 }
 
-                m_Pipeline->pushConstants(frameInfo.CommandBuffer, 
-                    VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 
-                    &push
-                );
+                bAllFit &= tile.valid();
+            }
+
+            return bAllFit;
+        };
 
-                modelComp.Model->bind(frameInfo.CommandBuffer);
-                modelComp.Model->draw(frameInfo.CommandBuffer);
+        if (!allocateMissing())
+        {
+            // Full or fragmented, repack every light from an empty atlas.
+            m_Atlas->reset();
+
+            for (ShadowSlot& slot : m_ShadowSlots)
+            {
+                slot.Requested.Tile = VyShadowAtlasTile{};
+            }
+
+            if (!allocateMissing() && !m_bWarnedAtlasFull)
+            {
+                VY_WARN_TAG("VyShadowSystem", "Shadow atlas is full, some of the {} shadow lights have no shadow", m_ShadowLightCount);
+
+                m_bWarnedAtlasFull = true;
             }
         }
-        // End shadow render pass.
-        shadowMap.endRenderPass(frameInfo.CommandBuffer);
+
+        for (int i = 0; i < m_ShadowLightCount; i++)
+        {
+            m_ShadowSlots[i].Requested.bValid = m_ShadowSlots[i].Requested.Tile.valid();
+        }
     }
 
     // =====================================================================================================================
 
-    void VyShadowSystem::renderShadowMaps(VyFrameInfo& frameInfo, float sceneRadius)
+    void VyShadowSystem::update(VyFrameInfo& frameInfo, float sceneRadius)
     {
-        m_ShadowLightCount = 0;
-        Vec3 sceneCenter   = Vec3(0.0f);
+        const VyFramePacket& packet = frameInfo.Packet;
+
+        m_ShadowLightCount     = 0;
+        m_CubeShadowLightCount = 0;
+        Vec3 sceneCenter       = Vec3(0.0f);
+
+        m_DirectionalShadowIndex = kNoShadow;
+        m_SpotShadowIndices .assign(packet.SpotLights .size(), kNoShadow);
+        m_PointShadowIndices.assign(packet.PointLights.size(), kNoShadow);
+
+        m_ShadowCullStats    .reset();
+        m_CubeShadowCullStats.reset();
 
-        // Render shadow map for first directional light.
-        auto dirView = frameInfo.Scene->registry().view<DirectionalLightComponent, TransformComponent>();
-        
-        for (auto&& [entity, dirLight, transform] : dirView.each())
+        updateCasterHistory(packet);
+
+        // Shadow map for first directional light.
+        for (const VyDirectionalLightProxy& dirLight : packet.DirectionalLights)
         {
             if (m_ShadowLightCount >= MAX_SHADOW_MAPS) break;
 
-            Vec3 lightDir = transform.forward();
+            ShadowSlot& slot = m_ShadowSlots[m_ShadowLightCount];
 
-            m_LightSpaceMatrices[m_ShadowLightCount] = calculateDirectionalLightMatrix(lightDir, sceneCenter, sceneRadius);
-            
-            renderToShadowMap(frameInfo, *m_ShadowMaps[m_ShadowLightCount], m_LightSpaceMatrices[m_ShadowLightCount]);
+            Vec3 lightDir = dirLight.Transform.forward();
+
+            slot.Requested.Matrix = calculateDirectionalLightMatrix(lightDir, sceneCenter, sceneRadius);
+
+            // Covers the whole scene, always the largest tile.
+            slot.Importance = 1.0f;
+            slot.TileSize   = m_ShadowMapSize;
+
+            m_DirectionalShadowIndex = static_cast<U32>(m_ShadowLightCount);
 
             m_ShadowLightCount++;
 
@@ -211,28 +458,297 @@ namespace Vy
             break;
         }
 
-        // Render shadow maps for spotlights.
-        auto spotView = frameInfo.Scene->registry().view<SpotLightComponent, TransformComponent>();
-        
-        for (auto&& [entity, spotLight, transform] : spotView.each())
+        // Shadow maps for spotlights.
+        for (size_t spot = 0; spot < packet.SpotLights.size(); spot++)
         {
             if (m_ShadowLightCount >= MAX_SHADOW_MAPS) break;
 
-            Vec3 position  = transform.Translation;
-            Vec3 direction = transform.forward();
+            const VySpotLightProxy& spotLight = packet.SpotLights[spot];
 
-            float outerCutoffDegrees = spotLight.OuterCutoffAngle;
-            float range              = 50.0f;
+            // The shadow reaches as far as the light, lights without a range are not shaded at all.
+            const float range = VyClusteredLightSystem::lightRange(spotLight.Light.Color, spotLight.Light.Intensity, spotLight.Light.Range);
+
+            if (range <= 0.0f)
+            {
+                continue;
+            }
+
+            ShadowSlot& slot = m_ShadowSlots[m_ShadowLightCount];
+
+            Vec3 position  = spotLight.Transform.Translation;
+            Vec3 direction = spotLight.Transform.forward();
+
+            float outerCutoffDegrees = spotLight.Light.OuterCutoffAngle;
+
+            slot.Requested.Matrix = calculateSpotLightMatrix(position, direction, outerCutoffDegrees, range);
+
+            // Importance: the cone's bounding sphere on screen.
+            const float cosAngle = glm::cos(glm::radians(outerCutoffDegrees));
+            const float radius   = range * 0.5f / std::max(cosAngle * cosAngle, 0.5f);
+            const Vec3  center   = position + glm::normalize(direction) * (range * 0.5f);
+
+            slot.Importance = screenCoverage(frameInfo.Camera, center, radius);
+            slot.TileSize   = tileSizeFor(slot.Importance);
+
+            m_SpotShadowIndices[spot] = static_cast<U32>(m_ShadowLightCount);
 
-            m_LightSpaceMatrices[m_ShadowLightCount] = calculateSpotLightMatrix(position, direction, outerCutoffDegrees, range);
-            
-            renderToShadowMap(frameInfo, *m_ShadowMaps[m_ShadowLightCount], m_LightSpaceMatrices[m_ShadowLightCount]);
-            
             m_ShadowLightCount++;
         }
 
-        // Render cube shadow maps for point lights.
-        renderPointLightShadowMaps(frameInfo);
+        allocateShadowTiles();
+
+        for (int i = 0; i < m_ShadowLightCount; i++)
+        {
+            ShadowSlot& slot = m_ShadowSlots[i];
+
+            if (!slot.Requested.bValid)
+            {
+                continue;
+            }
+
+            const VyFrustum lightFrustum = VyFrustum::fromMatrix(slot.Requested.Matrix);
+
+            gatherCasters(packet, slot, m_ShadowCullStats, [&](const VyRenderProxy& proxy)
+            {
+                return isMeshVisible(lightFrustum, *proxy.Mesh, proxy.Matrix);
+            });
+        }
+
+        // Cube shadow maps for point lights.
+        for (size_t point = 0; point < packet.PointLights.size(); point++)
+        {
+            if (m_CubeShadowLightCount >= MAX_CUBE_SHADOW_MAPS) break;
+
+            const VyPointLightProxy& pointLight = packet.PointLights[point];
+
+            // The far plane of the cube map is the light's range, so every lit fragment can be shadowed.
+            const float range = VyClusteredLightSystem::lightRange(pointLight.Light.Color, pointLight.Light.Intensity, pointLight.Light.Range);
+
+            if (range <= 0.0f)
+            {
+                continue;
+            }
+
+            ShadowSlot& slot = m_CubeSlots[m_CubeShadowLightCount];
+
+            Vec3 position = pointLight.Transform.Translation;
+
+            slot.Requested.PositionAndRange = Vec4(position, range);
+            slot.Requested.bValid           = true;
+
+            slot.Importance = screenCoverage(frameInfo.Camera, position, range);
+
+            gatherCasters(packet, slot, m_CubeShadowCullStats, [&](const VyRenderProxy& proxy)
+            {
+                const VyBoundingSphere bounds = proxy.Mesh->boundingSphere().transformed(proxy.Matrix);
+
+                return glm::distance(bounds.Center, position) <= bounds.Radius + range;
+            });
+
+            m_PointShadowIndices[point] = static_cast<U32>(MAX_SHADOW_MAPS + m_CubeShadowLightCount);
+
+            m_CubeShadowLightCount++;
+        }
+
+        // The slots of lights gone since the last frame, their tiles may be handed to other lights.
+        for (int i = m_ShadowLightCount; i < MAX_SHADOW_MAPS; i++)
+        {
+            m_ShadowSlots[i].Cached.bValid = false;
+        }
+
+        for (int i = m_CubeShadowLightCount; i < MAX_CUBE_SHADOW_MAPS; i++)
+        {
+            m_CubeSlots[i].Cached.bValid = false;
+        }
+
+        scheduleUpdates(frameInfo);
+
+        writeShadowData(frameInfo.FrameIndex);
+    }
+
+
+    U32 VyShadowSystem::shadowIndex(ELightType type, size_t index) const
+    {
+        switch (type)
+        {
+            case LightType_Directional: return index == 0                         ? m_DirectionalShadowIndex     : kNoShadow;
+            case LightType_Spot:        return index <  m_SpotShadowIndices .size() ? m_SpotShadowIndices [index] : kNoShadow;
+            case LightType_Point:       return index <  m_PointShadowIndices.size() ? m_PointShadowIndices[index] : kNoShadow;
+        }
+
+        return kNoShadow;
+    }
+
+
+    void VyShadowSystem::writeShadowData(int frameIndex)
+    {
+        TArray<ShadowData, kShadowCount> shadows{};
+
+        // The shadows as they were last rendered, a light deferred by the budget keeps its old matrix and position.
+        for (int i = 0; i < m_ShadowLightCount; i++)
+        {
+            const ShadowState& cached = m_ShadowSlots[i].Cached;
+
+            if (cached.bValid)
+            {
+                shadows[i].LightSpaceMatrix = cached.Matrix;
+                shadows[i].UVRect           = m_Atlas->uvRect(cached.Tile);
+                shadows[i].Valid            = 1;
+            }
+        }
+
+        for (int i = 0; i < m_CubeShadowLightCount; i++)
+        {
+            const ShadowState& cached = m_CubeSlots[i].Cached;
+
+            if (cached.bValid)
+            {
+                ShadowData& shadow = shadows[ MAX_SHADOW_MAPS + i ];
+
+                shadow.PositionAndRange = cached.PositionAndRange;
+                shadow.CubeIndex        = static_cast<U32>(i);
+                shadow.Valid            = 1;
+            }
+        }
+
+        m_ShadowBuffers[ frameIndex ]->write(shadows.data(), sizeof(ShadowData) * kShadowCount, 0);
+    }
+
+    // =====================================================================================================================
+
+    void VyShadowSystem::scheduleUpdates(const VyFrameInfo& frameInfo)
+    {
+        TArray<ShadowUpdate, kShadowCount> updates;
+
+        U32 updateCount = 0;
+
+        const U64 frame = frameInfo.Packet.FrameNumber;
+
+        auto schedule = [&](ShadowSlot& slot, int index, bool bCube)
+        {
+            const ShadowState& cached    = slot.Cached;
+            const ShadowState& requested = slot.Requested;
+
+            if (!requested.bValid)
+            {
+                // No tile this frame, the old one may belong to another light now.
+                slot.Cached.bValid = false;
+
+                return;
+            }
+
+            // A moved light or tile invalidates both layers.
+            const bool bLightChanged = 
+                !cached.bValid                                       || 
+                cached.Tile             != requested.Tile             || 
+                cached.Matrix           != requested.Matrix           || 
+                cached.PositionAndRange != requested.PositionAndRange;
+
+            ShadowUpdate update{};
+            {
+                update.Slot      = index;
+                update.bCube     = bCube;
+                update.bStatic   = bLightChanged || cached.StaticHash  != requested.StaticHash;
+                update.bDynamic  = bLightChanged || cached.DynamicHash != requested.DynamicHash;
+                update.bRequired = !cached.bValid || cached.Tile != requested.Tile;
+
+                // Grows every frame a light waits, so distant lights get their turn.
+                update.Priority  = slot.Importance * static_cast<float>(frame - slot.LastUpdate);
+            }
+
+            if (update.bStatic || update.bDynamic)
+            {
+                updates[ updateCount++ ] = update;
+            }
+        };
+
+        for (int i = 0; i < m_ShadowLightCount; i++)
+        {
+            schedule(m_ShadowSlots[i], i, false);
+        }
+
+        for (int i = 0; i < m_CubeShadowLightCount; i++)
+        {
+            schedule(m_CubeSlots[i], i, true);
+        }
+
+        std::sort(updates.begin(), updates.begin() + updateCount, [](const ShadowUpdate& a, const ShadowUpdate& b)
+        {
+            return a.bRequired != b.bRequired ? a.bRequired : a.Priority > b.Priority;
+        });
+
+        m_UpdateCount      = 0;
+        m_UpdatedViewCount = 0;
+
+        for (U32 i = 0; i < updateCount; i++)
+        {
+            const ShadowUpdate& update = updates[i];
+
+            const U32 cost = (update.bCube ? 6 : 1) * (static_cast<U32>(update.bStatic) + static_cast<U32>(update.bDynamic));
+
+            if (!update.bRequired && m_UpdateBudget > 0 && m_UpdatedViewCount + cost > m_UpdateBudget)
+            {
+                // Deferred, it keeps its last shadow and waits with a higher priority.
+                continue;
+            }
+
+            ShadowSlot& slot = update.bCube ? m_CubeSlots[ update.Slot ] : m_ShadowSlots[ update.Slot ];
+
+            // Rendered by `renderShadowMaps` later this frame, the shadow buffer already describes the new shadow.
+            slot.Cached     = slot.Requested;
+            slot.LastUpdate = frame;
+
+            m_Updates[ m_UpdateCount++ ] = update;
+
+            m_UpdatedViewCount += cost;
+        }
+    }
+
+
+    void VyShadowSystem::renderShadowMaps(VyFrameInfo& frameInfo)
+    {
+        if (m_UpdateCount == 0)
+        {
+            return;
+        }
+
+        for (U32 i = 0; i < m_UpdateCount; i++)
+        {
+            const ShadowUpdate& update = m_Updates[i];
+
+            const ShadowSlot&  slot   = update.bCube ? m_CubeSlots[ update.Slot ] : m_ShadowSlots[ update.Slot ];
+            const ShadowState& cached = slot.Cached;
+
+            if (update.bCube)
+            {
+                const Vec3  position = Vec3(cached.PositionAndRange);
+                const float range    = cached.PositionAndRange.w;
+
+                if (update.bStatic)
+                {
+                    renderToCubeShadowMap(frameInfo, *m_StaticCubeShadowMaps[ update.Slot ], position, range, slot.StaticCasters);
+                }
+
+                if (update.bDynamic)
+                {
+                    renderToCubeShadowMap(frameInfo, *m_CubeShadowMaps[ update.Slot ], position, range, slot.DynamicCasters);
+                }
+            }
+            else
+            {
+                if (update.bStatic)
+                {
+                    renderToShadowMap(frameInfo, cached.Tile, kStaticLayer, cached.Matrix, slot.StaticCasters);
+                }
+
+                if (update.bDynamic)
+                {
+                    renderToShadowMap(frameInfo, cached.Tile, kDynamicLayer, cached.Matrix, slot.DynamicCasters);
+                }
+            }
+        }
+
+        m_UpdateCount = 0;
     }
 
     // =====================================================================================================================
@@ -257,7 +773,7 @@ namespace Vy
             // No color attachment - depth only
             .setDepthAttachment(VK_FORMAT_D32_SFLOAT)
 
-            // Use the render pass from the first cube shadow map
+            // Use the multiview render pass from the first cube shadow map
             .setRenderPass(m_CubeShadowMaps[0]->renderPass())
 
         .buildUnique();
@@ -265,97 +781,91 @@ namespace Vy
 
     // =====================================================================================================================
 
-    void VyShadowSystem::renderPointLightShadowMaps(VyFrameInfo& frameInfo)
-    {
-        m_CubeShadowLightCount = 0;
-
-        auto view = frameInfo.Scene->registry().view<PointLightComponent, TransformComponent>();
-        
-        for (auto&& [entity, pointLight, transform] : view.each())
-        {
-            if (m_CubeShadowLightCount >= MAX_CUBE_SHADOW_MAPS) break;
-
-            Vec3  position = transform.Translation;
-            float range    = 25.0f; // Default range
-
-            // Store light data for UBO.
-            m_PointLightPositions[m_CubeShadowLightCount] = position;
-            m_PointLightRanges   [m_CubeShadowLightCount] = range;
-
-            // Render to cube map faces.
-            renderToCubeShadowMap(frameInfo, *m_CubeShadowMaps[m_CubeShadowLightCount], position, range);
-
-            m_CubeShadowLightCount++;
-        }
-    }
-
-    // =====================================================================================================================
-
     Mat4 VyShadowSystem::calculatePointLightMatrix(const Vec3& position, int face, float range)
     {
-        float nearPlane  = 0.1f;
-        Mat4  projection = glm::perspective(glm::radians(90.0f), 1.0f, nearPlane, range);
-
-        // Vulkan Y flip
-        projection[1][1] *= -1;
-
-        Mat4 view = VyCubeShadowMap::faceViewMatrix(position, face);
+        Mat4 projection = VyCubeShadowMap::projectionMatrix(kPointLightNearPlane, range);
+        Mat4 view       = VyCubeShadowMap::faceViewMatrix(position, face);
 
         return projection * view;
     }
 
     // =====================================================================================================================
 
-    void VyShadowSystem::renderToCubeShadowMap(VyFrameInfo& frameInfo, VyCubeShadowMap& cubeShadowMap, const Vec3& position, float range)
+    void VyShadowSystem::renderToCubeShadowMap(
+        VyFrameInfo&        frameInfo, 
+        VyCubeShadowMap&    cubeShadowMap, 
+        const Vec3&         position, 
+        float               range, 
+        const TVector<U32>& casters)
     {
-        for (int face = 0; face < 6; face++)
+        TArray<VyFrustum, VyCubeShadowMap::kFaceCount> faceFrustums;
+
+        for (U32 face = 0; face < VyCubeShadowMap::kFaceCount; face++)
         {
-            Mat4 lightSpaceMatrix = calculatePointLightMatrix(position, face, range);
-            
-            renderToCubeFace(frameInfo, cubeShadowMap, face, lightSpaceMatrix, position, range);
+            faceFrustums[face] = VyFrustum::fromMatrix(calculatePointLightMatrix(position, static_cast<int>(face), range));
         }
-    }
 
-    // =====================================================================================================================
+        // The faces share the projection, the vertex shader applies it after rotating into the face of its view.
+        const Mat4 projection = VyCubeShadowMap::projectionMatrix(kPointLightNearPlane, range);
 
-    void VyShadowSystem::renderToCubeFace(
-        VyFrameInfo&     frameInfo,
-        VyCubeShadowMap& cubeShadowMap,
-        int              face,
-        const Mat4&      lightSpaceMatrix,
-        const Vec3&      lightPos,
-        float            farPlane)
-    {
-        // Begin render pass for this face.
-        cubeShadowMap.beginRenderPass(frameInfo.CommandBuffer, face);
-        {
-            // Bind cube shadow pipeline.
-            m_CubePipeline->bind(frameInfo.CommandBuffer);
+        const VyRecordingPass pass{
+            .RenderPass  = cubeShadowMap.renderPass(),
+            .Framebuffer = cubeShadowMap.framebuffer(),
+            .Extent      = { cubeShadowMap.size(), cubeShadowMap.size() }
+        };
 
-            // Render all objects.
-            auto view = frameInfo.Scene->registry().view<ModelComponent, TransformComponent>();
-            
-            for (auto&& [entity, modelComp, transform] : view.each())
+        recordShadowPass(frameInfo, pass, static_cast<U32>(casters.size()),
+            [&](VkSubpassContents contents)
             {
-                if (!modelComp.Model) continue;
+                // Begin the render pass of all six faces.
+                cubeShadowMap.beginRenderPass(frameInfo.CommandBuffer, contents);
+            },
+            [&](VkCommandBuffer commandBuffer, U32 first, U32 last)
+            {
+                // Bind cube shadow pipeline.
+                m_CubePipeline->bind(commandBuffer);
 
-                CubeShadowPushConstants push{};
+                // Render every caster once, to the faces whose frustum it overlaps.
+                for (U32 i = first; i < last; i++)
                 {
-                    push.ModelMatrix         = transform.matrix();
-                    push.LightSpaceMatrix    = lightSpaceMatrix;
-                    push.LightPosAndFarPlane = Vec4(lightPos, farPlane);
+                    const VyRenderProxy& proxy       = frameInfo.Packet.Objects[ casters[i] ];
+                    const Mat4&          modelMatrix = proxy.Matrix;
+
+                    U32 faceMask = 0;
+
+                    for (U32 face = 0; face < VyCubeShadowMap::kFaceCount; face++)
+                    {
+                        if (isMeshVisible(faceFrustums[face], *proxy.Mesh, modelMatrix))
+                        {
+                            faceMask |= 1u << face;
+                        }
+                    }
+
+                    if (faceMask == 0)
+                    {
+                        continue;
+                    }
+
+                    CubeShadowPushConstants push{};
+                    {
+                        push.ModelMatrix         = modelMatrix;
+                        push.LightPosAndFarPlane = Vec4(position, range);
+                        push.Projection          = Vec4(projection[0][0], projection[1][1], projection[2][2], projection[3][2]);
+                        push.FaceMask            = faceMask;
+                    }
+
+                    m_CubePipeline->pushConstants(commandBuffer, 
+                        VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 
+                        push
+                    );
+
+                    proxy.Mesh->bind(commandBuffer);
+                    proxy.Mesh->draw(commandBuffer);
                 }
-
-                m_CubePipeline->pushConstants(frameInfo.CommandBuffer, 
-                    VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 
-                    &push
-                );
-
-                modelComp.Model->bind(frameInfo.CommandBuffer);
-                modelComp.Model->draw(frameInfo.CommandBuffer);
             }
-        }
-        // End face render pass.
+        );
+
+        // End the render pass, the faces are left ready for sampling.
         cubeShadowMap.endRenderPass(frameInfo.CommandBuffer);
     }
 
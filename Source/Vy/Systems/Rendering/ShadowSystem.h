@@ -1,8 +1,10 @@
 #pragma once
 
+#include <Vy/GFX/Resources/ShadowAtlas.h>
 #include <Vy/GFX/Resources/ShadowMap.h>
 #include <Vy/GFX/Backend/Descriptors.h>
 #include <Vy/GFX/Backend/Pipeline.h>
+#include <Vy/GFX/Backend/ParallelRecorder.h>
 #include <Vy/GFX/FrameInfo.h>
 #include <Vy/Systems/Rendering/IRenderSystem.h>
 
@@ -13,13 +15,47 @@ namespace Vy
      *
      * Manages shadow map rendering for directional, spot, and point lights.
      * Uses 2D shadow maps for directional/spot lights and cube maps for point lights.
+     *
+     * The 2D shadow maps are tiles of one `VyShadowAtlas`, which is the whole shadow memory budget of those lights.
+     * Every frame each light gets a tile size from its importance on screen (the directional light always gets the
+     * largest), and the tiles are allocated largest first. Lights that do not fit are shrunk down to the smallest
+     * tile size, and left without a shadow (a zero UV rect) when not even that fits.
+     *
+     * Shadows are cached. Casters that have not moved for `kStaticFrames` frames are static and rendered into their
+     * own layer (`kStaticLayer` of the atlas, the static cube map of a point light), the others into `kDynamicLayer`.
+     * A layer is only re-rendered when the light, its tile or the casters inside its bounds change, so a light
+     * whose surroundings rest costs nothing, and a moving object only re-renders the dynamic layers of the lights it
+     * touches. A texel is lit when it is lit in both layers: the shaders multiply the visibility of the two atlas
+     * layers, and test the distance to a point light against the nearer of its two cube maps.
+     *
+     * At most `updateBudget` shadow views (a tile layer, or a cube face) are re-rendered per frame. Lights without a
+     * valid shadow are always rendered; the others are picked by importance times the frames since their last
+     * update, so distant lights are refreshed in turn instead of every frame. A deferred light keeps the shadow and
+     * the matrices it was last rendered with, which are what the accessors return.
+     *
+     * Every frame `update` picks the shadowed lights, their tiles and casters, schedules the views to re-render and
+     * writes the shadow of every light into the frame's shadow buffer (`ShadowData`, indexed with
+     * `LightData::ShadowIndex`). `renderShadowMaps` then records the scheduled views, outside of any render pass.
+     * The lighting shaders sample the atlas through one descriptor (`shadowAtlasDescriptorInfo`), mapping the
+     * light's shadow UV into its tile with the UV rect and clamping the filter taps to the tile.
      */
     class VyShadowSystem
     {
     public:
-        static constexpr int MAX_SHADOW_MAPS      = 4; // For directional + spotlights
-        static constexpr int MAX_CUBE_SHADOW_MAPS = 4; // For point lights (cube maps)
+        static constexpr int MAX_SHADOW_MAPS      = 16; // For directional + spotlights, tiles of the atlas
+        static constexpr int MAX_CUBE_SHADOW_MAPS = 4;  // For point lights (cube maps)
+
+        static constexpr U32 kStaticLayer         = 0;  // Atlas layer / cube map of the casters at rest.
+        static constexpr U32 kDynamicLayer        = 1;  // Atlas layer / cube map of the moving casters.
+
+        static constexpr U64 kStaticFrames        = 60; // Frames a caster must rest before it is cached as static.
+
+        static constexpr U32 kShadowCount         = MAX_SHADOW_MAPS + MAX_CUBE_SHADOW_MAPS; // Entries of the shadow buffer.
+        static constexpr U32 kCubeShadowMapCount  = 2 * MAX_CUBE_SHADOW_MAPS;               // Dynamic and static cube map of every point light.
 
+        /**
+         * @param shadowMapSize Largest atlas tile and cube map face. The atlas holds four of the largest tiles.
+         */
         VyShadowSystem(U32 shadowMapSize = 2048);
 
         ~VyShadowSystem();
@@ -28,89 +64,295 @@ namespace Vy
         VyShadowSystem& operator=(const VyShadowSystem&) = delete;
 
         /**
-         * @brief Render all shadow maps for the frame
+         * @brief Creates the shadow pipelines, separate from the constructor so they are compiled with the other systems.
+         */
+        void createPipelines();
+
+        /**
+         * @brief Picks the shadowed lights of the frame, schedules the shadow views to re-render and writes the frame's shadow buffer
          * @param frameInfo Current frame information
          * @param sceneRadius Approximate scene bounds for light frustum calculation
          */
-        void renderShadowMaps(VyFrameInfo& frameInfo, float sceneRadius = 20.0f);
+        void update(VyFrameInfo& frameInfo, float sceneRadius = 20.0f);
+
+        /**
+         * @brief Records the shadow views scheduled by `update`. Must be outside of a render pass.
+         */
+        void renderShadowMaps(VyFrameInfo& frameInfo);
+
+        /**
+         * @brief Shadow buffer index of the light at `index` in the frame packet's lights of `type`, `kNoShadow` if it has none
+         */
+        U32 shadowIndex(ELightType type, size_t index) const;
+
+        /**
+         * @brief Get descriptor info of the frame's shadow buffer (`ShadowData[kShadowCount]`)
+         */
+        VkDescriptorBufferInfo shadowBufferInfo(int frameIndex) const
+        {
+            return m_ShadowBuffers[ frameIndex ]->descriptorBufferInfo();
+        }
+
+        /**
+         * @brief Get the atlas holding the shadow maps of all directional/spot lights
+         */
+        VyShadowAtlas& shadowAtlas()
+        {
+            return *m_Atlas;
+        }
+
+        /**
+         * @brief Get the atlas tile of the shadow map at specified index, invalid if the light has no shadow
+         */
+        const VyShadowAtlasTile& shadowTile(int index = 0) const
+        {
+            return m_ShadowSlots[index].Cached.Tile;
+        }
 
         /**
-         * @brief Get the shadow map at specified index for sampling
+         * @brief Get the atlas UV rect (xy = offset, zw = scale) of the shadow map at specified index, zero if the light has no shadow
          */
-        VyShadowMap& shadowMap(int index = 0) 
-        { 
-            return *m_ShadowMaps[index]; 
+        Vec4 shadowUVRect(int index = 0) const
+        {
+            return m_ShadowSlots[index].Cached.bValid ? m_Atlas->uvRect(m_ShadowSlots[index].Cached.Tile) : Vec4(0.0f);
         }
 
         /**
-         * @brief Get the cube shadow map at specified index for point lights
+         * @brief Get the cube shadow map of the moving casters at specified index for point lights
          */
-        VyCubeShadowMap& cubeShadowMap(int index = 0) 
-        { 
-            return *m_CubeShadowMaps[index]; 
+        VyCubeShadowMap& cubeShadowMap(int index = 0)
+        {
+            return *m_CubeShadowMaps[index];
         }
 
         /**
-         * @brief Get the light space matrix at specified index
+         * @brief Get the cube shadow map of the casters at rest at specified index for point lights
          */
-        const Mat4& lightSpaceMatrix(int index = 0) const 
-        { 
-            return m_LightSpaceMatrices[index]; 
+        VyCubeShadowMap& staticCubeShadowMap(int index = 0)
+        {
+            return *m_StaticCubeShadowMaps[index];
+        }
+
+        /**
+         * @brief Get the light space matrix the shadow map at specified index was rendered with
+         */
+        const Mat4& lightSpaceMatrix(int index = 0) const
+        {
+            return m_ShadowSlots[index].Cached.Matrix;
         }
 
         /**
          * @brief Get number of active shadow-casting directional/spot lights
          */
-        int shadowLightCount() const 
-        { 
-            return m_ShadowLightCount; 
+        int shadowLightCount() const
+        {
+            return m_ShadowLightCount;
         }
 
         /**
          * @brief Get number of active shadow-casting point lights
          */
-        int cubeShadowLightCount() const 
-        { 
-            return m_CubeShadowLightCount; 
+        int cubeShadowLightCount() const
+        {
+            return m_CubeShadowLightCount;
+        }
+
+        /**
+         * @brief Get the point light position the cube shadow map was rendered with
+         */
+        Vec3 pointLightPosition(int index = 0) const
+        {
+            return Vec3(m_CubeSlots[index].Cached.PositionAndRange);
+        }
+
+        /**
+         * @brief Get the point light range (far plane) the cube shadow map was rendered with
+         */
+        float pointLightRange(int index = 0) const
+        {
+            return m_CubeSlots[index].Cached.PositionAndRange.w;
         }
 
         /**
-         * @brief Get point light position for shadow calculation in shader
+         * @brief Get casters inside / outside the bounds of all directional/spot lights of the last frame
          */
-        const Vec3& pointLightPosition(int index = 0) const 
-        { 
-            return m_PointLightPositions[index]; 
+        const VyCullStats& shadowCullStats() const
+        {
+            return m_ShadowCullStats;
+        }
+
+        /**
+         * @brief Get casters inside / outside the range of all point lights of the last frame
+         */
+        const VyCullStats& cubeShadowCullStats() const
+        {
+            return m_CubeShadowCullStats;
+        }
+
+        /**
+         * @brief Get the shadow views (tile layers and cube faces) re-rendered by the last frame
+         */
+        U32 updatedViewCount() const
+        {
+            return m_UpdatedViewCount;
+        }
+
+        /**
+         * @brief Limits the shadow views (tile layers and cube faces) re-rendered per frame, 0 renders every change
+         */
+        void setUpdateBudget(U32 viewCount)
+        {
+            m_UpdateBudget = viewCount;
+        }
+
+        U32 updateBudget() const
+        {
+            return m_UpdateBudget;
         }
 
         /**
-         * @brief Get point light range (far plane) for shadow calculation
+         * @brief Records the shadow draws in parallel into secondary command buffers, null records them inline.
          */
-        float pointLightRange(int index = 0) const 
-        { 
-            return m_PointLightRanges[index]; 
+        void setParallelRecorder(VyParallelRecorder* recorder)
+        {
+            m_Recorder = recorder;
         }
 
         /**
-         * @brief Get descriptor info for shadow map sampling
+         * @brief Get descriptor info for sampling the shadow atlas (2D array of both layers), shared by all directional/spot lights
          */
-        VkDescriptorImageInfo shadowMapDescriptorInfo(int index = 0) const 
-        { 
-            return m_ShadowMaps[index]->descriptorImageInfo(); 
+        VkDescriptorImageInfo shadowAtlasDescriptorInfo() const
+        {
+            return m_Atlas->descriptorImageInfo();
         }
 
         /**
-         * @brief Get descriptor info for cube shadow map sampling
+         * @brief Get descriptor info for sampling the cube shadow map of the moving casters
          */
-        VkDescriptorImageInfo cubeShadowMapDescriptorInfo(int index = 0) const 
-        { 
-            return m_CubeShadowMaps[index]->descriptorImageInfo(); 
+        VkDescriptorImageInfo cubeShadowMapDescriptorInfo(int index = 0) const
+        {
+            return m_CubeShadowMaps[index]->descriptorImageInfo();
+        }
+
+        /**
+         * @brief Get descriptor info for sampling the cube shadow map of the casters at rest
+         */
+        VkDescriptorImageInfo staticCubeShadowMapDescriptorInfo(int index = 0) const
+        {
+            return m_StaticCubeShadowMaps[index]->descriptorImageInfo();
+        }
+
+        /**
+         * @brief Get descriptor infos of every cube shadow map, the moving casters first, then the casters at rest
+         *
+         * `ShadowData::CubeIndex` indexes the first half, the static map of the same light follows `MAX_CUBE_SHADOW_MAPS` later.
+         */
+        TArray<VkDescriptorImageInfo, kCubeShadowMapCount> cubeShadowMapDescriptorInfos() const
+        {
+            TArray<VkDescriptorImageInfo, kCubeShadowMapCount> infos{};
+
+            for (int i = 0; i < MAX_CUBE_SHADOW_MAPS; i++)
+            {
+                infos[ i ]                        = m_CubeShadowMaps      [i]->descriptorImageInfo();
+                infos[ i + MAX_CUBE_SHADOW_MAPS ] = m_StaticCubeShadowMaps[i]->descriptorImageInfo();
+            }
+
+            return infos;
         }
 
     private:
 
+        static constexpr U32 kMinObjectsPerChunk  = 64; // Per shadow view, most objects are culled before drawing.
+
+        static constexpr U32 kMinTileSize         = 256;
+
+        static constexpr U32 kDefaultUpdateBudget = 24; // Four point lights, or 24 tiles.
+
+        static constexpr float kPointLightNearPlane = 0.1f;
+
+        /**
+         * @brief What a shadow map holds, or is requested to hold this frame.
+         */
+        struct ShadowState
+        {
+            Mat4              Matrix          { 1.0f }; // Light space matrix (directional/spot).
+            Vec4              PositionAndRange{ 0.0f }; // xyz = position, w = range (point).
+            VyShadowAtlasTile Tile;                     // Directional/spot.
+            size_t            StaticHash      { 0 };    // Of the casters at rest in the light's bounds.
+            size_t            DynamicHash     { 0 };    // Of the moving casters in the light's bounds.
+            bool              bValid          { false };
+        };
+
+        struct ShadowSlot
+        {
+            ShadowState  Cached;                // Rendered into the shadow map.
+            ShadowState  Requested;             // Built this frame.
+            TVector<U32> StaticCasters;         // Packet objects in the light's bounds this frame.
+            TVector<U32> DynamicCasters;
+            U32          TileSize  { 0 };       // Requested from the light's importance.
+            float        Importance{ 1.0f };    // Fraction of the screen height the light covers.
+            U64          LastUpdate{ 0 };       // Frame number of the last render.
+        };
+
+        /**
+         * @brief A shadow map whose layers are re-rendered this frame.
+         */
+        struct ShadowUpdate
+        {
+            int   Slot     { 0 };
+            bool  bCube    { false };
+            bool  bStatic  { false }; // Layers to render.
+            bool  bDynamic { false };
+            bool  bRequired{ false }; // No valid shadow, rendered regardless of the budget.
+            float Priority { 0.0f };
+        };
+
+        struct CasterHistory
+        {
+            U32 Version  { 0 };
+            U64 LastMoved{ 0 };
+            U64 LastSeen { 0 };
+        };
+
         void createPipeline();
         void createCubeShadowPipeline();
 
+        /**
+         * @brief Writes the shadows of the frame's lights, as last rendered, into the frame's shadow buffer
+         */
+        void writeShadowData(int frameIndex);
+
+        /**
+         * @brief Atlas tile size of a light from the fraction of the screen height it covers
+         */
+        U32 tileSizeFor(float screenCoverage) const;
+
+        /**
+         * @brief Fraction of the screen height covered by a bounding sphere, 1 if the camera is inside it
+         */
+        static float screenCoverage(const VyCamera& camera, const Vec3& center, float radius);
+
+        /**
+         * @brief Classifies the packet objects into static and moving casters from their transform versions
+         */
+        void updateCasterHistory(const VyFramePacket& packet);
+
+        /**
+         * @brief Allocates the atlas tiles of the frame's shadow lights from their requested sizes, largest first
+         */
+        void allocateShadowTiles();
+
+        /**
+         * @brief Splits the casters passing `inBounds(proxy)` into the slot's static/dynamic lists and hashes them
+         */
+        template <typename InBounds>
+        void gatherCasters(const VyFramePacket& packet, ShadowSlot& slot, VyCullStats& cullStats, InBounds&& inBounds);
+
+        /**
+         * @brief Picks the layers of the shadow maps that changed to be re-rendered, within the update budget
+         */
+        void scheduleUpdates(const VyFrameInfo& frameInfo);
+
         /**
          * @brief Calculate orthographic projection matrix for directional light
          */
@@ -127,49 +369,85 @@ namespace Vy
         Mat4 calculatePointLightMatrix(const Vec3& position, int face, float range);
 
         /**
-         * @brief Render scene to a 2D shadow map with given light space matrix
-         */
-        void renderToShadowMap(VyFrameInfo& frameInfo, VyShadowMap& shadowMap, const Mat4& lightSpaceMatrix);
-
-        /**
-         * @brief Render point light shadow maps (all 6 faces for each point light)
+         * @brief Begins a shadow render pass and records `recordDraws(commandBuffer, first, last)` over `itemCount`
+         *        casters, inline or split into parallel secondary command buffers.
+         *
+         * `beginPass(contents)` begins the render pass, the caller ends it.
          */
-        void renderPointLightShadowMaps(VyFrameInfo& frameInfo);
+        template <typename BeginPass, typename RecordDraws>
+        void recordShadowPass(
+            VyFrameInfo&           frameInfo,
+            const VyRecordingPass& pass,
+            U32                    itemCount,
+            BeginPass&&            beginPass,
+            RecordDraws&&          recordDraws
+        );
 
         /**
-         * @brief Render all 6 faces of a cube shadow map for a single point light
+         * @brief Render casters to a layer of an atlas tile with given light space matrix
          */
-        void renderToCubeShadowMap(VyFrameInfo& frameInfo, VyCubeShadowMap& cubeShadowMap, const Vec3& position, float range);
+        void renderToShadowMap(
+            VyFrameInfo&             frameInfo,
+            const VyShadowAtlasTile& tile,
+            U32                      layer,
+            const Mat4&              lightSpaceMatrix,
+            const TVector<U32>&      casters
+        );
 
         /**
-         * @brief Render scene to a single face of a cube shadow map
+         * @brief Render all 6 faces of a cube shadow map for a single point light, in one multiview pass
+         *
+         * Every caster is drawn once with the mask of the faces whose frustum it overlaps, casters outside all of
+         * them are skipped. Not run on a device yet.
          */
-        void renderToCubeFace(
-            VyFrameInfo&     frameInfo,
-            VyCubeShadowMap& cubeShadowMap,
-            int              face,
-            const Mat4&      lightSpaceMatrix,
-            const Vec3&      lightPos,
-            float            farPlane
+        void renderToCubeShadowMap(
+            VyFrameInfo&        frameInfo,
+            VyCubeShadowMap&    cubeShadowMap,
+            const Vec3&         position,
+            float               range,
+            const TVector<U32>& casters
         );
 
     private:
 
         U32 m_ShadowMapSize;
 
-        // 2D shadow maps for directional/spot lights
-        TVector<Unique<VyShadowMap>> m_ShadowMaps;
+        // 2D shadow maps for directional/spot lights, packed into one atlas with a static and a dynamic layer
+        Unique<VyShadowAtlas>        m_Atlas;
         Unique<VyPipeline>           m_Pipeline;
 
-        // Cube shadow maps for point lights
+        // Cube shadow maps for point lights, one per layer
         TVector<Unique<VyCubeShadowMap>> m_CubeShadowMaps;
+        TVector<Unique<VyCubeShadowMap>> m_StaticCubeShadowMaps;
         Unique<VyPipeline>               m_CubePipeline;
 
-        Mat4 m_LightSpaceMatrices[MAX_SHADOW_MAPS];
-        int  m_ShadowLightCount = 0;
+        TArray<ShadowSlot, MAX_SHADOW_MAPS>      m_ShadowSlots;
+        TArray<ShadowSlot, MAX_CUBE_SHADOW_MAPS> m_CubeSlots;
+
+        int  m_ShadowLightCount     = 0;
+        int  m_CubeShadowLightCount = 0;
+        bool m_bWarnedAtlasFull     = false;
+
+        // Shadow buffer index of the packet's lights, `kNoShadow` for lights without a slot.
+        U32          m_DirectionalShadowIndex = kNoShadow; // Only the first directional light has a shadow.
+        TVector<U32> m_SpotShadowIndices;
+        TVector<U32> m_PointShadowIndices;
+
+        TArray<Unique<VyBuffer>, MAX_FRAMES_IN_FLIGHT> m_ShadowBuffers; // ShadowData[kShadowCount], host written every frame.
+
+        TArray<ShadowUpdate, kShadowCount> m_Updates; // Scheduled by `update`, recorded by `renderShadowMaps`.
+        U32                                m_UpdateCount = 0;
+
+        THashMap<U32, CasterHistory> m_CasterHistory; // By entity.
+        TVector<U8>                  m_bStaticCaster; // Per packet object of the frame.
+
+        U32 m_UpdateBudget     = kDefaultUpdateBudget;
+        U32 m_UpdatedViewCount = 0;
+
+        VyCullStats m_ShadowCullStats{};
+        VyCullStats m_CubeShadowCullStats{};
 
-        Vec3  m_PointLightPositions[MAX_CUBE_SHADOW_MAPS];
-        float m_PointLightRanges[MAX_CUBE_SHADOW_MAPS];
-        int   m_CubeShadowLightCount = 0;
+        VyParallelRecorder*      m_Recorder{ nullptr };
+        TVector<VkCommandBuffer> m_SecondaryBuffers; // Chunks of the pass being recorded.
     };
-}
\ No newline at end of file
+}
@@ -55,9 +55,7 @@ namespace Vy
             m_ShadowPipeline->bindDescriptorSet(frameInfo.CommandBuffer, 0, frameInfo.GlobalDescriptorSet);
 
             // 
-            auto view = frameInfo.Scene->registry().view<ModelComponent, TransformComponent>();
-            
-            for (auto&& [ entity, model, transform ] : view.each())
+            for (const VyRenderProxy& proxy : frameInfo.Packet.Objects)
             {
                 // Bind main descriptor set for UBO/Textures if needed (shadow shader usually only needs vertex pos)
                 // But pipeline was created with main descriptor layout, so we might need to bind it?
@@ -66,13 +64,13 @@ namespace Vy
 
                 ShadowPushConstant push{};
                 {
-                    push.ModelMatrix = transform.matrix();
+                    push.ModelMatrix = proxy.Matrix;
                 }
 
                 m_ShadowPipeline->pushConstants(frameInfo.CommandBuffer, VK_SHADER_STAGE_VERTEX_BIT, &push);
 
-                model.Model->bind(frameInfo.CommandBuffer);
-                model.Model->draw(frameInfo.CommandBuffer);
+                proxy.Mesh->bind(frameInfo.CommandBuffer);
+                proxy.Mesh->draw(frameInfo.CommandBuffer);
             }
             vkCmdEndRenderPass(frameInfo.CommandBuffer);
         }
@@ -42,15 +42,29 @@ namespace Vy
 
     void VySkyboxSystem::render(const VyFrameInfo& frameInfo)
     {
-        m_Pipeline->bind(frameInfo.CommandBuffer);
+        VyCommandContext context{ frameInfo.CommandBuffer };
 
-        auto globSets = TVector{ frameInfo.GlobalDescriptorSet, m_Skybox->descriptorSet() };
+        recordPacket(context, frameInfo, 0);
+    }
+
+
+    void VySkyboxSystem::submit(const VyFrameInfo& frameInfo, VyRenderQueue& queue)
+    {
+        queue.submit(*this, VyRenderKey::make(ERenderLayer::Sky, queue.pipelineId(*m_Pipeline), 0, 0, 0));
+    }
+
+
+    void VySkyboxSystem::recordPacket(VyCommandContext& context, const VyFrameInfo& frameInfo, U32 payload) const
+    {
+        const TArray<VkDescriptorSet, 2> sets{ frameInfo.GlobalDescriptorSet, m_Skybox->descriptorSet() };
+
+        context.bindPipeline(*m_Pipeline);
 
         // Bind global and skybox descriptor set.
-        m_Pipeline->bindDescriptorSets(frameInfo.CommandBuffer, 0, globSets);
+        context.bindDescriptorSets(*m_Pipeline, 0, sets);
 
         // Draw 36 vertices (12 triangles) for a cube.
-        vkCmdDraw(frameInfo.CommandBuffer, 36, 1, 0, 0);
+        vkCmdDraw(context.commandBuffer(), 36, 1, 0, 0);
     }
 
 }
\ No newline at end of file
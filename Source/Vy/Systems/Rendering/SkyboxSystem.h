@@ -24,6 +24,13 @@ namespace Vy
 
         virtual void render(const VyFrameInfo& frameInfo) override;
 
+        /**
+         * @brief Submits the skybox to the sky layer, drawn after the opaques into what they left at the far plane.
+         */
+        virtual void submit(const VyFrameInfo& frameInfo, VyRenderQueue& queue) override;
+
+        virtual void recordPacket(VyCommandContext& context, const VyFrameInfo& frameInfo, U32 payload) const override;
+
         void createPipeline(VkRenderPass& renderPass, TVector<VkDescriptorSetLayout> descSetLayouts);
 
     private:
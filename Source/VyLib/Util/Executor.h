@@ -6,13 +6,18 @@
 #include <VyLib/STL/Containers.h>
 #include <VyLib/STL/Utility.h>
 #include <VyLib/STL/Atomic.h>
+#include <VyLib/STL/Pointers.h>
+#include <VyLib/Util/JobSystem.h>
 
 #include <future>
-#include <condition_variable>
-#include <thread>
 
 namespace Vy
 {
+    /**
+     * @brief Future based task pool, runs its tasks on a VyJobSystem of its own.
+     *
+     * Tasks are stored inline in the job system's slots, submitting does not go through a shared queue lock.
+     */
     class ExecutorService 
     {
     public:
@@ -23,7 +28,7 @@ namespace Vy
         explicit ExecutorService(size_t numThreads = 0);
 
         /**
-         * @brief Destructor - stops all threads and waits for them to finish
+         * @brief Destructor - runs the remaining tasks, then stops all threads
          */
         ~ExecutorService();
 
@@ -57,12 +62,7 @@ namespace Vy
         ExecutorService& operator=(ExecutorService&&) noexcept = default;
 
     private:
-        TVector<std::thread>          m_Workers;
-        TQueue<std::function<void()>> m_Tasks;
-
-        mutable std::mutex m_QueueMutex;
-        std::condition_variable m_Condition;
-        bool m_bStop = false;
+        Unique<VyJobSystem> m_Jobs;
     };
 
     template<typename F, typename... Args>
@@ -70,23 +70,18 @@ namespace Vy
     {
         using ReturnType = typename std::invoke_result<F, Args...>::type;
 
-        auto task = std::make_shared<std::packaged_task<ReturnType()>>(
-            std::bind(std::forward<F>(f), std::forward<Args>(args)...)
-        );
-
-        std::future<ReturnType> result = task->get_future(); 
+        if (!m_Jobs) 
         {
-            std::unique_lock<std::mutex> lock(m_QueueMutex);
+            throw std::runtime_error("Cannot submit task to stopped ExecutorService");
+        }
 
-            if (m_bStop) 
-            {
-                throw std::runtime_error("Cannot submit task to stopped ExecutorService");
-            }
+        std::packaged_task<ReturnType()> task(
+            std::bind(std::forward<F>(f), std::forward<Args>(args)...)
+        );
 
-            m_Tasks.emplace([task]() { (*task)(); });
-        }
+        std::future<ReturnType> result = task.get_future();
 
-        m_Condition.notify_one();
+        m_Jobs->run(std::move(task));
 
         return result;
     }
@@ -0,0 +1,518 @@
+#include <VyLib/Util/JobSystem.h>
+
+#include <VyLib/Core/VyLogger.h>
+
+#include <exception>
+
+namespace Vy
+{
+    namespace
+    {
+        struct ThreadIdentity
+        {
+            const VyJobSystem* System{ nullptr };
+            U32                Index { 0 };
+        };
+
+        thread_local ThreadIdentity tlsIdentity;
+
+        // Empty polls before a worker goes to sleep.
+        constexpr U32 kSpinCount = 64;
+    }
+
+    // ============================================================================================
+    // Deque
+
+    bool VyJobSystem::Deque::push(Job* job)
+    {
+        const I64 bottom = m_Bottom.load(std::memory_order_relaxed);
+        const I64 top    = m_Top   .load(std::memory_order_acquire);
+
+        if (bottom - top >= static_cast<I64>(kJobsPerThread))
+        {
+            return false;
+        }
+
+        m_Buffer[ bottom & (kJobsPerThread - 1) ].store(job, std::memory_order_relaxed);
+
+        // Publishes the job (and its slot contents) to thieves, pairs with the acquire load in steal.
+        m_Bottom.store(bottom + 1, std::memory_order_release);
+
+        return true;
+    }
+
+
+    VyJobSystem::Job* VyJobSystem::Deque::pop()
+    {
+        const I64 bottom = m_Bottom.load(std::memory_order_relaxed) - 1;
+
+        m_Bottom.store(bottom, std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        I64 top = m_Top.load(std::memory_order_relaxed);
+
+        if (top > bottom)
+        {
+            // Empty.
+            m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+
+            return nullptr;
+        }
+
+        Job* job = m_Buffer[ bottom & (kJobsPerThread - 1) ].load(std::memory_order_relaxed);
+
+        if (top == bottom)
+        {
+            // Last job, race the thieves for it.
+            if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            {
+                job = nullptr;
+            }
+
+            m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+        }
+
+        return job;
+    }
+
+
+    VyJobSystem::Job* VyJobSystem::Deque::steal()
+    {
+        I64 top = m_Top.load(std::memory_order_acquire);
+
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        const I64 bottom = m_Bottom.load(std::memory_order_acquire);
+
+        if (top >= bottom)
+        {
+            return nullptr;
+        }
+
+        Job* job = m_Buffer[ top & (kJobsPerThread - 1) ].load(std::memory_order_relaxed);
+
+        if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        {
+            // Lost the race against the owner or another thief.
+            return nullptr;
+        }
+
+        return job;
+    }
+
+    // ============================================================================================
+    // Job System
+
+    VyJobSystem::VyJobSystem(U32 workerCount) :
+        m_OwnerThread{ std::this_thread::get_id() }
+    {
+        if (workerCount == 0)
+        {
+            const U32 hardwareThreads = std::thread::hardware_concurrency();
+
+            workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 3;
+        }
+
+        // The queues of the registered threads exist up front so thieves can scan m_Queues without locking, their
+        // slots are allocated on registration.
+        m_Queues.reserve(workerCount + 1 + kMaxRegistered);
+
+        for (U32 i = 0; i < workerCount + 1 + kMaxRegistered; i++)
+        {
+            auto& queue = m_Queues.emplace_back(MakeUnique<ThreadQueue>());
+
+            if (i <= workerCount)
+            {
+                queue->Slots = TVector<Job>(kJobsPerThread);
+            }
+        }
+
+        m_Workers.reserve(workerCount);
+
+        for (U32 i = 1; i <= workerCount; i++)
+        {
+            m_Workers.emplace_back([this, i]() { workerLoop(i); });
+        }
+    }
+
+
+    VyJobSystem::~VyJobSystem()
+    {
+        wait(m_AllJobs);
+
+        {
+            LockGuard<Mutex> lock(m_WakeMutex);
+
+            m_bStop.store(true);
+        }
+
+        m_WakeCondition.notify_all();
+
+        for (std::thread& worker : m_Workers)
+        {
+            if (worker.joinable())
+            {
+                worker.join();
+            }
+        }
+    }
+
+
+    VyJobSystem& VyJobSystem::shared()
+    {
+        static VyJobSystem instance;
+
+        return instance;
+    }
+
+
+    void VyJobSystem::wait(VyJobCounter& counter)
+    {
+        const U32 index = threadIndex();
+
+        while (!counter.isDone())
+        {
+            if (Job* job = findJob(index))
+            {
+                execute(*job);
+            }
+            else
+            {
+                // The remaining jobs are running on other threads.
+                std::this_thread::yield();
+            }
+        }
+    }
+
+
+    void VyJobSystem::waitLocal(VyJobCounter& counter)
+    {
+        const U32 index = threadIndex();
+
+        while (!counter.isDone())
+        {
+            if (Job* job = findJob(index, false))
+            {
+                execute(*job);
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+
+    bool VyJobSystem::registerThread()
+    {
+        if (threadIndex() != kExternalThread)
+        {
+            return true;
+        }
+
+        const U32 firstRegistered = workerCount() + 1;
+
+        for (U32 i = 0; i < kMaxRegistered; i++)
+        {
+            bool bExpected = false;
+
+            if (!m_bRegistered[ i ].compare_exchange_strong(bExpected, true, std::memory_order_acquire))
+            {
+                continue;
+            }
+
+            ThreadQueue& queue = *m_Queues[ firstRegistered + i ];
+
+            // Only the registered thread touches the slots, thieves only read the deque.
+            if (queue.Slots.empty())
+            {
+                queue.Slots = TVector<Job>(kJobsPerThread);
+            }
+
+            tlsIdentity = ThreadIdentity{ this, firstRegistered + i };
+
+            return true;
+        }
+
+        VY_WARN_TAG("JobSystem", "No free queue for a registered thread, it submits through the locked queue");
+
+        return false;
+    }
+
+
+    void VyJobSystem::unregisterThread()
+    {
+        const U32 index           = threadIndex();
+        const U32 firstRegistered = workerCount() + 1;
+
+        if (index == kExternalThread || index < firstRegistered)
+        {
+            return;
+        }
+
+        ThreadQueue& queue = *m_Queues[ index ];
+
+        // Jobs still queued or running (stolen) reference the slots, the next thread would reuse them.
+        auto hasBusySlot = [&queue]()
+        {
+            return std::any_of(queue.Slots.begin(), queue.Slots.end(), [](const Job& job)
+            {
+                return job.bBusy.load(std::memory_order_acquire);
+            });
+        };
+
+        while (hasBusySlot())
+        {
+            if (Job* job = findJob(index))
+            {
+                execute(*job);
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+
+        tlsIdentity = ThreadIdentity{};
+
+        m_bRegistered[ index - firstRegistered ].store(false, std::memory_order_release);
+    }
+
+
+    U32 VyJobSystem::threadIndex() const
+    {
+        if (tlsIdentity.System == this)
+        {
+            return tlsIdentity.Index;
+        }
+
+        if (std::this_thread::get_id() == m_OwnerThread)
+        {
+            return 0;
+        }
+
+        return kExternalThread;
+    }
+
+
+    VyJobSystem::Job& VyJobSystem::allocateJob(U32 index)
+    {
+        if (index == kExternalThread)
+        {
+            Job* job = new Job{};
+
+            job->bHeap = true;
+            job->bBusy.store(true, std::memory_order_relaxed);
+
+            return *job;
+        }
+
+        ThreadQueue& queue = *m_Queues[ index ];
+
+        while (true)
+        {
+            // Slots usually free up in order, the first one is almost always available. A busy slot can belong to
+            // a job running further up this very stack, so skip it instead of waiting for it.
+            for (U32 i = 0; i < kJobsPerThread; i++)
+            {
+                Job& job = queue.Slots[ queue.NextSlot++ & (kJobsPerThread - 1) ];
+
+                if (!job.bBusy.load(std::memory_order_acquire))
+                {
+                    job.bBusy.store(true, std::memory_order_relaxed);
+
+                    return job;
+                }
+            }
+
+            // Every slot holds an unfinished job, help until one is done.
+            if (Job* other = findJob(index))
+            {
+                execute(*other);
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+
+    void VyJobSystem::releaseJob(Job& job)
+    {
+        if (job.bHeap)
+        {
+            delete &job;
+        }
+        else
+        {
+            job.bBusy.store(false, std::memory_order_release);
+        }
+    }
+
+
+    void VyJobSystem::submit(U32 index, Job& job)
+    {
+        // Counted before it is visible so a thief never decrements first.
+        m_Pending.fetch_add(1, std::memory_order_seq_cst);
+
+        if (index == kExternalThread)
+        {
+            LockGuard<Mutex> lock(m_ExternalMutex);
+
+            m_External.push_back(&job);
+        }
+        else if (!m_Queues[ index ]->Jobs.push(&job))
+        {
+            // Cannot happen while the deque is as large as the slot ring, kept as a safety net.
+            m_Pending.fetch_sub(1, std::memory_order_relaxed);
+
+            execute(job);
+
+            return;
+        }
+
+        // Pairs with the increment of m_Sleeping in workerLoop, one of the two sides sees the other.
+        if (m_Sleeping.load(std::memory_order_seq_cst) > 0)
+        {
+            {
+                LockGuard<Mutex> lock(m_WakeMutex);
+            }
+
+            m_WakeCondition.notify_one();
+        }
+    }
+
+
+    VyJobSystem::Job* VyJobSystem::findJob(U32 index, bool bForeign)
+    {
+        if (m_Pending.load(std::memory_order_relaxed) == 0)
+        {
+            return nullptr;
+        }
+
+        Job* job = nullptr;
+
+        if (index != kExternalThread)
+        {
+            job = m_Queues[ index ]->Jobs.pop();
+        }
+
+        if (!job && bForeign)
+        {
+            UniqueLock<Mutex> lock(m_ExternalMutex, std::try_to_lock);
+
+            if (lock.owns_lock() && !m_External.empty())
+            {
+                job = m_External.front();
+
+                m_External.pop_front();
+            }
+        }
+
+        if (!job)
+        {
+            // Without foreign jobs only the owner and worker deques are searched.
+            const U32 queueCount = bForeign ? static_cast<U32>(m_Queues.size()) : workerCount() + 1;
+            const U32 start      = index == kExternalThread ? 0 : index + 1;
+
+            for (U32 i = 0; i < queueCount && !job; i++)
+            {
+                const U32 victim = (start + i) % queueCount;
+
+                if (victim != index)
+                {
+                    job = m_Queues[ victim ]->Jobs.steal();
+                }
+            }
+        }
+
+        if (job)
+        {
+            m_Pending.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        return job;
+    }
+
+
+    void VyJobSystem::execute(Job& job)
+    {
+        try
+        {
+            job.Invoke(job);
+        }
+        catch (const std::exception& e)
+        {
+            VY_ERROR_TAG("JobSystem", "Uncaught exception in job: {}", e.what());
+        }
+        catch (...)
+        {
+            VY_ERROR_TAG("JobSystem", "Uncaught unknown exception in job");
+        }
+
+        VyJobCounter* counter = job.Counter;
+
+        if (job.bHeap)
+        {
+            delete &job;
+        }
+        else
+        {
+            job.bBusy.store(false, std::memory_order_release);
+        }
+
+        if (counter)
+        {
+            counter->m_Value.fetch_sub(1, std::memory_order_acq_rel);
+        }
+
+        m_AllJobs.m_Value.fetch_sub(1, std::memory_order_acq_rel);
+    }
+
+
+    void VyJobSystem::workerLoop(U32 index)
+    {
+        tlsIdentity = ThreadIdentity{ this, index };
+
+        U32 idleCount = 0;
+
+        while (true)
+        {
+            if (Job* job = findJob(index))
+            {
+                execute(*job);
+
+                idleCount = 0;
+
+                continue;
+            }
+
+            if (m_bStop.load(std::memory_order_acquire))
+            {
+                return;
+            }
+
+            if (++idleCount < kSpinCount)
+            {
+                std::this_thread::yield();
+
+                continue;
+            }
+
+            idleCount = 0;
+
+            m_Sleeping.fetch_add(1, std::memory_order_seq_cst);
+            {
+                UniqueLock<Mutex> lock(m_WakeMutex);
+
+                m_WakeCondition.wait(lock, [this]()
+                {
+                    return m_bStop.load() || m_Pending.load(std::memory_order_seq_cst) > 0;
+                });
+            }
+            m_Sleeping.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+}
@@ -0,0 +1,326 @@
+#pragma once
+
+#include <VyLib/Common/Numeric.h>
+#include <VyLib/Core/Assert.h>
+#include <VyLib/STL/Mutex.h>
+#include <VyLib/STL/Containers.h>
+#include <VyLib/STL/Pointers.h>
+#include <VyLib/STL/Atomic.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <new>
+#include <thread>
+#include <type_traits>
+
+namespace Vy
+{
+    /**
+     * @brief Counts the unfinished jobs it was passed to. `VyJobSystem::wait` returns once it reaches zero.
+     */
+    class VyJobCounter
+    {
+    public:
+        VyJobCounter() = default;
+
+        VyJobCounter(const VyJobCounter&)            = delete;
+        VyJobCounter& operator=(const VyJobCounter&) = delete;
+
+        VY_NODISCARD bool isDone() const { return m_Value.load(std::memory_order_acquire) == 0; }
+
+    private:
+        friend class VyJobSystem;
+
+        AtomicU32 m_Value{ 0 };
+    };
+
+    // ============================================================================================
+
+    /**
+     * @brief Work-stealing job scheduler.
+     *
+     * Every worker thread, and the thread that created the system, owns a Chase-Lev deque: the owner pushes and pops
+     * jobs at the bottom without locking, idle threads steal from the top of the others. Jobs live in a fixed ring
+     * of slots per thread and store their callable inline (callables larger than `kInlineSize` are the only case
+     * that allocates), so submitting a job does not touch the heap.
+     *
+     * Other long lived threads that submit a lot (the render thread) get a deque and slot ring of their own with
+     * `registerThread`. Threads that are neither a worker, the owner nor registered submit through a mutex protected
+     * queue, and their jobs are allocated.
+     *
+     * `wait` lets the waiting thread execute jobs until the counter reaches zero instead of blocking, so waiting
+     * from inside a job or from the main thread never wastes a thread.
+     *
+     * @code
+     * VyJobCounter counter;
+     *
+     * jobs.run([&]() { ... }, &counter);
+     * jobs.run([&]() { ... }, &counter);
+     *
+     * jobs.wait(counter);
+     *
+     * jobs.parallelFor(count, 256, [&](U32 begin, U32 end) { ... });
+     * @endcode
+     */
+    class VyJobSystem
+    {
+    public:
+        static constexpr size_t kInlineSize     = 96;   // Callable bytes stored in the job itself.
+        static constexpr U32    kJobsPerThread  = 4096; // Job slots (and deque capacity) per thread, power of two.
+        static constexpr U32    kMaxRegistered  = 2;    // Threads that can be registered at the same time.
+
+        /**
+         * @param workerCount Number of worker threads, 0 = hardware_concurrency - 1 (the owner thread helps).
+         */
+        explicit VyJobSystem(U32 workerCount = 0);
+
+        VyJobSystem(const VyJobSystem&)            = delete;
+        VyJobSystem& operator=(const VyJobSystem&) = delete;
+
+        /**
+         * @brief Waits for every submitted job, then stops the workers.
+         */
+        ~VyJobSystem();
+
+        /**
+         * @brief Job system shared by the engine, created on first use by the calling thread (its owner).
+         */
+        static VyJobSystem& shared();
+
+        /**
+         * @brief Schedules `function()`, `counter` (optional) is incremented now and decremented once it ran.
+         *
+         * @note Exceptions escaping the function are logged and dropped.
+         */
+        template <typename F>
+        void run(F&& function, VyJobCounter* counter = nullptr);
+
+        /**
+         * @brief Executes jobs on the calling thread until `counter` reaches zero.
+         */
+        void wait(VyJobCounter& counter);
+
+        /**
+         * @brief Like `wait`, but only helps with the jobs of the calling thread and the workers, never with jobs
+         *        submitted by registered or external threads.
+         *
+         * Keeps a thread that waits for its own work (the main thread waiting for the logic systems) from picking
+         * up another thread's jobs (the render thread's recording) and finishing late because of them.
+         */
+        void waitLocal(VyJobCounter& counter);
+
+        /**
+         * @brief Calls `function(begin, end)` over [0, count) in ranges of `grainSize` and waits for all of them.
+         *
+         * The calling thread runs ranges itself while it waits, and no jobs of other registered or external threads
+         * (see `waitLocal`).
+         */
+        template <typename F>
+        void parallelFor(U32 count, U32 grainSize, F&& function);
+
+        /**
+         * @brief Gives the calling thread its own deque and job slots, so its jobs are submitted without locking
+         *        or allocating. Does nothing for the owner and the workers.
+         *
+         * @return False (the thread keeps submitting through the locked queue) if `kMaxRegistered` threads are
+         *         registered already.
+         */
+        bool registerThread();
+
+        /**
+         * @brief Runs the jobs the calling thread submitted until they all finished, then frees its queue for
+         *        another thread. Must be called before a registered thread exits.
+         */
+        void unregisterThread();
+
+        VY_NODISCARD U32 workerCount() const { return static_cast<U32>(m_Workers.size()); }
+
+        /**
+         * @brief Number of jobs queued and not started yet.
+         */
+        VY_NODISCARD U32 pendingCount() const { return m_Pending.load(std::memory_order_relaxed); }
+
+    private:
+        struct alignas(64) Job
+        {
+            using InvokeFn = void(*)(Job& job);
+
+            InvokeFn      Invoke { nullptr }; // Runs and destroys the callable.
+            VyJobCounter* Counter{ nullptr };
+            AtomicBool    bBusy  { false };   // Slot holds a job that has not finished yet.
+            bool          bHeap  { false };   // Slot came from `new`, submitted from a foreign thread.
+
+            alignas(std::max_align_t) std::byte Storage[ kInlineSize ];
+        };
+
+        /**
+         * @brief Chase-Lev work-stealing deque of fixed capacity (Le, Pop, Cohen, Zappa Nardelli 2013).
+         *
+         * `push` / `pop` are only called by the owning thread, `steal` by any thread.
+         */
+        class Deque
+        {
+        public:
+            bool push(Job* job);
+            Job* pop();
+            Job* steal();
+
+        private:
+            alignas(64) Atomic<I64> m_Top   { 0 };
+            alignas(64) Atomic<I64> m_Bottom{ 0 };
+
+            TArray<Atomic<Job*>, kJobsPerThread> m_Buffer{};
+        };
+
+        struct ThreadQueue
+        {
+            Deque        Jobs;
+            TVector<Job> Slots;
+            U32          NextSlot{ 0 };
+        };
+
+        static constexpr U32 kExternalThread = ~0u;
+
+        /**
+         * @brief Queue index of the calling thread: 0 for the owner, 1..N for workers, N+1.. for registered threads,
+         *        kExternalThread otherwise.
+         */
+        U32  threadIndex() const;
+
+        Job& allocateJob(U32 index);
+        void submit(U32 index, Job& job);
+
+        /**
+         * @param bForeign Also take the jobs of registered and external threads.
+         */
+        Job* findJob(U32 index, bool bForeign = true);
+        void execute(Job& job);
+
+        void workerLoop(U32 index);
+
+        /**
+         * @brief Returns a slot whose job never got submitted (its callable failed to construct).
+         */
+        void releaseJob(Job& job);
+
+        template <typename Fn>
+        static constexpr bool kFitsInline = sizeof(Fn) <= kInlineSize && alignof(Fn) <= alignof(std::max_align_t);
+
+        template <typename Fn>
+        static void invoke(Job& job);
+
+        TVector<Unique<ThreadQueue>> m_Queues;            // [0] = owner thread, [1..N] = workers, then registered threads.
+        TVector<std::thread>         m_Workers;
+        std::thread::id              m_OwnerThread;
+
+        TArray<AtomicBool, kMaxRegistered> m_bRegistered{}; // Registered queue in use by a thread.
+
+        Mutex                        m_ExternalMutex;     // Guards m_External.
+        TDeque<Job*>                 m_External;          // Jobs submitted by foreign threads.
+
+        AtomicU32                    m_Pending { 0 };     // Jobs queued, not started yet.
+        AtomicU32                    m_Sleeping{ 0 };     // Workers waiting on m_WakeCondition.
+        Mutex                        m_WakeMutex;
+        ConditionVariable            m_WakeCondition;
+        AtomicBool                   m_bStop   { false };
+        VyJobCounter                 m_AllJobs;           // Every job, waited on by the destructor.
+    };
+
+    // ============================================================================================
+
+    template <typename Fn>
+    void VyJobSystem::invoke(Job& job)
+    {
+        if constexpr (kFitsInline<Fn>)
+        {
+            Fn& function = *std::launder(reinterpret_cast<Fn*>(job.Storage));
+
+            struct Destroy
+            {
+                Fn& Function;
+
+                ~Destroy() { Function.~Fn(); }
+            } destroy{ function };
+
+            function();
+        }
+        else
+        {
+            Unique<Fn> function{ *std::launder(reinterpret_cast<Fn**>(job.Storage)) };
+
+            (*function)();
+        }
+    }
+
+
+    template <typename F>
+    void VyJobSystem::run(F&& function, VyJobCounter* counter)
+    {
+        using Fn = std::decay_t<F>;
+
+        const U32 index = threadIndex();
+        Job&      job   = allocateJob(index);
+
+        try
+        {
+            if constexpr (kFitsInline<Fn>)
+            {
+                ::new (job.Storage) Fn(std::forward<F>(function));
+            }
+            else
+            {
+                ::new (job.Storage) Fn*(new Fn(std::forward<F>(function)));
+            }
+        }
+        catch (...)
+        {
+            releaseJob(job);
+
+            throw;
+        }
+
+        job.Invoke  = &invoke<Fn>;
+        job.Counter = counter;
+
+        if (counter)
+        {
+            counter->m_Value.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        m_AllJobs.m_Value.fetch_add(1, std::memory_order_relaxed);
+
+        submit(index, job);
+    }
+
+
+    template <typename F>
+    void VyJobSystem::parallelFor(U32 count, U32 grainSize, F&& function)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        grainSize = std::max(grainSize, 1u);
+
+        // Small enough to not be worth a job.
+        if (count <= grainSize)
+        {
+            function(0u, count);
+
+            return;
+        }
+
+        VyJobCounter counter;
+
+        for (U32 begin = 0; begin < count; begin += grainSize)
+        {
+            const U32 end = std::min(begin + grainSize, count);
+
+            run([&function, begin, end]() { function(begin, end); }, &counter);
+        }
+
+        // The ranges are in the caller's deque, other threads' jobs would only delay the caller.
+        waitLocal(counter);
+    }
+}
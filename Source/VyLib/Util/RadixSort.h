@@ -0,0 +1,82 @@
+#pragma once
+
+#include <VyLib/Common/Numeric.h>
+#include <VyLib/STL/Containers.h>
+
+#include <utility>
+
+namespace Vy
+{
+    /**
+     * @brief Stable LSD radix sort of `items` by a 64-bit key, 8 bits per pass.
+     *
+     * Passes over bytes that are equal in every key are skipped, so keys with unused or constant fields only pay for
+     * the bytes that actually differ. `scratch` is resized to the item count and reused between calls.
+     *
+     * @param keyOf Returns the U64 sort key of an item, called once per item and pass.
+     */
+    template <typename T, typename KeyFn>
+    void radixSort64(TVector<T>& items, TVector<T>& scratch, KeyFn&& keyOf)
+    {
+        const size_t count = items.size();
+
+        if (count < 2)
+        {
+            return;
+        }
+
+        // One histogram per byte, built in a single pass over the keys.
+        TArray<TArray<U32, 256>, 8> histograms{};
+
+        for (const T& item : items)
+        {
+            const U64 key = keyOf(item);
+
+            for (U32 byte = 0; byte < 8; byte++)
+            {
+                histograms[ byte ][ (key >> (byte * 8)) & 0xFF ]++;
+            }
+        }
+
+        scratch.resize(count);
+
+        TVector<T>* source      = &items;
+        TVector<T>* destination = &scratch;
+
+        for (U32 byte = 0; byte < 8; byte++)
+        {
+            TArray<U32, 256>& histogram = histograms[ byte ];
+
+            // Every key has the same value in this byte, the pass would not move anything.
+            if (histogram[ (keyOf((*source)[0]) >> (byte * 8)) & 0xFF ] == count)
+            {
+                continue;
+            }
+
+            // Histogram to exclusive prefix sum: the first output index of each bucket.
+            U32 offset = 0;
+
+            for (U32& bucket : histogram)
+            {
+                const U32 bucketCount = bucket;
+
+                bucket  = offset;
+                offset += bucketCount;
+            }
+
+            for (T& item : *source)
+            {
+                const U32 bucket = static_cast<U32>((keyOf(item) >> (byte * 8)) & 0xFF);
+
+                (*destination)[ histogram[ bucket ]++ ] = std::move(item);
+            }
+
+            std::swap(source, destination);
+        }
+
+        if (source != &items)
+        {
+            items.swap(scratch);
+        }
+    }
+}
@@ -0,0 +1,138 @@
+#include <VyLib/Util/RangeAllocator.h>
+
+#include <iterator>
+
+namespace Vy
+{
+    VyRangeAllocator::VyRangeAllocator(U32 capacity)
+    {
+        reset(capacity);
+    }
+
+
+    U32 VyRangeAllocator::allocate(U32 size)
+    {
+        VY_ASSERT(size > 0, "Cannot allocate an empty range");
+
+        // Smallest free range of at least `size` units, lowest offset first.
+        auto fit = m_BySize.lower_bound({ size, 0 });
+
+        if (fit == m_BySize.end())
+        {
+            return kInvalidOffset;
+        }
+
+        const auto [ rangeSize, offset ] = *fit;
+
+        eraseFree(m_ByOffset.find(offset));
+
+        if (rangeSize > size)
+        {
+            insertFree(offset + size, rangeSize - size);
+        }
+
+        m_Used += size;
+
+        return offset;
+    }
+
+
+    void VyRangeAllocator::free(U32 offset, U32 size)
+    {
+        VY_ASSERT(size > 0 && offset + size <= m_Capacity, "Range is not part of the allocator");
+
+        m_Used -= size;
+
+        auto next = m_ByOffset.lower_bound(offset);
+
+        VY_ASSERT(next == m_ByOffset.end() || offset + size <= next->first, "Range overlaps a free range");
+
+        // Merge with the following free range.
+        if (next != m_ByOffset.end() && next->first == offset + size)
+        {
+            size += next->second;
+
+            eraseFree(next);
+
+            next = m_ByOffset.lower_bound(offset);
+        }
+
+        // Merge with the preceding free range.
+        if (next != m_ByOffset.begin())
+        {
+            auto previous = std::prev(next);
+
+            VY_ASSERT(previous->first + previous->second <= offset, "Range overlaps a free range");
+
+            if (previous->first + previous->second == offset)
+            {
+                offset  = previous->first;
+                size   += previous->second;
+
+                eraseFree(previous);
+            }
+        }
+
+        insertFree(offset, size);
+    }
+
+
+    void VyRangeAllocator::grow(U32 newCapacity)
+    {
+        VY_ASSERT(newCapacity >= m_Capacity, "Cannot shrink a range allocator");
+
+        if (newCapacity == m_Capacity)
+        {
+            return;
+        }
+
+        U32 offset = m_Capacity;
+        U32 size   = newCapacity - m_Capacity;
+
+        if (!m_ByOffset.empty())
+        {
+            auto last = std::prev(m_ByOffset.end());
+
+            if (last->first + last->second == m_Capacity)
+            {
+                offset  = last->first;
+                size   += last->second;
+
+                eraseFree(last);
+            }
+        }
+
+        insertFree(offset, size);
+
+        m_Capacity = newCapacity;
+    }
+
+
+    void VyRangeAllocator::reset(U32 capacity)
+    {
+        m_ByOffset.clear();
+        m_BySize.clear();
+
+        m_Capacity = capacity;
+        m_Used     = 0;
+
+        if (capacity > 0)
+        {
+            insertFree(0, capacity);
+        }
+    }
+
+
+    void VyRangeAllocator::insertFree(U32 offset, U32 size)
+    {
+        m_ByOffset.emplace(offset, size);
+        m_BySize.emplace(size, offset);
+    }
+
+
+    void VyRangeAllocator::eraseFree(TMap<U32, U32>::iterator it)
+    {
+        m_BySize.erase({ it->second, it->first });
+        m_ByOffset.erase(it);
+    }
+}
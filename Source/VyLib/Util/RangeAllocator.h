@@ -0,0 +1,79 @@
+#pragma once
+
+#include <VyLib/Common/Numeric.h>
+#include <VyLib/Core/Assert.h>
+#include <VyLib/STL/Containers.h>
+
+#include <utility>
+
+namespace Vy
+{
+    /**
+     * @brief Sub-allocates ranges of [0, capacity) with a best fit free list.
+     *
+     * Only the bookkeeping, the units (bytes, vertices, indices) and the memory are the caller's. Free ranges are
+     * kept twice, by offset to coalesce neighbours on `free` and by size to find the smallest range that fits in
+     * O(log n). Ties go to the lowest offset, which keeps the allocations packed towards the front.
+     *
+     * @note Not thread-safe.
+     */
+    class VyRangeAllocator
+    {
+    public:
+        static constexpr U32 kInvalidOffset = ~0u;
+
+        explicit VyRangeAllocator(U32 capacity = 0);
+
+        /**
+         * @brief Allocates `size` units.
+         *
+         * @return The offset of the range, or `kInvalidOffset` if no free range is large enough.
+         */
+        VY_NODISCARD U32 allocate(U32 size);
+
+        /**
+         * @brief Returns a range from `allocate`, merging it with the free ranges next to it.
+         */
+        void free(U32 offset, U32 size);
+
+        /**
+         * @brief Extends the capacity, the new space joins the free range at the end if there is one.
+         */
+        void grow(U32 newCapacity);
+
+        /**
+         * @brief Frees everything and sets a new capacity.
+         */
+        void reset(U32 capacity);
+
+        VY_NODISCARD U32 capacity() const { return m_Capacity; }
+        VY_NODISCARD U32 used()     const { return m_Used; }
+
+        VY_NODISCARD U32 freeRangeCount() const { return static_cast<U32>(m_ByOffset.size()); }
+
+        VY_NODISCARD U32 largestFreeRange() const
+        {
+            return m_BySize.empty() ? 0 : m_BySize.rbegin()->first;
+        }
+
+        /**
+         * @brief Share of the free space that is not in the largest free range, 0 when the free space is contiguous.
+         */
+        VY_NODISCARD float fragmentation() const
+        {
+            const U32 freeSpace = m_Capacity - m_Used;
+
+            return freeSpace == 0 ? 0.0f : 1.0f - static_cast<float>(largestFreeRange()) / static_cast<float>(freeSpace);
+        }
+
+    private:
+        void insertFree(U32 offset, U32 size);
+        void eraseFree(TMap<U32, U32>::iterator it);
+
+        TMap<U32, U32>            m_ByOffset; // Offset -> size.
+        TSet<std::pair<U32, U32>> m_BySize;   // (size, offset), for the best fit search.
+
+        U32 m_Capacity{ 0 };
+        U32 m_Used    { 0 };
+    };
+}